@@ -1198,8 +1198,12 @@ lifetime_calendar_t * lifetime_calendar_t::clone(){ return new lifetime_calendar
 void lifetime_calendar_t::copy(lifetime_calendar_t * lifetime_calendar)
 {
 	_calendar_choice = lifetime_calendar->_calendar_choice;
+
+	// doesn't change (and potentially slow)
+	/*
 	_calendar_days = lifetime_calendar->_calendar_days;
 	_calendar_capacity = lifetime_calendar->_calendar_capacity;
+	*/
 	_day_age_of_battery = lifetime_calendar->_day_age_of_battery;
 	_dt_hour = lifetime_calendar->_dt_hour;
 	_dt_day = lifetime_calendar->_dt_day;
@@ -1325,7 +1329,10 @@ void thermal_t::copy(thermal_t * thermal)
 	_height = thermal->_height;
 	_Cp = thermal->_Cp;
 	_h = thermal->_h;
-	_T_room = thermal->_T_room;
+
+	// the room temperature series doesn't change, only copy it into a default-constructed model
+	if (_T_room.size() != thermal->_T_room.size())
+		_T_room = thermal->_T_room;
 	_R = thermal->_R;
 	_A = thermal->_A;
 	_T_battery = thermal->_T_battery;
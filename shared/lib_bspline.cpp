@@ -0,0 +1,184 @@
+/*******************************************************************************************************
+*  Copyright 2017 Alliance for Sustainable Energy, LLC
+*
+*  NOTICE: This software was developed at least in part by Alliance for Sustainable Energy, LLC
+*  (Alliance) under Contract No. DE-AC36-08GO28308 with the U.S. Department of Energy and the U.S.
+*  The Government retains for itself and others acting on its behalf a nonexclusive, paid-up,
+*  irrevocable worldwide license in the software to reproduce, prepare derivative works, distribute
+*  copies to the public, perform publicly and display publicly, and to permit others to do so.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted
+*  provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, the above government
+*  rights notice, this list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice, the above government
+*  rights notice, this list of conditions and the following disclaimer in the documentation and/or
+*  other materials provided with the distribution.
+*
+*  3. The entire corresponding source code of any redistribution, with or without modification, by a
+*  research entity, including but not limited to any contracting manager/operator of a United States
+*  National Laboratory, any institution of higher learning, and any non-profit organization, must be
+*  made publicly available under this license for as long as the redistribution is made available by
+*  the research entity.
+*
+*  4. Redistribution of this software, without modification, must refer to the software by the same
+*  designation. Redistribution of a modified version of this software (i) may not refer to the modified
+*  version by the same designation, or by any confusingly similar designation, and (ii) must refer to
+*  the underlying software originally provided by Alliance as System Advisor Model or SAM. Except
+*  to comply with the foregoing, the terms System Advisor Model, SAM, or any confusingly similar
+*  designation may not be used to refer to any modified version of this software or any modified
+*  version of the underlying software originally provided by Alliance without the prior written consent
+*  of Alliance.
+*
+*  5. The name of the copyright holder, contributors, the United States Government, the United States
+*  Department of Energy, or any of their employees may not be used to endorse or promote products
+*  derived from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+*  IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+*  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER,
+*  CONTRIBUTORS, UNITED STATES GOVERNMENT OR UNITED STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR
+*  EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+*  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+*  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+*  THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "lib_bspline.h"
+
+bspline_evaluator::bspline_evaluator()
+{
+	m_n_vars = 0;
+	m_degree[0] = m_degree[1] = 0;
+	m_n_basis[0] = m_n_basis[1] = 0;
+}
+
+bool bspline_evaluator::compile(const SPLINTER::BSpline &bspline)
+{
+	m_n_vars = 0;
+	m_coefs.clear();
+
+	int n_vars = (int)bspline.getNumVariables();
+	if (n_vars < 1 || n_vars > 2)
+		return false;
+
+	std::vector< std::vector<double> > knots = bspline.getKnotVectors();
+	std::vector<unsigned int> degrees = bspline.getBasisDegrees();
+	if ((int)knots.size() != n_vars || (int)degrees.size() != n_vars)
+		return false;
+
+	int n_coefs = 1;
+	for (int v = 0; v < n_vars; v++)
+	{
+		int p = (int)degrees[v];
+		const std::vector<double> &t = knots[v];
+		if (p > MAX_DEGREE || (int)t.size() < 2 * (p + 1))
+			return false;
+
+		// Clamped: the first and last knots are repeated (degree + 1) times
+		for (int k = 1; k <= p; k++)
+		{
+			if (t[k] != t[0] || t[t.size() - 1 - k] != t.back())
+				return false;
+		}
+
+		m_degree[v] = p;
+		m_n_basis[v] = (int)t.size() - (p + 1);
+		m_knots[v] = t;
+		n_coefs *= m_n_basis[v];
+	}
+
+	SPLINTER::DenseMatrix control_points = bspline.getControlPoints();
+	if ((int)control_points.rows() != n_coefs)
+		return false;
+
+	m_coefs.resize(n_coefs);
+	for (int i = 0; i < n_coefs; i++)
+		m_coefs[i] = control_points(i, n_vars);
+
+	m_n_vars = n_vars;
+	return true;
+}
+
+int bspline_evaluator::eval_basis(int var, double x, double *N) const
+{
+	const std::vector<double> &t = m_knots[var];
+	int p = m_degree[var];
+
+	if (!(x >= t.front() && x <= t.back()))
+		return -1;
+
+	// The last knot belongs to the last interval, as in SPLINTER
+	if (x == t.back())
+		x = std::nextafter(x, std::numeric_limits<double>::lowest());
+
+	// Knot interval t[mu] <= x < t[mu + 1]
+	int mu = (int)(std::upper_bound(t.begin(), t.end(), x) - t.begin()) - 1;
+
+	// Cox-de Boor recursion over the (p + 1) nonzero basis functions
+	double left[MAX_DEGREE + 1], right[MAX_DEGREE + 1];
+	N[0] = 1.0;
+	for (int j = 1; j <= p; j++)
+	{
+		left[j] = x - t[mu + 1 - j];
+		right[j] = t[mu + j] - x;
+		double saved = 0.0;
+		for (int r = 0; r < j; r++)
+		{
+			double temp = N[r] / (right[r + 1] + left[j - r]);
+			N[r] = saved + right[r + 1] * temp;
+			saved = left[j - r] * temp;
+		}
+		N[j] = saved;
+	}
+
+	return mu - p;
+}
+
+double bspline_evaluator::eval(double x) const
+{
+	if (m_n_vars != 1)
+		return std::numeric_limits<double>::quiet_NaN();
+
+	double N[MAX_DEGREE + 1];
+	int i = eval_basis(0, x, N);
+	if (i < 0)
+		return 0.0;
+
+	double val = 0.0;
+	for (int a = 0; a <= m_degree[0]; a++)
+		val += N[a] * m_coefs[i + a];
+
+	return val;
+}
+
+double bspline_evaluator::eval(double x, double y) const
+{
+	if (m_n_vars != 2)
+		return std::numeric_limits<double>::quiet_NaN();
+
+	double N_x[MAX_DEGREE + 1], N_y[MAX_DEGREE + 1];
+	int i = eval_basis(0, x, N_x);
+	int j = eval_basis(1, y, N_y);
+	if (i < 0 || j < 0)
+		return 0.0;
+
+	double val = 0.0;
+	for (int a = 0; a <= m_degree[0]; a++)
+	{
+		const double *coefs = &m_coefs[(i + a)*m_n_basis[1] + j];
+		double val_y = 0.0;
+		for (int b = 0; b <= m_degree[1]; b++)
+			val_y += N_y[b] * coefs[b];
+		val += N_x[a] * val_y;
+	}
+
+	return val;
+}
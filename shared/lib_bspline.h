@@ -0,0 +1,95 @@
+/*******************************************************************************************************
+*  Copyright 2017 Alliance for Sustainable Energy, LLC
+*
+*  NOTICE: This software was developed at least in part by Alliance for Sustainable Energy, LLC
+*  (Alliance) under Contract No. DE-AC36-08GO28308 with the U.S. Department of Energy and the U.S.
+*  The Government retains for itself and others acting on its behalf a nonexclusive, paid-up,
+*  irrevocable worldwide license in the software to reproduce, prepare derivative works, distribute
+*  copies to the public, perform publicly and display publicly, and to permit others to do so.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted
+*  provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, the above government
+*  rights notice, this list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice, the above government
+*  rights notice, this list of conditions and the following disclaimer in the documentation and/or
+*  other materials provided with the distribution.
+*
+*  3. The entire corresponding source code of any redistribution, with or without modification, by a
+*  research entity, including but not limited to any contracting manager/operator of a United States
+*  National Laboratory, any institution of higher learning, and any non-profit organization, must be
+*  made publicly available under this license for as long as the redistribution is made available by
+*  the research entity.
+*
+*  4. Redistribution of this software, without modification, must refer to the software by the same
+*  designation. Redistribution of a modified version of this software (i) may not refer to the modified
+*  version by the same designation, or by any confusingly similar designation, and (ii) must refer to
+*  the underlying software originally provided by Alliance as System Advisor Model or SAM. Except
+*  to comply with the foregoing, the terms System Advisor Model, SAM, or any confusingly similar
+*  designation may not be used to refer to any modified version of this software or any modified
+*  version of the underlying software originally provided by Alliance without the prior written consent
+*  of Alliance.
+*
+*  5. The name of the copyright holder, contributors, the United States Government, the United States
+*  Department of Energy, or any of their employees may not be used to endorse or promote products
+*  derived from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+*  IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+*  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER,
+*  CONTRIBUTORS, UNITED STATES GOVERNMENT OR UNITED STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR
+*  EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+*  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+*  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+*  THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************************************/
+#ifndef __lib_bspline_h
+#define __lib_bspline_h
+
+#include <vector>
+
+#include "bspline.h"
+
+/**
+* Fast evaluation of a 1D or 2D tensor product B-spline built by SPLINTER.
+*
+* BSpline::eval builds Eigen sparse vectors and Kronecker products for every call. compile() instead copies
+* the knot vectors and coefficients of the spline once into flat arrays, and eval() finds the knot interval
+* with a binary search and evaluates the (degree + 1) nonzero basis functions of each variable on the stack,
+* without heap allocation. Results match BSpline::eval to rounding, including the value of 0 outside the knots.
+*/
+class bspline_evaluator
+{
+public:
+	static const int MAX_DEGREE = 5;
+
+	bspline_evaluator();
+
+	// Returns false, and leaves the evaluator empty, if the spline has more than 2 variables,
+	// a degree above MAX_DEGREE, or knot vectors that are not clamped
+	bool compile(const SPLINTER::BSpline &bspline);
+
+	bool is_compiled() const { return m_n_vars > 0; }
+
+	// Evaluate a 1D spline. Returns NaN if the spline is not 1D
+	double eval(double x) const;
+
+	// Evaluate a 2D spline. Returns NaN if the spline is not 2D
+	double eval(double x, double y) const;
+
+private:
+	int m_n_vars;
+	int m_degree[2];
+	int m_n_basis[2];
+	std::vector<double> m_knots[2];
+	std::vector<double> m_coefs;	// tensor product order: the last variable varies fastest
+
+	// Values of the nonzero basis functions of variable 'var' at x in N.
+	// Returns the index of the first one, or -1 if x is outside the knots
+	int eval_basis(int var, double x, double *N) const;
+};
+
+#endif
@@ -862,6 +862,7 @@ void irrad::setup()
 	planeOfArrayIrradianceRear[0] = planeOfArrayIrradianceRear[1] = planeOfArrayIrradianceRear[2] = diffuseIrradianceRear[0] = diffuseIrradianceRear[1] = diffuseIrradianceRear[2] = std::numeric_limits<double>::quiet_NaN();
 	timeStepSunPosition[0] = timeStepSunPosition[1] = timeStepSunPosition[2] = -999;
 	planeOfArrayIrradianceRearAverage = 0;
+	sunPositionPrecalculated = false;
 
 	calculatedDirectNormal = directNormal;
 	calculatedDiffuseHorizontal = 0.0;
@@ -1056,6 +1057,14 @@ void irrad::set_poa_pyranometer( double poaIrradianceFront, poaDecompReq* pA ){
 	this->radiationMode = irrad::POA_P;
 	this->poaAll = pA;
 }
+void irrad::set_sun_position(const double sunAngles[9], const int sunPositionTime[3])
+{
+	for (int i = 0; i < 9; i++)
+		sunAnglesRadians[i] = sunAngles[i];
+	for (int i = 0; i < 3; i++)
+		timeStepSunPosition[i] = sunPositionTime[i];
+	sunPositionPrecalculated = true;
+}
 void irrad::set_sun_component(size_t index, double value)
 {
 	if (index < sizeof(sunAnglesRadians) / sizeof(sunAnglesRadians[0])) {
@@ -1063,29 +1072,25 @@ void irrad::set_sun_component(size_t index, double value)
 	}
 }
 
-int irrad::calc()
-{
-	int code = check();
-	if ( code < 0 )
-		return -100+code;
 /*
-	calculates effective sun position at current timestep, with delt specified in hours
+	calculates effective sun position at the timestep, with delt specified in hours. sunNoon is the output of
+	solarpos() at noon on the same day, which provides the sunrise and sunset hours. Shared by irrad::calc()
+	and irrad_series::calc_sun(), which calculates sunNoon once per day.
+
+	sunn: results from solarpos
+	tsp: [0]  effective hour of day used for sun position
+		[1]  effective minute of hour used for sun position
+		[2]  is sun up?  (0=no, 1=midday, 2=sunup, 3=sundown)
+*/
+static void sun_position_timestep( int year, int month, int day, int hour, double minute, double delt,
+	double lat, double lon, double tz, const double sunNoon[9], double sunn[9], int tsp[3] )
+{
+	for (int i = 0; i < 9; i++)
+		sunn[i] = sunNoon[i];
 
-	sunAnglesRadians: results from solarpos
-	timeStepSunPosition: [0]  effective hour of day used for sun position
-			[1]  effective minute of hour used for sun position
-			[2]  is sun up?  (0=no, 1=midday, 2=sunup, 3=sundown)
-	surfaceAnglesRadians: result from incidence
-	planeOfArrayIrradianceFront: result from sky model
-	diff: broken out diffuse components from sky model
-*/	
 	double t_cur = hour + minute/60.0;
-
-	// calculate sunrise and sunset hours in local standard time for the current day
-	solarpos( year, month, day, 12, 0.0, latitudeDegrees, longitudeDegrees, timezone, sunAnglesRadians );
-
-	double t_sunrise = sunAnglesRadians[4];
-	double t_sunset = sunAnglesRadians[5];
+	double t_sunrise = sunNoon[4];
+	double t_sunset = sunNoon[5];
 
 	// recall: if delt <= 0.0, do not interpolate sunrise and sunset hours, just use specified time stamp
 	if ( delt > 0
@@ -1097,12 +1102,12 @@ int irrad::calc()
 		int hr_calc = (int)t_calc;
 		double min_calc = (t_calc-hr_calc)*60.0;
 
-		timeStepSunPosition[0] = hr_calc;
-		timeStepSunPosition[1] = (int)min_calc;
+		tsp[0] = hr_calc;
+		tsp[1] = (int)min_calc;
 				
-		solarpos( year, month, day, hr_calc, min_calc, latitudeDegrees, longitudeDegrees, timezone, sunAnglesRadians );
+		solarpos( year, month, day, hr_calc, min_calc, lat, lon, tz, sunn );
 
-		timeStepSunPosition[2] = 2;				
+		tsp[2] = 2;				
 	}
 	else if ( delt > 0
 		&& t_cur > t_sunset - delt/2.0
@@ -1113,30 +1118,55 @@ int irrad::calc()
 		int hr_calc = (int)t_calc;
 		double min_calc = (t_calc-hr_calc)*60.0;
 
-		timeStepSunPosition[0] = hr_calc;
-		timeStepSunPosition[1] = (int)min_calc;
+		tsp[0] = hr_calc;
+		tsp[1] = (int)min_calc;
 				
-		solarpos( year, month, day, hr_calc, min_calc, latitudeDegrees, longitudeDegrees, timezone, sunAnglesRadians );
+		solarpos( year, month, day, hr_calc, min_calc, lat, lon, tz, sunn );
 
-		timeStepSunPosition[2] = 3;
+		tsp[2] = 3;
 	}
 	else if (t_cur >= t_sunrise && t_cur <= t_sunset)
 	{
 		// timestep is not sunrise nor sunset, but sun is up  (calculate position at provided t_cur)			
-		timeStepSunPosition[0] = hour;
-		timeStepSunPosition[1] = (int)minute;
-		solarpos( year, month, day, hour, minute, latitudeDegrees, longitudeDegrees, timezone, sunAnglesRadians );
-		timeStepSunPosition[2] = 1;
+		tsp[0] = hour;
+		tsp[1] = (int)minute;
+		solarpos( year, month, day, hour, minute, lat, lon, tz, sunn );
+		tsp[2] = 1;
 	}
 	else
 	{	
 		// sun is down, assign sundown values
-		sunAnglesRadians[0] = -999*DTOR; //avoid returning a junk azimuth angle (return in radians)
-		sunAnglesRadians[1] = -999*DTOR; //avoid returning a junk zenith angle (return in radians)
-		sunAnglesRadians[2] = -999*DTOR; //avoid returning a junk elevation angle (return in radians)
-		timeStepSunPosition[0] = 0;
-		timeStepSunPosition[1] = 0;
-		timeStepSunPosition[2] = 0;
+		sunn[0] = -999*DTOR; //avoid returning a junk azimuth angle (return in radians)
+		sunn[1] = -999*DTOR; //avoid returning a junk zenith angle (return in radians)
+		sunn[2] = -999*DTOR; //avoid returning a junk elevation angle (return in radians)
+		tsp[0] = 0;
+		tsp[1] = 0;
+		tsp[2] = 0;
+	}
+}
+
+int irrad::calc()
+{
+	int code = check();
+	if ( code < 0 )
+		return -100+code;
+/*
+	calculates effective sun position at current timestep, with delt specified in hours
+
+	sunAnglesRadians: results from solarpos
+	timeStepSunPosition: [0]  effective hour of day used for sun position
+			[1]  effective minute of hour used for sun position
+			[2]  is sun up?  (0=no, 1=midday, 2=sunup, 3=sundown)
+	surfaceAnglesRadians: result from incidence
+	planeOfArrayIrradianceFront: result from sky model
+	diff: broken out diffuse components from sky model
+*/	
+	if (!sunPositionPrecalculated)
+	{
+		// calculate sunrise and sunset hours in local standard time for the current day
+		double sunNoon[9];
+		solarpos( year, month, day, 12, 0.0, latitudeDegrees, longitudeDegrees, timezone, sunNoon );
+		sun_position_timestep( year, month, day, hour, minute, delt, latitudeDegrees, longitudeDegrees, timezone, sunNoon, sunAnglesRadians, timeStepSunPosition );
 	}
 
 			
@@ -1847,6 +1877,191 @@ void irrad::getBackSurfaceIrradiances(double pvBackShadeFraction, double rowToRo
 	}
 }
 
+irrad_series::irrad_series()
+{
+	latitudeDegrees = longitudeDegrees = timezone = -999;
+	delt = IRRADPROC_NO_INTERPOLATE_SUNRISE_SUNSET;
+	skyModel = irrad::PEREZ;
+	trackingMode = irrad::FIXED_TILT;
+	enableBacktrack = false;
+	tiltDegrees = surfaceAzimuthDegrees = rotationLimitDegrees = groundCoverageRatio = 0;
+}
+
+void irrad_series::set_location(double lat, double lon, double tz)
+{
+	latitudeDegrees = lat;
+	longitudeDegrees = lon;
+	timezone = tz;
+}
+
+void irrad_series::set_sky_model(int skymodel)
+{
+	skyModel = skymodel;
+}
+
+void irrad_series::set_surface(int tracking, double tilt_deg, double azimuth_deg, double rotlim_deg, bool en_backtrack, double gcr)
+{
+	trackingMode = tracking;
+	if (tracking == 4)
+		trackingMode = 0; //treat timeseries tilt as fixed tilt
+	tiltDegrees = tilt_deg;
+	surfaceAzimuthDegrees = azimuth_deg;
+	rotationLimitDegrees = rotlim_deg;
+	enableBacktrack = en_backtrack;
+	groundCoverageRatio = gcr;
+}
+
+void irrad_series::calc_sun(size_t n, const int *year, const int *month, const int *day, const int *hour, const double *minute, double delt_hr)
+{
+	delt = delt_hr;
+	for (int k = 0; k < 9; k++)
+		sunAnglesRadians[k].assign(n, std::numeric_limits<double>::quiet_NaN());
+	sunUp.assign(n, 0);
+	sunPositionHour.assign(n, 0);
+	sunPositionMinute.assign(n, 0);
+	timeCheck.assign(n, 0);
+
+	// sunrise and sunset only change from day to day, so the noon sun position is calculated once per day
+	double sunNoon[9];
+	int noonYear = -999, noonMonth = -999, noonDay = -999;
+	double sunn[9];
+	int tsp[3];
+	for (size_t i = 0; i < n; i++)
+	{
+		if (year[i] < 0 || month[i] < 0 || day[i] < 0 || hour[i] < 0 || minute[i] < 0 || delt > 1)
+		{
+			timeCheck[i] = -1;
+			continue;
+		}
+
+		if (year[i] != noonYear || month[i] != noonMonth || day[i] != noonDay)
+		{
+			solarpos(year[i], month[i], day[i], 12, 0.0, latitudeDegrees, longitudeDegrees, timezone, sunNoon);
+			noonYear = year[i];
+			noonMonth = month[i];
+			noonDay = day[i];
+		}
+
+		sun_position_timestep(year[i], month[i], day[i], hour[i], minute[i], delt, latitudeDegrees, longitudeDegrees, timezone, sunNoon, sunn, tsp);
+
+		for (int k = 0; k < 9; k++)
+			sunAnglesRadians[k][i] = sunn[k];
+		sunPositionHour[i] = tsp[0];
+		sunPositionMinute[i] = tsp[1];
+		sunUp[i] = tsp[2];
+	}
+}
+
+void irrad_series::calc_poa(int radiationMode, const double *gh, const double *dn, const double *df, const double *alb)
+{
+	size_t n = size();
+	for (int k = 0; k < 5; k++)
+		surfaceAnglesRadians[k].assign(n, 0.0);
+	for (int k = 0; k < 3; k++)
+	{
+		poaFront[k].assign(n, 0.0);
+		diffuseFront[k].assign(n, 0.0);
+	}
+	directNormal.assign(n, 0.0);
+	diffuseHorizontal.assign(n, 0.0);
+	code.assign(n, 0);
+
+	// input checks, in the same order as irrad::check()
+	int locationCheck = 0, surfaceCheck = 0;
+	if (latitudeDegrees < -90 || latitudeDegrees > 90 || longitudeDegrees < -180 || longitudeDegrees > 180 || timezone < -15 || timezone > 15) locationCheck = -2;
+	else if (radiationMode < irrad::DN_DF || radiationMode > irrad::GH_DF || skyModel < 0 || skyModel > 2) locationCheck = -3;
+	else if (trackingMode < 0 || trackingMode > 4) locationCheck = -4;
+	if (tiltDegrees < 0 || tiltDegrees > 90) surfaceCheck = -8;
+	else if (surfaceAzimuthDegrees < 0 || surfaceAzimuthDegrees >= 360) surfaceCheck = -9;
+	else if (rotationLimitDegrees < -90 || rotationLimitDegrees > 90) surfaceCheck = -10;
+
+	for (size_t i = 0; i < n; i++)
+	{
+		int c = timeCheck[i];
+		if (c == 0) c = locationCheck;
+		if (c == 0 && radiationMode == irrad::DN_DF && (dn[i] < 0 || dn[i] > irrad::irradiationMax || df[i] < 0 || df[i] > 1500)) c = -5;
+		if (c == 0 && radiationMode == irrad::DN_GH && (gh[i] < 0 || gh[i] > 1500 || dn[i] < 0 || dn[i] > 1500)) c = -6;
+		if (c == 0 && (alb[i] < 0 || alb[i] > 1)) c = -7;
+		if (c == 0) c = surfaceCheck;
+		if (c == 0 && radiationMode == irrad::GH_DF && (gh[i] < 0 || gh[i] > 1500 || df[i] < 0 || df[i] > 1500)) c = -11;
+		if (c < 0) code[i] = -100 + c;
+	}
+
+	// surface angles for every timestep with the sun up
+	double angle[5];
+	for (size_t i = 0; i < n; i++)
+	{
+		if (code[i] != 0 || sunUp[i] <= 0) continue;
+		incidence(trackingMode, tiltDegrees, surfaceAzimuthDegrees, rotationLimitDegrees, sunAnglesRadians[1][i], sunAnglesRadians[0][i], enableBacktrack, groundCoverageRatio, angle);
+		for (int k = 0; k < 5; k++)
+			surfaceAnglesRadians[k][i] = angle[k];
+	}
+
+	// beam and diffuse inputs on horizontal based on irradiance inputs mode
+	const double *zen = sunAnglesRadians[1].data();
+	const double *hextra = sunAnglesRadians[8].data();
+	for (size_t i = 0; i < n; i++)
+	{
+		if (code[i] != 0 || sunUp[i] <= 0) continue;
+		double cosz = cos(zen[i]);
+		if (radiationMode == irrad::DN_DF)
+		{
+			directNormal[i] = dn[i];
+			diffuseHorizontal[i] = df[i];
+		}
+		else if (radiationMode == irrad::DN_GH)
+		{
+			directNormal[i] = dn[i];
+			diffuseHorizontal[i] = gh[i] - dn[i] * cosz;
+			if (diffuseHorizontal[i] < 0) diffuseHorizontal[i] = 0;
+		}
+		else
+		{
+			directNormal[i] = (gh[i] - df[i]) / cosz;
+			if (directNormal[i] > irrad::irradiationMax) directNormal[i] = irrad::irradiationMax;
+			if (directNormal[i] < 0) directNormal[i] = 0;
+			diffuseHorizontal[i] = df[i];
+		}
+
+		// check beam irradiance against extraterrestrial irradiance, the input beam is not known in GH_DF mode
+		if (radiationMode != irrad::GH_DF && dn[i] * cosz > hextra[i])
+			code[i] = -1;
+	}
+
+	// incident irradiance on tilted surface
+	double poa[3], diffc[3];
+	for (size_t i = 0; i < n; i++)
+	{
+		if (code[i] != 0 || sunUp[i] <= 0) continue;
+		switch (skyModel)
+		{
+		case 0:
+			isotropic(hextra[i], directNormal[i], diffuseHorizontal[i], alb[i], surfaceAnglesRadians[0][i], surfaceAnglesRadians[1][i], zen[i], poa, diffc);
+			break;
+		case 1:
+			hdkr(hextra[i], directNormal[i], diffuseHorizontal[i], alb[i], surfaceAnglesRadians[0][i], surfaceAnglesRadians[1][i], zen[i], poa, diffc);
+			break;
+		default:
+			perez(hextra[i], directNormal[i], diffuseHorizontal[i], alb[i], surfaceAnglesRadians[0][i], surfaceAnglesRadians[1][i], zen[i], poa, diffc);
+			break;
+		}
+		for (int k = 0; k < 3; k++)
+		{
+			poaFront[k][i] = poa[k];
+			diffuseFront[k][i] = diffc[k];
+		}
+	}
+}
+
+void irrad_series::get_sun_position(size_t i, double sunAngles[9], int sunPositionTime[3]) const
+{
+	for (int k = 0; k < 9; k++)
+		sunAngles[k] = sunAnglesRadians[k][i];
+	sunPositionTime[0] = sunPositionHour[i];
+	sunPositionTime[1] = sunPositionMinute[i];
+	sunPositionTime[2] = sunUp[i];
+}
+
 static double vec_dot(double a[3], double b[3])
 {
 	return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
@@ -328,6 +328,7 @@ protected:
 	double diffuseIrradianceRear[3];		///< Rear-side diffuse irradiance for isotropic, circumsolar, and horizon (W/m2)
 	int timeStepSunPosition[3];				///< [0] effective hour of day used for sun position, [1] effective minute of hour used for sun position, [2] is sun up?  (0=no, 1=midday, 2=sunup, 3=sundown)
 	double planeOfArrayIrradianceRearAverage; ///< Average rear side plane-of-array irradiance (W/m2)
+	bool sunPositionPrecalculated;			///< True if the sun position was provided by set_sun_position() instead of calculated in calc()
 
 public:
 
@@ -384,6 +385,9 @@ public:
 	/// Function to overwrite internally calculated sun position values, primarily to enable testing against other libraries using different sun position calculations
 	void set_sun_component(size_t index, double value);
 
+	/// Use a sun position calculated in advance, such as by \link irrad_series::calc_sun(), instead of calculating it in calc()
+	void set_sun_position(const double sunAngles[9], const int sunPositionTime[3]);
+
 	/// Run the irradiance processor and calculate the plane-of-array irradiance and diffuse components of irradiance
 	int calc();
 
@@ -449,6 +453,78 @@ public:
 
 };
 
+/**
+* \class irrad_series
+*
+*  The irrad_series class calculates the sun position, surface angles, and front-side plane-of-array irradiance for a
+*  whole series of timesteps at once. Results are stored as structure-of-arrays, with one vector per component indexed
+*  by timestep, and each stage of the calculation runs as a loop over contiguous arrays. Sunrise and sunset are
+*  calculated once per day instead of once per timestep. Results for each timestep are identical to \link irrad::calc()
+*  for the same inputs, so the per-timestep irrad class can be replaced by a single call for a year of weather data.
+*/
+class irrad_series
+{
+protected:
+	double latitudeDegrees;			///< latitude in degrees, north positive
+	double longitudeDegrees;		///< longitude in degrees, east positive
+	double timezone;				///< time zone, west longitudes negative
+	double delt;					///< timestep in hours, or IRRADPROC_NO_INTERPOLATE_SUNRISE_SUNSET
+	int skyModel;					///< sky model selection as defined in \link irrad::SKYMODEL
+	int trackingMode;				///< the surface tracking model as defined in \link irrad::TRACKING
+	bool enableBacktrack;			///< Boolean value for whether backtracking is enabled or not
+	double tiltDegrees;				///< Surface tilt in degrees
+	double surfaceAzimuthDegrees;	///< Surface azimuth in degrees
+	double rotationLimitDegrees;	///< Rotation limit in degrees
+	double groundCoverageRatio;		///< Ground coverage ratio
+	std::vector<int> timeCheck;		///< Result of the time check in \link irrad::check() for each timestep
+
+public:
+
+	/// Default constructor, location, sky model and surface must be set before calculating
+	irrad_series();
+
+	/// Set the location
+	void set_location(double lat, double lon, double tz);
+
+	/// Set the sky model, using \link irrad::SKYMODEL
+	void set_sky_model(int skymodel);
+
+	/// Set the surface orientation, as in \link irrad::set_surface()
+	void set_surface(int tracking, double tilt_deg, double azimuth_deg, double rotlim_deg, bool en_backtrack, double gcr);
+
+	/// Calculate the sun position for n timesteps, where delt_hr is the timestep as in \link irrad::set_time()
+	void calc_sun(size_t n, const int *year, const int *month, const int *day, const int *hour, const double *minute, double delt_hr);
+
+	/**
+	* Calculate the surface angles and front-side plane-of-array irradiance for the timesteps from \link calc_sun()
+	*
+	* \param[in] radiationMode irrad::DN_DF, irrad::DN_GH, or irrad::GH_DF
+	* \param[in] gh global horizontal irradiance for each timestep (W/m2), may be NULL if not used by radiationMode
+	* \param[in] dn direct normal irradiance for each timestep (W/m2), may be NULL if not used by radiationMode
+	* \param[in] df diffuse horizontal irradiance for each timestep (W/m2), may be NULL if not used by radiationMode
+	* \param[in] alb albedo for each timestep (0-1)
+	*/
+	void calc_poa(int radiationMode, const double *gh, const double *dn, const double *df, const double *alb);
+
+	/// Return the sun position of timestep i in the form used by \link irrad::set_sun_position()
+	void get_sun_position(size_t i, double sunAngles[9], int sunPositionTime[3]) const;
+
+	/// Return the number of timesteps calculated
+	size_t size() const { return sunUp.size(); }
+
+	std::vector<double> sunAnglesRadians[9];		///< Sun angles for each timestep, as in the output of solarpos()
+	std::vector<int> sunUp;							///< Is sun up? (0=no, 1=midday, 2=sunup, 3=sundown)
+	std::vector<int> sunPositionHour;				///< Effective hour of day used for sun position
+	std::vector<int> sunPositionMinute;				///< Effective minute of hour used for sun position
+
+	std::vector<double> surfaceAnglesRadians[5];	///< Surface angles for each timestep, as in the output of incidence()
+	std::vector<double> poaFront[3];				///< Front-side plane-of-array irradiance for beam, sky diffuse, ground diffuse (W/m2)
+	std::vector<double> diffuseFront[3];			///< Front-side diffuse irradiance for isotropic, circumsolar, and horizon (W/m2)
+	std::vector<double> directNormal;				///< Direct normal irradiance used by the sky model (W/m2)
+	std::vector<double> diffuseHorizontal;			///< Diffuse horizontal irradiance used by the sky model (W/m2)
+	std::vector<int> code;							///< Result code for each timestep, same as the return value of \link irrad::calc()
+};
+
 // allow for the poa decomp model to take all daily POA measurements into consideration
 struct poaDecompReq {
 	poaDecompReq() : i(0), dayStart(0), stepSize(1), stepScale('h'), doy(-1) {}
@@ -151,6 +151,7 @@ void mlmodel_module_t::initializeManual()
 				samples.addSample(IAM_c_cs_incAngle[i], IAM_c_cs_iamValue[i]);
 			}
 			m_bspline3 = BSpline::Builder(samples).degree(3).build();
+			m_spline3.compile(m_bspline3);
 
 			isInitialized = true;
 		}
@@ -185,13 +186,22 @@ bool mlmodel_module_t::operator() (pvinput_t &input, double T_C, double opvoltag
 //			f_IAM_beam = std::min(iamSpline(theta_beam), 1.0);
 //			f_IAM_diff = std::min(iamSpline(theta_diff), 1.0);
 //			f_IAM_gnd = std::min(iamSpline(theta_gnd), 1.0);
-			DenseVector x(1);
-			x(0) = theta_beam;
-			f_IAM_beam = std::min(m_bspline3.eval(x), 1.0);
-			x(0) = theta_diff;
-			f_IAM_diff = std::min(m_bspline3.eval(x), 1.0);
-			x(0) = theta_gnd;
-			f_IAM_gnd = std::min(m_bspline3.eval(x), 1.0);
+			if (m_spline3.is_compiled())
+			{
+				f_IAM_beam = std::min(m_spline3.eval(theta_beam), 1.0);
+				f_IAM_diff = std::min(m_spline3.eval(theta_diff), 1.0);
+				f_IAM_gnd = std::min(m_spline3.eval(theta_gnd), 1.0);
+			}
+			else
+			{
+				DenseVector x(1);
+				x(0) = theta_beam;
+				f_IAM_beam = std::min(m_bspline3.eval(x), 1.0);
+				x(0) = theta_diff;
+				f_IAM_diff = std::min(m_bspline3.eval(x), 1.0);
+				x(0) = theta_gnd;
+				f_IAM_gnd = std::min(m_bspline3.eval(x), 1.0);
+			}
 			break;
 	}
 
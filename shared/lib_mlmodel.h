@@ -55,6 +55,7 @@
 #include "lib_pvmodel.h"
 //#include "mlm_spline.h"
 #include "bspline.h"
+#include "lib_bspline.h"
 
 using namespace SPLINTER;
 
@@ -127,6 +128,7 @@ private:
 	double Vbi;
 //	tk::spline iamSpline;
 	BSpline m_bspline3;
+	bspline_evaluator m_spline3;	// compiled m_bspline3 used for the IAM
 
 };
 
@@ -295,6 +295,7 @@ void ond_inverter::initializeManual()
 				samples.addSample(xSamples, ondspl_Y[k]);
 			}
 			m_bspline3[j] = BSpline::Builder(samples).degree(3).build();
+			m_spline3[j].compile(m_bspline3[j]);
 
 		}
 		ondIsInitialized = true;
@@ -304,7 +305,6 @@ void ond_inverter::initializeManual()
 double ond_inverter::calcEfficiency(double Pdc, int index_eta) {
 	double eta;
 //	int splineIndex;
-	DenseVector x(1);
 //	if (Pdc > (Pdc_threshold * PNomDC_eff)) {
 //		splineIndex = 1;
 //	}
@@ -325,8 +325,16 @@ double ond_inverter::calcEfficiency(double Pdc, int index_eta) {
 	else if (Pdc >= x_lim[index_eta]) 
 	{
 //		eta = effSpline[splineIndex][index_eta](Pdc);
-		x(0) = Pdc;
-		eta = (m_bspline3[index_eta]).eval(x);
+		if (m_spline3[index_eta].is_compiled())
+		{
+			eta = m_spline3[index_eta].eval(Pdc);
+		}
+		else
+		{
+			DenseVector x(1);
+			x(0) = Pdc;
+			eta = (m_bspline3[index_eta]).eval(x);
+		}
 	}
 	else 
 	{
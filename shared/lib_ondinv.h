@@ -53,6 +53,7 @@
 #include <vector>
 //#include "mlm_spline.h" // spline interpolator for efficiency curves
 #include "bspline.h"
+#include "lib_bspline.h"
 using namespace std;
 using namespace SPLINTER;
 
@@ -135,6 +136,7 @@ private:
 //	tk::spline effSpline[2][3];
 //	BSpline m_bspline3[2][3];
 	BSpline m_bspline3[3];
+	bspline_evaluator m_spline3[3];	// compiled m_bspline3 used by calcEfficiency
 	double x_max[3];
 	double x_lim[3];
 	double Pdc_threshold;
@@ -0,0 +1,213 @@
+/*******************************************************************************************************
+*  Copyright 2017 Alliance for Sustainable Energy, LLC
+*
+*  NOTICE: This software was developed at least in part by Alliance for Sustainable Energy, LLC
+*  (Alliance) under Contract No. DE-AC36-08GO28308 with the U.S. Department of Energy and the U.S.
+*  The Government retains for itself and others acting on its behalf a nonexclusive, paid-up,
+*  irrevocable worldwide license in the software to reproduce, prepare derivative works, distribute
+*  copies to the public, perform publicly and display publicly, and to permit others to do so.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted
+*  provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, the above government
+*  rights notice, this list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice, the above government
+*  rights notice, this list of conditions and the following disclaimer in the documentation and/or
+*  other materials provided with the distribution.
+*
+*  3. The entire corresponding source code of any redistribution, with or without modification, by a
+*  research entity, including but not limited to any contracting manager/operator of a United States
+*  National Laboratory, any institution of higher learning, and any non-profit organization, must be
+*  made publicly available under this license for as long as the redistribution is made available by
+*  the research entity.
+*
+*  4. Redistribution of this software, without modification, must refer to the software by the same
+*  designation. Redistribution of a modified version of this software (i) may not refer to the modified
+*  version by the same designation, or by any confusingly similar designation, and (ii) must refer to
+*  the underlying software originally provided by Alliance as System Advisor Model or SAM. Except
+*  to comply with the foregoing, the terms System Advisor Model, SAM, or any confusingly similar
+*  designation may not be used to refer to any modified version of this software or any modified
+*  version of the underlying software originally provided by Alliance without the prior written consent
+*  of Alliance.
+*
+*  5. The name of the copyright holder, contributors, the United States Government, the United States
+*  Department of Energy, or any of their employees may not be used to endorse or promote products
+*  derived from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+*  IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+*  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER,
+*  CONTRIBUTORS, UNITED STATES GOVERNMENT OR UNITED STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR
+*  EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+*  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+*  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+*  THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************************************/
+
+#ifndef __lib_parallel_h
+#define __lib_parallel_h
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+Number of worker threads to use for a loop of 'n_items' items that are handed out in chunks
+of 'chunk' items. A requested count of 0 or less uses all available hardware threads. The
+result is never more than the number of chunks, so small loops run on the calling thread only.
+*/
+inline int sp_thread_count(int n_requested, int n_items, int chunk)
+{
+	int nt = n_requested;
+	if(nt < 1)
+		nt = (int)std::thread::hardware_concurrency();
+	if(nt < 1)
+		nt = 1;
+
+	chunk = std::max(chunk, 1);
+	int nchunk = (n_items + chunk - 1) / chunk;
+
+	return std::max(1, std::min(nt, nchunk));
+}
+
+/*
+Worker threads that are kept between loops, for code that runs many short loops such as one
+per time step. A pool runs one loop at a time, so it must only be used by one calling thread
+at a time.
+*/
+class sp_thread_pool
+{
+	std::vector<std::thread> m_workers;
+	std::mutex m_lock;
+	std::condition_variable m_start, m_finish;
+	std::function<void(int)> m_job;
+	size_t m_generation;
+	int m_running;
+	bool m_stop;
+
+	void work(int worker_id)
+	{
+		size_t generation = 0;
+		std::unique_lock<std::mutex> lock(m_lock);
+		while(true){
+			m_start.wait(lock, [&]{ return m_stop || m_generation != generation; });
+			if(m_stop) return;
+			generation = m_generation;
+
+			lock.unlock();
+			m_job(worker_id);
+			lock.lock();
+
+			if(--m_running == 0)
+				m_finish.notify_all();
+		}
+	}
+
+public:
+	explicit sp_thread_pool(int n_threads) : m_generation(0), m_running(0), m_stop(false)
+	{
+		for(int t=1; t<n_threads; t++)
+			m_workers.push_back( std::thread(&sp_thread_pool::work, this, t) );
+	}
+
+	~sp_thread_pool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_lock);
+			m_stop = true;
+		}
+		m_start.notify_all();
+		for(size_t t=0; t<m_workers.size(); t++)
+			m_workers[t].join();
+	}
+
+	int threads() const { return (int)m_workers.size() + 1; }
+
+	/*
+	Call body(i, worker) for each i in [0, n_items) on the threads of the pool. Items are claimed
+	in contiguous chunks of 'chunk' from a shared counter, so threads that finish early keep taking
+	work from the remainder of the range. The calling thread participates as worker 0 and is the
+	only thread that should report progress.
+
+	Each item must only write to data owned by that item. Under that condition, the results do not
+	depend on the number of threads or on the order in which the chunks are processed. The first
+	exception thrown by any worker stops the remaining work and is rethrown on the calling thread.
+	*/
+	template <typename F>
+	void parallel_for(int n_items, int chunk, F body)
+	{
+		if(n_items <= 0) return;
+
+		chunk = std::max(chunk, 1);
+		if(m_workers.empty() || n_items <= chunk){
+			for(int i=0; i<n_items; i++)
+				body(i, 0);
+			return;
+		}
+
+		std::atomic<int> next(0);
+		std::atomic<bool> failed(false);
+		std::exception_ptr error;
+		std::mutex error_lock;
+
+		auto worker = [&](int worker_id)
+		{
+			try{
+				while(! failed.load()){
+					int first = next.fetch_add(chunk);
+					if(first >= n_items) break;
+					int last = std::min(first + chunk, n_items);
+					for(int i=first; i<last; i++)
+						body(i, worker_id);
+				}
+			}
+			catch(...){
+				std::lock_guard<std::mutex> lock(error_lock);
+				if(! error) error = std::current_exception();
+				failed.store(true);
+			}
+		};
+
+		{
+			std::lock_guard<std::mutex> lock(m_lock);
+			m_job = worker;
+			m_running = (int)m_workers.size();
+			m_generation++;
+		}
+		m_start.notify_all();
+
+		worker(0);
+
+		{
+			std::unique_lock<std::mutex> lock(m_lock);
+			m_finish.wait(lock, [&]{ return m_running == 0; });
+			m_job = nullptr;
+		}
+
+		if(error)
+			std::rethrow_exception(error);
+	}
+};
+
+/*
+Run one loop like sp_thread_pool::parallel_for on up to 'n_threads' threads (see sp_thread_count)
+that are started for this loop only.
+*/
+template <typename F>
+void sp_parallel_for(int n_items, int n_threads, int chunk, F body)
+{
+	if(n_items <= 0) return;
+
+	sp_thread_pool pool( sp_thread_count(n_threads, n_items, chunk) );
+	pool.parallel_for(n_items, chunk, body);
+}
+
+#endif
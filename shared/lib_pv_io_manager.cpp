@@ -78,10 +78,17 @@ Simulation_IO::Simulation_IO(compute_module* cm, Irradiance_IO & IrradianceIO)
 	useLifetimeOutput = false;
 	if (cm->is_assigned("system_use_lifetime_output")) useLifetimeOutput = cm->as_integer("system_use_lifetime_output");
 	numberOfYears = 1;
+	reuseYearOneDC = false;
 	if (useLifetimeOutput) {
 		numberOfYears = cm->as_integer("analysis_period");
+		if (cm->is_assigned("en_lifetime_year1_reuse")) reuseYearOneDC = cm->as_boolean("en_lifetime_year1_reuse");
 	}
 	numberOfSteps = numberOfYears * numberOfWeatherFileRecords;
+
+	nThreads = 0;
+	if (cm->is_assigned("n_threads")) nThreads = cm->as_integer("n_threads");
+	useDCCache = false;
+	if (cm->is_assigned("en_dc_cache")) useDCCache = cm->as_boolean("en_dc_cache");
 }
 
 Irradiance_IO::Irradiance_IO(compute_module* cm, std::string cmName)
@@ -251,6 +258,7 @@ void Irradiance_IO::AllocateOutputs(compute_module* cm)
 
 	//set up the calculated components of irradiance such that they aren't reported if they aren't assigned
 	//three possible calculated irradiance: gh, df, dn
+	p_IrradianceCalculated[0] = p_IrradianceCalculated[1] = p_IrradianceCalculated[2] = 0;
 	if (radiationMode == irrad::DN_DF) p_IrradianceCalculated[0] = cm->allocate("gh_calc", numberOfWeatherFileRecords); //don't calculate global for POA models
 	if (radiationMode == irrad::DN_GH || radiationMode == irrad::POA_R || radiationMode == irrad::POA_P) p_IrradianceCalculated[1] = cm->allocate("df_calc", numberOfWeatherFileRecords);
 	if (radiationMode == irrad::GH_DF || radiationMode == irrad::POA_R || radiationMode == irrad::POA_P) p_IrradianceCalculated[2] = cm->allocate("dn_calc", numberOfWeatherFileRecords);
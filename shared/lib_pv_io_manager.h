@@ -227,6 +227,9 @@ struct Simulation_IO
 	size_t stepsPerHour;
 	double dtHour;
 	flag useLifetimeOutput;
+	flag reuseYearOneDC;		/// Replay year 1 subarray DC power in later years of a lifetime simulation
+	int nThreads;				/// Number of threads for the subarray DC calculations, 0 = all hardware threads
+	flag useDCCache;			/// Reuse the subarray DC power of a previous run with the same weather, subarray, module and inverter voltage inputs
 };
 
 /***
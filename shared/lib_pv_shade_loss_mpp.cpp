@@ -52,7 +52,17 @@
 #include <algorithm>    // std::sort
 #include <math.h> // logarithm function
 #include <cstring> // memcpy
+#include <cstdio>
+#include <mutex>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
+#include "lib_util.h"
 #include "lib_miniz.h" // decompression
 #include "DB8_vmpp_impp_uint8_bin.h" // char* of binary compressed file
 
@@ -67,7 +77,7 @@ typedef unsigned int uint;
 
 short ShadeDB8_mpp::get_vmpp(size_t i)
 {
-	if (i < 6045840) // uint16 check
+	if (p_vmpp && i < 6045840) // uint16 check
 		return (short)((p_vmpp[2 * i + 1] << 8) | p_vmpp[2 * i]); 
 	else 
 		return -1;
@@ -75,7 +85,7 @@ short ShadeDB8_mpp::get_vmpp(size_t i)
 
 short ShadeDB8_mpp::get_impp(size_t i)
 { 
-	if (i < 6045840) // uint16 check
+	if (p_impp && i < 6045840) // uint16 check
 		return (short)((p_impp[2 * i + 1] << 8) | p_impp[2 * i]); 
 	else 
 		return -1; 
@@ -184,54 +194,148 @@ std::vector<double> ShadeDB8_mpp::get_vector(const size_t &N, const size_t &d, c
 	return ret_vec;
 }
 
-void ShadeDB8_mpp::init()
+// sizes of the VMPP and IMPP uint8 tables (from matlab) and of the compressed database (from modified example5.c in miniz project)
+#define SHADE_DB8_VMPP_UINT8_SIZE 12091680
+#define SHADE_DB8_IMPP_UINT8_SIZE 12091680
+#define SHADE_DB8_COMPRESSED_SIZE 3133517
+
+// the cache file starts with a magic string and the size of the tables that follow
+#define SHADE_DB8_CACHE_MAGIC "SSCSDB1"
+#define SHADE_DB8_CACHE_HEADER_SIZE 16
+
+struct ShadeDB8_tables
 {
-	p_error_msg = "";
-	p_warning_msg = "";
-	p_vmpp_uint8_size = 12091680; // uint8 size from matlab
-	p_impp_uint8_size = 12091680; // uint8 size from matlab
-	p_vmpp = (unsigned char *)malloc(p_vmpp_uint8_size);//malloc(12091680); uint8 size
-	p_impp = (unsigned char *)malloc(p_impp_uint8_size);//malloc(12091680); uint8 size
-	p_compressed_size = 3133517; // from modified example5.c in miniz project
-	decompress_file_to_uint8();
-}
+	ShadeDB8_tables() : data(NULL), size(0), mapped(false) { }
+	~ShadeDB8_tables()
+	{
+#ifndef _WIN32
+		if (mapped)
+		{
+			munmap(data - SHADE_DB8_CACHE_HEADER_SIZE, size + SHADE_DB8_CACHE_HEADER_SIZE);
+			return;
+		}
+#endif
+		if (data)
+			free(data);
+	}
 
-ShadeDB8_mpp::~ShadeDB8_mpp()
+	unsigned char *data; // VMPP table followed by IMPP table
+	size_t size;
+	bool mapped;
+};
+
+#ifndef _WIN32
+static bool map_cache_file(const char *path, ShadeDB8_tables &tables)
 {
-	if (p_vmpp)
-		free(p_vmpp);
-	if (p_impp)
-		free(p_impp);
-}
+	int fd = open(path, O_RDONLY);
+	if (fd < 0) return false;
 
+	size_t file_size = tables.size + SHADE_DB8_CACHE_HEADER_SIZE;
+	struct stat st;
+	if (fstat(fd, &st) != 0 || (size_t)st.st_size != file_size)
+	{
+		close(fd);
+		return false;
+	}
 
+	void *p = mmap(NULL, file_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (p == MAP_FAILED) return false;
 
-bool ShadeDB8_mpp::decompress_file_to_uint8()
+	unsigned char *header = (unsigned char *)p;
+	unsigned long long tables_size;
+	memcpy(&tables_size, header + 8, sizeof(tables_size));
+	if (memcmp(header, SHADE_DB8_CACHE_MAGIC, 8) != 0 || tables_size != tables.size)
+	{
+		munmap(p, file_size);
+		return false;
+	}
+
+	tables.data = header + SHADE_DB8_CACHE_HEADER_SIZE;
+	tables.mapped = true;
+	return true;
+}
+#endif
+
+static void write_cache_file(const char *path, const ShadeDB8_tables &tables)
 {
-	size_t status;
-	uint8 *pTmp_data;
+	util::write_file_atomic(path, [&tables](FILE *fp) {
+		char magic[8] = SHADE_DB8_CACHE_MAGIC;
+		unsigned long long tables_size = tables.size;
+		return fwrite(magic, 1, 8, fp) == 8
+			&& util::write_value(fp, tables_size)
+			&& fwrite(tables.data, 1, tables.size, fp) == tables.size;
+	});
+}
 
-	size_t mem_size = p_vmpp_uint8_size + p_impp_uint8_size;
+static std::mutex sg_shadeDB8Mutex;
+static std::shared_ptr<ShadeDB8_tables> sg_shadeDB8Tables;
 
-	pTmp_data = (uint8 *)malloc(mem_size);
+static std::shared_ptr<ShadeDB8_tables> shade_db8_shared_tables(std::string &error)
+{
+	std::lock_guard<std::mutex> lock(sg_shadeDB8Mutex);
+	if (sg_shadeDB8Tables)
+		return sg_shadeDB8Tables;
 
-	status = tinfl_decompress_mem_to_mem((void *)pTmp_data, mem_size, pCmp_data, p_compressed_size, TINFL_FLAG_PARSE_ZLIB_HEADER);
+	std::shared_ptr<ShadeDB8_tables> tables(new ShadeDB8_tables());
+	tables->size = SHADE_DB8_VMPP_UINT8_SIZE + SHADE_DB8_IMPP_UINT8_SIZE;
 
-	memcpy(p_vmpp, pTmp_data, p_vmpp_uint8_size);
-	memcpy(p_impp, pTmp_data + p_vmpp_uint8_size, p_impp_uint8_size);
+	const char *cache_file = getenv("SSC_SHADE_DB_CACHE");
+	if (cache_file && !*cache_file)
+		cache_file = NULL;
 
-	free(pTmp_data);
+#ifndef _WIN32
+	if (cache_file && map_cache_file(cache_file, *tables))
+	{
+		sg_shadeDB8Tables = tables;
+		return tables;
+	}
+#endif
+
+	tables->data = (unsigned char *)malloc(tables->size);
+	if (!tables->data)
+	{
+		error = "not enough memory to decompress the shading database";
+		return std::shared_ptr<ShadeDB8_tables>();
+	}
 
+	size_t status = tinfl_decompress_mem_to_mem((void *)tables->data, tables->size, pCmp_data, SHADE_DB8_COMPRESSED_SIZE, TINFL_FLAG_PARSE_ZLIB_HEADER);
 	if (status == TINFL_DECOMPRESS_MEM_TO_MEM_FAILED)
 	{
 		std::stringstream outm;
 		outm << "tinfl_decompress_mem_to_mem() failed with status " << (int)status;
-		p_error_msg = outm.str();
-		return EXIT_FAILURE;
+		error = outm.str();
+		return std::shared_ptr<ShadeDB8_tables>();
 	}
 
-	return true;
-};
+	if (cache_file)
+		write_cache_file(cache_file, *tables);
+
+	sg_shadeDB8Tables = tables;
+	return tables;
+}
+
+void ShadeDB8_mpp::init()
+{
+	p_error_msg = "";
+	p_warning_msg = "";
+	p_tables = shade_db8_shared_tables(p_error_msg);
+	if (p_tables)
+	{
+		p_vmpp = p_tables->data;
+		p_impp = p_tables->data + SHADE_DB8_VMPP_UINT8_SIZE;
+	}
+	else
+	{
+		p_vmpp = NULL;
+		p_impp = NULL;
+	}
+}
+
+ShadeDB8_mpp::~ShadeDB8_mpp()
+{
+	// the tables are released with the last reference to them
+}
 
 double ShadeDB8_mpp::get_shade_loss(double &gpoa, double &dpoa, std::vector<double> &shade_frac, bool use_pv_cell_temp, double pv_cell_temp, int mods_per_str, double str_vmp_stc, double mppt_lo, double mppt_hi)
 {
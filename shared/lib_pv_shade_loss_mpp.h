@@ -56,8 +56,13 @@
 #include <vector>
 #include <stdlib.h>
 #include <string>
+#include <memory>
 
 extern const unsigned char pCmp_data[3133517];
+
+// decompressed VMPP/IMPP tables, shared read-only by every ShadeDB8_mpp in the process
+struct ShadeDB8_tables;
+
 // shading database with up to 8 strings
 class ShadeDB8_mpp
 {
@@ -68,6 +73,10 @@ public:
 		p_impp=NULL ;
 	};
 	~ShadeDB8_mpp();
+
+	/* attaches to the process-wide tables, decompressing them on first use only.
+	   If the environment variable SSC_SHADE_DB_CACHE names a file, the uncompressed
+	   tables are memory-mapped from it when it holds a valid cache, and written to it otherwise. */
 	void init();
 	short vmpp(size_t ndx){
 		return get_vmpp(ndx);
@@ -85,14 +94,11 @@ public:
 
 
 private:
-	unsigned char *p_vmpp;
-	unsigned char *p_impp;
+	const unsigned char *p_vmpp;
+	const unsigned char *p_impp;
 	short get_vmpp(size_t i);
 	short get_impp(size_t i);
-	bool decompress_file_to_uint8();
-	size_t p_vmpp_uint8_size;
-	size_t p_impp_uint8_size;
-	size_t p_compressed_size;
+	std::shared_ptr<ShadeDB8_tables> p_tables;
 	std::string p_warning_msg;
 	std::string p_error_msg;
 };
@@ -53,10 +53,13 @@
 #include <cstdlib>
 #include <limits>
 #include <numeric>
+#include <atomic>
 
 #ifdef _WIN32
 #include <direct.h>
+#include <process.h>
 #include <Windows.h>
+#define getpid _getpid
 #else
 #include <unistd.h>
 #include <sys/types.h>
@@ -344,6 +347,61 @@ bool util::set_cwd( const std::string &path )
 #endif
 }
 
+void util::fnv1a_hash( unsigned long long &hash, const void *data, size_t len )
+{
+	const unsigned char *p = static_cast<const unsigned char*>(data);
+	for (size_t i = 0; i < len; i++)
+	{
+		hash ^= p[i];
+		hash *= 1099511628211ULL;
+	}
+}
+
+bool util::fnv1a_hash_file( const std::string &file, unsigned long long &hash )
+{
+	FILE *fp = fopen(file.c_str(), "rb");
+	if (!fp) return false;
+
+	unsigned long long h = fnv1a_init;
+	unsigned char buf[65536];
+	size_t n;
+	while ((n = fread(buf, 1, sizeof(buf), fp)) > 0)
+		fnv1a_hash(h, buf, n);
+	fclose(fp);
+
+	hash = h;
+	return true;
+}
+
+std::string util::cache_dir_setting::get() const
+{
+	if (m_set)
+		return m_dir;
+
+	const char *dir = getenv(m_envVar);
+	return dir ? std::string(dir) : std::string();
+}
+
+bool util::write_file_atomic( const std::string &file, const std::function<bool(FILE*)> &write )
+{
+	// the temporary name is unique across processes and across threads of this one
+	static std::atomic<unsigned int> counter(0);
+	char suffix[64];
+	sprintf(suffix, ".%d.%u.tmp", (int)getpid(), counter++);
+	std::string tmp = file + suffix;
+	FILE *fp = fopen(tmp.c_str(), "wb");
+	if (!fp) return false;
+
+	bool ok = write(fp);
+	ok = (fclose(fp) == 0) && ok;
+	if (!ok || rename(tmp.c_str(), file.c_str()) != 0)
+	{
+		remove(tmp.c_str());
+		return false;
+	}
+	return true;
+}
+
 std::string util::read_file( const std::string &file )
 {
 	std::string buf;
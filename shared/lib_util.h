@@ -53,7 +53,9 @@
 #include <cstdio>
 #include <string>
 #include <vector>
+#include <utility>
 #include <cassert>
+#include <functional>
 
 #include <unordered_map>
 using std::unordered_map;
@@ -162,6 +164,30 @@ namespace util
 	char path_separator();
 	std::string get_cwd();
 	bool set_cwd( const std::string &path );
+
+	/* 64-bit FNV-1a hash: start from fnv1a_init and add data in as many calls as needed */
+	const unsigned long long fnv1a_init = 14695981039346656037ULL;
+	void fnv1a_hash( unsigned long long &hash, const void *data, size_t len );
+	bool fnv1a_hash_file( const std::string &file, unsigned long long &hash ); /* returns false if the file can't be read */
+
+	/* directory for cache files: the one set by the caller, otherwise the value of an environment variable */
+	class cache_dir_setting
+	{
+	public:
+		explicit cache_dir_setting( const char *env_var ) : m_envVar(env_var), m_set(false) { }
+		void set( const std::string &dir ) { m_dir = dir; m_set = true; }
+		std::string get() const;
+	private:
+		const char *m_envVar;
+		std::string m_dir;
+		bool m_set;
+	};
+
+	/* writes the file under a temporary name and renames it when complete, so that concurrent readers never see a partial file */
+	bool write_file_atomic( const std::string &file, const std::function<bool(FILE*)> &write );
+
+	template<typename T> bool write_value( FILE *fp, const T &v ) { return fwrite(&v, sizeof(T), 1, fp) == 1; }
+	template<typename T> bool read_value( FILE *fp, T &v ) { return fread(&v, sizeof(T), 1, fp) == 1; }
 	
 	template <class T>
 	std::vector<T> array_to_vector(T * array_in, size_t n)
@@ -301,6 +327,15 @@ namespace util
 			t_array = NULL;
 			copy( cc );
 		}
+
+		matrix_t( matrix_t &&mv )
+		{
+			t_array = mv.t_array;
+			n_rows = mv.n_rows;
+			n_cols = mv.n_cols;
+			mv.t_array = new T[1];
+			mv.n_rows = mv.n_cols = 1;
+		}
 		
 		matrix_t(size_t len)
 		{
@@ -390,6 +425,14 @@ namespace util
 
 			return *this;
 		}
+
+		matrix_t &operator=(matrix_t &&rhs)
+		{
+			std::swap( t_array, rhs.t_array );
+			std::swap( n_rows, rhs.n_rows );
+			std::swap( n_cols, rhs.n_cols );
+			return *this;
+		}
 		
 		matrix_t &operator=(const T &val)
 		{
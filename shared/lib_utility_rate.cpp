@@ -1,6 +1,267 @@
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include "lib_utility_rate.h"
 
+CompiledUtilityRate::CompiledUtilityRate(size_t stepsPerHour)
+{
+	m_stepsPerHour = stepsPerHour;
+	m_hasEnergyCharges = false;
+	m_hasDemandCharges = false;
+	m_dcFlatTiers.resize(12);
+
+	m_monthFirstStep.push_back(0);
+	for (size_t m = 0; m < 12; m++)
+		m_monthFirstStep.push_back(m_monthFirstStep[m] + util::nday[m] * 24 * m_stepsPerHour);
+}
+
+bool CompiledUtilityRate::compileSchedule(const util::matrix_t<size_t> & weekday, const util::matrix_t<size_t> & weekend,
+	std::vector<int> & periodOfStep, std::vector<int> & rowOfStep, std::vector<std::vector<int> > & monthPeriods)
+{
+	// single period schedules apply to every hour
+	util::matrix_t<float> schedules[2];
+	const util::matrix_t<size_t> * input[2] = { &weekday, &weekend };
+	for (size_t k = 0; k < 2; k++)
+	{
+		if (input[k]->nrows() == 1 && input[k]->ncols() == 1)
+			schedules[k].resize_fill(12, 24, (float)input[k]->at(0, 0));
+		else
+		{
+			schedules[k].resize(input[k]->nrows(), input[k]->ncols());
+			for (size_t r = 0; r < input[k]->nrows(); r++)
+				for (size_t c = 0; c < input[k]->ncols(); c++)
+					schedules[k].at(r, c) = (float)input[k]->at(r, c);
+		}
+	}
+
+	int tod[8760];
+	if (!util::translate_schedule(tod, schedules[0], schedules[1], 1, 12))
+		return false;
+
+	monthPeriods.assign(12, std::vector<int>());
+	for (size_t m = 0; m < 12; m++)
+	{
+		for (size_t k = 0; k < 2; k++)
+			for (size_t h = 0; h < 24; h++)
+				monthPeriods[m].push_back((int)schedules[k].at(m, h));
+		std::sort(monthPeriods[m].begin(), monthPeriods[m].end());
+		monthPeriods[m].erase(std::unique(monthPeriods[m].begin(), monthPeriods[m].end()), monthPeriods[m].end());
+	}
+
+	periodOfStep.resize(numberOfSteps());
+	rowOfStep.resize(numberOfSteps());
+	for (size_t m = 0; m < 12; m++)
+	{
+		for (size_t step = m_monthFirstStep[m]; step < m_monthFirstStep[m + 1]; step++)
+		{
+			int period = tod[step / m_stepsPerHour];
+			std::vector<int>::const_iterator row = std::lower_bound(monthPeriods[m].begin(), monthPeriods[m].end(), period);
+			periodOfStep[step] = period;
+			rowOfStep[step] = (row != monthPeriods[m].end() && *row == period) ? (int)(row - monthPeriods[m].begin()) : -1;
+		}
+	}
+	return true;
+}
+
+void CompiledUtilityRate::compileTiers(const util::matrix_t<double> & ratesMatrix, int unitsColumn, int rateColumn, int sellColumn,
+	std::vector<int> & periods, std::vector<RateTiers> & tiers)
+{
+	periods.clear();
+	for (size_t r = 0; r < ratesMatrix.nrows(); r++)
+		periods.push_back((int)ratesMatrix.at(r, 0));
+	std::sort(periods.begin(), periods.end());
+	periods.erase(std::unique(periods.begin(), periods.end()), periods.end());
+
+	// rows sorted by period then tier, in table order for a repeated tier
+	std::vector<size_t> rows;
+	for (size_t r = 0; r < ratesMatrix.nrows(); r++)
+		rows.push_back(r);
+	std::stable_sort(rows.begin(), rows.end(), [&ratesMatrix](size_t a, size_t b) {
+		if ((int)ratesMatrix.at(a, 0) != (int)ratesMatrix.at(b, 0))
+			return (int)ratesMatrix.at(a, 0) < (int)ratesMatrix.at(b, 0);
+		return (int)ratesMatrix.at(a, 1) < (int)ratesMatrix.at(b, 1);
+	});
+
+	tiers.assign(periods.size(), RateTiers());
+	for (size_t i = 0; i < rows.size(); i++)
+	{
+		size_t r = rows[i];
+		size_t index = std::lower_bound(periods.begin(), periods.end(), (int)ratesMatrix.at(r, 0)) - periods.begin();
+		RateTiers & t = tiers[index];
+		size_t tier = (size_t)ratesMatrix.at(r, 1);
+		if (!t.tier.empty() && t.tier.back() == tier)
+			continue;
+
+		t.tier.push_back(tier);
+		t.max.push_back(ratesMatrix.at(r, 2));
+		t.units.push_back(unitsColumn >= 0 ? (size_t)ratesMatrix.at(r, unitsColumn) : 0);
+		t.rate.push_back(ratesMatrix.at(r, rateColumn));
+		t.sellRate.push_back(sellColumn >= 0 && sellColumn < (int)ratesMatrix.ncols() ? ratesMatrix.at(r, sellColumn) : 0);
+	}
+}
+
+bool CompiledUtilityRate::compileEnergyCharges(const util::matrix_t<size_t> & ecWeekday, const util::matrix_t<size_t> & ecWeekend, const util::matrix_t<double> & ecRatesMatrix)
+{
+	m_hasEnergyCharges = false;
+	if (ecRatesMatrix.ncols() < 5 || !compileSchedule(ecWeekday, ecWeekend, m_ecPeriodOfStep, m_ecRowOfStep, m_ecMonthPeriods))
+		return false;
+
+	compileTiers(ecRatesMatrix, 3, 4, 5, m_ecPeriods, m_ecTiers);
+	m_hasEnergyCharges = true;
+	return true;
+}
+
+bool CompiledUtilityRate::compileDemandCharges(const util::matrix_t<size_t> & dcWeekday, const util::matrix_t<size_t> & dcWeekend, const util::matrix_t<double> & dcTouMatrix, const util::matrix_t<double> & dcFlatMatrix)
+{
+	m_hasDemandCharges = false;
+	if (dcTouMatrix.ncols() < 4 || dcFlatMatrix.ncols() < 4 || !compileSchedule(dcWeekday, dcWeekend, m_dcPeriodOfStep, m_dcRowOfStep, m_dcMonthPeriods))
+		return false;
+
+	compileTiers(dcTouMatrix, -1, 3, -1, m_dcPeriods, m_dcTiers);
+
+	std::vector<int> months;
+	std::vector<RateTiers> flatTiers;
+	compileTiers(dcFlatMatrix, -1, 3, -1, months, flatTiers);
+	m_dcFlatTiers.assign(12, RateTiers());
+	for (size_t i = 0; i < months.size(); i++)
+	{
+		if (months[i] >= 0 && months[i] < 12)
+			m_dcFlatTiers[months[i]] = flatTiers[i];
+	}
+	m_hasDemandCharges = true;
+	return true;
+}
+
+const CompiledUtilityRate::RateTiers & CompiledUtilityRate::energyTiers(int period) const
+{
+	static const RateTiers noTiers;
+	std::vector<int>::const_iterator it = std::lower_bound(m_ecPeriods.begin(), m_ecPeriods.end(), period);
+	if (it == m_ecPeriods.end() || *it != period)
+		return noTiers;
+	return m_ecTiers[it - m_ecPeriods.begin()];
+}
+
+const CompiledUtilityRate::RateTiers & CompiledUtilityRate::demandTiers(int period) const
+{
+	static const RateTiers noTiers;
+	std::vector<int>::const_iterator it = std::lower_bound(m_dcPeriods.begin(), m_dcPeriods.end(), period);
+	if (it == m_dcPeriods.end() || *it != period)
+		return noTiers;
+	return m_dcTiers[it - m_dcPeriods.begin()];
+}
+
+double CompiledUtilityRate::energyTierCharge(size_t month, const std::vector<double> & energyPerRow, double peakDemand, bool isSell) const
+{
+	double total = 0;
+	for (size_t row = 0; row < energyPerRow.size(); row++)
+		total += energyPerRow[row];
+	if (total <= 0)
+		return 0;
+
+	double charge = 0;
+	for (size_t row = 0; row < energyPerRow.size(); row++)
+	{
+		if (energyPerRow[row] <= 0)
+			continue;
+
+		const RateTiers & tiers = energyTiers(m_ecMonthPeriods[month][row]);
+		double share = energyPerRow[row] / total;
+		double lower = 0;
+		for (size_t t = 0; t < tiers.tier.size(); t++)
+		{
+			// daily maximums are per day of the month, kWh/kW maximums per kW of monthly peak
+			double upper = tiers.max[t];
+			if (tiers.units[t] == 2 || tiers.units[t] == 3)
+				upper *= util::nday[month];
+			if (tiers.units[t] == 1 || tiers.units[t] == 3)
+				upper *= peakDemand;
+
+			double rate = isSell ? tiers.sellRate[t] : tiers.rate[t];
+			charge += share * (std::min(total, upper) - lower) * rate;
+			if (total <= upper)
+				break;
+			lower = upper;
+		}
+	}
+	return charge;
+}
+
+double CompiledUtilityRate::demandTierCharge(const RateTiers & tiers, double demand) const
+{
+	double charge = 0;
+	double lower = 0;
+	for (size_t t = 0; t < tiers.tier.size(); t++)
+	{
+		if (demand < tiers.max[t])
+		{
+			charge += (demand - lower) * tiers.rate[t];
+			break;
+		}
+		charge += (tiers.max[t] - lower) * tiers.rate[t];
+		lower = tiers.max[t];
+	}
+	return charge;
+}
+
+double CompiledUtilityRate::calculateBill(const double * gridPower) const
+{
+	double dtHour = 1.0 / m_stepsPerHour;
+	double bill = 0;
+	std::vector<double> energyUse, energySurplus, touPeak;
+	for (size_t m = 0; m < 12; m++)
+	{
+		energyUse.assign(m_hasEnergyCharges ? m_ecMonthPeriods[m].size() : 0, 0);
+		energySurplus.assign(energyUse.size(), 0);
+		touPeak.assign(m_hasDemandCharges ? m_dcMonthPeriods[m].size() : 0, 0);
+		double peak = 0;
+
+		for (size_t step = firstStepOfMonth(m); step <= lastStepOfMonth(m); step++)
+		{
+			double power = gridPower[step];
+			if (power > peak)
+				peak = power;
+
+			int row = m_hasEnergyCharges ? m_ecRowOfStep[step] : -1;
+			if (row >= 0)
+			{
+				if (power > 0)
+					energyUse[row] += power * dtHour;
+				else
+					energySurplus[row] -= power * dtHour;
+			}
+
+			row = m_hasDemandCharges ? m_dcRowOfStep[step] : -1;
+			if (row >= 0 && power > touPeak[row])
+				touPeak[row] = power;
+		}
+
+		if (m_hasEnergyCharges)
+			bill += energyTierCharge(m, energyUse, peak, false) - energyTierCharge(m, energySurplus, peak, true);
+
+		if (m_hasDemandCharges)
+		{
+			bill += demandTierCharge(m_dcFlatTiers[m], peak);
+			for (size_t row = 0; row < touPeak.size(); row++)
+				bill += demandTierCharge(demandTiers(m_dcMonthPeriods[m][row]), touPeak[row]);
+		}
+	}
+	return bill;
+}
+
+bool CompiledUtilityRate::calculateBills(const std::vector<std::vector<double> > & gridPowerProfiles, std::vector<double> & bills) const
+{
+	bool complete = true;
+	bills.assign(gridPowerProfiles.size(), std::numeric_limits<double>::quiet_NaN());
+	for (size_t i = 0; i < gridPowerProfiles.size(); i++)
+	{
+		if (gridPowerProfiles[i].size() >= numberOfSteps())
+			bills[i] = calculateBill(&gridPowerProfiles[i][0]);
+		else
+			complete = false;
+	}
+	return complete;
+}
+
 
 UtilityRate::UtilityRate(util::matrix_t<size_t> ecWeekday, util::matrix_t<size_t> ecWeekend, util::matrix_t<double> ecRatesMatrix)
 {
@@ -26,7 +287,8 @@ UtilityRateCalculator::UtilityRateCalculator(UtilityRate * rate, size_t stepsPer
 
 void UtilityRateCalculator::initializeRate()
 {
-	
+	m_compiledRate.compileEnergyCharges(m_ecWeekday, m_ecWeekend, m_ecRatesMatrix);
+
 	for (size_t r = 0; r != m_ecRatesMatrix.nrows(); r++)
 	{
 		size_t period = static_cast<size_t>(m_ecRatesMatrix(r, 0));
@@ -68,6 +330,9 @@ double UtilityRateCalculator::getEnergyRate(size_t hourOfYear)
 }
 size_t UtilityRateCalculator::getEnergyPeriod(size_t hourOfYear)
 {
+	if (m_compiledRate.hasEnergyCharges() && hourOfYear < m_compiledRate.numberOfSteps())
+		return static_cast<size_t>(m_compiledRate.energyPeriod(hourOfYear));
+
 	size_t period, month, hour;
 	util::month_hour(hourOfYear, month, hour);
 
@@ -3,6 +3,121 @@
 
 #include "lib_util.h"
 #include <map>
+#include <vector>
+
+/**
+* \class CompiledUtilityRate
+*
+* \brief
+*
+*  A tariff compiled once from its weekday and weekend schedules and rate tables into flat lookups: the
+*  period for each time step of the year and its row in the month's sorted period list, the first and last
+*  time step of each month (the demand windows), and tier maximums and rates sorted by tier for each period.
+*  Bills for many load profiles can then be evaluated without re-deriving the tariff structure.
+*
+*  A bill has no net metering: each step's grid power is either an import, charged at buy rates, or an export,
+*  credited at sell rates. Imports and exports are summed separately per period over the month and split over
+*  the tier maximums in proportion to each period's share, as utilityrate5 does for monthly reconciliation, and
+*  demand charges apply to the month's import peaks. Fixed and minimum charges, rollover credits and time step
+*  sell rates are not included. The bill matches utilityrate5 with net billing (ur_metering_option 2) for
+*  tariffs without energy tiers, and utilityrate5 with any metering option for profiles without exports.
+*/
+class CompiledUtilityRate
+{
+public:
+	/// Tier maximums and rates for one period, sorted by tier number
+	struct RateTiers
+	{
+		std::vector<size_t> tier;
+		std::vector<double> max;
+		std::vector<size_t> units;
+		std::vector<double> rate;
+		std::vector<double> sellRate;
+	};
+
+	/// Construct an empty tariff for a year of records at stepsPerHour
+	CompiledUtilityRate(size_t stepsPerHour = 1);
+
+	/// Compile the energy charge schedules (12 x 24, or 1 x 1 for a single period) and table of period, tier, max usage, units, buy rate, (sell rate optional)
+	bool compileEnergyCharges(const util::matrix_t<size_t> & ecWeekday, const util::matrix_t<size_t> & ecWeekend, const util::matrix_t<double> & ecRatesMatrix);
+
+	/// Compile the demand charge schedules (12 x 24), TOU table of period, tier, max demand, charge and monthly table of month, tier, max demand, charge
+	bool compileDemandCharges(const util::matrix_t<size_t> & dcWeekday, const util::matrix_t<size_t> & dcWeekend, const util::matrix_t<double> & dcTouMatrix, const util::matrix_t<double> & dcFlatMatrix);
+
+	/// Whether the energy and demand charges compiled
+	bool hasEnergyCharges() const { return m_hasEnergyCharges; }
+	bool hasDemandCharges() const { return m_hasDemandCharges; }
+
+	/// Number of time steps per hour and per year
+	size_t stepsPerHour() const { return m_stepsPerHour; }
+	size_t numberOfSteps() const { return m_stepsPerHour * 8760; }
+
+	/// First and last time step of a month (0-11)
+	size_t firstStepOfMonth(size_t month) const { return m_monthFirstStep[month]; }
+	size_t lastStepOfMonth(size_t month) const { return m_monthFirstStep[month + 1] - 1; }
+
+	/// Energy charge period (1-based) at a time step and its row in energyPeriodsInMonth, -1 if not in the month
+	int energyPeriod(size_t step) const { return m_ecPeriodOfStep[step]; }
+	int energyPeriodRow(size_t step) const { return m_ecRowOfStep[step]; }
+
+	/// Sorted energy charge periods in the month's weekday and weekend schedules
+	const std::vector<int> & energyPeriodsInMonth(size_t month) const { return m_ecMonthPeriods[month]; }
+
+	/// Energy charge tiers for a period, empty if the period is not in the rate table
+	const RateTiers & energyTiers(int period) const;
+
+	/// Demand charge period (1-based) at a time step and its row in demandPeriodsInMonth, -1 if not in the month
+	int demandPeriod(size_t step) const { return m_dcPeriodOfStep[step]; }
+	int demandPeriodRow(size_t step) const { return m_dcRowOfStep[step]; }
+
+	/// Sorted demand charge periods in the month's weekday and weekend schedules
+	const std::vector<int> & demandPeriodsInMonth(size_t month) const { return m_dcMonthPeriods[month]; }
+
+	/// TOU demand charge tiers for a period and flat demand charge tiers for a month (0-11)
+	const RateTiers & demandTiers(int period) const;
+	const RateTiers & flatDemandTiers(size_t month) const { return m_dcFlatTiers[month]; }
+
+	/// Annual energy and demand charges for one year of grid power (kW, positive from grid) at stepsPerHour ($)
+	double calculateBill(const double * gridPower) const;
+
+	/// Annual energy and demand charges for each of many grid power profiles ($). Returns false if any profile is shorter
+	/// than numberOfSteps(), and its bill is NaN
+	bool calculateBills(const std::vector<std::vector<double> > & gridPowerProfiles, std::vector<double> & bills) const;
+
+protected:
+
+	/// Translate schedules to a period per step, and find the sorted periods in each month and each step's row among them
+	bool compileSchedule(const util::matrix_t<size_t> & weekday, const util::matrix_t<size_t> & weekend,
+		std::vector<int> & periodOfStep, std::vector<int> & rowOfStep, std::vector<std::vector<int> > & monthPeriods);
+
+	/// Sort rows of (period or month, tier, max, ...) tables into tiers, keeping the first row of a repeated tier
+	void compileTiers(const util::matrix_t<double> & ratesMatrix, int unitsColumn, int rateColumn, int sellColumn,
+		std::vector<int> & periods, std::vector<RateTiers> & tiers);
+
+	/// Charge for a month's energy per period row, split over tier maximums in proportion to each period's share
+	double energyTierCharge(size_t month, const std::vector<double> & energyPerRow, double peakDemand, bool isSell) const;
+
+	/// Charge for a demand over tier maximums
+	double demandTierCharge(const RateTiers & tiers, double demand) const;
+
+	size_t m_stepsPerHour;
+	std::vector<size_t> m_monthFirstStep;
+
+	bool m_hasEnergyCharges;
+	std::vector<int> m_ecPeriodOfStep;
+	std::vector<int> m_ecRowOfStep;
+	std::vector<std::vector<int> > m_ecMonthPeriods;
+	std::vector<int> m_ecPeriods;
+	std::vector<RateTiers> m_ecTiers;
+
+	bool m_hasDemandCharges;
+	std::vector<int> m_dcPeriodOfStep;
+	std::vector<int> m_dcRowOfStep;
+	std::vector<std::vector<int> > m_dcMonthPeriods;
+	std::vector<int> m_dcPeriods;
+	std::vector<RateTiers> m_dcTiers;
+	std::vector<RateTiers> m_dcFlatTiers;
+};
 
 class UtilityRate
 {
@@ -67,6 +182,9 @@ protected:
 
 	/// The energy usage per period
 	std::vector<double> m_energyUsagePerPeriod;
+
+	/// Energy charge period per hour of year, compiled once
+	CompiledUtilityRate m_compiledRate;
 };
 
 
@@ -576,7 +576,170 @@ bool weatherfile::timeStepChecks(int hdr_step_sec) {
 	return true;
 }
 
+#define WFCACHE_MAGIC "SSCWFC1"
+
+static util::cache_dir_setting sg_weatherCacheDir("SSC_WEATHER_CACHE_DIR");
+
+void weatherfile::set_cache_dir(const std::string &dir)
+{
+	sg_weatherCacheDir.set(dir);
+}
+
+std::string weatherfile::cache_dir()
+{
+	return sg_weatherCacheDir.get();
+}
+
+static std::string wfc_file_name(const std::string &dir, unsigned long long hash)
+{
+	char name[32];
+	sprintf(name, "%016llx.wfc", hash);
+	return dir + util::path_separator() + name;
+}
+
+std::string weatherfile::cache_file(const std::string &file)
+{
+	std::string dir = cache_dir();
+	unsigned long long hash = 0;
+	if (dir.empty() || !util::fnv1a_hash_file(file, hash))
+		return std::string();
+
+	return wfc_file_name(dir, hash);
+}
+
+static bool wfc_write_str(FILE *fp, const std::string &s)
+{
+	unsigned int len = (unsigned int)s.length();
+	return util::write_value(fp, len) && (len == 0 || fwrite(s.c_str(), 1, len, fp) == len);
+}
+
+static bool wfc_read_str(FILE *fp, std::string &s)
+{
+	unsigned int len;
+	if (!util::read_value(fp, len) || len > 65536) return false;
+	s.assign(len, ' ');
+	return len == 0 || fread(&s[0], 1, len, fp) == len;
+}
+
+bool weatherfile::write_cache(const std::string &cache_file, unsigned long long source_hash)
+{
+	return util::write_file_atomic(cache_file, [&](FILE *fp) { return write_cache(fp, source_hash); });
+}
+
+bool weatherfile::write_cache(FILE *fp, unsigned long long source_hash)
+{
+	char magic[8] = WFCACHE_MAGIC;
+	bool ok = fwrite(magic, 1, 8, fp) == 8
+		&& util::write_value(fp, source_hash)
+		&& util::write_value(fp, m_type)
+		&& util::write_value(fp, m_startYear)
+		&& util::write_value(fp, m_hasLeapYear)
+		&& util::write_value(fp, (unsigned long long)m_startSec)
+		&& util::write_value(fp, (unsigned long long)m_stepSec)
+		&& util::write_value(fp, (unsigned long long)m_nRecords)
+		&& util::write_value(fp, m_time)
+		&& util::write_value(fp, m_hdr.hasunits)
+		&& util::write_value(fp, m_hdr.tz)
+		&& util::write_value(fp, m_hdr.lat)
+		&& util::write_value(fp, m_hdr.lon)
+		&& util::write_value(fp, m_hdr.elev)
+		&& wfc_write_str(fp, m_hdr.location)
+		&& wfc_write_str(fp, m_hdr.city)
+		&& wfc_write_str(fp, m_hdr.state)
+		&& wfc_write_str(fp, m_hdr.country)
+		&& wfc_write_str(fp, m_hdr.source)
+		&& wfc_write_str(fp, m_hdr.description)
+		&& wfc_write_str(fp, m_hdr.url)
+		&& wfc_write_str(fp, m_message);
+
+	for (size_t i = 0; ok && i < _MAXCOL_; i++)
+		ok = util::write_value(fp, m_columns[i].index);
+
+	// one contiguous array per column
+	for (size_t i = 0; ok && i < _MAXCOL_; i++)
+		ok = m_nRecords == 0 || fwrite(&m_columns[i].data[0], sizeof(float), m_nRecords, fp) == m_nRecords;
+
+	return ok;
+}
+
+bool weatherfile::read_cache(const std::string &cache_file, unsigned long long source_hash)
+{
+	FILE *fp = fopen(cache_file.c_str(), "rb");
+	if (!fp) return false;
+
+	char magic[8];
+	unsigned long long hash, start_sec, step_sec, nrecords;
+	bool ok = fread(magic, 1, 8, fp) == 8
+		&& strncmp(magic, WFCACHE_MAGIC, 8) == 0
+		&& util::read_value(fp, hash)
+		&& hash == source_hash
+		&& util::read_value(fp, m_type)
+		&& util::read_value(fp, m_startYear)
+		&& util::read_value(fp, m_hasLeapYear)
+		&& util::read_value(fp, start_sec)
+		&& util::read_value(fp, step_sec)
+		&& util::read_value(fp, nrecords)
+		&& util::read_value(fp, m_time)
+		&& util::read_value(fp, m_hdr.hasunits)
+		&& util::read_value(fp, m_hdr.tz)
+		&& util::read_value(fp, m_hdr.lat)
+		&& util::read_value(fp, m_hdr.lon)
+		&& util::read_value(fp, m_hdr.elev)
+		&& wfc_read_str(fp, m_hdr.location)
+		&& wfc_read_str(fp, m_hdr.city)
+		&& wfc_read_str(fp, m_hdr.state)
+		&& wfc_read_str(fp, m_hdr.country)
+		&& wfc_read_str(fp, m_hdr.source)
+		&& wfc_read_str(fp, m_hdr.description)
+		&& wfc_read_str(fp, m_hdr.url)
+		&& wfc_read_str(fp, m_message);
+
+	m_startSec = (size_t)start_sec;
+	m_stepSec = (size_t)step_sec;
+	m_nRecords = (size_t)nrecords;
+
+	for (size_t i = 0; ok && i < _MAXCOL_; i++)
+		ok = util::read_value(fp, m_columns[i].index);
+
+	for (size_t i = 0; ok && i < _MAXCOL_; i++)
+	{
+		m_columns[i].data.resize(m_nRecords);
+		ok = m_nRecords == 0 || fread(&m_columns[i].data[0], sizeof(float), m_nRecords, fp) == m_nRecords;
+	}
+
+	fclose(fp);
+
+	if (!ok)
+	{
+		// stale or corrupt cache, fall back to parsing the source file
+		std::string file = m_file;
+		reset();
+		m_file = file;
+	}
+	return ok;
+}
+
 bool weatherfile::open(const std::string &file, bool header_only)
+{
+	m_file = file;
+
+	std::string dir = cache_dir();
+	unsigned long long hash = 0;
+	if (header_only || dir.empty() || !util::fnv1a_hash_file(file, hash))
+		return parse(file, header_only);
+
+	std::string wfc_file = wfc_file_name(dir, hash);
+	if (read_cache(wfc_file, hash))
+		return true;
+
+	if (!parse(file, header_only))
+		return false;
+
+	write_cache(wfc_file, hash);
+	return true;
+}
+
+bool weatherfile::parse(const std::string &file, bool header_only)
 {
 	if (file.empty())
 	{
@@ -1745,3 +1908,149 @@ bool weatherfile::convert_to_wfcsv( const std::string &input, const std::string
 
 }
 
+
+weather_data_columns::weather_data_columns()
+{
+	m_startSec = m_stepSec = m_nRecords = 0;
+	m_nColumnRecords = 0;
+	m_index = 0;
+	m_ok = true;
+	for (size_t i = 0; i < _MAXCOL_; i++)
+	{
+		m_col[i].p = 0;
+		m_col[i].len = 0;
+		m_col[i].assigned = false;
+	}
+}
+
+void weather_data_columns::set_column(size_t id, const float *p, size_t len)
+{
+	if (id >= _MAXCOL_) return;
+	m_col[id].p = p;
+	m_col[id].len = p ? len : 0;
+	m_col[id].assigned = true;
+}
+
+void weather_data_columns::set_location(double lat, double lon, double tz, double elev)
+{
+	m_hdr.lat = lat;
+	m_hdr.lon = lon;
+	m_hdr.tz = tz;
+	m_hdr.elev = elev;
+}
+
+bool weather_data_columns::init(size_t nrec)
+{
+	m_nRecords = nrec;
+
+	// estimate time step
+	size_t nmult = 0;
+	if ( m_nRecords%8760 == 0 )
+	{
+		nmult = nrec / 8760;
+		m_stepSec = 3600 / nmult;
+		m_startSec = m_stepSec / 2;
+	}
+	else if ( m_nRecords%8784==0 )
+	{ 
+		// Check if the weather file contains a leap day
+		// if so, correct the number of nrecords 
+		m_nRecords = m_nRecords/8784*8760;
+		nmult = m_nRecords/8760;
+		m_stepSec = 3600 / nmult;
+		m_startSec = m_stepSec / 2;
+	}
+	else
+	{
+		m_message = "could not determine timestep in weatherdata";
+		m_ok = false;
+		return false;
+	}
+
+	if ( nrec > 0 && nmult >= 1 )
+		m_nColumnRecords = nrec;
+
+	return true;
+}
+
+void weather_data_columns::set_counter_to(size_t cur_index)
+{
+	if (cur_index < m_nColumnRecords) {
+		m_index = cur_index;
+	}
+}
+
+bool weather_data_columns::read(weather_record *r)
+{
+	if (!r || m_index >= m_nColumnRecords)
+		return false;
+
+	size_t i = m_index++;
+	r->reset();
+
+	if ( i < m_col[YEAR].len ) r->year = (int)m_col[YEAR].p[i];
+	else r->year = 2000;
+
+	if ( i < m_col[MONTH].len ) r->month = (int)m_col[MONTH].p[i];
+	else if ( m_stepSec == 3600 && m_nRecords == 8760 ) {
+		r->month = util::month_of((double)i);
+	}
+
+	if ( i < m_col[DAY].len ) r->day = (int)m_col[DAY].p[i];
+	else if ( m_stepSec == 3600 && m_nRecords == 8760 ) {
+		int month = util::month_of( (double)i );
+		r->day = util::day_of_month( month, (double)i );
+	}
+
+	if ( i < m_col[HOUR].len ) r->hour = (int)m_col[HOUR].p[i];
+	else if ( m_stepSec == 3600 && m_nRecords == 8760 ) {
+		size_t day = i / 24;
+		size_t start_of_day = day * 24;
+		r->hour = (int)(i - start_of_day);
+	}
+
+	if ( i < m_col[MINUTE].len ) r->minute = m_col[MINUTE].p[i];
+	else r->minute = (double)((m_stepSec / 2) / 60);
+
+	if ( i < m_col[GHI].len ) r->gh = m_col[GHI].p[i];
+	if ( i < m_col[DNI].len ) r->dn = m_col[DNI].p[i];
+	if ( i < m_col[DHI].len ) r->df = m_col[DHI].p[i];
+	if ( i < m_col[POA].len ) r->poa = m_col[POA].p[i];
+
+	if ( i < m_col[WSPD].len ) r->wspd = m_col[WSPD].p[i];
+	if ( i < m_col[WDIR].len ) r->wdir = m_col[WDIR].p[i];
+
+	bool has_tdry = i < m_col[TDRY].len, has_rhum = i < m_col[RH].len, has_pres = i < m_col[PRES].len;
+
+	if ( has_tdry ) r->tdry = m_col[TDRY].p[i];
+	if ( i < m_col[TWET].len ) r->twet = m_col[TWET].p[i];
+	else if ( has_tdry && has_rhum && has_pres ) {
+		// calculate twet using calc_twet if tdry & rh & pres are available
+		r->twet = (float)calc_twet(m_col[TDRY].p[i], m_col[RH].p[i], m_col[PRES].p[i]);
+	}
+	if ( i < m_col[TDEW].len ) r->tdew = m_col[TDEW].p[i];
+	else if ( has_tdry && has_rhum ) {
+		// calculate tdew using wiki_dew_calc if tdry & rh are available
+		r->tdew = (float)wiki_dew_calc(m_col[TDRY].p[i], m_col[RH].p[i]);
+	}
+
+	if ( has_rhum ) r->rhum = m_col[RH].p[i];
+	if ( has_pres ) r->pres = m_col[PRES].p[i];
+
+	if ( i < m_col[SNOW].len ) r->snow = m_col[SNOW].p[i];
+	if ( i < m_col[ALB].len ) r->alb = m_col[ALB].p[i];
+	if ( i < m_col[AOD].len ) r->aod = m_col[AOD].p[i];
+
+	return true;
+}
+
+bool weather_data_columns::read_average(weather_record *r, std::vector<int> &, size_t &)
+{
+	// finish per bool weatherfile::read_average(weather_record *r, std::vector<int> &cols, size_t &num_timesteps)
+	return read(r);
+}
+
+bool weather_data_columns::has_data_column(size_t id)
+{
+	return id < _MAXCOL_ && m_col[id].assigned;
+}
@@ -50,6 +50,7 @@
 #ifndef __lib_weatherfile_h
 #define __lib_weatherfile_h
 
+#include <cstdio>
 #include <string>
 #include <vector>  // needed to compile in typelib_vc2012
 #include <cmath>
@@ -226,6 +227,39 @@ public:
 	}
 };
 
+/* Weather data provider over contiguous column arrays, one per weather_record field.
+   The arrays are owned by the caller: they are not copied and must remain valid while
+   the provider is used.  Records are assembled from the columns as they are read,
+   and wet bulb and dew point temperatures are calculated when not provided. */
+class weather_data_columns : public weather_data_provider
+{
+protected:
+	struct column
+	{
+		const float *p;
+		size_t len;
+		bool assigned;
+	};
+	column m_col[_MAXCOL_];
+	size_t m_nColumnRecords; // length of the data columns, including any leap day records
+
+public:
+	weather_data_columns();
+	virtual ~weather_data_columns() { }
+
+	/// Assign the array for field 'id' (YEAR...AOD)
+	void set_column( size_t id, const float *p, size_t len );
+	void set_location( double lat, double lon, double tz, double elev );
+
+	/// Determine the time step from the number of records, returns false and sets the message if it can't
+	bool init( size_t nrec );
+
+	void set_counter_to( size_t cur_index );
+	bool read( weather_record *r );
+	bool read_average( weather_record *r, std::vector<int> &cols, size_t &num_timesteps );
+	bool has_data_column( size_t id );
+};
+
 class weatherfile : public weather_data_provider
 {
 private:
@@ -258,6 +292,10 @@ public:
 	/// Check timestep of weatherfile and leap year, returns true if success
 	bool timeStepChecks(int hdr_step_sec = -1);
 
+	/* Opens and parses the file.  If a cache directory is set, the parsed columns are
+	written there in a binary columnar format on the first open, keyed by a hash of
+	the file contents, and later opens of the same contents load the columns from
+	the cache instead of parsing the text again. */
 	bool open( const std::string &file, bool header_only = false );
 
 	bool read( weather_record *r ); 
@@ -266,6 +304,18 @@ public:
 	
 	static std::string normalize_city( const std::string &in );
 	static bool convert_to_wfcsv( const std::string &input, const std::string &output );
+
+	/// Set the directory for binary weather caches, empty to disable. Defaults to the SSC_WEATHER_CACHE_DIR environment variable.
+	static void set_cache_dir( const std::string &dir );
+	static std::string cache_dir();
+	/// Cache file for the contents of a weather file, empty if caching is disabled or the file can't be read
+	static std::string cache_file( const std::string &file );
+
+private:
+	bool parse( const std::string &file, bool header_only );
+	bool read_cache( const std::string &cache_file, unsigned long long source_hash );
+	bool write_cache( const std::string &cache_file, unsigned long long source_hash );
+	bool write_cache( FILE *fp, unsigned long long source_hash );
 	
 };
 
@@ -57,6 +57,7 @@
 #include <numeric>
 #include <sstream>
 #include <typeinfo>
+#include <iterator>
 #include <stdio.h>
 
 #if defined(__WINDOWS__)||defined(WIN32)||defined(_WIN32)
@@ -143,30 +144,31 @@ bool winddata_provider::can_interpolate( int index1, int index2, int ncols, doub
 	return false;
 }
 
-bool winddata_provider::read( double requested_height,
-	double *speed,
-	double *direction,
-	double *temperature,
-	double *pressure,
-	double *closest_speed_meas_height_in_file,
-	double *closest_dir_meas_height_in_file,
-	bool bInterpolate /*= false*/)
-{	
-	std::vector<double> values;
-	if ( !read_line( values ) )
-		return false;
-	
-	if (values.size() < m_heights.size() || values.size() < m_dataid.size())
-		return false;
-
-	int ncols = (int)values.size();
+winddata_provider::column_pick winddata_provider::pick_columns( int id, int ncols, double requested_height, bool bInterpolate )
+{
+	column_pick pick;
+	pick.index = pick.index2 = -1;
+	pick.interpolate = false;
+	if ( !find_closest(pick.index, id, ncols, requested_height) )
+	{
+		pick.index = -1;
+		return pick;
+	}
+	pick.interpolate = ( (bInterpolate) && (m_heights[pick.index] != requested_height) && find_closest(pick.index2, id, ncols, requested_height, pick.index) && can_interpolate(pick.index, pick.index2, ncols, requested_height) );
+	return pick;
+}
 
+bool winddata_provider::resource_at_height( const double values[], const column_pick &speed_cols, const column_pick &dir_cols,
+	const column_pick &temp_cols, const column_pick &pres_cols, double requested_height,
+	double *speed, double *direction, double *temperature, double *pressure,
+	double *closest_speed_meas_height_in_file, double *closest_dir_meas_height_in_file )
+{
 	*speed = *direction = *temperature = *pressure = *closest_speed_meas_height_in_file = *closest_dir_meas_height_in_file = std::numeric_limits<double>::quiet_NaN();
 
-	int index = -1, index2 = -1;
-	if ( find_closest(index, SPEED, ncols, requested_height) )
+	int index = speed_cols.index, index2 = speed_cols.index2;
+	if ( index >= 0 )
 	{
-		if ( (bInterpolate) && (m_heights[index] != requested_height) && find_closest(index2, SPEED, ncols, requested_height, index) && can_interpolate(index, index2, ncols, requested_height)  )
+		if ( speed_cols.interpolate )
 		{
 			*speed = util::interpolate(m_heights[index], values[index], m_heights[index2], values[index2], requested_height);
 			*closest_speed_meas_height_in_file = requested_height;
@@ -178,12 +180,14 @@ bool winddata_provider::read( double requested_height,
 		}
 	}
 
-	if (find_closest(index, DIR, ncols, requested_height) )
+	index = dir_cols.index;
+	index2 = dir_cols.index2;
+	if ( index >= 0 )
 	{
 		// interpolating direction is a little more complicated
 		double dir1=0, dir2=0, angle;
 		double ht1=0, ht2=0;
-		bool interp_direction = ( (bInterpolate) && (m_heights[index] != requested_height) && find_closest(index2, DIR, ncols, requested_height, index) && can_interpolate(index, index2, ncols, requested_height)  );
+		bool interp_direction = dir_cols.interpolate;
 		if ( interp_direction )
 		{
 			dir1 = values[index];
@@ -231,17 +235,21 @@ bool winddata_provider::read( double requested_height,
 		}
 	}
 
-	if ( find_closest(index, TEMP, ncols, requested_height) )
+	index = temp_cols.index;
+	index2 = temp_cols.index2;
+	if ( index >= 0 )
 	{
-		if ( (bInterpolate) && (m_heights[index] != requested_height) && find_closest(index2, TEMP, ncols, requested_height, index) && can_interpolate(index, index2, ncols, requested_height)  )
+		if ( temp_cols.interpolate )
 			*temperature = util::interpolate(m_heights[index], values[index], m_heights[index2], values[index2], requested_height);
 		else
 			*temperature = values[index];
 	}
 
-	if ( find_closest(index, PRES, ncols, requested_height) )
+	index = pres_cols.index;
+	index2 = pres_cols.index2;
+	if ( index >= 0 )
 	{
-		if ( (bInterpolate) && (m_heights[index] != requested_height) && find_closest(index2, PRES, ncols, requested_height, index) && can_interpolate(index, index2, ncols, requested_height)  )
+		if ( pres_cols.interpolate )
 			*pressure = util::interpolate(m_heights[index], values[index], m_heights[index2], values[index2], requested_height);
 		else
 			*pressure = values[index];
@@ -271,7 +279,93 @@ bool winddata_provider::read( double requested_height,
 	}
 
 	return found_all;
+}
+
+bool winddata_provider::read( double requested_height,
+	double *speed,
+	double *direction,
+	double *temperature,
+	double *pressure,
+	double *closest_speed_meas_height_in_file,
+	double *closest_dir_meas_height_in_file,
+	bool bInterpolate /*= false*/)
+{	
+	std::vector<double> values;
+	if ( !read_line( values ) )
+		return false;
+	
+	if (values.size() < m_heights.size() || values.size() < m_dataid.size())
+		return false;
 
+	int ncols = (int)values.size();
+
+	return resource_at_height( &values[0],
+		pick_columns(SPEED, ncols, requested_height, bInterpolate),
+		pick_columns(DIR, ncols, requested_height, bInterpolate),
+		pick_columns(TEMP, ncols, requested_height, bInterpolate),
+		pick_columns(PRES, ncols, requested_height, bInterpolate),
+		requested_height, speed, direction, temperature, pressure,
+		closest_speed_meas_height_in_file, closest_dir_meas_height_in_file );
+}
+
+bool winddata_provider::read_lines( util::matrix_t<double> &values )
+{
+	std::vector<double> row, all;
+	size_t nrows = 0, ncols = 0;
+	while ( read_line( row ) )
+	{
+		if ( nrows == 0 )
+			ncols = row.size();
+		else if ( row.size() != ncols )
+			break;
+		all.insert( all.end(), row.begin(), row.end() );
+		nrows++;
+	}
+
+	if ( nrows == 0 )
+	{
+		values.clear();
+		return false;
+	}
+
+	values.assign( &all[0], nrows, ncols );
+	return true;
+}
+
+bool winddata_provider::read_all( double requested_height, bool bInterpolate, winddata_columns &resource )
+{
+	util::matrix_t<double> values;
+	if ( !read_lines( values ) )
+		return false;
+
+	int ncols = (int)values.ncols();
+	if ( ncols < (int)m_heights.size() || ncols < (int)m_dataid.size() )
+		return false;
+
+	// the columns used at the requested height depend only on the header
+	column_pick speed_cols = pick_columns(SPEED, ncols, requested_height, bInterpolate);
+	column_pick dir_cols = pick_columns(DIR, ncols, requested_height, bInterpolate);
+	column_pick temp_cols = pick_columns(TEMP, ncols, requested_height, bInterpolate);
+	column_pick pres_cols = pick_columns(PRES, ncols, requested_height, bInterpolate);
+
+	size_t nrows = values.nrows();
+	resource.speed.resize( nrows );
+	resource.direction.resize( nrows );
+	resource.temperature.resize( nrows );
+	resource.pressure.resize( nrows );
+
+	for ( size_t r = 0; r < nrows; r++ )
+	{
+		if ( !resource_at_height( values.data() + r * ncols, speed_cols, dir_cols, temp_cols, pres_cols, requested_height,
+			&resource.speed[r], &resource.direction[r], &resource.temperature[r], &resource.pressure[r],
+			&resource.speedMeasHeight, &resource.dirMeasHeight ) )
+		{
+			m_errorMsg = util::format( "error reading wind resource record %d: %s", (int)r + 1, m_errorMsg.c_str() );
+			return false;
+		}
+	}
+
+	return true;
 }
 
 
@@ -463,3 +557,66 @@ bool windfile::read_line( std::vector<double> &values )
 	else
 		return false;
 }
+
+bool windfile::read_lines( util::matrix_t<double> &values )
+{
+	if ( !ok() ) return false;
+
+	// read the rest of the file in one block and parse it in place, rather than splitting each line into strings
+	std::string text( (std::istreambuf_iterator<char>(m_ifs)), std::istreambuf_iterator<char>() );
+
+	size_t ncols = m_heights.size();
+	std::vector<double> all;
+	all.reserve( m_nrec * ncols );
+
+	size_t nrows = 0;
+	const char *p = text.c_str();
+	const char *end = p + text.length();
+	while ( p < end )
+	{
+		const char *eol = (const char*)memchr( p, '\n', end - p );
+		if ( eol == 0 ) eol = end;
+		const char *line_end = ( eol > p && *(eol - 1) == '\r' ) ? eol - 1 : eol;
+
+		if ( line_end == p )
+		{	// blank lines are only allowed at the end of the file
+			p = eol + 1;
+			while ( p < end && ( *p == '\r' || *p == '\n' ) ) p++;
+			if ( p < end )
+			{
+				m_errorMsg = util::format( "error reading wind resource record %d: blank line", (int)nrows + 1 );
+				return false;
+			}
+			break;
+		}
+
+		for ( size_t i = 0; i < ncols; i++ )
+		{
+			char *next = 0;
+			float x = ( p < line_end && *p != ',' ) ? strtof( p, &next ) : 0.0f;
+			if ( next == 0 || next == p || next > line_end )
+			{
+				m_errorMsg = util::format( "error reading wind resource record %d: column %d is missing or not a number", (int)nrows + 1, (int)i + 1 );
+				return false;
+			}
+			all.push_back( x );
+
+			// skip anything after the number up to the next delimiter, as stof does
+			p = next;
+			while ( p < line_end && *p != ',' ) p++;
+			if ( p < line_end ) p++;
+		}
+
+		nrows++;
+		p = eol + 1;
+	}
+
+	if ( nrows == 0 )
+	{
+		values.clear();
+		return false;
+	}
+
+	values.assign( &all[0], nrows, ncols );
+	return true;
+}
@@ -52,8 +52,27 @@
 
 #include <string>
 #include <fstream>
+#include <vector>
 #include "lib_util.h"
 
+/**
+ * Resource at one requested height for every record of a wind resource, filled by winddata_provider::read_all.
+ * The closest measurement heights only depend on the file header, so they are the same for every record.
+ */
+
+struct winddata_columns
+{
+	std::vector<double> speed;			// m/s
+	std::vector<double> direction;		// degrees
+	std::vector<double> temperature;	// degrees Celsius
+	std::vector<double> pressure;		// atmospheres
+	double speedMeasHeight;				// closest speed measurement height, or the requested height if interpolated
+	double dirMeasHeight;				// closest direction measurement height, or the requested height if interpolated
+
+	winddata_columns() : speedMeasHeight(0), dirMeasHeight(0) {}
+	size_t size() { return speed.size(); }
+};
+
 class winddata_provider
 {
 public:
@@ -78,9 +97,9 @@ public:
 	double elev;
 	double measurementHeight;
 
-	std::vector<int> types() { return m_dataid; }
-	std::vector<double> heights() { return m_heights; }
-	std::vector<float> relativeHumidity() { return m_relativeHumidity; }
+	const std::vector<int> &types() { return m_dataid; }
+	const std::vector<double> &heights() { return m_heights; }
+	const std::vector<float> &relativeHumidity() { return m_relativeHumidity; }
 
 	bool read( double requested_height,
 		double *speed,
@@ -91,7 +110,12 @@ public:
 		double *dir_meas_height,
 		bool bInterpolate = false);
 	
+	/// Reads all remaining records at once and returns the same values read() would give record by record
+	bool read_all( double requested_height, bool bInterpolate, winddata_columns &resource );
+
 	virtual bool read_line( std::vector<double> &values ) = 0;
+	/// Reads all remaining records, one row per record
+	virtual bool read_lines( util::matrix_t<double> &values );
 	virtual size_t nrecords() = 0;
 
 	
@@ -108,6 +132,20 @@ protected:
 	bool find_closest( int& closest_index, int id, int ncols, double requested_height, int index_to_exclude = -1 );
 	bool can_interpolate( int index1, int index2, int ncols, double requested_height );
 
+	/// data columns used for one resource type at the requested height, index is -1 if the type is missing
+	struct column_pick
+	{
+		int index, index2;
+		bool interpolate;
+	};
+	column_pick pick_columns( int id, int ncols, double requested_height, bool bInterpolate );
+
+	/// resource at the requested height for one record, given the picks for SPEED, DIR, TEMP and PRES
+	bool resource_at_height( const double values[], const column_pick &speed_cols, const column_pick &dir_cols,
+		const column_pick &temp_cols, const column_pick &pres_cols, double requested_height,
+		double *speed, double *direction, double *temperature, double *pressure,
+		double *speed_meas_height, double *dir_meas_height );
+
 
 };
 
@@ -130,6 +168,7 @@ public:
 	bool open( const std::string &file );
 	
 	virtual bool read_line( std::vector<double> &values );
+	virtual bool read_lines( util::matrix_t<double> &values );
 	virtual size_t nrecords();
 	
 };
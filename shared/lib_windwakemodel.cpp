@@ -47,11 +47,14 @@
 *  THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 *******************************************************************************************************/
 
+#include <algorithm>
 #include <cmath>
+#include <thread>
 #include "lib_physics.h"
 #include "lib_util.h"
 #include "lib_windwatts.h"
 #include "lib_windwakemodel.h"
+#include "lib_parallel.h"
 
 bool windTurbine::setPowerCurve(std::vector<double> windSpeeds, std::vector<double> powerOutput){
 	if (windSpeeds.size() == powerOutput.size()) powerCurveArrayLength = windSpeeds.size();
@@ -61,7 +64,6 @@ bool windTurbine::setPowerCurve(std::vector<double> windSpeeds, std::vector<doub
 	}
 	powerCurveWS = windSpeeds;
 	powerCurveKW = powerOutput;
-	densityCorrectedWS.resize(powerCurveArrayLength, 0);
 	powerCurveRPM.resize(powerCurveArrayLength, -1);
 	return 1;
 }
@@ -95,11 +97,8 @@ void windTurbine::turbinePower(double windVelocity, double airDensity, double *t
 	*turbineOutput = 0.0;
 
 	//first, correct wind speeds in power curve for site air density. Using method 2 described in https://www.scribd.com/document/38818683/PO310-EWEC2010-Presentation
-	std::vector <double> temp_ws;
+	//the corrected speeds are not stored, so several threads can share the turbine
 	double correction = pow((physics::AIR_DENSITY_SEA_LEVEL / airDensity), (1.0 / 3.0));
-	for (size_t i = 0; i < densityCorrectedWS.size(); i++) {
-		densityCorrectedWS[i] = powerCurveWS[i] * correction;
-	}
 	int i = 0;
 	while (powerCurveKW[i] == 0)
 		i++; //find the index of the first non-zero power output in the power curve
@@ -107,7 +106,7 @@ void windTurbine::turbinePower(double windVelocity, double airDensity, double *t
 	//this is consistent with the NREL Cost & Scaling model- if you specify a cut-in speed of 4 m/s, the power curve value at 4 m/s is 0, and it starts producing power at 4.25.
 	//HOWEVER, if you specify the cut-in speed BETWEEN the wind speed bins, then this method would improperly assume that the cut-in speed is lower than it actually is. But given the 0.25 m/s size of the bins, that type of
 	//specification would be false accuracy anyways, so we'll ignore it for now.
-	cutInSpeed = densityCorrectedWS[i - 1];
+	double cutInSpeed = powerCurveWS[i - 1] * correction;
 
 	/*	//We will continue not to check cut-out speed because currently the model will interpolate between the last non-zero power point and zero, and we don't have a better definition of where the power cutoff should be.
 	i = m_adPowerCurveKW.size() - 1; //last index in the array
@@ -117,15 +116,15 @@ void windTurbine::turbinePower(double windVelocity, double airDensity, double *t
 
 	// Find power from turbine power curve
 	double out_pwr = 0.0;
-	if ((windVelocity > densityCorrectedWS[0]) && (windVelocity < densityCorrectedWS[powerCurveArrayLength - 1]))
+	if ((windVelocity > powerCurveWS[0] * correction) && (windVelocity < powerCurveWS[powerCurveArrayLength - 1] * correction))
 	{
 		int j = 1;
-		while (densityCorrectedWS[j] <= windVelocity)
+		while (powerCurveWS[j] * correction <= windVelocity)
 			j++; // find first m_adPowerCurveWS > windVelocity
 
-		out_pwr = util::interpolate(densityCorrectedWS[j - 1], powerCurveKW[j - 1], densityCorrectedWS[j], powerCurveKW[j], windVelocity);
+		out_pwr = util::interpolate(powerCurveWS[j - 1] * correction, powerCurveKW[j - 1], powerCurveWS[j] * correction, powerCurveKW[j], windVelocity);
 	}
-	else if (windVelocity == densityCorrectedWS[powerCurveArrayLength - 1])
+	else if (windVelocity == powerCurveWS[powerCurveArrayLength - 1] * correction)
 		out_pwr = powerCurveKW[powerCurveArrayLength - 1];
 
 	// Check against turbine cut-in speed
@@ -149,6 +148,150 @@ void windTurbine::turbinePower(double windVelocity, double airDensity, double *t
 	return;
 }
 
+// search distance for wakes without a crosswind or downwind limit, finite so strip arithmetic stays well defined
+static const double WAKE_UNBOUNDED = 1e30;
+
+void wakeNeighborIndex::build(size_t nTurbines, const double distanceCrosswind[], double width)
+{
+	strips.clear();
+	if (nTurbines == 0)
+		return;
+
+	crosswindMin = distanceCrosswind[0];
+	double crosswindMax = distanceCrosswind[0];
+	for (size_t i = 1; i < nTurbines; i++)
+	{
+		crosswindMin = min_of(crosswindMin, distanceCrosswind[i]);
+		crosswindMax = max_of(crosswindMax, distanceCrosswind[i]);
+	}
+
+	// a strip as wide as the search band means a query only looks at two or three strips
+	stripWidth = max_of(width, 1e-6);
+	size_t nStrips = (size_t)min_of((crosswindMax - crosswindMin) / stripWidth, (double)nTurbines) + 1;
+	stripWidth = max_of(stripWidth, (crosswindMax - crosswindMin) / nStrips);
+	strips.resize(nStrips);
+	for (size_t i = 0; i < nTurbines; i++)
+	{
+		size_t k = min_of((double)nStrips - 1, floor((distanceCrosswind[i] - crosswindMin) / stripWidth));
+		strips[k].push_back(i);
+	}
+}
+
+void wakeNeighborIndex::upwindNeighbors(size_t i, const double distanceDownwind[], const double distanceCrosswind[],
+	double halfWidth, double maxDownwind, std::vector<size_t> &neighbors) const
+{
+	neighbors.clear();
+	if (strips.empty())
+		return;
+
+	double c = distanceCrosswind[i];
+	double lo = max_of(0.0, floor((c - halfWidth - crosswindMin) / stripWidth));
+	double hi = min_of((double)strips.size() - 1, floor((c + halfWidth - crosswindMin) / stripWidth));
+	double downwindMin = distanceDownwind[i] - maxDownwind;
+
+	for (size_t k = (size_t)lo; k <= (size_t)hi; k++)
+	{
+		const std::vector<size_t> &strip = strips[k];
+
+		// turbine indices, and so downwind distances, increase along the strip
+		std::vector<size_t>::const_iterator first = std::lower_bound(strip.begin(), strip.end(), downwindMin,
+			[distanceDownwind](size_t j, double d) { return distanceDownwind[j] < d; });
+		for (std::vector<size_t>::const_iterator it = first; it != strip.end() && *it < i; ++it)
+		{
+			if (fabs(distanceCrosswind[*it] - c) <= halfWidth)
+				neighbors.push_back(*it);
+		}
+	}
+
+	// the wake models accumulate upwind effects in turbine order
+	std::sort(neighbors.begin(), neighbors.end());
+}
+
+sp_thread_pool *wakeModelBase::turbinePool()
+{
+	int threads = nThreads;
+	if (threads < 1)
+		threads = (nTurbines >= wakeTurbinePass::MIN_PARALLEL_TURBINES) ? (int)std::thread::hardware_concurrency() : 1;
+	threads = std::max(1, std::min(threads, (int)nTurbines));
+
+	if (!pool || pool->threads() != threads)
+		pool = std::make_shared<sp_thread_pool>(threads);
+	return pool.get();
+}
+
+wakeTurbinePass::wakeTurbinePass(size_t n, sp_thread_pool *threadPool) : nTurbines(n), pool(threadPool), done(new std::atomic<char>[n > 0 ? n : 1]), failed(false)
+{
+	for (size_t i = 0; i < nTurbines; i++)
+		done[i].store(0, std::memory_order_relaxed);
+}
+
+int wakeTurbinePass::threads()
+{
+	return pool ? pool->threads() : 1;
+}
+
+bool wakeTurbinePass::run(size_t first, const std::function<bool(size_t, int)> &calc)
+{
+	for (size_t i = 0; i < first && i < nTurbines; i++)
+		done[i].store(1, std::memory_order_relaxed);
+
+	if (threads() == 1)
+	{
+		for (size_t i = first; i < nTurbines; i++)
+		{
+			if (!calc(i, 0))
+				return false;
+			done[i].store(1, std::memory_order_relaxed);
+		}
+		return true;
+	}
+
+	// turbines are claimed in increasing order, so the lowest unfinished turbine never waits on an unclaimed one
+	if (first >= nTurbines)
+		return true;
+	pool->parallel_for((int)(nTurbines - first), 1, [&](int k, int thread)
+	{
+		size_t i = first + k;
+		if (failed.load())
+			return;
+		bool ok;
+		try
+		{
+			ok = calc(i, thread);
+		}
+		catch (...)
+		{
+			// stop turbines waiting in upwindReady before the pool passes the exception on
+			finish(i, false);
+			throw;
+		}
+		finish(i, ok);
+	});
+
+	return !failed.load();
+}
+
+void wakeTurbinePass::finish(size_t i, bool ok)
+{
+	{
+		std::lock_guard<std::mutex> lock(readyLock);
+		if (ok)
+			done[i].store(1, std::memory_order_release);
+		else
+			failed.store(true);
+	}
+	ready.notify_all();
+}
+
+bool wakeTurbinePass::upwindReady(size_t j)
+{
+	if (done[j].load(std::memory_order_acquire))
+		return true;
+
+	std::unique_lock<std::mutex> lock(readyLock);
+	ready.wait(lock, [&] { return done[j].load(std::memory_order_acquire) || failed.load(); });
+	return done[j].load(std::memory_order_acquire) != 0;
+}
 
 /// Calculates the velocity deficit (% reduction in wind speed) and the turbulence intensity (TI) due to an upwind turbine.
 double simpleWakeModel::velDeltaPQ(double radiiCrosswind, double axialDistInRadii, double thrustCoeff, double *newTurbulenceIntensity)
@@ -168,11 +311,25 @@ double simpleWakeModel::velDeltaPQ(double radiiCrosswind, double axialDistInRadi
 void simpleWakeModel::wakeCalculations(const double airDensity, const double distanceDownwind[], const double distanceCrosswind[],
 	double power[], double eff[], double thrust[], double windSpeed[], double turbulenceIntensity[])
 {
-	for (size_t i = 1; i < nTurbines; i++) // loop through all turbines, starting with most upwind turbine. i=0 has already been done
+	// velDeltaPQ ignores upwind turbines more than 20 radii crosswind, at any downwind distance
+	const double maxCrosswind = 20.0;
+	wakeNeighborIndex index;
+	index.build(nTurbines, distanceCrosswind, maxCrosswind);
+
+	wakeTurbinePass pass(nTurbines, turbinePool());
+	std::vector<std::vector<size_t>> upwind(pass.threads());
+
+	bool ok = pass.run(1, [&](size_t i, int thread) -> bool // loop through all turbines, starting with most upwind turbine. i=0 has already been done
 	{
+		index.upwindNeighbors(i, distanceDownwind, distanceCrosswind, maxCrosswind, WAKE_UNBOUNDED, upwind[thread]);
+
 		double dDeficit = 1;
-		for (size_t j = 0; j < i; j++) // loop through all turbines upwind of turbine[i]
+		for (size_t k = 0; k < upwind[thread].size(); k++) // loop through all turbines upwind of turbine[i]
 		{
+			size_t j = upwind[thread][k];
+			if (!pass.upwindReady(j))
+				return false;
+
 			// distance downwind (axial distance) = distance from turbine j to turbine i along axis of wind direction (units of wind turbine blade radii)
 			double fDistanceDownwind = fabs(distanceDownwind[j] - distanceDownwind[i]);
 
@@ -188,11 +345,14 @@ void simpleWakeModel::wakeCalculations(const double airDensity, const double dis
 		}
 		windSpeed[i] = windSpeed[i] * dDeficit;
 		wTurbine->turbinePower(windSpeed[i], airDensity, &power[i], &thrust[i]);
-		if (wTurbine->errDetails.length() > 0){
-			errDetails = wTurbine->errDetails;
-			return;
-		}
+		if (wTurbine->errDetails.length() > 0)
+			return false;
 		eff[i] = wTurbine->calculateEff(power[i], power[0]);
+		return true;
+	});
+	if (!ok){
+		errDetails = wTurbine->errDetails;
+		return;
 	}
 	eff[0] = 100.;
 }
@@ -245,11 +405,25 @@ void parkWakeModel::wakeCalculations(const double airDensity, const double dista
 {
 	double turbineRadius = wTurbine->rotorDiameter / 2;
 
-	for (size_t i = 1; i < nTurbines; i++) // downwind turbines, i=0 has already been done
+	// an upwind wake only reaches turbines whose rotor overlaps the cone of radius (1 + k * downwind distance), in radii
+	wakeNeighborIndex index;
+	index.build(nTurbines, distanceCrosswind, 2.0);
+
+	wakeTurbinePass pass(nTurbines, turbinePool());
+	std::vector<std::vector<size_t>> upwind(pass.threads());
+
+	bool ok = pass.run(1, [&](size_t i, int thread) -> bool // downwind turbines, i=0 has already been done
 	{
+		double maxCrosswind = 2.0 + wakeDecayCoefficient * (distanceDownwind[i] - distanceDownwind[0]) + 1e-6;
+		index.upwindNeighbors(i, distanceDownwind, distanceCrosswind, maxCrosswind, WAKE_UNBOUNDED, upwind[thread]);
+
 		double newSpeed = windSpeed[0];
-		for (size_t j = 0; j < i; j++) // upwind turbines
+		for (size_t k = 0; k < upwind[thread].size(); k++) // upwind turbines
 		{
+			size_t j = upwind[thread][k];
+			if (!pass.upwindReady(j))
+				return false;
+
 			double distanceDownwindMeters = turbineRadius*fabs(distanceDownwind[i] - distanceDownwind[j]);
 			double distanceCrosswindMeters = turbineRadius*fabs(distanceCrosswind[i] - distanceCrosswind[j]);
 
@@ -259,11 +433,14 @@ void parkWakeModel::wakeCalculations(const double airDensity, const double dista
 		}
 		windSpeed[i] = newSpeed;
 		wTurbine->turbinePower(windSpeed[i], airDensity, &power[i], &thrust[i]);
-		if (wTurbine->errDetails.length() > 0){
-			errDetails = wTurbine->errDetails;
-			return;
-		}
+		if (wTurbine->errDetails.length() > 0)
+			return false;
 		eff[i] = wTurbine->calculateEff(power[i], power[0]);
+		return true;
+	});
+	if (!ok){
+		errDetails = wTurbine->errDetails;
+		return;
 	}
 	eff[0] = 100;
 }
@@ -511,23 +688,42 @@ void eddyViscosityWakeModel::wakeCalculations(/*INPUTS */ const double air_densi
 	/*OUTPUTS*/ double power[], double eff[], double Thrust[], double adWindSpeed[], double aTurbulence_intensity[])
 {
 	double dTurbineRadius = rotorDiameter / 2;
-	matEVWakeDeficits.fill(0.0);
-	matEVWakeWidths.fill(0.0);
+	double dFreeStream = adWindSpeed[0];
 	std::vector<VMLN> vmln(nTurbines);
 	std::vector<double> Iamb(nTurbines, turbulenceCoeff);
 
+	// the wake arrays end MIN_DIAM_EV + (ncols - 1) * axialResolution diameters downwind, turbines further away are not affected
+	double maxDownwindRadii = 2.0 * (MIN_DIAM_EV + (matEVWakeDeficits.ncols() - 1) * axialResolution) + 1e-6;
+	wakeNeighborIndex index;
+	index.build(nTurbines, aDistanceCrosswind, WAKE_UNBOUNDED);
+
+	wakeTurbinePass pass(nTurbines, turbinePool());
+	std::vector<std::vector<size_t>> upwind(pass.threads());
+
 	// Note that this 'i' loop starts with i=0, which is necessary to initialize stuff for turbine[0]
-	for (size_t i = 0; i<nTurbines; i++) // downwind turbines, but starting with most upwind and working downwind
+	bool ok = pass.run(0, [&](size_t i, int thread) -> bool // downwind turbines, but starting with most upwind and working downwind
 	{
+		for (size_t c = 0; c < matEVWakeDeficits.ncols(); c++)
+		{
+			matEVWakeDeficits.at(i, c) = 0.0;
+			matEVWakeWidths.at(i, c) = 0.0;
+		}
+		index.upwindNeighbors(i, aDistanceDownwind, aDistanceCrosswind, WAKE_UNBOUNDED, maxDownwindRadii, upwind[thread]);
+
 		double dDeficit = 0, Iadd = 0, dTotalTI = aTurbulence_intensity[i];
 		//		double dTOut=0, dThrustCoeff=0;
-		for (size_t j = 0; j<i; j++) // upwind turbines - turbines upwind of turbine[i]
+		for (size_t k = 0; k < upwind[thread].size(); k++) // upwind turbines - turbines upwind of turbine[i]
 		{
+			size_t j = upwind[thread][k];
+
 			// distance downwind = distance from turbine i to turbine j along axis of wind direction
 			double dDistAxialInDiameters = fabs(aDistanceDownwind[i] - aDistanceDownwind[j]) / 2.0;
 			if (std::abs(dDistAxialInDiameters) <= 0.0001)
 				continue; // if this turbine isn't really upwind, move on to the next
 
+			if (!pass.upwindReady(j))
+				return false;
+
 			// separation crosswind between turbine i and turbine j
 			double dDistRadialInDiameters = fabs(aDistanceCrosswind[i] - aDistanceCrosswind[j]) / 2.0;
 
@@ -535,9 +731,13 @@ void eddyViscosityWakeModel::wakeCalculations(/*INPUTS */ const double air_densi
 			if (dWakeRadiusMeters <= 0.0)
 				continue;
 
+			// more than four wake widths away the gaussian deficit is below double precision and the wake misses the rotor
+			if (dDistRadialInDiameters*rotorDiameter - dTurbineRadius > 4.0 * dWakeRadiusMeters)
+				continue;
+
 			// calculate the wake deficit
 			double dDef = wakeDeficit((int)j, dDistRadialInDiameters, dDistAxialInDiameters);
-			double dWindSpeedWaked = adWindSpeed[0] * (1 - dDef); // wind speed = free stream * (1-deficit)
+			double dWindSpeedWaked = dFreeStream * (1 - dDef); // wind speed = free stream * (1-deficit)
 
 			// keep it if it's bigger
 			dDeficit = max_of(dDeficit, dDef);
@@ -545,24 +745,27 @@ void eddyViscosityWakeModel::wakeCalculations(/*INPUTS */ const double air_densi
 			Iadd = addedTurbulenceIntensity( Thrust[j], dDistAxialInDiameters*rotorDiameter );
 
 			double dFractionOfOverlap = simpleIntersect(dDistRadialInDiameters*rotorDiameter, dTurbineRadius, dWakeRadiusMeters);
-			dTotalTI = max_of(dTotalTI, totalTurbulenceIntensity(aTurbulence_intensity[i], Iadd, adWindSpeed[0], dWindSpeedWaked, dFractionOfOverlap));
+			dTotalTI = max_of(dTotalTI, totalTurbulenceIntensity(aTurbulence_intensity[i], Iadd, dFreeStream, dWindSpeedWaked, dFractionOfOverlap));
 		}
 		// use the max deficit found to calculate the turbine output
-		adWindSpeed[i] = adWindSpeed[0] * (1 - dDeficit);
+		adWindSpeed[i] = dFreeStream * (1 - dDeficit);
 		aTurbulence_intensity[i] = dTotalTI;
 		wTurbine->turbinePower(adWindSpeed[i], air_density, &power[i], &Thrust[i]);
-		if (wTurbine->errDetails.length() > 0){
-			errDetails = wTurbine->errDetails;
-			return;
-		}
+		if (wTurbine->errDetails.length() > 0)
+			return false;
+		if (i > 0 && !pass.upwindReady(0))
+			return false;
 		eff[i] = wTurbine->calculateEff(power[i], power[0]);
 
 		// now that turbine[i] wind speed, output, thrust, etc. have been calculated, calculate wake characteristics for it, because downwind turbines will need the info
-		if (!fillWakeArrays((int)i, adWindSpeed[0], adWindSpeed[i], power[i], Thrust[i], aTurbulence_intensity[i], fabs(aDistanceDownwind[nTurbines - 1] - aDistanceDownwind[i])*dTurbineRadius))
-		{
-			if (errDetails.length() == 0) errDetails = "Could not calculate the turbine wake arrays in the Eddy-Viscosity model.";
-		}
+		if (!fillWakeArrays((int)i, dFreeStream, adWindSpeed[i], power[i], Thrust[i], aTurbulence_intensity[i], fabs(aDistanceDownwind[nTurbines - 1] - aDistanceDownwind[i])*dTurbineRadius))
+			return false;
 		nearWakeRegionLength(adWindSpeed[i], Iamb[i], Thrust[i], air_density, vmln[i]);
+		return true;
+	});
+	if (!ok)
+	{
+		errDetails = wTurbine->errDetails;
+		if (errDetails.length() == 0) errDetails = "Could not calculate the turbine wake arrays in the Eddy-Viscosity model.";
 	}
 }
-
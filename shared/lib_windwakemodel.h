@@ -50,9 +50,16 @@
 #ifndef __lib_windwake
 #define __lib_windwake
 
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include "lib_util.h"
 
+class sp_thread_pool;
+
 /**
  * windTurbine class stores characteristics of turbine used in simulation and the power curve arrays,
  * which map from wind speed to turbine's output. The following public variables must be set before use:
@@ -65,9 +72,7 @@ class windTurbine
 private:
 	std::vector<double> powerCurveWS,			// windspeed: x-axis on turbine power curve
 						powerCurveKW,			// power output: y-axis
-						densityCorrectedWS,
 						powerCurveRPM;
-	double cutInSpeed;
 public:
 
 	std::vector<double> getPowerCurveWS(){ return powerCurveWS; }
@@ -96,6 +101,7 @@ public:
 		}
 		return false;
 	}
+	/// Does not modify the turbine, so the wake models can call it from several threads at once
 	void turbinePower(double windVelocity, double airDensity, double *turbineOutput, double *thrustCoefficient);
 	double calculateEff(double reducedPower, double originalPower) {
 		double Eff = 0.0;
@@ -107,6 +113,57 @@ public:
 	}
 };
 
+/**
+ * Spatial index over the turbines of a wake calculation, which are sorted by downwind distance. The turbines are
+ * binned into crosswind strips so a wake model only visits the upwind turbines whose wakes can reach a given turbine,
+ * instead of every upwind turbine.
+ */
+
+class wakeNeighborIndex
+{
+private:
+	double stripWidth, crosswindMin;
+	std::vector<std::vector<size_t>> strips;	// turbine indices in each crosswind strip, in downwind order
+public:
+	wakeNeighborIndex() : stripWidth(1.0), crosswindMin(0.0) {}
+	void build(size_t nTurbines, const double distanceCrosswind[], double width);
+
+	/// Turbines upwind of turbine i (lower index) within halfWidth crosswind and maxDownwind downwind of it, in index order
+	void upwindNeighbors(size_t i, const double distanceDownwind[], const double distanceCrosswind[],
+		double halfWidth, double maxDownwind, std::vector<size_t> &neighbors) const;
+};
+
+/**
+ * Runs the per-turbine part of a wake calculation in downwind order on the threads of a pool kept by the wake model.
+ * Turbines are handed out in index order and a turbine waits for each upwind turbine with upwindReady() before reading
+ * its results, so the results do not depend on the number of threads.
+ */
+
+class wakeTurbinePass
+{
+private:
+	size_t nTurbines;
+	sp_thread_pool *pool;
+	std::unique_ptr<std::atomic<char>[]> done;
+	std::atomic<bool> failed;
+	std::mutex readyLock;
+	std::condition_variable ready;		// notified when a turbine is calculated or the pass fails
+
+	void finish(size_t i, bool ok);
+public:
+	static const size_t MIN_PARALLEL_TURBINES = 200;	// farms smaller than this run on the calling thread unless a thread count is set
+
+	/// A pool of zero or with one thread runs on the calling thread
+	wakeTurbinePass(size_t nTurbines, sp_thread_pool *pool);
+	int threads();
+
+	/// Calls calc(i, thread) for turbines first..nTurbines-1, turbines before 'first' are already calculated. Returns false if any call fails
+	bool run(size_t first, const std::function<bool(size_t, int)> &calc);
+
+	/// Waits until turbine j has been calculated, returns false if the pass was stopped by a failure
+	bool upwindReady(size_t j);
+};
+
 /**
  * Wake models are used to calculate the wind velocity deficit at a turbine and the following changes to power, efficient, thrust and
  * turbulence intensity. The class requires an turbine with initialized values to run. Error messages can be propagated via errDetails.
@@ -117,8 +174,13 @@ class wakeModelBase
 protected:
 	size_t nTurbines;
 	windTurbine* wTurbine;
+	int nThreads = 0;
+	std::shared_ptr<sp_thread_pool> pool;		// kept between time steps, started on the first wake pass
+	sp_thread_pool *turbinePool();
 public:
 	wakeModelBase(){}
+	/// Threads for the per-timestep wake pass, zero or less picks automatically based on farm size
+	void setThreadCount(int n){ nThreads = n; }
 	virtual ~wakeModelBase() {};
 	virtual std::string getModelName(){ return ""; };
 	std::string errDetails;
@@ -203,7 +265,7 @@ private:
 	double rotorDiameter, turbulenceCoeff;
 	double axialResolution, minThrustCoeff, nBlades;
 	double minDeficit;
-	int MIN_DIAM_EV, EV_SCALE, MAX_WIND_TURBINES;
+	int MIN_DIAM_EV, EV_SCALE;
 	bool useFilterFx;
 	// EV wake matrices: each turbine is row, each col is wake data for that turbine at dist
 	util::matrix_t<double> matEVWakeDeficits;	// wind velocity deficit behind each turbine, indexed by axial distance downwind
@@ -263,7 +325,6 @@ public:
 		minDeficit = 0.0002;
 		MIN_DIAM_EV = 2;
 		EV_SCALE = 1;
-		MAX_WIND_TURBINES = 300;
 		axialResolution = 0.5; // in rotor diameters, default in openWind=0.5
 		//double radialResolution = 0.2; // in rotor diameters, default in openWind=0.2
 		double maxRotorDiameters = 50; // in rotor diameters, default in openWind=50
@@ -50,6 +50,7 @@
 #include "lib_windwatts.h"
 #include "lib_physics.h"
 
+#include <algorithm>
 #include <iostream>
 #include <math.h>
 #include "lib_util.h"
@@ -144,22 +145,27 @@ int windPowerCalculator::windPowerUsingResource(/*INPUTS */ double windSpeed, do
 	/*OUTPUTS*/ double *farmPower, double power[], double thrust[], double eff[], double adWindSpeed[], double TI[],
 	double distanceDownwind[], double distanceCrosswind[])
 {
-	if ((nTurbines > MAX_WIND_TURBINES) || (nTurbines < 1))
+	// convert barometric pressure in ATM to air density
+	double fAirDensity = (airPressureAtm * physics::Pa_PER_Atm) / (physics::R_GAS_DRY_AIR * physics::CelciusToKelvin(TdryC));   //!Air Density, kg/m^3
+
+	return windPowerUsingDensity(windSpeed, windDirDeg, fAirDensity, farmPower, power, thrust, eff, adWindSpeed, TI, distanceDownwind, distanceCrosswind);
+}
+
+int windPowerCalculator::windPowerUsingDensity(double windSpeed, double windDirDeg, double fAirDensity,
+	double *farmPower, double power[], double thrust[], double eff[], double adWindSpeed[], double TI[],
+	double distanceDownwind[], double distanceCrosswind[])
+{
+	if (nTurbines < 1)
 	{
-		errDetails = "The number of wind turbines was greater than the maximum allowed in the wake model.";
+		errDetails = "The number of wind turbines was zero.";
 		return 0;
 	}
 
 	size_t i, j;
-	//unsigned char wt_id[MAX_WIND_TURBINES], wid; // unsigned char has 256 limit
-	size_t wt_id[MAX_WIND_TURBINES], wid;
-
+	std::vector<size_t> wt_id(nTurbines);
 	for (i = 0; i<nTurbines; i++)
 		wt_id[i] = i;
 
-	// convert barometric pressure in ATM to air density
-	double fAirDensity = (airPressureAtm * physics::Pa_PER_Atm) / (physics::R_GAS_DRY_AIR * physics::CelciusToKelvin(TdryC));   //!Air Density, kg/m^3
-
 	// calculate output power of a turbine
 	double fTurbine_output(0.0), fThrust_coeff(0.0);
 	windTurb->turbinePower(windSpeed, fAirDensity, &fTurbine_output, &fThrust_coeff);
@@ -232,26 +238,16 @@ int windPowerCalculator::windPowerUsingResource(/*INPUTS */ double windSpeed, do
 	eff[0] = (fTurbine_output < 1.0) ? 0.0 : 100.0;
 
 
-	// Sort aDistanceDownwind, aDistanceCrosswind arrays by downwind distance, aDistanceDownwind[0] is smallest downwind distance, presumably zero
-	for (j = 1; j<nTurbines; j++)
-	{
-		d = distanceDownwind[j]; // pick out each element
-		c = distanceCrosswind[j];
-		wid = wt_id[j];
-
-		i = j;
-		while (i > 0 && distanceDownwind[i - 1] > d) // look for place to insert item
-		{
-			distanceDownwind[i] = distanceDownwind[i - 1];
-			distanceCrosswind[i] = distanceCrosswind[i - 1];
-			wt_id[i] = wt_id[i - 1];
-			i--;
-		}
-
-		distanceDownwind[i] = d; // insert it
-		distanceCrosswind[i] = c;
-		wt_id[i] = wid;
-	}
+	// Sort aDistanceDownwind, aDistanceCrosswind arrays by downwind distance, aDistanceDownwind[0] is smallest downwind distance, presumably zero.
+	// The sort is stable, so turbines at the same downwind distance stay in turbine ID order
+	std::stable_sort(wt_id.begin(), wt_id.end(), [distanceDownwind](size_t a, size_t b) { return distanceDownwind[a] < distanceDownwind[b]; });
+	std::vector<double> sorted(nTurbines);
+	for (i = 0; i < nTurbines; i++)
+		sorted[i] = distanceDownwind[wt_id[i]];
+	std::copy(sorted.begin(), sorted.end(), distanceDownwind);
+	for (i = 0; i < nTurbines; i++)
+		sorted[i] = distanceCrosswind[wt_id[i]];
+	std::copy(sorted.begin(), sorted.end(), distanceCrosswind);
 
 	// calculate the power output of downwind turbines using wake model
 	wakeModel->wakeCalculations(fAirDensity, &distanceDownwind[0], &distanceCrosswind[0], power, eff, thrust, adWindSpeed, TI);
@@ -265,51 +261,242 @@ int windPowerCalculator::windPowerUsingResource(/*INPUTS */ double windSpeed, do
 	for (i = 0; i<nTurbines; i++)
 		*farmPower += power[i];
 
-	// Update down/cross wind distance units for turbine zero (convert from radii to meters)
-	distanceDownwind[0] *= windTurb->rotorDiameter / 2;
-	distanceCrosswind[0] *= windTurb->rotorDiameter / 2;
+	// Convert down/cross wind distances back to meters from radii
+	for (i = 0; i < nTurbines; i++)
+	{
+		distanceDownwind[i] *= windTurb->rotorDiameter / 2;
+		distanceCrosswind[i] *= windTurb->rotorDiameter / 2;
+	}
 
 	// Re-sort output arrays by wind turbine ID (0..nwt-1)
 	// for consistent reporting
-	double p(0.0), t(0.0), e(0.0), w(0.0), b(0.0), dd(0.0), dc(0.0);
-	for (j = 1; j<nTurbines; j++)
+	double *outputs[] = { power, thrust, eff, adWindSpeed, TI, distanceDownwind, distanceCrosswind };
+	for (size_t k = 0; k < sizeof(outputs) / sizeof(outputs[0]); k++)
+	{
+		for (i = 0; i < nTurbines; i++)
+			sorted[wt_id[i]] = outputs[k][i];
+		std::copy(sorted.begin(), sorted.end(), outputs[k]);
+	}
+
+	return (int)nTurbines;
+}
+
+bool windPowerCalculator::buildWakeTable(double dirBinDeg, double speedBinMs, double densityMin, double densityMax, double densityBin)
+{
+	wakeTable.reset();
+	if (nTurbines < 2 || !wakeModel)
+		return false; // no wake losses to tabulate
+
+	if (dirBinDeg <= 0 || speedBinMs <= 0 || densityBin <= 0 || densityMin <= 0 || densityMax < densityMin)
 	{
-		p = power[j];// pick out each element
-		t = thrust[j];
-		e = eff[j];
-		w = adWindSpeed[j];
-		b = TI[j];
-		dd = distanceDownwind[j] * windTurb->rotorDiameter / 2; // convert back to meters from radii
-		dc = distanceCrosswind[j] * windTurb->rotorDiameter / 2;
-		wid = wt_id[j];
-
-		i = j;
-		while (i > 0 && wt_id[i - 1] > wid) // look for place to insert item
+		errDetails = "The wake table bin sizes and air density range must be positive.";
+		return false;
+	}
+
+	std::shared_ptr<windWakeTable> table(new windWakeTable());
+	table->nTurbines = nTurbines;
+
+	// direction bins evenly divide the circle and wrap around at 360 degrees
+	table->nDir = (size_t)ceil(360.0 / dirBinDeg - 1e-6);
+	table->dirBin = 360.0 / table->nDir;
+
+	table->densityMin = densityMin;
+	table->densityBin = densityBin;
+	table->nDensity = (size_t)ceil((densityMax - densityMin) / densityBin - 1e-6) + 1;
+
+	// density correction moves the power curve to higher wind speeds at low air density, so the lowest density sets the top of the speed axis
+	std::vector<double> pcWS = windTurb->getPowerCurveWS();
+	double speedMax = pcWS[pcWS.size() - 1] * pow(physics::AIR_DENSITY_SEA_LEVEL / densityMin, 1.0 / 3.0);
+	table->speedBin = speedBinMs;
+	table->nSpeed = (size_t)ceil(speedMax / speedBinMs) + 1;
+
+	size_t nDens = table->nDensity;
+	size_t nNodes = table->nDir * table->nSpeed * nDens;
+	std::vector<double> &farmEff = table->farmEff;
+	std::vector<float> &turbineEff = table->turbineEff;
+	farmEff.assign(nNodes, -1.0); // -1 marks nodes where the free stream turbine produces nothing
+	turbineEff.assign(nNodes * nTurbines, 0.0f);
+
+	std::vector<double> power(nTurbines), thrust(nTurbines), eff(nTurbines), windSpeed(nTurbines),
+		TI(nTurbines), distDown(nTurbines), distCross(nTurbines);
+	for (size_t d = 0; d < table->nDir; d++)
+	{
+		double dir = d * table->dirBin;
+		for (size_t s = 0; s < table->nSpeed; s++)
 		{
-			power[i] = power[i - 1];
-			thrust[i] = thrust[i - 1];
-			eff[i] = eff[i - 1];
-			adWindSpeed[i] = adWindSpeed[i - 1];
-			TI[i] = TI[i - 1];
-			distanceDownwind[i] = distanceDownwind[i - 1];
-			distanceCrosswind[i] = distanceCrosswind[i - 1];
-			wt_id[i] = wt_id[i - 1];
-			i--;
+			double speed = s * table->speedBin;
+			for (size_t r = 0; r < nDens; r++)
+			{
+				double rho = densityMin + r * densityBin;
+				double freeStream(0.0), thrustCoeff(0.0);
+				windTurb->turbinePower(speed, rho, &freeStream, &thrustCoeff);
+				if (windTurb->errDetails.length() > 0){
+					errDetails = windTurb->errDetails;
+					return false;
+				}
+				if (freeStream <= 0.0)
+					continue;
+
+				double farmPower(0.0);
+				if ((int)nTurbines != windPowerUsingDensity(speed, dir, rho, &farmPower, &power[0], &thrust[0], &eff[0],
+					&windSpeed[0], &TI[0], &distDown[0], &distCross[0]))
+					return false;
+
+				size_t node = (d * table->nSpeed + s) * nDens + r;
+				farmEff[node] = farmPower / (nTurbines * freeStream);
+				for (size_t i = 0; i < nTurbines; i++)
+					turbineEff[node * nTurbines + i] = (float)(power[i] / freeStream);
+			}
 		}
+	}
 
-		power[i] = p;
-		thrust[i] = t;
-		eff[i] = e;
-		adWindSpeed[i] = w;
-		TI[i] = b;
-		distanceDownwind[i] = dd;
-		distanceCrosswind[i] = dc;
-		wt_id[i] = wid;
+	// below cut-in and above cut-out the efficiency is undefined: copy it from the closest speed with power,
+	// so interpolating next to those speeds does not blend in a zero
+	for (size_t d = 0; d < table->nDir; d++)
+	{
+		for (size_t r = 0; r < nDens; r++)
+		{
+			for (size_t s = 0; s < table->nSpeed; s++)
+			{
+				size_t node = (d * table->nSpeed + s) * nDens + r;
+				if (farmEff[node] >= 0.0)
+					continue;
+
+				size_t source = node;
+				for (size_t k = 1; k < table->nSpeed && source == node; k++)
+				{
+					if (s + k < table->nSpeed && farmEff[node + k * nDens] >= 0.0)
+						source = node + k * nDens;
+					else if (s >= k && farmEff[node - k * nDens] >= 0.0)
+						source = node - k * nDens;
+				}
+
+				if (source == node)
+				{	// no power at any speed for this direction and density
+					farmEff[node] = 1.0;
+					for (size_t i = 0; i < nTurbines; i++)
+						turbineEff[node * nTurbines + i] = 1.0f;
+				}
+				else
+				{
+					farmEff[node] = farmEff[source];
+					for (size_t i = 0; i < nTurbines; i++)
+						turbineEff[node * nTurbines + i] = turbineEff[source * nTurbines + i];
+				}
+			}
+		}
 	}
 
-	return (int)nTurbines;
+	wakeTable = table;
+	return true;
+}
+
+/// Finds the lower grid index and the fractional distance to the next node along one axis of the wake table, clamping at the ends
+static void wake_table_axis(double x, double x0, double bin, size_t count, size_t *i0, size_t *i1, double *frac)
+{
+	double t = (x - x0) / bin;
+	if (count < 2 || t <= 0.0)
+	{
+		*i0 = *i1 = 0;
+		*frac = 0.0;
+	}
+	else if (t >= count - 1)
+	{
+		*i0 = *i1 = count - 1;
+		*frac = 0.0;
+	}
+	else
+	{
+		*i0 = (size_t)t;
+		*i1 = *i0 + 1;
+		*frac = t - *i0;
+	}
 }
 
+int windPowerCalculator::windPowerUsingWakeTable(double windSpeed, double windDirDeg, double airPressureAtm, double TdryC,
+	double *farmPower, double power[], double eff[])
+{
+	if (!wakeTable || wakeTable->nTurbines != nTurbines)
+	{
+		errDetails = "The wake efficiency table has not been built for this farm.";
+		return 0;
+	}
+	const windWakeTable &table = *wakeTable;
+
+	double fAirDensity = (airPressureAtm * physics::Pa_PER_Atm) / (physics::R_GAS_DRY_AIR * physics::CelciusToKelvin(TdryC));   //!Air Density, kg/m^3
+
+	// the free stream turbine is calculated exactly, only the wake losses are interpolated
+	double fTurbine_output(0.0), fThrust_coeff(0.0);
+	windTurb->turbinePower(windSpeed, fAirDensity, &fTurbine_output, &fThrust_coeff);
+	if (windTurb->errDetails.length() > 0){
+		errDetails = windTurb->errDetails;
+		return 0;
+	}
+
+	size_t i;
+	if (fTurbine_output <= 0.0)
+	{
+		*farmPower = 0.0;
+		for (i = 0; power && i < nTurbines; i++)
+			power[i] = 0.0;
+		for (i = 0; eff && i < nTurbines; i++)
+			eff[i] = 0.0;
+		return (int)nTurbines;
+	}
+
+	// direction wraps around, speed and density are clamped to the table
+	double dir = fmod(windDirDeg, 360.0);
+	if (dir < 0.0) dir += 360.0;
+	double fd = dir / table.dirBin;
+	size_t d0 = (size_t)fd;
+	fd -= d0;
+	d0 %= table.nDir;
+	size_t d1 = (d0 + 1) % table.nDir;
+
+	size_t s0, s1, r0, r1;
+	double fs, fr;
+	wake_table_axis(windSpeed, 0.0, table.speedBin, table.nSpeed, &s0, &s1, &fs);
+	wake_table_axis(fAirDensity, table.densityMin, table.densityBin, table.nDensity, &r0, &r1, &fr);
+
+	size_t nodes[8];
+	double weights[8];
+	int c = 0;
+	for (int a = 0; a < 2; a++)
+	{
+		size_t d = a ? d1 : d0;
+		double wd = a ? fd : 1.0 - fd;
+		for (int b = 0; b < 2; b++)
+		{
+			size_t s = b ? s1 : s0;
+			double ws = b ? fs : 1.0 - fs;
+			for (int k = 0; k < 2; k++)
+			{
+				nodes[c] = (d * table.nSpeed + s) * table.nDensity + (k ? r1 : r0);
+				weights[c] = wd * ws * (k ? fr : 1.0 - fr);
+				c++;
+			}
+		}
+	}
+
+	double farmEff = 0.0;
+	for (c = 0; c < 8; c++)
+		farmEff += weights[c] * table.farmEff[nodes[c]];
+	*farmPower = farmEff * nTurbines * fTurbine_output;
+
+	if (power || eff)
+	{
+		for (i = 0; i < nTurbines; i++)
+		{
+			double e = 0.0;
+			for (c = 0; c < 8; c++)
+				e += weights[c] * table.turbineEff[nodes[c] * nTurbines + i];
+			if (power) power[i] = e * fTurbine_output;
+			if (eff) eff[i] = 100.0 * e;
+		}
+	}
+
+	return (int)nTurbines;
+}
 
 double windPowerCalculator::windPowerUsingWeibull(double weibull_k, double avg_speed, double ref_height, double energy_turbine[])
 {	// returns same units as 'power_curve'
@@ -61,6 +61,19 @@ static inline double max_of(double a, double b)
 static inline double min_of(double a, double b)
 {	return (a < b) ? a : b; }
 
+/**
+ * Wake efficiency table: the ratio of each turbine's power to the free stream turbine power, tabulated on a
+ * (wind direction x wind speed x air density) grid for one farm layout. Node index is (dir * nSpeed + speed) * nDensity + density.
+ */
+
+struct windWakeTable
+{
+	double dirBin, speedBin, densityMin, densityBin;
+	size_t nDir, nSpeed, nDensity, nTurbines;
+	std::vector<double> farmEff;		// farm efficiency at each node, 0..1
+	std::vector<float> turbineEff;		// efficiency of each turbine at each node (nTurbines per node), 0..1
+};
+
 /**
  * Wind power calculator calculates the power output of a wind turbine farm. Requires an initialized windTurbine and wakeModel, as well as the following variables:
  * nTurbines, turbulenceIntensity, YCoords, XCoords. The windPowerUsingResource and windPowerUsingWeibull require allocated vectors for inputs and outputs.
@@ -76,6 +89,12 @@ private:
 	void coordtrans(double metersNorth, double metersEast, double fWind_dir_degrees, double *fMetersDownWind, double *metersCrosswind);
 	double gammaln(double x);
 
+	/// Farm calculation shared by windPowerUsingResource and buildWakeTable, for a given air density (kg/m^3)
+	int windPowerUsingDensity(double windSpeed, double windDirDeg, double airDensity,
+		double *farmPower, double power[], double thrust[], double eff[], double adWindSpeed[], double TI[],
+		double distanceDownwind[], double distanceCrosswind[]);
+	std::shared_ptr<windWakeTable> wakeTable;
+
 public:
 	windTurbine* windTurb;
 	size_t nTurbines;
@@ -88,7 +107,6 @@ public:
 		errDetails="";
 	}
 	
-	static const int MAX_WIND_TURBINES = 300;	// Max turbines in the farm
 	static const int MIN_DIAM_EV = 2;			// Minimum number of rotor diameters between turbines for EV wake modeling to work
 	static const int EV_SCALE = 1;				// Uo or 1.0 depending on how you read Ainslie 1988
 
@@ -99,7 +117,6 @@ public:
 
 	std::vector<double> XCoords, YCoords;
 
-	size_t GetMaxTurbines() {return MAX_WIND_TURBINES;}
 	bool InitializeModel(std::shared_ptr<wakeModelBase>selectedWakeModel);
 	std::string GetWakeModelName();
 	std::string GetErrorDetails() { return errDetails; }
@@ -122,6 +139,26 @@ public:
 			double distCross[] // distance cross wind
 		);
 
+	/// Precompute farm and per-turbine wake efficiency for the current layout on a wind direction x wind speed x air density grid
+	bool buildWakeTable(double dirBinDeg, double speedBinMs, double densityMin, double densityMax, double densityBin);
+	bool hasWakeTable() { return wakeTable != nullptr; }
+	std::shared_ptr<windWakeTable> getWakeTable() { return wakeTable; }
+	void setWakeTable(std::shared_ptr<windWakeTable> table) { wakeTable = table; }
+
+	/// Same as windPowerUsingResource, but interpolates wake losses from the table built by buildWakeTable()
+	int windPowerUsingWakeTable(
+		// INPUTS
+			double windSpeed,    // wind velocity m/s
+			double windDirDeg,  // wind direction 0-360, 0=N
+			double BarPAtm,  // barometric pressure (Atm)
+			double TdryC,    // dry bulb temp ('C)
+
+		// OUTPUTS
+			double *farmPwer,    // total farm power output
+			double power[],  // calculated power of each WT, may be null
+			double eff[]     // downwind efficiency of each WT, may be null
+		);
+
 	double windPowerUsingWeibull(
 		double weibull_k, 
 		double avg_speed, 
@@ -497,6 +497,7 @@ AutoPilot::AutoPilot()
 	_detail_callback_data = 0;
 	_summary_siminfo = 0;
 	_detail_siminfo = 0;
+	_n_sim_threads = 0;
     _opt = new sp_optimize();
 }
 
@@ -579,6 +580,17 @@ void AutoPilot::SetExternalSFObject( SolarField *SF )
 	_is_solarfield_external = true;
 }
 
+void AutoPilot::SetSimulationThreadCount(int n_threads)
+{
+	/* 
+	Set the number of threads used for the per-heliostat efficiency and flux calculations within 
+	each simulation. A value of 0 or less uses all available hardware threads.
+	*/
+	_n_sim_threads = n_threads;
+	if( _SF != 0 )
+		_SF->setSimulationThreadCount(n_threads);
+}
+
 bool AutoPilot::Setup(var_map &V, bool /*for_optimize*/)
 {
 
@@ -635,6 +647,7 @@ bool AutoPilot::Setup(var_map &V, bool /*for_optimize*/)
 	
 	//Create the solar field object
 	_SF->Create(V);
+	_SF->setSimulationThreadCount(_n_sim_threads);
 
 	//if a layout is provided in the sp_layout structure, go ahead and create the geometry here.
     if( ! V.sf.layout_data.val.empty() )
@@ -2308,6 +2321,7 @@ bool AutoPilot_MT::CreateLayout(sp_layout &layout, bool do_post_process)
 				SFarr = new SolarField*[nthreads];
 				for(int i=0; i<nthreads; i++){
 					SFarr[i] = new SolarField(*_SF);
+					SFarr[i]->setSimulationThreadCount(1);	//the simulations are already divided among threads
 				}
 			
 				//Create sufficient results arrays in memory
@@ -2529,6 +2543,7 @@ bool AutoPilot_MT::CalculateOpticalEfficiencyTable(sp_optical_table &opttab)
 	SFarr = new SolarField*[_n_threads];
 	for(int i=0; i<_n_threads; i++){
 		SFarr[i] = new SolarField(*_SF);
+		SFarr[i]->setSimulationThreadCount(1);	//the simulations are already divided among threads
 	}
 
 	//Create sufficient results arrays in memory
@@ -2699,6 +2714,7 @@ bool AutoPilot_MT::CalculateFluxMaps(sp_flux_table &fluxtab, int flux_res_x, int
 	SFarr = new SolarField*[_n_threads];
 	for(int i=0; i<_n_threads; i++){
 		SFarr[i] = new SolarField(*_SF);
+		SFarr[i]->setSimulationThreadCount(1);	//the simulations are already divided among threads
 	}
 
 	//Create sufficient results arrays in memory
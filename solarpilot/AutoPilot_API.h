@@ -96,6 +96,8 @@ protected:
 
     sp_optimize *_opt;
 
+	int _n_sim_threads;	//number of threads used for per-heliostat calculations within a simulation (0 = all available)
+
 	std::vector<double> interpolate_vectors( std::vector<double> &A, std::vector<double> &B, double alpha);
 
 
@@ -121,6 +123,7 @@ public:
 	//setup
 	void PreSimCallbackUpdate();
 	void SetExternalSFObject(SolarField *SF);
+	void SetSimulationThreadCount(int n_threads);
 	bool Setup(var_map &V, bool for_optimize = false);
 	//generate weather data
 	void GenerateDesignPointSimulations(var_map &V, std::vector<std::string> &hourly_weather_data);
@@ -55,6 +55,7 @@
 #include "Receiver.h"
 #include "SolarField.h"
 #include "Land.h"
+#include "../shared/lib_parallel.h"
 //#include <vector>
 #include <iostream>
 #include <algorithm>
@@ -2163,7 +2164,7 @@ void Flux::hermiteIntegral(double G[5], double F[5], double X[2], double A[2], d
 #endif
 }
 
-void Flux::fluxDensity(simulation_info *siminfo, FluxSurface &flux_surface, Hvector &helios, bool clear_grid, bool norm_grid, bool show_progress){
+void Flux::fluxDensity(simulation_info *siminfo, FluxSurface &flux_surface, Hvector &helios, bool clear_grid, bool norm_grid, bool show_progress, int n_threads){
 	/* 
 	Take a set of points defining the flux plane within the flux_surface object, a solar field geometry, 
 	and calculate the flux intensity at each point. Fills and returns these values into the FluxSurface
@@ -2222,45 +2223,76 @@ void Flux::fluxDensity(simulation_info *siminfo, FluxSurface &flux_surface, Hvec
 	sp_point *offset = flux_surface.getSurfaceOffset();
 	
 	int nh = (int)helios.size();
-	if(show_progress){
-		siminfo->setTotalSimulationCount(nh);
-	}
-	//Loop through each heliostat
-	int update_every = max(nh/20,1);
+	
+	//Collect the image properties of each enabled heliostat. These do not depend on the flux point.
+	struct helio_image
+	{
+		Heliostat *H;
+		sp_point *aim;	//heliostat aim point
+		Vect tvr;		//reversed heliostat-to-receiver vector
+		double sigx, sigy;	//image error std dev's, normalized by the tower height
+		double tht;		//optical height of the receiver that the heliostat is aiming at
+		double cnorm;	//normalizing constant
+		double azpt, zenpt;	//image plane rotation angles
+	};
+	vector<helio_image> images;
+	images.reserve(nh);
 
 	for(int i=0; i<nh; i++){
-		if(show_progress && i % update_every == 0)
-			siminfo->setCurrentSimulation(i+1);
-		
         if(! helios.at(i)->IsEnabled() )
             continue;
 
+		helio_image im;
+		im.H = helios.at(i);
+		
 		//Get the image error std dev's
-		double sigx, sigy;	
-		helios.at(i)->getImageSize(sigx, sigy);	//Image size is normalized by the tower height
+		im.H->getImageSize(im.sigx, im.sigy);	//Image size is normalized by the tower height
 		
 		//Get the heliostat aim point
-		sp_point *aim = helios.at(i)->getAimPoint();
+		im.aim = im.H->getAimPoint();
 		//Get the height of the receiver that the heliostat is aiming at
-		double tht = helios.at(i)->getWhichReceiver()->getVarMap()->optical_height.Val();
+		im.tht = im.H->getWhichReceiver()->getVarMap()->optical_height.Val();
 
 		//Calculate the normalizing constant. This is equal to the normalized power delivered by the heliostat to the
 		//reciever divided by the tower height squared. (the tht^2 term falls out of the normalizing procedure
 		//that we previously used in defining the Hermite moments). See DELSOL 7634.
-		double cnorm = helios.at(i)->getArea() * helios.at(i)->getEfficiencyTotal()/(tht*tht);
-		//Loop through each flux point
-		//Rows
-		for(int j=0; j<nfx; j++){
-			//Cols
-			for(int k=0; k<nfy; k++){
-				//Get the flux point
-				FluxPoint *pt = &grid->at(j).at(k);
-				//Calculate the dot product between the flux point normal and the helio->tower vector
-				Vect *tv = helios.at(i)->getTowerVector();
-				Vect tvr;
-				tvr.Set( -tv->i, -tv->j, -tv->k );	//Reverse
-
-				double f_dot_t = Toolbox::dotprod(pt->normal, tvr);	
+		im.cnorm = im.H->getArea() * im.H->getEfficiencyTotal()/(im.tht*im.tht);
+
+		//The reversed helio->tower vector is dotted with each flux point normal below
+		Vect *tv = im.H->getTowerVector();
+		im.tvr.Set( -tv->i, -tv->j, -tv->k );	//Reverse
+
+		//Angles expressing image plane coordinates
+        im.azpt = atan2(im.tvr.i, im.tvr.j);
+        im.zenpt = acos(im.tvr.k);
+
+		images.push_back(im);
+	}
+	int nim = (int)images.size();
+
+	if(show_progress){
+		siminfo->setTotalSimulationCount(nfx);
+	}
+
+	/* 
+	Each flux point sums the contribution of the heliostats in field order, so the rows of the grid can be 
+	evaluated on separate threads and the result is identical regardless of the thread count. Progress is 
+	only reported by the calling thread.
+	*/
+	std::atomic<int> rows_done(0);
+
+	sp_parallel_for(nfx, n_threads, 1, [&](int j, int worker)
+	{
+		//Cols
+		for(int k=0; k<nfy; k++){
+			//Get the flux point
+			FluxPoint *pt = &grid->at(j).at(k);
+
+			//Loop through each heliostat
+			for(int i=0; i<nim; i++){
+				helio_image &im = images[i];
+
+				double f_dot_t = Toolbox::dotprod(pt->normal, im.tvr);	
 				//If the dot product is negative, the point is not in view of the heliostat, so continue.
 				if(f_dot_t < 0.) continue;
 				if(f_dot_t>1.){
@@ -2268,42 +2300,40 @@ void Flux::fluxDensity(simulation_info *siminfo, FluxSurface &flux_surface, Hvec
 				}
 				//Translate the flux point location into global coordinates
 				sp_point pt_g;
-				pt_g.Set(pt->location.x + offset->x, pt->location.y + offset->y, pt->location.z + tht); //tht include z offset
+				pt_g.Set(pt->location.x + offset->x, pt->location.y + offset->y, pt->location.z + im.tht); //tht include z offset
 
 				//Project the current flux point into the image plane as defined by the 
 				//aim point and the heliostat-to-receiver vector.
 				sp_point pt_ip;
-				Toolbox::plane_intersect(*aim, tvr, pt_g, tvr, pt_ip); 
+				Toolbox::plane_intersect(*im.aim, im.tvr, pt_g, im.tvr, pt_ip); 
 				
 				//Now the point pt_ip indicates in global coordinates the projection of the flux point onto the image plane.
 				
 				//Translate the flux point into coordinates relative to the aim point
-				pt_ip.Subtract( *aim );
+				pt_ip.Subtract( *im.aim );
 				
 				//Express this point in image plane coordinates
-                double azpt = atan2(tvr.i, tvr.j);
-                double zenpt = acos(tvr.k);
-
-				Toolbox::rotation(pi-azpt, 2, pt_ip);
-				Toolbox::rotation(zenpt, 0, pt_ip);
+				Toolbox::rotation(pi-im.azpt, 2, pt_ip);
+				Toolbox::rotation(im.zenpt, 0, pt_ip);
 
 				//This rotation now expresses pt_ip in x,y coordinates of the image plane.
 
 				//Normalize the x,y coordinates with respect to the image error size
 				double
-					xn = -pt_ip.x/tht / sigx,       //with delsol formulation, image is flipped in x direction. Not sure why.
-					yn = pt_ip.y/tht / sigy;
+					xn = -pt_ip.x/im.tht / im.sigx,       //with delsol formulation, image is flipped in x direction. Not sure why.
+					yn = pt_ip.y/im.tht / im.sigy;
 				
 				//Calculate the flux
-                double hfe = hermiteFluxEval(helios.at(i), xn, yn) * exp( -0.5 *( xn*xn + yn*yn) );
-                //if( hfe != hfe )
-                //{
-                //    double xxxxx = 0.;
-                //}
-				pt->flux += f_dot_t * hfe * cnorm;
+                double hfe = hermiteFluxEval(im.H, xn, yn) * exp( -0.5 *( xn*xn + yn*yn) );
+				pt->flux += f_dot_t * hfe * im.cnorm;
 			}
 		}
-	}
+
+		int ndone = ++rows_done;
+		if(show_progress && worker == 0)
+			siminfo->setCurrentSimulation(ndone);
+	});
+
 	if(show_progress){
 		siminfo->Reset();
 		siminfo->setCurrentSimulation(0);
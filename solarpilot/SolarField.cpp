@@ -55,6 +55,7 @@
 #include "SolarField.h"
 
 #include "sort_method.h"
+#include "../shared/lib_parallel.h"
 #include "Heliostat.h"
 #include "Receiver.h"
 #include "Financial.h"
@@ -98,6 +99,7 @@ var_map *SolarField::getVarMap(){return _var_map;}
 bool SolarField::getAimpointStatus(){return _is_aimpoints_updated;}
 double SolarField::getSimulatedPowerToReceiver(){return _sim_p_to_rec;}
 double *SolarField::getHeliostatExtents(){return _helio_extents;}
+int SolarField::getSimulationThreadCount(){return _n_threads;}
 	
 simulation_info *SolarField::getSimInfoObject(){return &_sim_info;}
 simulation_error *SolarField::getSimErrorObject(){return &_sim_error;}
@@ -116,6 +118,7 @@ void SolarField::setHeliostatExtents(double xmax, double xmin, double ymax, doub
 	_helio_extents[2] = ymax;
 	_helio_extents[3] = ymin;
 };
+void SolarField::setSimulationThreadCount(int n_threads){_n_threads = n_threads;}
 	
 //Scripts
 bool SolarField::ErrCheck(){return _sim_error.checkForErrors();}
@@ -136,6 +139,7 @@ SolarField::SolarField(){
     _var_map = 0;
 	_is_created = false;	//The Create() method hasn't been called yet.
 	_estimated_annual_power = 0.;
+	_n_threads = 0;
 };		
 
 SolarField::~SolarField(){ 
@@ -156,6 +160,7 @@ SolarField::SolarField( const SolarField &sf )
 	_is_aimpoints_updated( sf._is_aimpoints_updated ),
 	_cancel_flag( sf._cancel_flag ),
 	_is_created( sf._is_created ),
+	_n_threads( sf._n_threads ),
 	_layout( sf._layout ),
 	_helio_objects( sf._helio_objects ),	//This contains the heliostat objects. The heliostat constructor will handle all internal pointer copy operations
 	_helio_template_objects( sf._helio_template_objects ),	//This contains the heliostat template objects.
@@ -3068,13 +3073,13 @@ void SolarField::Simulate(double azimuth, double zenith, sim_params &P)
 		//The intercept factor is the most time consuming calculation. Simulate just a single heliostat in the 
 		//neighboring group and apply it to all the rest.
 		
-		for(int i=0; i<(int)_layout_groups.size(); i++){
-			
+		sp_parallel_for((int)_layout_groups.size(), _n_threads, 8, [&](int i, int)
+        {
 			Hvector *hg = &_layout_groups.at(i);
 
 			int ngroup = (int)hg->size();
 
-			if(ngroup == 0) continue;
+			if(ngroup == 0) return;
 
 			Heliostat *helios = hg->front(); // just use the first one
 			double eta_int = _flux->imagePlaneIntercept(*_var_map, *helios, helios->getWhichReceiver(), &Sun);
@@ -3085,14 +3090,15 @@ void SolarField::Simulate(double azimuth, double zenith, sim_params &P)
 				hg->at(k)->setEfficiencyIntercept( eta_int );
 				hg->at(k)->CopyImageData( helios );
 			}
-
-			
-		}
+		});
 	}
 	
-	//Simulate efficiency for all heliostats
-	for(int i=0; i<nh; i++)
+	//Simulate efficiency for all heliostats. Each heliostat only updates its own efficiency and image data, so the 
+	//heliostats can be divided among threads without changing the result.
+	sp_parallel_for(nh, _n_threads, 64, [&](int i, int)
+    {
 		SimulateHeliostatEfficiency(this, Sun, _heliostats.at(i), P); 
+	});
 	
 	
 
@@ -3558,13 +3564,16 @@ void SolarField::calcAllAimPoints(Vect &Sun, sim_params &P) //bool force_simple,
         //update images
         //RefactorHeliostatImages(Sun);
 
-		//Create a list of heliostats sorted by their Y image size
+		//update heliostat efficiency and optical coefficients
 		int nh = (int)_heliostats.size();
-		for(int i=0; i<nh; i++)
+		sp_parallel_for(nh, _n_threads, 64, [&](int i, int)
         {
-            //update heliostat efficiency and optical coefficients
             SimulateHeliostatEfficiency(this, Sun, _heliostats.at(i), P);
+		});
 
+		//Create a list of heliostats sorted by their Y image size
+		for(int i=0; i<nh; i++)
+        {
             hsort.push_back(_heliostats.at(i));
 			ysize.push_back(_heliostats.at(i)->getImageSize()[1]);
 		}
@@ -3875,7 +3884,7 @@ void SolarField::AnalyticalFluxSimulation(Hvector &helios)
 		if(! _receivers.at(n)->isReceiverEnabled() ) continue;
 		FluxSurfaces *surfaces = _receivers.at(n)->getFluxSurfaces();
 		for(unsigned int i=0; i<surfaces->size(); i++){
-			_flux->fluxDensity(&_sim_info, surfaces->at(i), helios, true, true, true);		
+			_flux->fluxDensity(&_sim_info, surfaces->at(i), helios, true, true, true, _n_threads);		
 		}
 	}
 
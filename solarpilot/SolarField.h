@@ -138,6 +138,7 @@ protected:
 		_cancel_flag,	//Flag indicating the current simulation should be cancelled
 		_is_created;	//Has the solar field Create() method been called?
 
+	int _n_threads;	//Number of threads used for per-heliostat calculations. 0 uses all available threads.
 
 	double _helio_extents[4];	//Extents of the heliostat field [xmax, xmin, ymax, ymin]
 	layout_shell _layout;	//All of the layouts associated with this solar field
@@ -227,6 +228,8 @@ public:
 	void setAimpointStatus(bool state);
 	void setSimulatedPowerToReceiver(double val);
 	void setHeliostatExtents(double xmax, double xmin, double ymax, double ymin);
+	void setSimulationThreadCount(int n_threads);
+	int getSimulationThreadCount();
 	
 	//Scripts
 	void Create(var_map &V);
@@ -195,89 +195,62 @@ public:
 		ssc_number_t *p_sunrise = allocate("sunrise", count);
 		ssc_number_t *p_sunset = allocate("sunset", count);
 		
-		for (size_t i = 0; i < count ;i ++ )
+		// copy the time and irradiance columns into contiguous arrays for the irradiance processor
+		std::vector<int> t_year(count), t_month(count), t_day(count), t_hour(count);
+		std::vector<double> t_minute(count), t_glob(count, 0.0), t_beam(count, 0.0), t_diff(count, 0.0), t_alb(count);
+		for (size_t i = 0; i < count; i++)
 		{
-			double t_cur = hour[i] + minute[i]/60.0;
-			double delt = 1.0;
-			if ( i == 0 )
-			{
-				double t_next = hour[i+1] + minute[i+1]/60.0;
-				if (t_cur > t_next) t_next += 24;
-				delt = t_next - t_cur;
-			}
-			else
-			{
-				double t_prev = hour[i-1] + minute[i-1]/60.0;
-				if (t_cur < t_prev) t_cur += 24;
-				delt = t_cur - t_prev;
-			}
-
-			// double precsion issue (15 digits IEEE 754) encountered by Anthony Lopez 4/29/13 for 
-			// minutes other than 15,30,45 and 60
-			if (fabs(delt-1.0)<1e-14) delt=1.0;
-
-			double alb = alb_const;
+			t_year[i] = (int)year[i];
+			t_month[i] = (int)month[i];
+			t_day[i] = (int)day[i];
+			t_hour[i] = (int)hour[i];
+			t_minute[i] = minute[i];
+			if (glob != 0) t_glob[i] = glob[i];
+			if (beam != 0) t_beam[i] = beam[i];
+			if (diff != 0) t_diff[i] = diff[i];
+
+			t_alb[i] = alb_const;
 			// if we have array of albedo values, use it
 			if ( albvec != 0  && albvec[i] >= 0 && albvec[i] <= (ssc_number_t)1.0)
-				alb = albvec[i];
+				t_alb[i] = albvec[i];
+		}
 
-			irrad x;
+		irrad_series x;
+		x.set_location( lat, lon, tz );
+		x.set_sky_model( sky_model );
+		x.set_surface( track_mode, tilt, azimuth, rotlim, en_backtrack, gcr );
+		x.calc_sun( count, &t_year[0], &t_month[0], &t_day[0], &t_hour[0], &t_minute[0], IRRADPROC_NO_INTERPOLATE_SUNRISE_SUNSET );
+		if ( irrad_mode == 1 ) x.calc_poa( irrad::DN_GH, &t_glob[0], &t_beam[0], 0, &t_alb[0] );
+		else if (irrad_mode == 2) x.calc_poa( irrad::GH_DF, &t_glob[0], 0, &t_diff[0], &t_alb[0] );
+		else x.calc_poa( irrad::DN_DF, 0, &t_beam[0], &t_diff[0], &t_alb[0] );
 
-			x.set_time( (int)year[i], (int)month[i], (int)day[i], (int)hour[i], minute[i], IRRADPROC_NO_INTERPOLATE_SUNRISE_SUNSET );
-			x.set_location( lat, lon, tz );
-			x.set_sky_model( sky_model, alb );
-			if ( irrad_mode == 1 ) x.set_global_beam( glob[i], beam[i] );
-			else if (irrad_mode == 2) x.set_global_diffuse(glob[i], diff[i]);
-			else x.set_beam_diffuse( beam[i], diff[i] );
-			x.set_surface( track_mode, tilt, azimuth, rotlim, en_backtrack, gcr );
-			
-			int code = x.calc();
+		for (size_t i = 0; i < count ;i ++ )
+		{
+			int code = x.code[i];
 			if (code < 0)
 				throw general_error( util::format("irradiance processor issued error code %d", code ));
 
-			double solazi, solzen, solelv, soldec, sunrise, sunset;
-			int sunup;
-
-			x.get_sun( &solazi,
-				&solzen,
-				&solelv,
-				&soldec,
-				&sunrise,
-				&sunset,
-				&sunup,
-				0,
-				0,
-				0 );
-			
-			p_azm[i] = (ssc_number_t) solazi;
-			p_zen[i] = (ssc_number_t) solzen;
-			p_elv[i] = (ssc_number_t) solelv;
-			p_dec[i] = (ssc_number_t) soldec;	
-			p_sunrise[i] = (ssc_number_t) sunrise;
-			p_sunset[i] = (ssc_number_t) sunset;
-			p_sunup[i] = (ssc_number_t) sunup;
-			
-			
-			double aoi, stilt, sazi, rot, btd;
-			x.get_angles( &aoi, &stilt, &sazi, &rot, &btd );
+			p_azm[i] = (ssc_number_t) (x.sunAnglesRadians[0][i] * (180/M_PI));
+			p_zen[i] = (ssc_number_t) (x.sunAnglesRadians[1][i] * (180/M_PI));
+			p_elv[i] = (ssc_number_t) (x.sunAnglesRadians[2][i] * (180/M_PI));
+			p_dec[i] = (ssc_number_t) (x.sunAnglesRadians[3][i] * (180/M_PI));
+			p_sunrise[i] = (ssc_number_t) x.sunAnglesRadians[4][i];
+			p_sunset[i] = (ssc_number_t) x.sunAnglesRadians[5][i];
+			p_sunup[i] = (ssc_number_t) x.sunUp[i];
 
 			// assign outputs
-			p_inc[i] = (ssc_number_t) aoi;
-			p_surftilt[i] = (ssc_number_t) stilt;
-			p_surfazm[i] = (ssc_number_t) sazi;
-			p_rot[i] = (ssc_number_t) rot;
-			p_btdiff[i] = (ssc_number_t) btd;
-			
-			double beam, skydiff, gnddiff, iso, cir, hor;
-			x.get_poa( &beam, &skydiff, &gnddiff, &iso, &cir, &hor );
-
-			p_poa_beam[i] = (ssc_number_t) beam;
-			p_poa_skydiff[i] = (ssc_number_t) skydiff;
-			p_poa_gnddiff[i] = (ssc_number_t) gnddiff;
-			p_poa_skydiff_iso[i] = (ssc_number_t) iso;
-			p_poa_skydiff_cir[i] = (ssc_number_t) cir;
-			p_poa_skydiff_hor[i] = (ssc_number_t) hor;
-			
+			p_inc[i] = (ssc_number_t) (x.surfaceAnglesRadians[0][i] * (180/M_PI));
+			p_surftilt[i] = (ssc_number_t) (x.surfaceAnglesRadians[1][i] * (180/M_PI));
+			p_surfazm[i] = (ssc_number_t) (x.surfaceAnglesRadians[2][i] * (180/M_PI));
+			p_rot[i] = (ssc_number_t) (x.surfaceAnglesRadians[3][i] * (180/M_PI));
+			p_btdiff[i] = (ssc_number_t) (x.surfaceAnglesRadians[4][i] * (180/M_PI));
+
+			p_poa_beam[i] = (ssc_number_t) x.poaFront[0][i];
+			p_poa_skydiff[i] = (ssc_number_t) x.poaFront[1][i];
+			p_poa_gnddiff[i] = (ssc_number_t) x.poaFront[2][i];
+			p_poa_skydiff_iso[i] = (ssc_number_t) x.diffuseFront[0][i];
+			p_poa_skydiff_cir[i] = (ssc_number_t) x.diffuseFront[1][i];
+			p_poa_skydiff_hor[i] = (ssc_number_t) x.diffuseFront[2][i];
 		}
 	}
 };
@@ -49,6 +49,13 @@
 
 #include "cmod_pvsamv1.h"
 #include "lib_pv_io_manager.h"
+#include "lib_parallel.h"
+
+#include <algorithm>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_set>
 
 // comment following define if do not want shading database validation outputs
 //#define SHADE_DB_OUTPUTS
@@ -71,6 +78,7 @@ static var_info _cm_vtab_pvsamv1[] = {
 //	{ SSC_OUTPUT,       SSC_ARRAY,       "ac_degrade_factor",                           "Annual AC degrade factor",                             "",         "",                              "pvsamv1",             "system_use_lifetime_output=1",   "",                             "" },
 	{ SSC_INPUT,        SSC_NUMBER,      "en_dc_lifetime_losses",                       "Enable lifetime daily DC losses",                      "0/1",      "",                              "pvsamv1",             "?=0",                        "INTEGER,MIN=0,MAX=1",          "" },
 	{ SSC_INPUT,        SSC_ARRAY,       "dc_lifetime_losses",                          "Lifetime daily DC losses",                             "%",        "",                              "pvsamv1",             "en_dc_lifetime_losses=1",    "",                             "" },
+	{ SSC_INPUT,        SSC_NUMBER,      "en_lifetime_year1_reuse",                     "Reuse year 1 DC power in later lifetime years, not with the snow model", "0/1",      "",                              "pvsamv1",             "?=0",                        "INTEGER,MIN=0,MAX=1",          "" },
 	{ SSC_INPUT,        SSC_NUMBER,      "en_ac_lifetime_losses",                       "Enable lifetime daily AC losses",                      "0/1",      "",                              "pvsamv1",             "?=0",                        "INTEGER,MIN=0,MAX=1",          "" },
 	{ SSC_INPUT,        SSC_ARRAY,       "ac_lifetime_losses",                          "Lifetime daily AC losses",                             "%",        "",                              "pvsamv1",             "en_ac_lifetime_losses=1",    "",                             "" },
 
@@ -86,6 +94,8 @@ static var_info _cm_vtab_pvsamv1[] = {
 	{ SSC_INPUT,        SSC_NUMBER,      "inverter_count",                              "Number of inverters",                                   "",        "",                              "pvsamv1",              "*",                        "INTEGER,POSITIVE",              "" },
 
 	{ SSC_INPUT,        SSC_NUMBER,      "enable_mismatch_vmax_calc",                   "Enable mismatched subarray Vmax calculation",           "",        "",                              "pvsamv1",              "?=0",                      "BOOLEAN",                       "" },
+	{ SSC_INPUT,        SSC_NUMBER,      "n_threads",                                   "Number of threads for the subarray DC calculations, 0 = all hardware threads", "", "",             "pvsamv1",              "?=0",                      "INTEGER,MIN=0",                 "" },
+	{ SSC_INPUT,        SSC_NUMBER,      "en_dc_cache",                                 "Reuse subarray DC power from a previous run with the same weather, subarray and module inputs", "0/1", "", "pvsamv1",    "?=0",                      "BOOLEAN",                       "" },
 
 	{ SSC_INPUT,        SSC_NUMBER,      "subarray1_nstrings",                          "Sub-array 1 Number of parallel strings",                "",        "",                              "pvsamv1",              "",						 "INTEGER",                       "" },
 	{ SSC_INPUT,        SSC_NUMBER,      "subarray1_modules_per_string",                "Sub-array 1 Modules per string",                        "",        "",                              "pvsamv1",              "*",                        "INTEGER,POSITIVE",              "" },
@@ -929,6 +939,112 @@ static var_info _cm_vtab_pvsamv1[] = {
 
 var_info_invalid };
 
+// The subarray DC power before DC losses only depends on the weather, subarray, module and inverter voltage inputs, so with en_dc_cache
+// the results of the most recent runs are kept for later runs that only change losses, degradation, the inverter count or battery inputs.
+// Results are keyed by their inputs, and the least recently used one is dropped when the cache is full
+struct pvsamv1_dc_cache
+{
+	unsigned long long key;
+	std::vector<std::vector<double>> dcPowerSubarray;	// subarray DC power before DC losses [W]
+	std::vector<std::vector<double>> dcStringVoltage;	// [V]
+	std::vector<std::vector<ssc_number_t>> outputs;		// year 1 output arrays written by the DC calculation
+	double dcGross[4];									// [kWh]
+	double annualSnowLoss;								// [kWh]
+	double annualMpptVoltageClipping;					// [kWh]
+	int snowBadValues;
+	std::vector<compute_module::log_item> logs;
+};
+
+#define DC_CACHE_CAPACITY 4
+
+static std::mutex sg_dcCacheMutex;
+static std::list<std::shared_ptr<const pvsamv1_dc_cache>> sg_dcCache;	// most recently used first
+
+static std::shared_ptr<const pvsamv1_dc_cache> cached_dc(unsigned long long key)
+{
+	std::lock_guard<std::mutex> lock(sg_dcCacheMutex);
+	for (auto it = sg_dcCache.begin(); it != sg_dcCache.end(); it++)
+	{
+		if ((*it)->key == key)
+		{
+			sg_dcCache.splice(sg_dcCache.begin(), sg_dcCache, it);
+			return sg_dcCache.front();
+		}
+	}
+	return nullptr;
+}
+
+static void cache_dc(std::shared_ptr<const pvsamv1_dc_cache> dc)
+{
+	std::lock_guard<std::mutex> lock(sg_dcCacheMutex);
+	sg_dcCache.remove_if([&dc](const std::shared_ptr<const pvsamv1_dc_cache> &c) { return c->key == dc->key; });
+	sg_dcCache.push_front(dc);
+	if (sg_dcCache.size() > DC_CACHE_CAPACITY)
+		sg_dcCache.pop_back();
+}
+
+static void dc_cache_skip_inputs(std::unordered_set<std::string> &skip, var_info vi[])
+{
+	for (int i = 0; vi[i].data_type != SSC_INVALID && vi[i].name != NULL; i++)
+		skip.insert(vi[i].name);
+}
+
+/*
+Hash the inputs of the subarray DC calculation in their exact binary form. Inputs that are only applied to the subarray DC power
+afterwards (DC and AC losses, degradation, adjustment factors, inverter count, lifetime and battery inputs) are not part of the key.
+Neither is the weather file name, as the weather records are added to the key when they are read.
+*/
+static unsigned long long dc_cache_key(compute_module *cm)
+{
+	static const char *downstream[] = {
+		"solar_resource_file", "solar_resource_data",
+		"system_use_lifetime_output", "analysis_period", "en_lifetime_year1_reuse",
+		"dc_degradation", "ac_degradation", "en_dc_lifetime_losses", "dc_lifetime_losses", "en_ac_lifetime_losses", "ac_lifetime_losses",
+		"system_capacity", "inverter_count", "n_threads", "en_dc_cache",
+		"subarray1_mismatch_loss", "subarray1_diodeconn_loss", "subarray1_dcwiring_loss", "subarray1_tracking_loss", "subarray1_nameplate_loss",
+		"subarray2_mismatch_loss", "subarray2_diodeconn_loss", "subarray2_dcwiring_loss", "subarray2_tracking_loss", "subarray2_nameplate_loss",
+		"subarray3_mismatch_loss", "subarray3_diodeconn_loss", "subarray3_dcwiring_loss", "subarray3_tracking_loss", "subarray3_nameplate_loss",
+		"subarray4_mismatch_loss", "subarray4_diodeconn_loss", "subarray4_dcwiring_loss", "subarray4_tracking_loss", "subarray4_nameplate_loss",
+		"dcoptimizer_loss", "acwiring_loss", "transformer_loss", "transmission_loss", "transformer_no_load_loss", "transformer_load_loss",
+		"en_batt", "load",
+		0 };
+
+	std::unordered_set<std::string> skip;
+	for (int i = 0; downstream[i] != 0; i++)
+		skip.insert(downstream[i]);
+	dc_cache_skip_inputs(skip, vtab_adjustment_factors);
+	dc_cache_skip_inputs(skip, vtab_dc_adjustment_factors);
+	dc_cache_skip_inputs(skip, vtab_battery_inputs);
+
+	unsigned long long h = util::fnv1a_init;
+	for (int i = 0; var_info *vi = cm->info(i); i++)
+	{
+		if (vi->var_type == SSC_OUTPUT || skip.count(vi->name) > 0)
+			continue;
+
+		util::fnv1a_hash(h, vi->name, strlen(vi->name) + 1);
+
+		var_data *v = cm->lookup(vi->name);
+		if (!v)
+		{
+			unsigned char unassigned = SSC_INVALID;
+			util::fnv1a_hash(h, &unassigned, 1);
+			continue;
+		}
+		util::fnv1a_hash(h, &v->type, 1);
+		if (v->type == SSC_STRING)
+			util::fnv1a_hash(h, v->str.c_str(), v->str.length() + 1);
+		else
+		{
+			size_t dims[2] = { v->num.nrows(), v->num.ncols() };
+			util::fnv1a_hash(h, dims, sizeof(dims));
+			if (v->num.ncells() > 0)
+				util::fnv1a_hash(h, v->num.data(), v->num.ncells() * sizeof(ssc_number_t));
+		}
+	}
+	return h;
+}
+
 cm_pvsamv1::cm_pvsamv1()
 {
 	add_var_info( _cm_vtab_pvsamv1 );
@@ -995,8 +1111,8 @@ void cm_pvsamv1::exec( ) throw (compute_module::general_error)
 		nameplate_kw += Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings * module_watts_stc * util::watt_to_kilowatt;
 	}
 
-	// Warning workaround
-	static bool is32BitLifetime = (__ARCHBITS__ == 32 && system_use_lifetime_output);
+	// Warning workaround (not static, the value depends on this run's inputs)
+	bool is32BitLifetime = (__ARCHBITS__ == 32 && system_use_lifetime_output);
 	if (is32BitLifetime)
 		throw exec_error( "pvsamv1", "Lifetime simulation of PV systems is only available in the 64 bit version of SAM.");
 
@@ -1087,739 +1203,1229 @@ void cm_pvsamv1::exec( ) throw (compute_module::general_error)
 		std::vector<double> tmp;
 		dcStringVoltage.push_back(tmp);
 	}
-	for (size_t iyear = 0; iyear < nyears; iyear++)
+
+	// Year 1 reuse: weather, irradiance, shading, cell temperature and module power repeat every year of a lifetime simulation,
+	// so the subarray DC power from year 1 (before DC losses, degradation, and adjustments) is stored and replayed in later years.
+	// The snow model carries the snow cover from the end of one year into the next, so its later years are simulated
+	bool reuse_year1 = system_use_lifetime_output && Simulation->reuseYearOneDC && nyears > 1;
+	if (reuse_year1 && PVSystem->enableSnowModel)
 	{
-		for (hour = 0; hour < 8760; hour++)
+		log("Year 1 DC power is not reused in later years with the snow model, because the snow cover carries over from year to year.", SSC_NOTICE);
+		reuse_year1 = false;
+	}
+
+	// DC cache: the year 1 subarray DC power of a previous run with the same weather, subarray, module and inverter voltage inputs is replayed
+	// like year 1 reuse. Without year 1 reuse, later years of a lifetime simulation carry state such as the snow cover over from year 1
+	bool use_dc_cache = Simulation->useDCCache && (nyears == 1 || reuse_year1);
+
+	std::vector<std::vector<double>> year1DcPowerSubarray;
+	if (reuse_year1 || use_dc_cache)
+		year1DcPowerSubarray.resize(num_subarrays, std::vector<double>(nrec, 0.0));
+
+	unsigned long long dcCacheKey = 0;
+	if (use_dc_cache)
+	{
+		dcCacheKey = dc_cache_key(this);
+		double location[4] = { hdr.lat, hdr.lon, hdr.tz, hdr.elev };
+		util::fnv1a_hash(dcCacheKey, location, sizeof(location));
+	}
+
+	// The sun position is the same for every subarray and every year, so calculate it once for the weather file
+	irrad_series sunPosition;
+	{
+		std::vector<int> wf_year(nrec), wf_month(nrec), wf_day(nrec), wf_hour(nrec);
+		std::vector<double> wf_minute(nrec);
+		weather_record wr;
+		wdprov->rewind();
+		for (size_t i = 0; i < nrec; i++)
 		{
-			// report progress updates to the caller	
-			ireport++;
-			if (ireport - ireplast > irepfreq)
+			if (!wdprov->read(&wr))
+				throw exec_error("pvsamv1", "could not read data line " + util::to_string((int)(i + 1)) + " in weather file");
+			wf_year[i] = wr.year;
+			wf_month[i] = wr.month;
+			wf_day[i] = wr.day;
+			wf_hour[i] = wr.hour;
+			wf_minute[i] = wr.minute;
+
+			if (use_dc_cache)
 			{
-				percent_complete = percent_baseline + 100.0f *(float)(hour + iyear * 8760) / (float)(insteps);
-				if (!update("", percent_complete))
-					throw exec_error("pvsamv1", "simulation canceled at hour " + util::to_string(hour + 1.0) + " in year " + util::to_string((int)iyear + 1) + "in dc loop");
-				ireplast = ireport;
+				double record[19] = { (double)wr.year, (double)wr.month, (double)wr.day, (double)wr.hour, wr.minute, wr.gh, wr.dn, wr.df, wr.poa,
+					wr.wspd, wr.wdir, wr.tdry, wr.twet, wr.tdew, wr.rhum, wr.pres, wr.snow, wr.alb, wr.aod };
+				util::fnv1a_hash(dcCacheKey, record, sizeof(record));
 			}
+		}
+		wdprov->rewind();
 
-			// only hourly electric load, even
-			// if PV simulation is subhourly.  load is assumed constant over the hour.
-			// if no load profile supplied, load = 0
-			if (nload == 8760)
-				cur_load = p_load_in[hour];
+		sunPosition.set_location(hdr.lat, hdr.lon, hdr.tz);
+		sunPosition.calc_sun(nrec, &wf_year[0], &wf_month[0], &wf_day[0], &wf_hour[0], &wf_minute[0],
+			Irradiance->instantaneous ? IRRADPROC_NO_INTERPOLATE_SUNRISE_SUNSET : Irradiance->dtHour);
+	}
 
-			for (size_t jj = 0; jj < step_per_hour; jj++)
-			{
-				// Reset dcPower calculation for new timestep
-				dcPowerNetTotalSystem = 0; 
+	// Year 1 outputs of the DC calculation, which are kept with the subarray DC power in the DC cache
+	auto dc_cache_outputs = [&]()
+	{
+		std::vector<ssc_number_t *> outputs = { Irradiance->p_weatherFileGHI, Irradiance->p_weatherFileDNI, Irradiance->p_weatherFileDHI,
+			Irradiance->p_sunPositionTime, Irradiance->p_weatherFileWindSpeed, Irradiance->p_weatherFileAmbientTemp, Irradiance->p_weatherFileAlbedo,
+			Irradiance->p_weatherFileSnowDepth, Irradiance->p_IrradianceCalculated[0], Irradiance->p_IrradianceCalculated[1], Irradiance->p_IrradianceCalculated[2],
+			Irradiance->p_sunZenithAngle, Irradiance->p_sunAltitudeAngle, Irradiance->p_sunAzimuthAngle, Irradiance->p_absoluteAirmass, Irradiance->p_sunUpOverHorizon,
+			PVSystem->p_poaFrontNominalTotal, PVSystem->p_poaFrontBeamNominalTotal, PVSystem->p_poaFrontBeamTotal, PVSystem->p_poaFrontShadedTotal,
+			PVSystem->p_poaFrontShadedSoiledTotal, PVSystem->p_poaRearTotal, PVSystem->p_poaFrontTotal, PVSystem->p_poaTotalAllSubarrays,
+			PVSystem->p_snowLossTotal, PVSystem->p_inverterMPPTLoss };
+
+		std::vector<ssc_number_t *> *subarray_outputs[] = { &Irradiance->p_weatherFilePOA,
+			&PVSystem->p_angleOfIncidence, &PVSystem->p_angleOfIncidenceModifier, &PVSystem->p_surfaceTilt, &PVSystem->p_surfaceAzimuth,
+			&PVSystem->p_axisRotation, &PVSystem->p_idealRotation, &PVSystem->p_poaNominalFront, &PVSystem->p_poaShadedFront,
+			&PVSystem->p_poaShadedSoiledFront, &PVSystem->p_poaBeamFront, &PVSystem->p_poaDiffuseFront, &PVSystem->p_poaFront,
+			&PVSystem->p_poaTotal, &PVSystem->p_poaRear, &PVSystem->p_derateSoiling, &PVSystem->p_beamShadingFactor,
+			&PVSystem->p_temperatureCell, &PVSystem->p_moduleEfficiency, &PVSystem->p_dcStringVoltage, &PVSystem->p_voltageOpenCircuit,
+			&PVSystem->p_currentShortCircuit, &PVSystem->p_dcPowerGross, &PVSystem->p_derateLinear, &PVSystem->p_derateSelfShading,
+			&PVSystem->p_derateSelfShadingDiffuse, &PVSystem->p_derateSelfShadingReflected, &PVSystem->p_shadeDBShadeFraction,
+			&PVSystem->p_snowLoss, &PVSystem->p_snowCoverage, &PVSystem->p_shadeDB_GPOA, &PVSystem->p_shadeDB_DPOA,
+			&PVSystem->p_shadeDB_temperatureCell, &PVSystem->p_shadeDB_modulesPerString, &PVSystem->p_shadeDB_voltageMaxPowerSTC,
+			&PVSystem->p_shadeDB_voltageMPPTLow, &PVSystem->p_shadeDB_voltageMPPTHigh, &PVSystem->p_mpptVoltage };
+		for (size_t k = 0; k < sizeof(subarray_outputs) / sizeof(subarray_outputs[0]); k++)
+			outputs.insert(outputs.end(), subarray_outputs[k]->begin(), subarray_outputs[k]->end());
+
+		outputs.erase(std::remove(outputs.begin(), outputs.end(), (ssc_number_t *)0), outputs.end());
+		return outputs;
+	};
+
+	std::shared_ptr<const pvsamv1_dc_cache> dcCache;
+	if (use_dc_cache)
+		dcCache = cached_dc(dcCacheKey);
+	if (dcCache && dcCache->outputs.size() != dc_cache_outputs().size())
+		dcCache = nullptr;
+
+	if (dcCache)
+	{
+		std::vector<ssc_number_t *> outputs = dc_cache_outputs();
+		for (size_t k = 0; k < outputs.size(); k++)
+			std::copy(dcCache->outputs[k].begin(), dcCache->outputs[k].end(), outputs[k]);
+
+		year1DcPowerSubarray = dcCache->dcPowerSubarray;
+		dcStringVoltage = dcCache->dcStringVoltage;
+		for (size_t nn = 0; nn < 4; nn++)
+			dc_gross[nn] = dcCache->dcGross[nn];
+		annual_snow_loss = dcCache->annualSnowLoss;
+		annualMpptVoltageClipping = dcCache->annualMpptVoltageClipping;
+		Subarrays[0]->snowModel.badValues = dcCache->snowBadValues;
+
+		for (size_t i = 0; i < dcCache->logs.size(); i++)
+			log(dcCache->logs[i].text, dcCache->logs[i].type, dcCache->logs[i].time);
+		log("Subarray DC power loaded from the cache of a previous run", SSC_NOTICE);
+	}
 
-				// electric load is subhourly
-				// if no load profile supplied, load = 0
-				if (nload == nrec)
-					cur_load = p_load_in[hour*step_per_hour + jj];
+	// messages logged by the DC calculation of year 1 are kept in the DC cache
+	int dcLogBegin = 0;
+	while (use_dc_cache && !dcCache && log(dcLogBegin) != 0)
+		dcLogBegin++;
 
-				// log cur_load to check both hourly and sub hourly load data
-				// load data over entrie lifetime period not currently supported.
-				//					log(util::format("year=%d, hour=%d, step per hour=%d, load=%g",
-				//						iyear, hour, jj, cur_load), SSC_WARNING, (float)idx);
-				p_load_full.push_back((ssc_number_t)cur_load);
+	// Predict clipping for DC battery controller at lifetime index idx_step
+	auto predict_dc_clipping = [&](size_t idx_step)
+	{
+		double cliploss = 0;
+		double dcpwr_kw = PVSystem->p_systemDCPower[idx_step];
 
-				if (!wdprov->read(&Irradiance->weatherRecord))
-					throw exec_error("pvsamv1", "could not read data line " + util::to_string((int)(idx + 1)) + " in weather file");
+		if (p_pv_dc_forecast.size() > 1 && p_pv_dc_forecast.size() > idx_step % (8760 * step_per_hour)) {
+			dcpwr_kw = p_pv_dc_forecast[idx_step % (8760 * step_per_hour)];
+		}
+		p_pv_dc_use.push_back(static_cast<ssc_number_t>(dcpwr_kw));
 
-				weather_record wf = Irradiance->weatherRecord;
+		if (p_pv_clipping_forecast.size() > 1 && p_pv_clipping_forecast.size() > idx_step % (8760 * step_per_hour)) {
+			cliploss = p_pv_clipping_forecast[idx_step % (8760 * step_per_hour)] * util::kilowatt_to_watt;
+		}
+		else {
+			//DC batteries not allowed with multiple MPPT, so can just use MPPT 1's voltage
+			sharedInverter->calculateACPower(dcpwr_kw, PVSystem->p_mpptVoltage[0][idx_step], 0.0);
+			cliploss = sharedInverter->powerClipLoss_kW;
+		}
 
-				//update POA data structure indicies if radmode is POA model is enabled
-				if (radmode == irrad::POA_R || radmode == irrad::POA_P){
-					for (size_t nn = 0; nn < num_subarrays; nn++){
-						if (!Subarrays[nn]->enable) continue;
-
-						Subarrays[nn]->poa.poaAll->tDew = wf.tdew;
-						Subarrays[nn]->poa.poaAll->i = idx;
-						if (jj == 0 && wf.hour == 0) {
-							Subarrays[nn]->poa.poaAll->dayStart = idx;
-							Subarrays[nn]->poa.poaAll->doy += 1;
-						}
+		p_invcliploss_full.push_back(static_cast<ssc_number_t>(cliploss));
+	};
 
-					}
+	// Subarray DC power is calculated for blocks of time steps. Within a block, the plane-of-array irradiance runs for each subarray, and then
+	// the module power for each MPPT input, on up to n_threads threads. Results that are summed across subarrays and log messages are
+	// combined afterwards in the order of a serial run, so the results do not depend on the number of threads.
+	struct dc_subarray_step
+	{
+		// plane-of-array irradiance passed to the module power calculation, see Subarray_IO::poa
+		double poaBeamFront, poaDiffuseFront, poaGroundFront, poaRear, poaTotal;
+		bool sunUp;
+		double angleOfIncidenceDegrees, surfaceTiltDegrees, surfaceAzimuthDegrees, nonlinearDCShadingDerate;
+		bool usePOAFromWF;
+		double dcShadeFactor;
+		double ipoa, ipoaFront, ipoaRear, ipoaRearAfterLosses; // [W/m2]
+		double solazi, solzen, solalt, alb;
+		int sunup;
+		ssc_number_t beamCalculated; // beam calculated from global and diffuse [W/m2]
+
+		// contributions to the array totals [W]
+		double poaFrontNominalW, poaFrontBeamNominalW, poaFrontShadedW, poaFrontShadedSoiledW, poaRearW, poaFrontBeamEffW, poaFrontTotalW, poaTotalEffW;
+		double mpptVoltageClipping; // [W]
+		double snowLoss_kW;
+		double dcPowerSubarray; // [W]
+	};
+	struct dc_log_message
+	{
+		size_t step;
+		std::string msg;
+		int type;
+		float time;
+	};
+	// The work for one subarray or MPPT input over a block. An error stops the task, and is thrown when its step is reached
+	struct dc_block_task
+	{
+		std::vector<dc_log_message> logs;
+		size_t nextLog;
+		std::exception_ptr error;
+		size_t errorStep;
+		int errorStage;		// 0 = irradiance, 1 = module power, 2 = DC derates
+		size_t errorRank;	// subarray or MPPT input within the stage
+	};
+
+	const size_t dc_block_hours = 168;
+	int n_threads = Simulation->nThreads;
+
+	// With POA irradiance as input, self-shading uses the beam irradiance decomposed by the previous subarray, so the subarrays run in order
+	bool serial_poa = (radmode == irrad::POA_R || radmode == irrad::POA_P);
+
+	std::vector<bool> subarrayCalculated(num_subarrays);
+	size_t last_subarray = 0;
+	for (size_t nn = 0; nn < num_subarrays; nn++)
+	{
+		subarrayCalculated[nn] = Subarrays[nn]->enable && Subarrays[nn]->nStrings >= 1;
+		if (subarrayCalculated[nn])
+			last_subarray = nn;
+	}
+
+	// The shading database keeps the result of its last lookup, so subarrays that run at the same time need their own copy
+	std::vector<std::unique_ptr<ShadeDB8_mpp>> subarrayShadeDatabases;
+	std::vector<ShadeDB8_mpp *> shadeDatabases(num_subarrays, shadeDatabase);
+	for (size_t nn = 1; nn < num_subarrays; nn++)
+	{
+		if (Subarrays[nn]->shadeCalculator.use_shade_db())
+		{
+			subarrayShadeDatabases.push_back(std::unique_ptr<ShadeDB8_mpp>(new ShadeDB8_mpp()));
+			subarrayShadeDatabases.back()->init();
+			shadeDatabases[nn] = subarrayShadeDatabases.back().get();
+		}
+	}
+
+	std::vector<weather_record> block_weather;
+	std::vector<std::vector<dc_subarray_step>> block_steps(num_subarrays);
+	std::vector<dc_block_task> poa_tasks(num_subarrays);
+	std::vector<dc_block_task> mppt_tasks(PVSystem->Inverter->nMpptInputs);
+	size_t block_idx = 0, block_hour = 0;
+
+	auto defer_log = [](dc_block_task &task, size_t s, const std::string &msg, int type, float time)
+	{
+		dc_log_message message;
+		message.step = s;
+		message.msg = msg;
+		message.type = type;
+		message.time = time;
+		task.logs.push_back(message);
+	};
+
+	// Run step s of a task, keeping an error instead of throwing it so that the steps before it can be reported
+	auto run_block_step = [](dc_block_task &task, size_t s, const std::function<void()> &calculate)
+	{
+		if (task.error)
+			return;
+		try
+		{
+			calculate();
+		}
+		catch (...)
+		{
+			task.error = std::current_exception();
+			task.errorStep = s;
+		}
+	};
+
+	// Log the messages of step s of a task, and throw its error if it stopped there
+	auto report_block_step = [&](dc_block_task &task, size_t s, int stage)
+	{
+		while (task.nextLog < task.logs.size() && task.logs[task.nextLog].step == s)
+		{
+			const dc_log_message &message = task.logs[task.nextLog++];
+			log(message.msg, message.type, message.time);
+		}
+		if (task.error && task.errorStep == s && task.errorStage == stage)
+			std::rethrow_exception(task.error);
+	};
+
+	for (size_t iyear = 0; iyear < nyears; iyear++)
+	{
+		// replay the subarray DC power from year 1 or from the DC cache
+		bool replay_dc = dcCache || (reuse_year1 && iyear > 0);
+
+		// irradiance incident on subarray nn at step s of the block
+		auto calculate_subarray_poa = [&](size_t nn, size_t s)
+		{
+			size_t idx = block_idx + s;
+			size_t hour = block_hour + s / step_per_hour;
+			size_t jj = s % step_per_hour;
+			const weather_record &wf = block_weather[s];
+			dc_subarray_step &step = block_steps[nn][s];
+			dc_block_task &task = poa_tasks[nn];
+			task.errorStage = 0;
+			task.errorRank = nn;
+
+			//update POA data structure indicies if radmode is POA model is enabled
+			if ((radmode == irrad::POA_R || radmode == irrad::POA_P) && Subarrays[nn]->enable)
+			{
+				Subarrays[nn]->poa.poaAll->tDew = wf.tdew;
+				Subarrays[nn]->poa.poaAll->i = idx;
+				if (jj == 0 && wf.hour == 0) {
+					Subarrays[nn]->poa.poaAll->dayStart = idx;
+					Subarrays[nn]->poa.poaAll->doy += 1;
 				}
-				
-				double solazi = 0, solzen = 0, solalt = 0;
-				int sunup = 0;
+			}
 
-				// accumulators for radiation power (W) over this 
-				// timestep from each subarray
-				double ts_accum_poa_front_nom = 0.0;
-				double ts_accum_poa_front_beam_nom = 0.0;
-				double ts_accum_poa_front_shaded = 0.0;
-				double ts_accum_poa_front_shaded_soiled = 0.0;
-				double ts_accum_poa_front_total = 0.0;
-				double ts_accum_poa_rear = 0.0;
-				double ts_accum_poa_rear_after_losses = 0.0;
-				double ts_accum_poa_total_eff = 0.0;
-				double ts_accum_poa_front_beam_eff = 0.0;
+			step.ipoa = step.ipoaFront = step.ipoaRear = step.ipoaRearAfterLosses = 0;
+			if (!subarrayCalculated[nn])
+			{
+				step.dcShadeFactor = Subarrays[nn]->shadeCalculator.dc_shade_factor();
+				return; // skip disabled subarrays
+			}
 
-				// calculate incident irradiance on each subarray
-				std::vector<double> ipoa_rear, ipoa_rear_after_losses, ipoa_front, ipoa;
-				double alb;
-				alb = 0;
+			double sunAngles[9];
+			int sunPositionTime[3];
+			sunPosition.get_sun_position(idx % nrec, sunAngles, sunPositionTime);
+
+			double solazi = 0, solzen = 0, solalt = 0;
+			int sunup = 0;
+			double alb = 0;
+
+			irrad irr(wf, Irradiance->weatherHeader,
+				Irradiance->skyModel, Irradiance->radiationMode, Subarrays[nn]->trackMode,
+				Irradiance->useWeatherFileAlbedo, Irradiance->instantaneous, Subarrays[nn]->backtrackingEnabled,
+				Irradiance->dtHour, Subarrays[nn]->tiltDegrees, Subarrays[nn]->azimuthDegrees, Subarrays[nn]->trackerRotationLimitDegrees, Subarrays[nn]->groundCoverageRatio,
+				Subarrays[nn]->monthlyTiltDegrees, Irradiance->userSpecifiedMonthlyAlbedo,
+				Subarrays[nn]->poa.poaAll.get());
+			irr.set_sun_position(sunAngles, sunPositionTime);
+									
+			int code = irr.calc();
+
+			if (code < 0) //jmf updated 11/30/18 so that negative numbers are errors, positive numbers are warnings, 0 is everything correct. implemented in patch for POA model only, will be added to develop for other irrad models as well
+				throw exec_error("pvsamv1",
+				util::format("failed to calculate irradiance incident on surface (POA) %d (code: %d) [y:%d m:%d d:%d h:%d]",
+				nn + 1, code, wf.year, wf.month, wf.day, wf.hour));
+
+			if (code == 40)
+				defer_log(task, s, util::format("SAM calculated negative direct normal irradiance in the POA decomposition algorithm at time [y:%d m:%d d:%d h:%d], set to zero.",
+					wf.year, wf.month, wf.day, wf.hour), SSC_WARNING, (float)idx);
+			else if (code == 41)
+				defer_log(task, s, util::format("SAM calculated negative diffuse horizontal irradiance in the POA decomposition algorithm at time [y:%d m:%d d:%d h:%d], set to zero.",
+					wf.year, wf.month, wf.day, wf.hour), SSC_WARNING, (float)idx);
+			else if (code == 42)
+				defer_log(task, s, util::format("SAM calculated negative global horizontal irradiance in the POA decomposition algorithm at time [y:%d m:%d d:%d h:%d], set to zero.",
+					wf.year, wf.month, wf.day, wf.hour), SSC_WARNING, (float)idx);
+							   					 
+			// p_irrad_calc is only weather file records long...
+			if (iyear == 0)
+			{
+				if (radmode == irrad::POA_R || radmode == irrad::POA_P) {
+					double gh_temp, df_temp, dn_temp;
+					gh_temp = df_temp = dn_temp = 0;
+					irr.get_irrad(&gh_temp, &dn_temp, &df_temp);
+					Irradiance->p_IrradianceCalculated[1][idx] = (ssc_number_t)df_temp;
+					Irradiance->p_IrradianceCalculated[2][idx] = (ssc_number_t)dn_temp;
+				}
+			}
+			// beam, skydiff, and grounddiff IN THE PLANE OF ARRAY (W/m2)
+			double ibeam, iskydiff, ignddiff;
+			double aoi, stilt, sazi, rot, btd;
+
+			// Ensure that the usePOAFromWF flag is false unless a reference cell has been used. 
+			//  This will later get forced to false if any shading has been applied (in any scenario)
+			//  also this will also be forced to false if using the cec mcsp thermal model OR if using the spe module model with a diffuse util. factor < 1.0
+			Subarrays[nn]->poa.usePOAFromWF = false;
+			if (radmode == irrad::POA_R){
+				step.ipoa = wf.poa;
+				Subarrays[nn]->poa.usePOAFromWF = true;
+			}
+			else if (radmode == irrad::POA_P){
+				step.ipoa = wf.poa;
+			}
 
-				for (size_t nn = 0; nn < num_subarrays; nn++)
-				{
-					ipoa_rear.push_back(0);
-					ipoa_rear_after_losses.push_back(0);
-					ipoa_front.push_back(0);
-					ipoa.push_back(0);
-
-					if (!Subarrays[nn]->enable
-						|| Subarrays[nn]->nStrings < 1)
-						continue; // skip disabled subarrays
-
-					irrad irr(Irradiance->weatherRecord, Irradiance->weatherHeader,
-						Irradiance->skyModel, Irradiance->radiationMode, Subarrays[nn]->trackMode,
-						Irradiance->useWeatherFileAlbedo, Irradiance->instantaneous, Subarrays[nn]->backtrackingEnabled,
-						Irradiance->dtHour, Subarrays[nn]->tiltDegrees, Subarrays[nn]->azimuthDegrees, Subarrays[nn]->trackerRotationLimitDegrees, Subarrays[nn]->groundCoverageRatio,
-						Subarrays[nn]->monthlyTiltDegrees, Irradiance->userSpecifiedMonthlyAlbedo,
-						Subarrays[nn]->poa.poaAll.get());
-											
-					int code = irr.calc();
-
-					if (code < 0) //jmf updated 11/30/18 so that negative numbers are errors, positive numbers are warnings, 0 is everything correct. implemented in patch for POA model only, will be added to develop for other irrad models as well
-						throw exec_error("pvsamv1",
-						util::format("failed to calculate irradiance incident on surface (POA) %d (code: %d) [y:%d m:%d d:%d h:%d]",
-						nn + 1, code, wf.year, wf.month, wf.day, wf.hour));
-
-					if (code == 40)
-						log(util::format("SAM calculated negative direct normal irradiance in the POA decomposition algorithm at time [y:%d m:%d d:%d h:%d], set to zero.",
-							wf.year, wf.month, wf.day, wf.hour), SSC_WARNING, (float)idx);
-					else if (code == 41)
-						log(util::format("SAM calculated negative diffuse horizontal irradiance in the POA decomposition algorithm at time [y:%d m:%d d:%d h:%d], set to zero.",
-							wf.year, wf.month, wf.day, wf.hour), SSC_WARNING, (float)idx);
-					else if (code == 42)
-						log(util::format("SAM calculated negative global horizontal irradiance in the POA decomposition algorithm at time [y:%d m:%d d:%d h:%d], set to zero.",
-							wf.year, wf.month, wf.day, wf.hour), SSC_WARNING, (float)idx);
-									   					 
-					// p_irrad_calc is only weather file records long...
-					if (iyear == 0)
-					{
-						if (radmode == irrad::POA_R || radmode == irrad::POA_P) {
-							double gh_temp, df_temp, dn_temp;
-							gh_temp = df_temp = dn_temp = 0;
-							irr.get_irrad(&gh_temp, &dn_temp, &df_temp);
-							Irradiance->p_IrradianceCalculated[1][idx] = (ssc_number_t)df_temp;
-							Irradiance->p_IrradianceCalculated[2][idx] = (ssc_number_t)dn_temp;
-						}
-					}
-					// beam, skydiff, and grounddiff IN THE PLANE OF ARRAY (W/m2)
-					double ibeam, iskydiff, ignddiff;
-					double aoi, stilt, sazi, rot, btd;
+			if (Subarrays[nn]->Module->simpleEfficiencyForceNoPOA && (radmode == irrad::POA_R || radmode == irrad::POA_P)){  // only will be true if using a poa model AND spe module model AND spe_fp is < 1
+				Subarrays[nn]->poa.usePOAFromWF = false;
+				if (idx == 0)
+					defer_log(task, s, "The combination of POA irradiance as in input, single point efficiency module model, and module diffuse utilization factor less than one means that SAM must use a POA decomposition model to calculate the incident diffuse irradiance", SSC_WARNING, -1.0f);
+			}
 
-					// Ensure that the usePOAFromWF flag is false unless a reference cell has been used. 
-					//  This will later get forced to false if any shading has been applied (in any scenario)
-					//  also this will also be forced to false if using the cec mcsp thermal model OR if using the spe module model with a diffuse util. factor < 1.0
-					Subarrays[nn]->poa.usePOAFromWF = false;
-					if (radmode == irrad::POA_R){
-						ipoa[nn] = wf.poa;
-						Subarrays[nn]->poa.usePOAFromWF = true;
-					}
-					else if (radmode == irrad::POA_P){
-						ipoa[nn] = wf.poa;
-					}
+			if (Subarrays[nn]->Module->mountingSpecificCellTemperatureForceNoPOA && (radmode == irrad::POA_R || radmode == irrad::POA_P)){
+				Subarrays[nn]->poa.usePOAFromWF = false;
+				if (idx == 0)
+					defer_log(task, s, "The combination of POA irradiance as input and heat transfer method for cell temperature means that SAM must use a POA decomposition model to calculate the beam irradiance required by the cell temperature model", SSC_WARNING, -1.0f);
+			}
 
-					if (Subarrays[nn]->Module->simpleEfficiencyForceNoPOA && (radmode == irrad::POA_R || radmode == irrad::POA_P)){  // only will be true if using a poa model AND spe module model AND spe_fp is < 1
-						Subarrays[nn]->poa.usePOAFromWF = false;
-						if (idx == 0)
-							log("The combination of POA irradiance as in input, single point efficiency module model, and module diffuse utilization factor less than one means that SAM must use a POA decomposition model to calculate the incident diffuse irradiance", SSC_WARNING);
-					}
 
-					if (Subarrays[nn]->Module->mountingSpecificCellTemperatureForceNoPOA && (radmode == irrad::POA_R || radmode == irrad::POA_P)){
-						Subarrays[nn]->poa.usePOAFromWF = false;
-						if (idx == 0)
-							log("The combination of POA irradiance as input and heat transfer method for cell temperature means that SAM must use a POA decomposition model to calculate the beam irradiance required by the cell temperature model", SSC_WARNING);
-					}
+			// Get Incident angles and irradiances
+			irr.get_sun(&solazi, &solzen, &solalt, 0, 0, 0, &sunup, 0, 0, 0);
+			irr.get_angles(&aoi, &stilt, &sazi, &rot, &btd);
+			irr.get_poa(&ibeam, &iskydiff, &ignddiff, 0, 0, 0);
+			alb = irr.getAlbedo();
 
+			// the array-level irradiance outputs are the same for every subarray, so only one subarray writes them when they run at the same time
+			bool write_irradiance = serial_poa || nn == last_subarray;
+			if (iyear == 0 && write_irradiance)
+				Irradiance->p_sunPositionTime[idx] = (ssc_number_t)irr.get_sunpos_calc_hour();
 
-					// Get Incident angles and irradiances
-					irr.get_sun(&solazi, &solzen, &solalt, 0, 0, 0, &sunup, 0, 0, 0);
-					irr.get_angles(&aoi, &stilt, &sazi, &rot, &btd);
-					irr.get_poa(&ibeam, &iskydiff, &ignddiff, 0, 0, 0);
-					alb = irr.getAlbedo();
+			// save weather file beam, diffuse, and global for output and for use later in pvsamv1- year 1 only
+			/*jmf 2016: these calculations are currently redundant with calculations in irrad.calc() because ibeam and idiff in that function are DNI and DHI, **NOT** in the plane of array
+			we'll have to fix this redundancy in the pvsamv1 rewrite. it will require allowing irradproc to report the errors below
+			and deciding what to do if the weather file DOES contain the third component but it's not being used in the calculations.*/
+			if (iyear == 0 && write_irradiance)
+			{
+				// Apply all irradiance component data from weather file (if it exists)
+				Irradiance->p_weatherFilePOA[0][idx] = (ssc_number_t)wf.poa;
+				Irradiance->p_weatherFileDNI[idx] = (ssc_number_t)wf.dn;
+				Irradiance->p_weatherFileGHI[idx] = (ssc_number_t)(wf.gh);
+				Irradiance->p_weatherFileDHI[idx] = (ssc_number_t)(wf.df);
+			}
 
+			// calculate beam if global & diffuse are selected as inputs, every year because self-shading uses it
+			if (radmode == irrad::GH_DF)
+			{
+				step.beamCalculated = (ssc_number_t)((wf.gh - wf.df) / cos(solzen*3.1415926 / 180));
+				if (step.beamCalculated < -1)
+				{
 					if (iyear == 0)
-						Irradiance->p_sunPositionTime[idx] = (ssc_number_t)irr.get_sunpos_calc_hour();
+						defer_log(task, s, util::format("SAM calculated negative direct normal irradiance %lg W/m2 at time [y:%d m:%d d:%d h:%d], set to zero.",
+							step.beamCalculated, wf.year, wf.month, wf.day, wf.hour), SSC_WARNING, (float)idx);
+					step.beamCalculated = 0;
+				}
+				if (iyear == 0 && write_irradiance)
+					Irradiance->p_IrradianceCalculated[2][idx] = step.beamCalculated;
+			}
 
-					// save weather file beam, diffuse, and global for output and for use later in pvsamv1- year 1 only
-					/*jmf 2016: these calculations are currently redundant with calculations in irrad.calc() because ibeam and idiff in that function are DNI and DHI, **NOT** in the plane of array
-					we'll have to fix this redundancy in the pvsamv1 rewrite. it will require allowing irradproc to report the errors below
-					and deciding what to do if the weather file DOES contain the third component but it's not being used in the calculations.*/
-					if (iyear == 0)
+			if (iyear == 0)
+			{
+				// calculate global if beam & diffuse are selected as inputs
+				if (radmode == irrad::DN_DF)
+				{
+					ssc_number_t globalCalculated = (ssc_number_t)(wf.df + wf.dn * cos(solzen*3.1415926 / 180));
+					if (globalCalculated < -1)
 					{
-						// Apply all irradiance component data from weather file (if it exists)
-						Irradiance->p_weatherFilePOA[0][idx] = (ssc_number_t)wf.poa;
-						Irradiance->p_weatherFileDNI[idx] = (ssc_number_t)wf.dn;
-						Irradiance->p_weatherFileGHI[idx] = (ssc_number_t)(wf.gh);
-						Irradiance->p_weatherFileDHI[idx] = (ssc_number_t)(wf.df);
-
-						// calculate beam if global & diffuse are selected as inputs
-						if (radmode == irrad::GH_DF)
-						{
-							Irradiance->p_IrradianceCalculated[2][idx] = (ssc_number_t)((wf.gh - wf.df) / cos(solzen*3.1415926 / 180));
-							if (Irradiance->p_IrradianceCalculated[2][idx] < -1)
-							{
-								log(util::format("SAM calculated negative direct normal irradiance %lg W/m2 at time [y:%d m:%d d:%d h:%d], set to zero.",
-									Irradiance->p_IrradianceCalculated[2][idx], wf.year, wf.month, wf.day, wf.hour), SSC_WARNING, (float)idx);
-								Irradiance->p_IrradianceCalculated[2][idx] = 0;
-							}
-						}
-
-						// calculate global if beam & diffuse are selected as inputs
-						if (radmode == irrad::DN_DF)
-						{
-							Irradiance->p_IrradianceCalculated[0][idx] = (ssc_number_t)(wf.df + wf.dn * cos(solzen*3.1415926 / 180));
-							if (Irradiance->p_IrradianceCalculated[0][idx] < -1)
-							{
-								log(util::format("SAM calculated negative global horizontal irradiance %lg W/m2 at time [y:%d m:%d d:%d h:%d], set to zero.",
-									Irradiance->p_IrradianceCalculated[0][idx], wf.year, wf.month, wf.day, wf.hour), SSC_WARNING, (float)idx);
-								Irradiance->p_IrradianceCalculated[0][idx] = 0;
-							}
-						}
-
-						// calculate diffuse if total & beam are selected as inputs
-						if (radmode == irrad::DN_GH)
-						{
-							Irradiance->p_IrradianceCalculated[1][idx] = (ssc_number_t)(wf.gh - wf.dn * cos(solzen*3.1415926 / 180));
-							if (Irradiance->p_IrradianceCalculated[1][idx] < -1)
-							{
-								log(util::format("SAM calculated negative diffuse horizontal irradiance %lg W/m2 at time [y:%d m:%d d:%d h:%d], set to zero.",
-									Irradiance->p_IrradianceCalculated[1][idx], wf.year, wf.month, wf.day, wf.hour), SSC_WARNING, (float)idx);
-								Irradiance->p_IrradianceCalculated[1][idx] = 0;
-							}
-						}
+						defer_log(task, s, util::format("SAM calculated negative global horizontal irradiance %lg W/m2 at time [y:%d m:%d d:%d h:%d], set to zero.",
+							globalCalculated, wf.year, wf.month, wf.day, wf.hour), SSC_WARNING, (float)idx);
+						globalCalculated = 0;
 					}
+					if (write_irradiance)
+						Irradiance->p_IrradianceCalculated[0][idx] = globalCalculated;
+				}
 
-					// record sub-array plane of array output before computing shading and soiling
-					if (iyear == 0)
+				// calculate diffuse if total & beam are selected as inputs
+				if (radmode == irrad::DN_GH)
+				{
+					ssc_number_t diffuseCalculated = (ssc_number_t)(wf.gh - wf.dn * cos(solzen*3.1415926 / 180));
+					if (diffuseCalculated < -1)
 					{
-						if (radmode != irrad::POA_R)
-							PVSystem->p_poaNominalFront[nn][idx] = (ssc_number_t)((ibeam + iskydiff + ignddiff));
-						else
-							PVSystem->p_poaNominalFront[nn][idx] = (ssc_number_t)((ipoa[nn]));
+						defer_log(task, s, util::format("SAM calculated negative diffuse horizontal irradiance %lg W/m2 at time [y:%d m:%d d:%d h:%d], set to zero.",
+							diffuseCalculated, wf.year, wf.month, wf.day, wf.hour), SSC_WARNING, (float)idx);
+						diffuseCalculated = 0;
 					}
+					if (write_irradiance)
+						Irradiance->p_IrradianceCalculated[1][idx] = diffuseCalculated;
+				}
+			}
 
+			// record sub-array plane of array output before computing shading and soiling
+			if (iyear == 0)
+			{
+				if (radmode != irrad::POA_R)
+					PVSystem->p_poaNominalFront[nn][idx] = (ssc_number_t)((ibeam + iskydiff + ignddiff));
+				else
+					PVSystem->p_poaNominalFront[nn][idx] = (ssc_number_t)((step.ipoa));
+			}
 
-					// record sub-array contribution to total POA power for this time step  (W)
-					if (radmode != irrad::POA_R)
-						ts_accum_poa_front_nom += (ibeam + iskydiff + ignddiff) * ref_area_m2 * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
-					else
-						ts_accum_poa_front_nom += (ipoa[nn])* ref_area_m2 * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
 
-					// record sub-array contribution to total POA beam power for this time step (W)
-					ts_accum_poa_front_beam_nom += ibeam * ref_area_m2 * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
+			// record sub-array contribution to total POA power for this time step  (W)
+			if (radmode != irrad::POA_R)
+				step.poaFrontNominalW = (ibeam + iskydiff + ignddiff) * ref_area_m2 * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
+			else
+				step.poaFrontNominalW = (step.ipoa)* ref_area_m2 * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
 
-					// for non-linear shading from shading database
-					if (Subarrays[nn]->shadeCalculator.use_shade_db())
-					{
-						double shadedb_gpoa = ibeam + iskydiff + ignddiff;
-						double shadedb_dpoa = iskydiff + ignddiff;
+			// record sub-array contribution to total POA beam power for this time step (W)
+			step.poaFrontBeamNominalW = ibeam * ref_area_m2 * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
 
-						// update cell temperature - unshaded value per Sara 1/25/16
-						double tcell = wf.tdry;
-						if (sunup > 0)
-						{
-							// calculate cell temperature using selected temperature model
-							pvinput_t in(ibeam, iskydiff, ignddiff, 0, ipoa[nn],
-								wf.tdry, wf.tdew, wf.wspd, wf.wdir, wf.pres,
-								solzen, aoi, hdr.elev,
-								stilt, sazi,
-								((double)wf.hour) + wf.minute / 60.0,
-								radmode, Subarrays[nn]->poa.usePOAFromWF);
-							// voltage set to -1 for max power
-							(*Subarrays[nn]->Module->cellTempModel)(in, *Subarrays[nn]->Module->moduleModel, -1.0, tcell);
-						}
-						double shadedb_str_vmp_stc = Subarrays[nn]->nModulesPerString * Subarrays[nn]->Module->voltageMaxPower;
-						double shadedb_mppt_lo = PVSystem->Inverter->mpptLowVoltage;
-						double shadedb_mppt_hi = PVSystem->Inverter->mpptHiVoltage;
-						 
-						// shading database if necessary
-						if (!Subarrays[nn]->shadeCalculator.fbeam_shade_db(shadeDatabase, hour, solalt, solazi, jj, step_per_hour, shadedb_gpoa, shadedb_dpoa, tcell, Subarrays[nn]->nModulesPerString, shadedb_str_vmp_stc, shadedb_mppt_lo, shadedb_mppt_hi))
-						{
-							throw exec_error("pvsamv1", util::format("Error calculating shading factor for subarray %d", nn));
-						}
-						if (iyear == 0)
-						{
+			// for non-linear shading from shading database
+			if (Subarrays[nn]->shadeCalculator.use_shade_db())
+			{
+				double shadedb_gpoa = ibeam + iskydiff + ignddiff;
+				double shadedb_dpoa = iskydiff + ignddiff;
+
+				// update cell temperature - unshaded value per Sara 1/25/16
+				double tcell = wf.tdry;
+				if (sunup > 0)
+				{
+					// calculate cell temperature using selected temperature model
+					pvinput_t in(ibeam, iskydiff, ignddiff, 0, step.ipoa,
+						wf.tdry, wf.tdew, wf.wspd, wf.wdir, wf.pres,
+						solzen, aoi, hdr.elev,
+						stilt, sazi,
+						((double)wf.hour) + wf.minute / 60.0,
+						radmode, Subarrays[nn]->poa.usePOAFromWF);
+					// voltage set to -1 for max power
+					(*Subarrays[nn]->Module->cellTempModel)(in, *Subarrays[nn]->Module->moduleModel, -1.0, tcell);
+				}
+				double shadedb_str_vmp_stc = Subarrays[nn]->nModulesPerString * Subarrays[nn]->Module->voltageMaxPower;
+				double shadedb_mppt_lo = PVSystem->Inverter->mpptLowVoltage;
+				double shadedb_mppt_hi = PVSystem->Inverter->mpptHiVoltage;
+				 
+				// shading database if necessary
+				if (!Subarrays[nn]->shadeCalculator.fbeam_shade_db(shadeDatabases[nn], hour, solalt, solazi, jj, step_per_hour, shadedb_gpoa, shadedb_dpoa, tcell, Subarrays[nn]->nModulesPerString, shadedb_str_vmp_stc, shadedb_mppt_lo, shadedb_mppt_hi))
+				{
+					throw exec_error("pvsamv1", util::format("Error calculating shading factor for subarray %d", nn));
+				}
+				if (iyear == 0)
+				{
 #ifdef SHADE_DB_OUTPUTS
-							p_shadedb_gpoa[nn][idx] = (ssc_number_t)shadedb_gpoa;
-							p_shadedb_dpoa[nn][idx] = (ssc_number_t)shadedb_dpoa;
-							p_shadedb_pv_cell_temp[nn][idx] = (ssc_number_t)tcell;
-							p_shadedb_mods_per_str[nn][idx] = (ssc_number_t)Subarrays[nn]->nModulesPerString;
-							p_shadedb_str_vmp_stc[nn][idx] = (ssc_number_t)shadedb_str_vmp_stc;
-							p_shadedb_mppt_lo[nn][idx] = (ssc_number_t)shadedb_mppt_lo;
-							p_shadedb_mppt_hi[nn][idx] = (ssc_number_t)shadedb_mppt_hi;
-							log("shade db hour " + util::to_string((int)hour) +"\n" + shadeCalculator->get_warning());
+					p_shadedb_gpoa[nn][idx] = (ssc_number_t)shadedb_gpoa;
+					p_shadedb_dpoa[nn][idx] = (ssc_number_t)shadedb_dpoa;
+					p_shadedb_pv_cell_temp[nn][idx] = (ssc_number_t)tcell;
+					p_shadedb_mods_per_str[nn][idx] = (ssc_number_t)Subarrays[nn]->nModulesPerString;
+					p_shadedb_str_vmp_stc[nn][idx] = (ssc_number_t)shadedb_str_vmp_stc;
+					p_shadedb_mppt_lo[nn][idx] = (ssc_number_t)shadedb_mppt_lo;
+					p_shadedb_mppt_hi[nn][idx] = (ssc_number_t)shadedb_mppt_hi;
+					log("shade db hour " + util::to_string((int)hour) +"\n" + shadeCalculator->get_warning());
 #endif
-							// fraction shaded for comparison
-							PVSystem->p_shadeDBShadeFraction[nn][idx] = (ssc_number_t)(Subarrays[nn]->shadeCalculator.dc_shade_factor());
-						} 
-					}
-					else
-					{
-						if (!Subarrays[nn]->shadeCalculator.fbeam(hour, solalt, solazi, jj, step_per_hour))
-						{
-							throw exec_error("pvsamv1", util::format("Error calculating shading factor for subarray %d", nn));
-						}
-					}
+					// fraction shaded for comparison
+					PVSystem->p_shadeDBShadeFraction[nn][idx] = (ssc_number_t)(Subarrays[nn]->shadeCalculator.dc_shade_factor());
+				} 
+			}
+			else
+			{
+				if (!Subarrays[nn]->shadeCalculator.fbeam(hour, solalt, solazi, jj, step_per_hour))
+				{
+					throw exec_error("pvsamv1", util::format("Error calculating shading factor for subarray %d", nn));
+				}
+			}
 
-					// apply hourly shading factors to beam (if none enabled, factors are 1.0) 
-					// shj 3/21/16 - update to handle negative shading loss
-					if (Subarrays[nn]->shadeCalculator.beam_shade_factor() != 1.0){
-						//							if (sa[nn].shad.beam_shade_factor() < 1.0){
-						// Sara 1/25/16 - shading database derate applied to dc only
-						// shading loss applied to beam if not from shading database
-						ibeam *= Subarrays[nn]->shadeCalculator.beam_shade_factor();
-						if (radmode == irrad::POA_R || radmode == irrad::POA_P){
-							Subarrays[nn]->poa.usePOAFromWF = false;
-							if (Subarrays[nn]->poa.poaShadWarningCount == 0){
-								log(util::format("Combining POA irradiance as input with the beam shading losses at time [y:%d m:%d d:%d h:%d] forces SAM to use a POA decomposition model to calculate incident beam irradiance",
-									wf.year, wf.month, wf.day, wf.hour), SSC_WARNING, (float)idx);
-							}
-							else{
-								log(util::format("Combining POA irradiance as input with the beam shading losses at time [y:%d m:%d d:%d h:%d] forces SAM to use a POA decomposition model to calculate incident beam irradiance",
-									wf.year, wf.month, wf.day, wf.hour), SSC_NOTICE, (float)idx);
-							}
-							Subarrays[nn]->poa.poaShadWarningCount++;
-						}
+			// apply hourly shading factors to beam (if none enabled, factors are 1.0) 
+			// shj 3/21/16 - update to handle negative shading loss
+			if (Subarrays[nn]->shadeCalculator.beam_shade_factor() != 1.0){
+				//							if (sa[nn].shad.beam_shade_factor() < 1.0){
+				// Sara 1/25/16 - shading database derate applied to dc only
+				// shading loss applied to beam if not from shading database
+				ibeam *= Subarrays[nn]->shadeCalculator.beam_shade_factor();
+				if (radmode == irrad::POA_R || radmode == irrad::POA_P){
+					Subarrays[nn]->poa.usePOAFromWF = false;
+					if (Subarrays[nn]->poa.poaShadWarningCount == 0){
+						defer_log(task, s, util::format("Combining POA irradiance as input with the beam shading losses at time [y:%d m:%d d:%d h:%d] forces SAM to use a POA decomposition model to calculate incident beam irradiance",
+							wf.year, wf.month, wf.day, wf.hour), SSC_WARNING, (float)idx);
 					}
-
-					// apply sky diffuse shading factor (specified as constant, nominally 1.0 if disabled in UI)
-					if (Subarrays[nn]->shadeCalculator.fdiff() < 1.0){
-						iskydiff *= Subarrays[nn]->shadeCalculator.fdiff();
-						if (radmode == irrad::POA_R || radmode == irrad::POA_P){
-							if (idx == 0)
-								log("Combining POA irradiance as input with the diffuse shading losses forces SAM to use a POA decomposition model to calculate incident diffuse irradiance", SSC_WARNING);
-							Subarrays[nn]->poa.usePOAFromWF = false;
-						}
+					else{
+						defer_log(task, s, util::format("Combining POA irradiance as input with the beam shading losses at time [y:%d m:%d d:%d h:%d] forces SAM to use a POA decomposition model to calculate incident beam irradiance",
+							wf.year, wf.month, wf.day, wf.hour), SSC_NOTICE, (float)idx);
 					}
+					Subarrays[nn]->poa.poaShadWarningCount++;
+				}
+			}
 
-					double beam_shading_factor = Subarrays[nn]->shadeCalculator.beam_shade_factor();
+			// apply sky diffuse shading factor (specified as constant, nominally 1.0 if disabled in UI)
+			if (Subarrays[nn]->shadeCalculator.fdiff() < 1.0){
+				iskydiff *= Subarrays[nn]->shadeCalculator.fdiff();
+				if (radmode == irrad::POA_R || radmode == irrad::POA_P){
+					if (idx == 0)
+						defer_log(task, s, "Combining POA irradiance as input with the diffuse shading losses forces SAM to use a POA decomposition model to calculate incident diffuse irradiance", SSC_WARNING, -1.0f);
+					Subarrays[nn]->poa.usePOAFromWF = false;
+				}
+			}
 
-					//self-shading calculations
-					if (((Subarrays[nn]->trackMode == 0 || Subarrays[nn]->trackMode == 4) && (Subarrays[nn]->shadeMode == 1 || Subarrays[nn]->shadeMode == 2)) //fixed tilt or timeseries tilt, self-shading (linear or non-linear) OR
-						|| (Subarrays[nn]->trackMode == 1 && (Subarrays[nn]->shadeMode == 1 || Subarrays[nn]->shadeMode == 2) && Subarrays[nn]->backtrackingEnabled == 0)) //one-axis tracking, self-shading, not backtracking
-					{
+			double beam_shading_factor = Subarrays[nn]->shadeCalculator.beam_shade_factor();
 
-						if (radmode == irrad::POA_R || radmode == irrad::POA_P){
-							if (idx == 0)
-								log("Combining POA irradiance as input with self shading forces SAM to employ a POA decomposition model to calculate incident beam irradiance", SSC_WARNING);
-							Subarrays[nn]->poa.usePOAFromWF = false;
-						}
+			//self-shading calculations
+			if (((Subarrays[nn]->trackMode == 0 || Subarrays[nn]->trackMode == 4) && (Subarrays[nn]->shadeMode == 1 || Subarrays[nn]->shadeMode == 2)) //fixed tilt or timeseries tilt, self-shading (linear or non-linear) OR
+				|| (Subarrays[nn]->trackMode == 1 && (Subarrays[nn]->shadeMode == 1 || Subarrays[nn]->shadeMode == 2) && Subarrays[nn]->backtrackingEnabled == 0)) //one-axis tracking, self-shading, not backtracking
+			{
 
-						// info to be passed to self-shading function
-						bool trackbool = (Subarrays[nn]->trackMode == 1);	// 0 for fixed tilt and timeseries tilt, 1 for one-axis
-						bool linear = (Subarrays[nn]->shadeMode == 2); //0 for full self-shading, 1 for linear self-shading
+				if (radmode == irrad::POA_R || radmode == irrad::POA_P){
+					if (idx == 0)
+						defer_log(task, s, "Combining POA irradiance as input with self shading forces SAM to employ a POA decomposition model to calculate incident beam irradiance", SSC_WARNING, -1.0f);
+					Subarrays[nn]->poa.usePOAFromWF = false;
+				}
 
-						//geometric fraction of the array that is shaded for one-axis trackers.
-						//USES A DIFFERENT FUNCTION THAN THE SELF-SHADING BECAUSE SS IS MEANT FOR FIXED ONLY. shadeFraction1x IS FOR ONE-AXIS TRACKERS ONLY.
-						//used in the non-linear self-shading calculator for one-axis tracking only
-						double shad1xf = 0;
-						if (trackbool)
-							shad1xf = shadeFraction1x(solazi, solzen, Subarrays[nn]->tiltDegrees, Subarrays[nn]->azimuthDegrees, Subarrays[nn]->groundCoverageRatio, rot);
+				// info to be passed to self-shading function
+				bool trackbool = (Subarrays[nn]->trackMode == 1);	// 0 for fixed tilt and timeseries tilt, 1 for one-axis
+				bool linear = (Subarrays[nn]->shadeMode == 2); //0 for full self-shading, 1 for linear self-shading
 
-						//execute self-shading calculations
-						ssc_number_t beam_to_use; //some self-shading calculations require DNI, NOT ibeam (beam in POA). Need to know whether to use DNI from wf or calculated, depending on radmode
-						if (radmode == irrad::DN_DF || radmode == irrad::DN_GH) beam_to_use = (ssc_number_t)wf.dn;
-						else beam_to_use = Irradiance->p_IrradianceCalculated[2][hour * step_per_hour]; // top of hour in first year
+				//geometric fraction of the array that is shaded for one-axis trackers.
+				//USES A DIFFERENT FUNCTION THAN THE SELF-SHADING BECAUSE SS IS MEANT FOR FIXED ONLY. shadeFraction1x IS FOR ONE-AXIS TRACKERS ONLY.
+				//used in the non-linear self-shading calculator for one-axis tracking only
+				double shad1xf = 0;
+				if (trackbool)
+					shad1xf = shadeFraction1x(solazi, solzen, Subarrays[nn]->tiltDegrees, Subarrays[nn]->azimuthDegrees, Subarrays[nn]->groundCoverageRatio, rot);
 
-						if (linear && trackbool) //one-axis linear
-						{
-							ibeam *= (1 - shad1xf); //derate beam irradiance linearly by the geometric shading fraction calculated above per Chris Deline 2/10/16
-							beam_shading_factor *= (1 - shad1xf);
-							if (iyear == 0)
-							{
-								PVSystem->p_derateSelfShading[nn][idx] = (ssc_number_t)1;
-								PVSystem->p_derateLinear[nn][idx] = (ssc_number_t)(1 - shad1xf);
-								PVSystem->p_derateSelfShadingDiffuse[nn][idx] = (ssc_number_t)1; //no diffuse derate for linear shading
-								PVSystem->p_derateSelfShadingReflected[nn][idx] = (ssc_number_t)1; //no reflected derate for linear shading
-							}
-						}
+				//execute self-shading calculations
+				ssc_number_t beam_to_use; //some self-shading calculations require DNI, NOT ibeam (beam in POA). Need to know whether to use DNI from wf or calculated, depending on radmode
+				if (radmode == irrad::DN_DF || radmode == irrad::DN_GH) beam_to_use = (ssc_number_t)wf.dn;
+				else if (radmode == irrad::GH_DF) beam_to_use = block_steps[nn][s - jj].beamCalculated; // top of hour
+				else beam_to_use = Irradiance->p_IrradianceCalculated[2][hour * step_per_hour]; // top of hour in first year
 
-						else if (ss_exec(Subarrays[nn]->selfShadingInputs, stilt, sazi, solzen, solazi, beam_to_use, ibeam, (iskydiff + ignddiff), alb, trackbool, linear, shad1xf, Subarrays[nn]->selfShadingOutputs))
-						{
-							if (linear) //fixed tilt linear
-							{
-								ibeam *= (1 - Subarrays[nn]->selfShadingOutputs.m_shade_frac_fixed);
-								beam_shading_factor *= (1 - Subarrays[nn]->selfShadingOutputs.m_shade_frac_fixed);
-								if (iyear == 0)
-								{
-									PVSystem->p_derateSelfShading[nn][idx] = (ssc_number_t)1;
-									PVSystem->p_derateLinear[nn][idx] = (ssc_number_t)(1 - Subarrays[nn]->selfShadingOutputs.m_shade_frac_fixed);
-									PVSystem->p_derateSelfShadingDiffuse[nn][idx] = (ssc_number_t)1; //no diffuse derate for linear shading
-									PVSystem->p_derateSelfShadingReflected[nn][idx] = (ssc_number_t)1; //no reflected derate for linear shading
-								}
-							}
-							else //non-linear: fixed tilt AND one-axis
-							{
-								if (iyear == 0)
-								{
-									PVSystem->p_derateSelfShadingDiffuse[nn][idx] = (ssc_number_t)Subarrays[nn]->selfShadingOutputs.m_diffuse_derate;
-									PVSystem->p_derateSelfShadingReflected[nn][idx] = (ssc_number_t)Subarrays[nn]->selfShadingOutputs.m_reflected_derate;
-									PVSystem->p_derateSelfShading[nn][idx] = (ssc_number_t)Subarrays[nn]->selfShadingOutputs.m_dc_derate;
-									PVSystem->p_derateLinear[nn][idx] = (ssc_number_t)1;
-								}
-
-								// Sky diffuse and ground-reflected diffuse are derated according to C. Deline's algorithm
-								iskydiff *= Subarrays[nn]->selfShadingOutputs.m_diffuse_derate;
-								ignddiff *= Subarrays[nn]->selfShadingOutputs.m_reflected_derate;
-								// Beam is not derated- all beam derate effects (linear and non-linear) are taken into account in the nonlinear_dc_shading_derate
-								Subarrays[nn]->poa.nonlinearDCShadingDerate = Subarrays[nn]->selfShadingOutputs.m_dc_derate;
-							}
-						}
-						else
-							throw exec_error("pvsamv1", util::format("Self-shading calculation failed at %d", (int)idx));
+				if (linear && trackbool) //one-axis linear
+				{
+					ibeam *= (1 - shad1xf); //derate beam irradiance linearly by the geometric shading fraction calculated above per Chris Deline 2/10/16
+					beam_shading_factor *= (1 - shad1xf);
+					if (iyear == 0)
+					{
+						PVSystem->p_derateSelfShading[nn][idx] = (ssc_number_t)1;
+						PVSystem->p_derateLinear[nn][idx] = (ssc_number_t)(1 - shad1xf);
+						PVSystem->p_derateSelfShadingDiffuse[nn][idx] = (ssc_number_t)1; //no diffuse derate for linear shading
+						PVSystem->p_derateSelfShadingReflected[nn][idx] = (ssc_number_t)1; //no reflected derate for linear shading
 					}
+				}
 
-					double poashad = (radmode == irrad::POA_R) ? ipoa[nn] : (ibeam + iskydiff + ignddiff);
-
-					// determine sub-array contribution to total shaded plane of array for this hour
-					ts_accum_poa_front_shaded += poashad * ref_area_m2 * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
-
-					// apply soiling derate to all components of irradiance
-					double soiling_factor = 1.0;
-					int month_idx = wf.month - 1;
-					if (month_idx >= 0 && month_idx < 12)
+				else if (ss_exec(Subarrays[nn]->selfShadingInputs, stilt, sazi, solzen, solazi, beam_to_use, ibeam, (iskydiff + ignddiff), alb, trackbool, linear, shad1xf, Subarrays[nn]->selfShadingOutputs))
+				{
+					if (linear) //fixed tilt linear
 					{
-						soiling_factor = Subarrays[nn]->monthlySoiling[month_idx];
-						ibeam *= soiling_factor;
-						iskydiff *= soiling_factor;
-						ignddiff *= soiling_factor;
-						if (radmode == irrad::POA_R || radmode == irrad::POA_P){
-							ipoa[nn] *= soiling_factor;
-							if (soiling_factor < 1 && idx == 0)
-								log("Soiling may already be accounted for in the input POA data. Please confirm that the input data does not contain soiling effects, or remove the additional losses on the Losses page.", SSC_WARNING);
+						ibeam *= (1 - Subarrays[nn]->selfShadingOutputs.m_shade_frac_fixed);
+						beam_shading_factor *= (1 - Subarrays[nn]->selfShadingOutputs.m_shade_frac_fixed);
+						if (iyear == 0)
+						{
+							PVSystem->p_derateSelfShading[nn][idx] = (ssc_number_t)1;
+							PVSystem->p_derateLinear[nn][idx] = (ssc_number_t)(1 - Subarrays[nn]->selfShadingOutputs.m_shade_frac_fixed);
+							PVSystem->p_derateSelfShadingDiffuse[nn][idx] = (ssc_number_t)1; //no diffuse derate for linear shading
+							PVSystem->p_derateSelfShadingReflected[nn][idx] = (ssc_number_t)1; //no reflected derate for linear shading
 						}
-						beam_shading_factor *= soiling_factor;
 					}
-
-					// Calculate total front irradiation after soiling added to shading
-					ipoa_front[nn] = ibeam + iskydiff + ignddiff;
-					ts_accum_poa_front_shaded_soiled += ipoa_front[nn] * ref_area_m2 * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
-					
-					// Calculate rear-side irradiance for bifacial modules
-					if (Subarrays[0]->Module->isBifacial)
+					else //non-linear: fixed tilt AND one-axis
 					{
-						double slopeLength = Subarrays[nn]->selfShadingInputs.length * Subarrays[nn]->selfShadingInputs.nmody;
-						if (Subarrays[nn]->selfShadingInputs.mod_orient == 1) {
-							slopeLength = Subarrays[nn]->selfShadingInputs.width * Subarrays[nn]->selfShadingInputs.nmody;
+						if (iyear == 0)
+						{
+							PVSystem->p_derateSelfShadingDiffuse[nn][idx] = (ssc_number_t)Subarrays[nn]->selfShadingOutputs.m_diffuse_derate;
+							PVSystem->p_derateSelfShadingReflected[nn][idx] = (ssc_number_t)Subarrays[nn]->selfShadingOutputs.m_reflected_derate;
+							PVSystem->p_derateSelfShading[nn][idx] = (ssc_number_t)Subarrays[nn]->selfShadingOutputs.m_dc_derate;
+							PVSystem->p_derateLinear[nn][idx] = (ssc_number_t)1;
 						}
-						irr.calc_rear_side(Subarrays[0]->Module->bifacialTransmissionFactor, Subarrays[0]->Module->bifaciality, Subarrays[0]->Module->groundClearanceHeight, slopeLength);
-						ipoa_rear[nn] = irr.get_poa_rear();
-						ipoa_rear_after_losses[nn] = ipoa_rear[nn] * (1 - Subarrays[nn]->rearIrradianceLossPercent);
+
+						// Sky diffuse and ground-reflected diffuse are derated according to C. Deline's algorithm
+						iskydiff *= Subarrays[nn]->selfShadingOutputs.m_diffuse_derate;
+						ignddiff *= Subarrays[nn]->selfShadingOutputs.m_reflected_derate;
+						// Beam is not derated- all beam derate effects (linear and non-linear) are taken into account in the nonlinear_dc_shading_derate
+						Subarrays[nn]->poa.nonlinearDCShadingDerate = Subarrays[nn]->selfShadingOutputs.m_dc_derate;
 					}
+				}
+				else
+					throw exec_error("pvsamv1", util::format("Self-shading calculation failed at %d", (int)idx));
+			}
 
-					ts_accum_poa_rear += ipoa_rear[nn] * ref_area_m2 * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
-					ts_accum_poa_rear_after_losses = ts_accum_poa_rear * (1 - Subarrays[nn]->rearIrradianceLossPercent);
+			double poashad = (radmode == irrad::POA_R) ? step.ipoa : (ibeam + iskydiff + ignddiff);
 
-					if (iyear == 0) 
-					{
-						// save sub-array level outputs			
-						PVSystem->p_poaShadedFront[nn][idx] = (ssc_number_t)poashad;
-						PVSystem->p_poaShadedSoiledFront[nn][idx] = (ssc_number_t)ipoa_front[nn];
-						PVSystem->p_poaBeamFront[nn][idx] = (ssc_number_t)ibeam;
-						PVSystem->p_poaDiffuseFront[nn][idx] = (ssc_number_t)(iskydiff + ignddiff);
-						PVSystem->p_poaRear[nn][idx] = (ssc_number_t)(ipoa_rear_after_losses[nn]);
-						PVSystem->p_beamShadingFactor[nn][idx] = (ssc_number_t)beam_shading_factor;
-						PVSystem->p_axisRotation[nn][idx] = (ssc_number_t)rot;
-						PVSystem->p_idealRotation[nn][idx] = (ssc_number_t)(rot - btd);
-						PVSystem->p_angleOfIncidence[nn][idx] = (ssc_number_t)aoi;
-						PVSystem->p_surfaceTilt[nn][idx] = (ssc_number_t)stilt;
-						PVSystem->p_surfaceAzimuth[nn][idx] = (ssc_number_t)sazi;
-						PVSystem->p_derateSoiling[nn][idx] = (ssc_number_t)soiling_factor;
-					}
+			// determine sub-array contribution to total shaded plane of array for this hour
+			step.poaFrontShadedW = poashad * ref_area_m2 * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
 
-					// accumulate incident total radiation (W) in this timestep (all subarrays)
-					ts_accum_poa_front_beam_eff += ibeam * ref_area_m2 * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
-
-					// save the required irradiance inputs on array plane for the module output calculations.
-					Subarrays[nn]->poa.poaBeamFront = ibeam;
-					Subarrays[nn]->poa.poaDiffuseFront = iskydiff;
-					Subarrays[nn]->poa.poaGroundFront = ignddiff;
-					Subarrays[nn]->poa.poaRear = ipoa_rear_after_losses[nn];
-					Subarrays[nn]->poa.poaTotal = (radmode == irrad::POA_R) ? ipoa[nn] :(ipoa_front[nn] + ipoa_rear_after_losses[nn]);
-					Subarrays[nn]->poa.angleOfIncidenceDegrees = aoi;
-					Subarrays[nn]->poa.sunUp = sunup;
-					Subarrays[nn]->poa.surfaceTiltDegrees = stilt;
-					Subarrays[nn]->poa.surfaceAzimuthDegrees = sazi;
+			// apply soiling derate to all components of irradiance
+			double soiling_factor = 1.0;
+			int month_idx = wf.month - 1;
+			if (month_idx >= 0 && month_idx < 12)
+			{
+				soiling_factor = Subarrays[nn]->monthlySoiling[month_idx];
+				ibeam *= soiling_factor;
+				iskydiff *= soiling_factor;
+				ignddiff *= soiling_factor;
+				if (radmode == irrad::POA_R || radmode == irrad::POA_P){
+					step.ipoa *= soiling_factor;
+					if (soiling_factor < 1 && idx == 0)
+						defer_log(task, s, "Soiling may already be accounted for in the input POA data. Please confirm that the input data does not contain soiling effects, or remove the additional losses on the Losses page.", SSC_WARNING, -1.0f);
 				}
+				beam_shading_factor *= soiling_factor;
+			}
 
-				std::vector<double> mpptVoltageClipping; //a vector to store power that is clipped due to the inverter MPPT low & high voltage limits for each subarray
-				for (size_t nn = 0; nn < PVSystem->numberOfSubarrays; nn++) {
-					mpptVoltageClipping.push_back(0.0);
+			// Calculate total front irradiation after soiling added to shading
+			step.ipoaFront = ibeam + iskydiff + ignddiff;
+			step.poaFrontShadedSoiledW = step.ipoaFront * ref_area_m2 * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
+			
+			// Calculate rear-side irradiance for bifacial modules
+			if (Subarrays[0]->Module->isBifacial)
+			{
+				double slopeLength = Subarrays[nn]->selfShadingInputs.length * Subarrays[nn]->selfShadingInputs.nmody;
+				if (Subarrays[nn]->selfShadingInputs.mod_orient == 1) {
+					slopeLength = Subarrays[nn]->selfShadingInputs.width * Subarrays[nn]->selfShadingInputs.nmody;
 				}
+				irr.calc_rear_side(Subarrays[0]->Module->bifacialTransmissionFactor, Subarrays[0]->Module->bifaciality, Subarrays[0]->Module->groundClearanceHeight, slopeLength);
+				step.ipoaRear = irr.get_poa_rear();
+				step.ipoaRearAfterLosses = step.ipoaRear * (1 - Subarrays[nn]->rearIrradianceLossPercent);
+			}
 
-				//Calculate power of each MPPT input
-				for (size_t mpptInput = 0; mpptInput < PVSystem->Inverter->nMpptInputs; mpptInput++) //remember that actual named mppt inputs are 1-indexed, and these are 0-indexed
-				{
-					int nSubarraysOnMpptInput = (int)(PVSystem->mpptMapping[mpptInput].size()); //number of subarrays attached to this MPPT input
-					std::vector<int> SubarraysOnMpptInput = PVSystem->mpptMapping[mpptInput]; //vector of which subarrays are attached to this MPPT input
-
-					//string voltage for this MPPT input- if 1 subarray, this will be the string voltage. if >1 subarray and mismatch enabled, this
-					//will be the string voltage found by the mismatch calculation. if >1 subarray and mismatch not enabled, this will be the average
-					//voltage of the strings from all the subarrays on this mppt input.
-					//initialize it as -1 and check for that later
-					double stringVoltage = -1;
-
-					//mismatch calculations assume that the inverter MPPT operates all strings on that MPPT input at the same voltage.
-					//this algorithm sweeps across a range of string voltages, calculating total power for all strings on this MPPT input at each voltage.
-					//it finds the maximum total power of all string voltages swept, then uses that in subsequent power calculations for each subarray. 
-					if (PVSystem->enableMismatchVoltageCalc)
-					{
-						double vmax = PVSystem->Inverter->mpptHiVoltage; //the upper MPPT range of the inverter is the high end for string voltages that it will control
-						double vmin = PVSystem->Inverter->mpptLowVoltage; //the lower MPPT range of the inverter is the low end for string voltages that it will control
-						const int NP = 100; //number of points in between max and min voltage to sweep
-						double Pmax = 0; //variable to store the maximum power for comparison between different points along the voltage sweep
-						// sweep voltage, calculating current for each subarray, add all subarray currents together at each voltage
-						for (int i = 0; i < NP; i++)
-						{
-							double stringV = vmin + (vmax - vmin)*i / ((double)NP); //voltage of a string at this point in the voltage sweep							
-
-							//if the voltage is ok, continue to calculate total power on this MPPT input at this voltage
-							double P = 0; //temporary variable to store the total power on this MPPT input at this voltage
-							for (int nSubarray = 0; nSubarray < nSubarraysOnMpptInput; nSubarray++) //sweep across all subarrays connected to this MPPT input
-							{
-								int nn = SubarraysOnMpptInput[nSubarray]; //get the index of the subarray we're checking here
-								double V = stringV / (double)Subarrays[nn]->nModulesPerString; //voltage of an individual module on a string on this subarray
-
-								//initalize pvinput and pvoutput structures for the model
-								pvinput_t in(Subarrays[nn]->poa.poaBeamFront, Subarrays[nn]->poa.poaDiffuseFront, Subarrays[nn]->poa.poaGroundFront, Subarrays[nn]->poa.poaRear, Subarrays[nn]->poa.poaTotal,
-									wf.tdry, wf.tdew, wf.wspd, wf.wdir, wf.pres,
-									solzen, Subarrays[nn]->poa.angleOfIncidenceDegrees, hdr.elev,
-									Subarrays[nn]->poa.surfaceTiltDegrees, Subarrays[nn]->poa.surfaceAzimuthDegrees,
-									((double)wf.hour) + wf.minute / 60.0,
-									radmode, Subarrays[nn]->poa.usePOAFromWF);
-								pvoutput_t out(0, 0, 0, 0, 0, 0, 0, 0);
-
-								//calculate the output power for one module in this subarray at this voltage
-								if (Subarrays[nn]->poa.sunUp)
-								{
-									double tcell = wf.tdry;
-									// calculate cell temperature using selected temperature model
-									(*Subarrays[nn]->Module->cellTempModel)(in, *Subarrays[nn]->Module->moduleModel, V, tcell);
-									// calculate module power output using conversion model previously specified
-									(*Subarrays[nn]->Module->moduleModel)(in, tcell, V, out);
-								}
-								//add the power from this subarray to the total power
-								P += V * out.Current * (double)Subarrays[nn]->nModulesPerString * (double)Subarrays[nn]->nStrings;
-							}
-
-							//check if the total power at this voltage is higher than the power values we've calculated before, if so, set it as the new max
-							if (P > Pmax)
-							{
-								Pmax = P;
-								stringVoltage = stringV;
-							}
-						}
+			step.poaRearW = step.ipoaRear * ref_area_m2 * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
+
+			if (iyear == 0) 
+			{
+				// save sub-array level outputs			
+				PVSystem->p_poaShadedFront[nn][idx] = (ssc_number_t)poashad;
+				PVSystem->p_poaShadedSoiledFront[nn][idx] = (ssc_number_t)step.ipoaFront;
+				PVSystem->p_poaBeamFront[nn][idx] = (ssc_number_t)ibeam;
+				PVSystem->p_poaDiffuseFront[nn][idx] = (ssc_number_t)(iskydiff + ignddiff);
+				PVSystem->p_poaRear[nn][idx] = (ssc_number_t)(step.ipoaRearAfterLosses);
+				PVSystem->p_beamShadingFactor[nn][idx] = (ssc_number_t)beam_shading_factor;
+				PVSystem->p_axisRotation[nn][idx] = (ssc_number_t)rot;
+				PVSystem->p_idealRotation[nn][idx] = (ssc_number_t)(rot - btd);
+				PVSystem->p_angleOfIncidence[nn][idx] = (ssc_number_t)aoi;
+				PVSystem->p_surfaceTilt[nn][idx] = (ssc_number_t)stilt;
+				PVSystem->p_surfaceAzimuth[nn][idx] = (ssc_number_t)sazi;
+				PVSystem->p_derateSoiling[nn][idx] = (ssc_number_t)soiling_factor;
+			}
+
+			// sub-array contribution to incident beam radiation (W) in this timestep
+			step.poaFrontBeamEffW = ibeam * ref_area_m2 * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
+
+			// save the required irradiance inputs on array plane for the module output calculations.
+			Subarrays[nn]->poa.poaBeamFront = ibeam;
+			Subarrays[nn]->poa.poaDiffuseFront = iskydiff;
+			Subarrays[nn]->poa.poaGroundFront = ignddiff;
+			Subarrays[nn]->poa.poaRear = step.ipoaRearAfterLosses;
+			Subarrays[nn]->poa.poaTotal = (radmode == irrad::POA_R) ? step.ipoa :(step.ipoaFront + step.ipoaRearAfterLosses);
+			Subarrays[nn]->poa.angleOfIncidenceDegrees = aoi;
+			Subarrays[nn]->poa.sunUp = sunup;
+			Subarrays[nn]->poa.surfaceTiltDegrees = stilt;
+			Subarrays[nn]->poa.surfaceAzimuthDegrees = sazi;
+
+			// keep the state of this step for the module power calculation
+			step.poaBeamFront = Subarrays[nn]->poa.poaBeamFront;
+			step.poaDiffuseFront = Subarrays[nn]->poa.poaDiffuseFront;
+			step.poaGroundFront = Subarrays[nn]->poa.poaGroundFront;
+			step.poaRear = Subarrays[nn]->poa.poaRear;
+			step.poaTotal = Subarrays[nn]->poa.poaTotal;
+			step.sunUp = Subarrays[nn]->poa.sunUp;
+			step.angleOfIncidenceDegrees = Subarrays[nn]->poa.angleOfIncidenceDegrees;
+			step.surfaceTiltDegrees = Subarrays[nn]->poa.surfaceTiltDegrees;
+			step.surfaceAzimuthDegrees = Subarrays[nn]->poa.surfaceAzimuthDegrees;
+			step.nonlinearDCShadingDerate = Subarrays[nn]->poa.nonlinearDCShadingDerate;
+			step.usePOAFromWF = Subarrays[nn]->poa.usePOAFromWF;
+			step.dcShadeFactor = Subarrays[nn]->shadeCalculator.dc_shade_factor();
+			step.solazi = solazi;
+			step.solzen = solzen;
+			step.solalt = solalt;
+			step.sunup = sunup;
+			step.alb = alb;
+		};
+
+		// module power of MPPT input mpptInput and DC derates of its subarrays at step s of the block
+		auto calculate_mppt_power = [&](size_t mpptInput, size_t s)
+		{
+			size_t idx = block_idx + s;
+			const weather_record &wf = block_weather[s];
+			double solzen = block_steps[last_subarray][s].solzen;
+			int sunup = block_steps[last_subarray][s].sunup;
+			dc_block_task &task = mppt_tasks[mpptInput];
+			task.errorStage = 1;
+			task.errorRank = mpptInput;
+
+			int nSubarraysOnMpptInput = (int)(PVSystem->mpptMapping[mpptInput].size()); //number of subarrays attached to this MPPT input
+			std::vector<int> SubarraysOnMpptInput = PVSystem->mpptMapping[mpptInput]; //vector of which subarrays are attached to this MPPT input
+
+			// restore the plane-of-array irradiance of this step
+			for (int nSubarray = 0; nSubarray < nSubarraysOnMpptInput; nSubarray++)
+			{
+				int nn = SubarraysOnMpptInput[nSubarray];
+				dc_subarray_step &step = block_steps[nn][s];
+				step.mpptVoltageClipping = 0;
+				step.snowLoss_kW = 0;
+				if (!subarrayCalculated[nn])
+					continue;
+				Subarrays[nn]->poa.poaBeamFront = step.poaBeamFront;
+				Subarrays[nn]->poa.poaDiffuseFront = step.poaDiffuseFront;
+				Subarrays[nn]->poa.poaGroundFront = step.poaGroundFront;
+				Subarrays[nn]->poa.poaRear = step.poaRear;
+				Subarrays[nn]->poa.poaTotal = step.poaTotal;
+				Subarrays[nn]->poa.sunUp = step.sunUp;
+				Subarrays[nn]->poa.angleOfIncidenceDegrees = step.angleOfIncidenceDegrees;
+				Subarrays[nn]->poa.surfaceTiltDegrees = step.surfaceTiltDegrees;
+				Subarrays[nn]->poa.surfaceAzimuthDegrees = step.surfaceAzimuthDegrees;
+				Subarrays[nn]->poa.nonlinearDCShadingDerate = step.nonlinearDCShadingDerate;
+				Subarrays[nn]->poa.usePOAFromWF = step.usePOAFromWF;
+			}
+
+			//string voltage for this MPPT input- if 1 subarray, this will be the string voltage. if >1 subarray and mismatch enabled, this
+			//will be the string voltage found by the mismatch calculation. if >1 subarray and mismatch not enabled, this will be the average
+			//voltage of the strings from all the subarrays on this mppt input.
+			//initialize it as -1 and check for that later
+			double stringVoltage = -1;
 
-					} //now we have the string voltage at which the MPPT input will produce max power, to be used in subsequent calcs
+			//mismatch calculations assume that the inverter MPPT operates all strings on that MPPT input at the same voltage.
+			//this algorithm sweeps across a range of string voltages, calculating total power for all strings on this MPPT input at each voltage.
+			//it finds the maximum total power of all string voltages swept, then uses that in subsequent power calculations for each subarray. 
+			if (PVSystem->enableMismatchVoltageCalc)
+			{
+				double vmax = PVSystem->Inverter->mpptHiVoltage; //the upper MPPT range of the inverter is the high end for string voltages that it will control
+				double vmin = PVSystem->Inverter->mpptLowVoltage; //the lower MPPT range of the inverter is the low end for string voltages that it will control
+				const int NP = 100; //number of points in between max and min voltage to sweep
+				double Pmax = 0; //variable to store the maximum power for comparison between different points along the voltage sweep
+				// sweep voltage, calculating current for each subarray, add all subarray currents together at each voltage
+				for (int i = 0; i < NP; i++)
+				{
+					double stringV = vmin + (vmax - vmin)*i / ((double)NP); //voltage of a string at this point in the voltage sweep							
 
-					//now calculate power for each subarray on this mppt input. stringVoltage will still be -1 if mismatch calcs aren't enabled, or the value decided by mismatch calcs if they are enabled
-					std::vector<pvinput_t> in{ num_subarrays }; //create arrays for the pv input and output structures because we have to deal with them in multiple loops to check for MPPT clipping
-					std::vector<pvoutput_t> out{ num_subarrays };
-					double tcell = wf.tdry;
+					//if the voltage is ok, continue to calculate total power on this MPPT input at this voltage
+					double P = 0; //temporary variable to store the total power on this MPPT input at this voltage
 					for (int nSubarray = 0; nSubarray < nSubarraysOnMpptInput; nSubarray++) //sweep across all subarrays connected to this MPPT input
 					{
 						int nn = SubarraysOnMpptInput[nSubarray]; //get the index of the subarray we're checking here
+						double V = stringV / (double)Subarrays[nn]->nModulesPerString; //voltage of an individual module on a string on this subarray
+
 						//initalize pvinput and pvoutput structures for the model
-						pvinput_t in_temp(Subarrays[nn]->poa.poaBeamFront, Subarrays[nn]->poa.poaDiffuseFront, Subarrays[nn]->poa.poaGroundFront, Subarrays[nn]->poa.poaRear, Subarrays[nn]->poa.poaTotal,
+						pvinput_t in(Subarrays[nn]->poa.poaBeamFront, Subarrays[nn]->poa.poaDiffuseFront, Subarrays[nn]->poa.poaGroundFront, Subarrays[nn]->poa.poaRear, Subarrays[nn]->poa.poaTotal,
 							wf.tdry, wf.tdew, wf.wspd, wf.wdir, wf.pres,
 							solzen, Subarrays[nn]->poa.angleOfIncidenceDegrees, hdr.elev,
 							Subarrays[nn]->poa.surfaceTiltDegrees, Subarrays[nn]->poa.surfaceAzimuthDegrees,
 							((double)wf.hour) + wf.minute / 60.0,
 							radmode, Subarrays[nn]->poa.usePOAFromWF);
-						pvoutput_t out_temp(0, 0, 0, 0, 0, 0, 0, 0);
-						in[nn] = in_temp;
-						out[nn] = out_temp;					
-						
+						pvoutput_t out(0, 0, 0, 0, 0, 0, 0, 0);
+
+						//calculate the output power for one module in this subarray at this voltage
 						if (Subarrays[nn]->poa.sunUp)
 						{
-							//module voltage value to be passed into module power function. 
-							//if -1 is passed in, power will be calculated at max power point. 
-							//if a voltage value is passed in, power will be calculated at the specified voltage for all single-diode module models
-							double module_voltage = -1;
-							if (stringVoltage != -1) module_voltage = stringVoltage / (double)Subarrays[nn]->nModulesPerString;
+							double tcell = wf.tdry;
 							// calculate cell temperature using selected temperature model
+							(*Subarrays[nn]->Module->cellTempModel)(in, *Subarrays[nn]->Module->moduleModel, V, tcell);
 							// calculate module power output using conversion model previously specified
-							(*Subarrays[nn]->Module->cellTempModel)(in[nn], *Subarrays[nn]->Module->moduleModel, module_voltage, tcell);
-							(*Subarrays[nn]->Module->moduleModel)(in[nn], tcell, module_voltage, out[nn]);
+							(*Subarrays[nn]->Module->moduleModel)(in, tcell, V, out);
 						}
+						//add the power from this subarray to the total power
+						P += V * out.Current * (double)Subarrays[nn]->nModulesPerString * (double)Subarrays[nn]->nStrings;
+					}
+
+					//check if the total power at this voltage is higher than the power values we've calculated before, if so, set it as the new max
+					if (P > Pmax)
+					{
+						Pmax = P;
+						stringVoltage = stringV;
 					}
+				}
+
+			} //now we have the string voltage at which the MPPT input will produce max power, to be used in subsequent calcs
+
+			//now calculate power for each subarray on this mppt input. stringVoltage will still be -1 if mismatch calcs aren't enabled, or the value decided by mismatch calcs if they are enabled
+			std::vector<pvinput_t> in{ num_subarrays }; //create arrays for the pv input and output structures because we have to deal with them in multiple loops to check for MPPT clipping
+			std::vector<pvoutput_t> out{ num_subarrays };
+			double tcell = wf.tdry;
+			for (int nSubarray = 0; nSubarray < nSubarraysOnMpptInput; nSubarray++) //sweep across all subarrays connected to this MPPT input
+			{
+				int nn = SubarraysOnMpptInput[nSubarray]; //get the index of the subarray we're checking here
+				//initalize pvinput and pvoutput structures for the model
+				pvinput_t in_temp(Subarrays[nn]->poa.poaBeamFront, Subarrays[nn]->poa.poaDiffuseFront, Subarrays[nn]->poa.poaGroundFront, Subarrays[nn]->poa.poaRear, Subarrays[nn]->poa.poaTotal,
+					wf.tdry, wf.tdew, wf.wspd, wf.wdir, wf.pres,
+					solzen, Subarrays[nn]->poa.angleOfIncidenceDegrees, hdr.elev,
+					Subarrays[nn]->poa.surfaceTiltDegrees, Subarrays[nn]->poa.surfaceAzimuthDegrees,
+					((double)wf.hour) + wf.minute / 60.0,
+					radmode, Subarrays[nn]->poa.usePOAFromWF);
+				pvoutput_t out_temp(0, 0, 0, 0, 0, 0, 0, 0);
+				in[nn] = in_temp;
+				out[nn] = out_temp;					
+				
+				if (Subarrays[nn]->poa.sunUp)
+				{
+					//module voltage value to be passed into module power function. 
+					//if -1 is passed in, power will be calculated at max power point. 
+					//if a voltage value is passed in, power will be calculated at the specified voltage for all single-diode module models
+					double module_voltage = -1;
+					if (stringVoltage != -1) module_voltage = stringVoltage / (double)Subarrays[nn]->nModulesPerString;
+					// calculate cell temperature using selected temperature model
+					// calculate module power output using conversion model previously specified
+					(*Subarrays[nn]->Module->cellTempModel)(in[nn], *Subarrays[nn]->Module->moduleModel, module_voltage, tcell);
+					(*Subarrays[nn]->Module->moduleModel)(in[nn], tcell, module_voltage, out[nn]);
+				}
+			}
+
+			//assign input voltage at this MPPT input
+			//if mismatch was enabled, the voltage already was clipped to the inverter MPPT range as needed and  
+			//the string voltage is the same for all subarrays, so the voltage at the MPPT input is the same as the string voltage of any subarray
+			if (PVSystem->enableMismatchVoltageCalc) {
+				PVSystem->p_mpptVoltage[mpptInput][idx] = (ssc_number_t)out[SubarraysOnMpptInput[0]].Voltage * Subarrays[SubarraysOnMpptInput[0]]->nModulesPerString;
+			}
+			//if mismatch wasn't enabled, we assume the MPPT input voltage is a weighted average of the string voltages on this MPPT input,
+			//and still need to check that average against the inverter MPPT bounds
+			else
+			{
+				//create temporary values to calculate the weighted average string voltage
+				double nStrings = 0;
+				double avgVoltage = 0;
+				for (int nSubarray = 0; nSubarray < nSubarraysOnMpptInput; nSubarray++)
+				{
+					int nn = SubarraysOnMpptInput[nSubarray]; //get the index of the subarray itself
+					nStrings += Subarrays[nn]->nStrings;
+					avgVoltage += out[nn].Voltage * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
+				}
+				avgVoltage /= nStrings;
+				PVSystem->p_mpptVoltage[mpptInput][idx] = (ssc_number_t)avgVoltage;
 
-					//assign input voltage at this MPPT input
-					//if mismatch was enabled, the voltage already was clipped to the inverter MPPT range as needed and  
-					//the string voltage is the same for all subarrays, so the voltage at the MPPT input is the same as the string voltage of any subarray
-					if (PVSystem->enableMismatchVoltageCalc) {
-						PVSystem->p_mpptVoltage[mpptInput][idx] = (ssc_number_t)out[SubarraysOnMpptInput[0]].Voltage * Subarrays[SubarraysOnMpptInput[0]]->nModulesPerString;
+				//check the weighted average string voltage against the inverter MPPT bounds
+				bool recalculatePower = false;
+				if (PVSystem->clipMpptWindow)
+				{
+					if (avgVoltage < PVSystem->Inverter->mpptLowVoltage)
+					{
+						avgVoltage = PVSystem->Inverter->mpptLowVoltage;
+						recalculatePower = true;
+					}
+					else if (avgVoltage > PVSystem->Inverter->mpptHiVoltage)
+					{
+						avgVoltage = PVSystem->Inverter->mpptHiVoltage;
+						recalculatePower = true;
 					}
-					//if mismatch wasn't enabled, we assume the MPPT input voltage is a weighted average of the string voltages on this MPPT input,
-					//and still need to check that average against the inverter MPPT bounds
-					else
+					
+					//if MPPT clipping occurs, we need to recalculate the module power for each subarray
+					if (recalculatePower)
 					{
-						//create temporary values to calculate the weighted average string voltage
-						double nStrings = 0;
-						double avgVoltage = 0;
-						for (int nSubarray = 0; nSubarray < nSubarraysOnMpptInput; nSubarray++)
+						for (int nSubarray = 0; nSubarray < nSubarraysOnMpptInput; nSubarray++) //sweep across all subarrays connected to this MPPT input
 						{
-							int nn = SubarraysOnMpptInput[nSubarray]; //get the index of the subarray itself
-							nStrings += Subarrays[nn]->nStrings;
-							avgVoltage += out[nn].Voltage * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
-						}
-						avgVoltage /= nStrings;
-						PVSystem->p_mpptVoltage[mpptInput][idx] = (ssc_number_t)avgVoltage;
+							int nn = SubarraysOnMpptInput[nSubarray]; //get the index of the subarray we're checking here
+							dc_subarray_step &step = block_steps[nn][s];
 
-						//check the weighted average string voltage against the inverter MPPT bounds
-						bool recalculatePower = false;
-						if (PVSystem->clipMpptWindow)
-						{
-							if (avgVoltage < PVSystem->Inverter->mpptLowVoltage)
-							{
-								avgVoltage = PVSystem->Inverter->mpptLowVoltage;
-								recalculatePower = true;
-							}
-							else if (avgVoltage > PVSystem->Inverter->mpptHiVoltage)
-							{
-								avgVoltage = PVSystem->Inverter->mpptHiVoltage;
-								recalculatePower = true;
-							}
-							
-							//if MPPT clipping occurs, we need to recalculate the module power for each subarray
-							if (recalculatePower)
-							{
-								for (int nSubarray = 0; nSubarray < nSubarraysOnMpptInput; nSubarray++) //sweep across all subarrays connected to this MPPT input
-								{
-									int nn = SubarraysOnMpptInput[nSubarray]; //get the index of the subarray we're checking here
-
-									if (iyear == 0) mpptVoltageClipping[nn] = out[nn].Power; //initialize the voltage clipping loss with the power at module MPP, subtract from this later for the actual MPPT clipping loss
-
-									//recalculate power at the correct voltage
-									double module_voltage = avgVoltage / (double)Subarrays[nn]->nModulesPerString;
-									(*Subarrays[nn]->Module->cellTempModel)(in[nn], *Subarrays[nn]->Module->moduleModel, module_voltage, tcell);
-									(*Subarrays[nn]->Module->moduleModel)(in[nn], tcell, module_voltage, out[nn]);
-
-									if (iyear == 0)	mpptVoltageClipping[nn] -= out[nn].Power; //subtract the power that remains after voltage clipping in order to get the total loss. if no power was lost, all the power will be subtracted away again.
-								}
-							}
+							if (iyear == 0) step.mpptVoltageClipping = out[nn].Power; //initialize the voltage clipping loss with the power at module MPP, subtract from this later for the actual MPPT clipping loss
+
+							//recalculate power at the correct voltage
+							double module_voltage = avgVoltage / (double)Subarrays[nn]->nModulesPerString;
+							(*Subarrays[nn]->Module->cellTempModel)(in[nn], *Subarrays[nn]->Module->moduleModel, module_voltage, tcell);
+							(*Subarrays[nn]->Module->moduleModel)(in[nn], tcell, module_voltage, out[nn]);
+
+							if (iyear == 0)	step.mpptVoltageClipping -= out[nn].Power; //subtract the power that remains after voltage clipping in order to get the total loss. if no power was lost, all the power will be subtracted away again.
 						}
 					}
+				}
+			}
 
-					//now that we have the correct power for all subarrays, subject to inverter MPPT clipping, save outputs 
-					for (int nSubarray = 0; nSubarray < nSubarraysOnMpptInput; nSubarray++) //sweep across all subarrays connected to this MPPT input
-					{
-						int nn = SubarraysOnMpptInput[nSubarray]; //get the index of the subarray we're checking here
+			//now that we have the correct power for all subarrays, subject to inverter MPPT clipping, save outputs 
+			for (int nSubarray = 0; nSubarray < nSubarraysOnMpptInput; nSubarray++) //sweep across all subarrays connected to this MPPT input
+			{
+				int nn = SubarraysOnMpptInput[nSubarray]; //get the index of the subarray we're checking here
+				dc_subarray_step &step = block_steps[nn][s];
 
-						//check for weird results
-						if (out[nn].Voltage > Subarrays[nn]->Module->moduleModel->VocRef()*1.3)
-							log(util::format("Module voltage is unrealistically high (exceeds 1.3*VocRef) at [mdhm: %d %d %d %lg]: %lg V\n", wf.month, wf.day, wf.hour, wf.minute, out[nn].Voltage), SSC_NOTICE);
-						if (!std::isfinite(out[nn].Power))
-						{
-							out[nn].Power = 0;
-							out[nn].Voltage = 0;
-							out[nn].Current = 0;
-							out[nn].Efficiency = 0;
-							out[nn].CellTemp = tcell;
-							log(util::format("Non-finite power output calculated at [mdhm: %d %d %d %lg], set to zero.\n"
-								"could be due to anomolous equation behavior at very low irradiances (poa: %lg W/m2)",
-								wf.month, wf.day, wf.hour, wf.minute, Subarrays[nn]->poa.poaTotal), SSC_NOTICE);
-						}
+				//check for weird results
+				if (out[nn].Voltage > Subarrays[nn]->Module->moduleModel->VocRef()*1.3)
+					defer_log(task, s, util::format("Module voltage is unrealistically high (exceeds 1.3*VocRef) at [mdhm: %d %d %d %lg]: %lg V\n", wf.month, wf.day, wf.hour, wf.minute, out[nn].Voltage), SSC_NOTICE, -1.0f);
+				if (!std::isfinite(out[nn].Power))
+				{
+					out[nn].Power = 0;
+					out[nn].Voltage = 0;
+					out[nn].Current = 0;
+					out[nn].Efficiency = 0;
+					out[nn].CellTemp = tcell;
+					defer_log(task, s, util::format("Non-finite power output calculated at [mdhm: %d %d %d %lg], set to zero.\n"
+						"could be due to anomolous equation behavior at very low irradiances (poa: %lg W/m2)",
+						wf.month, wf.day, wf.hour, wf.minute, Subarrays[nn]->poa.poaTotal), SSC_NOTICE, -1.0f);
+				}
 
-						// save DC module outputs for this subarray
-						Subarrays[nn]->Module->dcPowerW = out[nn].Power;
-						Subarrays[nn]->Module->dcEfficiency = out[nn].Efficiency * 100;
-						Subarrays[nn]->Module->dcVoltage = out[nn].Voltage;
-						Subarrays[nn]->Module->temperatureCellCelcius = out[nn].CellTemp;
-						Subarrays[nn]->Module->currentShortCircuit = out[nn].Isc_oper;
-						Subarrays[nn]->Module->voltageOpenCircuit = out[nn].Voc_oper;
-						Subarrays[nn]->Module->angleOfIncidenceModifier = out[nn].AOIModifier;
-						
-						// Lifetime dcStringVoltage
-						dcStringVoltage[nn].push_back(Subarrays[nn]->Module->dcVoltage * Subarrays[nn]->nModulesPerString);
-
-						// Output front-side irradiance after the reflection (IAM) loss - needs to be after the module model for now because reflection effects are part of the module model
-						if (iyear == 0)
-						{
-							ipoa_front[nn] *= out[nn].AOIModifier;
-							PVSystem->p_poaFront[nn][idx] = (radmode == irrad::POA_R) ? (ssc_number_t)ipoa[nn] : (ssc_number_t)(ipoa_front[nn]);
-							PVSystem->p_poaTotal[nn][idx] = (radmode == irrad::POA_R) ? (ssc_number_t)ipoa[nn] : (ssc_number_t)(ipoa_front[nn] + ipoa_rear[nn]);
+				// save DC module outputs for this subarray
+				Subarrays[nn]->Module->dcPowerW = out[nn].Power;
+				Subarrays[nn]->Module->dcEfficiency = out[nn].Efficiency * 100;
+				Subarrays[nn]->Module->dcVoltage = out[nn].Voltage;
+				Subarrays[nn]->Module->temperatureCellCelcius = out[nn].CellTemp;
+				Subarrays[nn]->Module->currentShortCircuit = out[nn].Isc_oper;
+				Subarrays[nn]->Module->voltageOpenCircuit = out[nn].Voc_oper;
+				Subarrays[nn]->Module->angleOfIncidenceModifier = out[nn].AOIModifier;
+				
+				// Lifetime dcStringVoltage
+				dcStringVoltage[nn].push_back(Subarrays[nn]->Module->dcVoltage * Subarrays[nn]->nModulesPerString);
 
-							ts_accum_poa_front_total += ipoa_front[nn] * ref_area_m2 * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
-							ts_accum_poa_total_eff += ((radmode == irrad::POA_R) ? ipoa[nn] : (ipoa_front[nn] + ipoa_rear_after_losses[nn])) * ref_area_m2 * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
+				// Output front-side irradiance after the reflection (IAM) loss - needs to be after the module model for now because reflection effects are part of the module model
+				if (iyear == 0)
+				{
+					step.ipoaFront *= out[nn].AOIModifier;
+					PVSystem->p_poaFront[nn][idx] = (radmode == irrad::POA_R) ? (ssc_number_t)step.ipoa : (ssc_number_t)(step.ipoaFront);
+					PVSystem->p_poaTotal[nn][idx] = (radmode == irrad::POA_R) ? (ssc_number_t)step.ipoa : (ssc_number_t)(step.ipoaFront + step.ipoaRear);
 
-							//assign final string voltage output
-							PVSystem->p_dcStringVoltage[nn][idx] = (ssc_number_t)Subarrays[nn]->Module->dcVoltage * Subarrays[nn]->nModulesPerString;
-						}
+					step.poaFrontTotalW = step.ipoaFront * ref_area_m2 * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
+					step.poaTotalEffW = ((radmode == irrad::POA_R) ? step.ipoa : (step.ipoaFront + step.ipoaRearAfterLosses)) * ref_area_m2 * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
+
+					//assign final string voltage output
+					PVSystem->p_dcStringVoltage[nn][idx] = (ssc_number_t)Subarrays[nn]->Module->dcVoltage * Subarrays[nn]->nModulesPerString;
+				}
+			}
+
+			for (int nSubarray = 0; nSubarray < nSubarraysOnMpptInput; nSubarray++)
+			{
+				int nn = SubarraysOnMpptInput[nSubarray];
+				dc_subarray_step &step = block_steps[nn][s];
+				task.errorStage = 2;
+				task.errorRank = nn;
+
+				// DC derates for snow and shading must be applied first
+				// these can't be applied before the power calculation because they are POWER derates
+
+				// self-shading derate (by default it is 1.0 if disbled)
+				Subarrays[nn]->Module->dcPowerW *= Subarrays[nn]->poa.nonlinearDCShadingDerate;
+				if (iyear == 0) step.mpptVoltageClipping *= Subarrays[nn]->poa.nonlinearDCShadingDerate;
+
+				// Sara 1/25/16 - shading database derate applied to dc only
+				// shading loss applied to beam if not from shading database
+				Subarrays[nn]->Module->dcPowerW *= step.dcShadeFactor;
+
+				// Calculate and apply snow coverage losses if activated
+				if (PVSystem->enableSnowModel)
+				{
+					float smLoss = 0.0f;
+
+					if (Subarrays[nn]->snowModel.getLoss((float)(Subarrays[nn]->poa.poaBeamFront + Subarrays[nn]->poa.poaDiffuseFront + Subarrays[nn]->poa.poaGroundFront),
+						(float)Subarrays[nn]->poa.surfaceTiltDegrees, (float)wf.wspd, (float)wf.tdry, (float)wf.snow, sunup, 1.0f / step_per_hour, smLoss))
+					{
+						if (!Subarrays[nn]->snowModel.good)
+							throw exec_error("pvsamv1", Subarrays[nn]->snowModel.msg);
 					}
+
+					if (iyear == 0)
+					{
+						PVSystem->p_snowLoss[nn][idx] = (ssc_number_t)(util::watt_to_kilowatt*Subarrays[nn]->Module->dcPowerW*smLoss);
+						PVSystem->p_snowCoverage[nn][idx] = (ssc_number_t)(Subarrays[nn]->snowModel.coverage);
+						step.snowLoss_kW = util::watt_to_kilowatt*Subarrays[nn]->Module->dcPowerW*smLoss;
+					}
+
+					Subarrays[nn]->Module->dcPowerW *= (1 - smLoss);
+					if (iyear == 0) step.mpptVoltageClipping *= (1 - smLoss);
 				}
 
-				// sum up all DC power from the whole array
-				PVSystem->p_systemDCPower[idx] = 0;
-				for (size_t nn = 0; nn < num_subarrays; nn++)
+				// scale power and mppt voltage clipping to subarray dimensions
+				Subarrays[nn]->dcPowerSubarray = Subarrays[nn]->Module->dcPowerW * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
+				if (iyear == 0) step.mpptVoltageClipping *= Subarrays[nn]->nModulesPerString* Subarrays[nn]->nStrings;
+
+				step.dcPowerSubarray = Subarrays[nn]->dcPowerSubarray;
+				if (iyear == 0 && !year1DcPowerSubarray.empty())
+					year1DcPowerSubarray[nn][idx] = Subarrays[nn]->dcPowerSubarray;
+
+				//assign gross outputs per subarray at this point
+				if (iyear == 0)
+				{
+					//Gross DC power
+					dc_gross[nn] += Subarrays[nn]->dcPowerSubarray*util::watt_to_kilowatt*ts_hour; //power W to	energy kWh
+					PVSystem->p_dcPowerGross[nn][idx] = (ssc_number_t)dc_gross[nn];
+					// save to SSC output arrays
+					PVSystem->p_temperatureCell[nn][idx] = (ssc_number_t)Subarrays[nn]->Module->temperatureCellCelcius;
+					PVSystem->p_moduleEfficiency[nn][idx] = (ssc_number_t)Subarrays[nn]->Module->dcEfficiency;					
+					PVSystem->p_voltageOpenCircuit[nn][idx] = (ssc_number_t)(Subarrays[nn]->Module->voltageOpenCircuit * (double)Subarrays[nn]->nModulesPerString);
+					PVSystem->p_currentShortCircuit[nn][idx] = (ssc_number_t)Subarrays[nn]->Module->currentShortCircuit;
+					PVSystem->p_angleOfIncidenceModifier[nn][idx] = (ssc_number_t)(Subarrays[nn]->Module->angleOfIncidenceModifier);
+
+				}
+			}
+		};
+
+		// Read the weather and calculate the subarray DC power for the block of hours starting at hour_begin. If a weather file line
+		// can not be read, the block ends before it
+		auto calculate_block = [&](size_t hour_begin)
+		{
+			block_idx = idx;
+			block_hour = hour_begin;
+			size_t nsteps = (std::min(hour_begin + dc_block_hours, (size_t)8760) - hour_begin) * step_per_hour;
+
+			block_weather.resize(nsteps);
+			size_t nread = 0;
+			while (nread < nsteps && wdprov->read(&block_weather[nread]))
+				nread++;
+			block_weather.resize(nread);
+
+			for (size_t nn = 0; nn < num_subarrays; nn++)
+				block_steps[nn].resize(nread);
+			for (size_t k = 0; k < poa_tasks.size() + mppt_tasks.size(); k++)
+			{
+				dc_block_task &task = (k < poa_tasks.size()) ? poa_tasks[k] : mppt_tasks[k - poa_tasks.size()];
+				task.logs.clear();
+				task.nextLog = 0;
+				task.error = nullptr;
+			}
+
+			if (serial_poa)
+			{
+				for (size_t s = 0; s < nread; s++)
+					for (size_t nn = 0; nn < num_subarrays; nn++)
+						run_block_step(poa_tasks[nn], s, [&]() { calculate_subarray_poa(nn, s); });
+			}
+			else
+			{
+				sp_parallel_for((int)num_subarrays, n_threads, 1, [&](int nn, int)
 				{
-					// DC derates for snow and shading must be applied first
-					// these can't be applied before the power calculation because they are POWER derates
+					for (size_t s = 0; s < nread; s++)
+						run_block_step(poa_tasks[nn], s, [&]() { calculate_subarray_poa(nn, s); });
+				});
+			}
+
+			// the module power needs the irradiance of all subarrays on the MPPT input, so it stops at the first irradiance error
+			size_t nvalid = nread;
+			for (size_t nn = 0; nn < num_subarrays; nn++)
+				if (poa_tasks[nn].error)
+					nvalid = std::min(nvalid, poa_tasks[nn].errorStep);
+
+			sp_parallel_for((int)mppt_tasks.size(), n_threads, 1, [&](int mpptInput, int)
+			{
+				for (size_t s = 0; s < nvalid; s++)
+					run_block_step(mppt_tasks[mpptInput], s, [&]() { calculate_mppt_power(mpptInput, s); });
+			});
+		};
 
-					// self-shading derate (by default it is 1.0 if disbled)
-					Subarrays[nn]->Module->dcPowerW *= Subarrays[nn]->poa.nonlinearDCShadingDerate;
-					if (iyear == 0) mpptVoltageClipping[nn] *= Subarrays[nn]->poa.nonlinearDCShadingDerate;
+		for (hour = 0; hour < 8760; hour++)
+		{
+			if (!replay_dc && hour % dc_block_hours == 0)
+				calculate_block(hour);
 
-					// Sara 1/25/16 - shading database derate applied to dc only
-					// shading loss applied to beam if not from shading database
-					Subarrays[nn]->Module->dcPowerW *= Subarrays[nn]->shadeCalculator.dc_shade_factor();
+			// report progress updates to the caller	
+			ireport++;
+			if (ireport - ireplast > irepfreq)
+			{
+				percent_complete = percent_baseline + 100.0f *(float)(hour + iyear * 8760) / (float)(insteps);
+				if (!update("", percent_complete))
+					throw exec_error("pvsamv1", "simulation canceled at hour " + util::to_string(hour + 1.0) + " in year " + util::to_string((int)iyear + 1) + "in dc loop");
+				ireplast = ireport;
+			}
 
-					// Calculate and apply snow coverage losses if activated
-					if (PVSystem->enableSnowModel)
+			// only hourly electric load, even
+			// if PV simulation is subhourly.  load is assumed constant over the hour.
+			// if no load profile supplied, load = 0
+			if (nload == 8760)
+				cur_load = p_load_in[hour];
+
+			for (size_t jj = 0; jj < step_per_hour; jj++)
+			{
+				// Reset dcPower calculation for new timestep
+				dcPowerNetTotalSystem = 0; 
+
+				// electric load is subhourly
+				// if no load profile supplied, load = 0
+				if (nload == nrec)
+					cur_load = p_load_in[hour*step_per_hour + jj];
+
+				// log cur_load to check both hourly and sub hourly load data
+				// load data over entrie lifetime period not currently supported.
+				//					log(util::format("year=%d, hour=%d, step per hour=%d, load=%g",
+				//						iyear, hour, jj, cur_load), SSC_WARNING, (float)idx);
+				p_load_full.push_back((ssc_number_t)cur_load);
+
+				// replay year 1 subarray DC power and apply only the losses that change from year to year, or from run to run
+				if (replay_dc)
+				{
+					size_t idx_year1 = idx % nrec;
+					PVSystem->p_systemDCPower[idx] = 0;
+					if (iyear > 0)
 					{
-						float smLoss = 0.0f;
+						for (size_t m = 0; m < PVSystem->Inverter->nMpptInputs; m++)
+							PVSystem->p_mpptVoltage[m][idx] = PVSystem->p_mpptVoltage[m][idx_year1];
+					}
 
-						if (Subarrays[nn]->snowModel.getLoss((float)(Subarrays[nn]->poa.poaBeamFront + Subarrays[nn]->poa.poaDiffuseFront + Subarrays[nn]->poa.poaGroundFront),
-							(float)Subarrays[nn]->poa.surfaceTiltDegrees, (float)wf.wspd, (float)wf.tdry, (float)wf.snow, sunup, 1.0f / step_per_hour, smLoss))
+					for (size_t nn = 0; nn < num_subarrays; nn++)
+					{
+						if (iyear > 0)
 						{
-							if (!Subarrays[nn]->snowModel.good)
-								throw exec_error("pvsamv1", Subarrays[nn]->snowModel.msg);
+							double stringVoltage = dcStringVoltage[nn][idx_year1];
+							dcStringVoltage[nn].push_back(stringVoltage);
 						}
 
-						if (iyear == 0)
+						dcPowerNetPerSubarray[nn] = year1DcPowerSubarray[nn][idx_year1] * (1 - Subarrays[nn]->dcLossTotalPercent);
+						if (system_use_lifetime_output == 1)
+							dcPowerNetPerSubarray[nn] *= PVSystem->dcDegradationFactor[iyear + 1];
+						if (iyear == 0) annual_dc_adjust_loss += dcPowerNetPerSubarray[nn] * (1 - dc_haf(hour)) * util::watt_to_kilowatt * ts_hour;
+						dcPowerNetPerSubarray[nn] *= dc_haf(hour);
+						if (system_use_lifetime_output == 1 && PVSystem->enableDCLifetimeLosses)
 						{
-							PVSystem->p_snowLoss[nn][idx] = (ssc_number_t)(util::watt_to_kilowatt*Subarrays[nn]->Module->dcPowerW*smLoss);
-							PVSystem->p_snowLossTotal[idx] += (ssc_number_t)(util::watt_to_kilowatt*Subarrays[nn]->Module->dcPowerW*smLoss);
-							PVSystem->p_snowCoverage[nn][idx] = (ssc_number_t)(Subarrays[nn]->snowModel.coverage);
-							annual_snow_loss += (ssc_number_t)(util::watt_to_kilowatt*Subarrays[nn]->Module->dcPowerW*smLoss);
+							int dc_loss_index = (int)iyear * 365 + (int)floor(hour / 24);
+							if (iyear == 0) annual_dc_lifetime_loss += dcPowerNetPerSubarray[nn] * (PVSystem->p_dcLifetimeLosses[dc_loss_index] / 100) * util::watt_to_kilowatt * ts_hour;
+							dcPowerNetPerSubarray[nn] *= (100 - PVSystem->p_dcLifetimeLosses[dc_loss_index]) / 100;
 						}
 
-						Subarrays[nn]->Module->dcPowerW *= (1 - smLoss);
-						if (iyear == 0) mpptVoltageClipping[nn] *= (1 - smLoss);
+						PVSystem->p_systemDCPower[idx] += (ssc_number_t)(dcPowerNetPerSubarray[nn] * util::watt_to_kilowatt);
+						PVSystem->p_dcPowerNetPerMppt[Subarrays[nn]->mpptInput - 1][idx] += (ssc_number_t)(dcPowerNetPerSubarray[nn]);
+						dcPowerNetTotalSystem += dcPowerNetPerSubarray[nn];
+					}
+
+					if (en_batt)
+						predict_dc_clipping(idx);
+
+					idx++;
+					continue;
+				}
+
+				// the irradiance and module power of this step were calculated with its block
+				size_t s = idx - block_idx;
+				if (s == block_weather.size())
+					throw exec_error("pvsamv1", "could not read data line " + util::to_string((int)(idx + 1)) + " in weather file");
+
+				for (size_t nn = 0; nn < num_subarrays; nn++)
+					report_block_step(poa_tasks[nn], s, 0);
+				for (size_t mpptInput = 0; mpptInput < mppt_tasks.size(); mpptInput++)
+					report_block_step(mppt_tasks[mpptInput], s, 1);
+
+				// errors in the DC derates come after the module power of all MPPT inputs, in subarray order
+				dc_block_task *derate_error = 0;
+				for (size_t mpptInput = 0; mpptInput < mppt_tasks.size(); mpptInput++)
+				{
+					dc_block_task &task = mppt_tasks[mpptInput];
+					if (task.error && task.errorStep == s && task.errorStage == 2 && (!derate_error || task.errorRank < derate_error->errorRank))
+						derate_error = &task;
+				}
+				if (derate_error)
+					std::rethrow_exception(derate_error->error);
+
+				Irradiance->weatherRecord = block_weather[s];
+				weather_record wf = Irradiance->weatherRecord;
+
+				// the sun position and albedo are the same for all subarrays
+				const dc_subarray_step &sun = block_steps[last_subarray][s];
+				double solazi = sun.solazi, solzen = sun.solzen, solalt = sun.solalt, alb = sun.alb;
+				int sunup = sun.sunup;
+
+				// accumulators for radiation power (W) over this 
+				// timestep from each subarray
+				double ts_accum_poa_front_nom = 0.0;
+				double ts_accum_poa_front_beam_nom = 0.0;
+				double ts_accum_poa_front_shaded = 0.0;
+				double ts_accum_poa_front_shaded_soiled = 0.0;
+				double ts_accum_poa_front_total = 0.0;
+				double ts_accum_poa_rear = 0.0;
+				double ts_accum_poa_rear_after_losses = 0.0;
+				double ts_accum_poa_total_eff = 0.0;
+				double ts_accum_poa_front_beam_eff = 0.0;
+
+				for (size_t nn = 0; nn < num_subarrays; nn++)
+				{
+					if (!subarrayCalculated[nn])
+						continue;
+					const dc_subarray_step &step = block_steps[nn][s];
+					ts_accum_poa_front_nom += step.poaFrontNominalW;
+					ts_accum_poa_front_beam_nom += step.poaFrontBeamNominalW;
+					ts_accum_poa_front_shaded += step.poaFrontShadedW;
+					ts_accum_poa_front_shaded_soiled += step.poaFrontShadedSoiledW;
+					ts_accum_poa_rear += step.poaRearW;
+					ts_accum_poa_rear_after_losses = ts_accum_poa_rear * (1 - Subarrays[nn]->rearIrradianceLossPercent);
+					ts_accum_poa_front_beam_eff += step.poaFrontBeamEffW;
+				}
+
+				// irradiance after the reflection loss is summed in the order of the MPPT inputs
+				if (iyear == 0)
+				{
+					for (size_t mpptInput = 0; mpptInput < PVSystem->Inverter->nMpptInputs; mpptInput++)
+					{
+						for (size_t nSubarray = 0; nSubarray < PVSystem->mpptMapping[mpptInput].size(); nSubarray++)
+						{
+							const dc_subarray_step &step = block_steps[PVSystem->mpptMapping[mpptInput][nSubarray]][s];
+							ts_accum_poa_front_total += step.poaFrontTotalW;
+							ts_accum_poa_total_eff += step.poaTotalEffW;
+						}
 					}
+				}
 
-					// scale power and mppt voltage clipping to subarray dimensions
-					Subarrays[nn]->dcPowerSubarray = Subarrays[nn]->Module->dcPowerW * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
-					if (iyear == 0) mpptVoltageClipping[nn] *= Subarrays[nn]->nModulesPerString* Subarrays[nn]->nStrings;
+				// sum up all DC power from the whole array
+				PVSystem->p_systemDCPower[idx] = 0;
+				for (size_t nn = 0; nn < num_subarrays; nn++)
+				{
+					const dc_subarray_step &step = block_steps[nn][s];
 
-					//assign gross outputs per subarray at this point
 					if (iyear == 0)
 					{
-						//Gross DC power
-						dc_gross[nn] += Subarrays[nn]->dcPowerSubarray*util::watt_to_kilowatt*ts_hour; //power W to	energy kWh
-						PVSystem->p_dcPowerGross[nn][idx] = (ssc_number_t)dc_gross[nn];
+						if (PVSystem->enableSnowModel)
+						{
+							PVSystem->p_snowLossTotal[idx] += (ssc_number_t)step.snowLoss_kW;
+							annual_snow_loss += (ssc_number_t)step.snowLoss_kW;
+						}
 						//Add to annual MPPT clipping
-						annualMpptVoltageClipping += mpptVoltageClipping[nn]*util::watt_to_kilowatt*ts_hour; //power W to energy kWh
-						// save to SSC output arrays
-						PVSystem->p_temperatureCell[nn][idx] = (ssc_number_t)Subarrays[nn]->Module->temperatureCellCelcius;
-						PVSystem->p_moduleEfficiency[nn][idx] = (ssc_number_t)Subarrays[nn]->Module->dcEfficiency;					
-						PVSystem->p_voltageOpenCircuit[nn][idx] = (ssc_number_t)(Subarrays[nn]->Module->voltageOpenCircuit * (double)Subarrays[nn]->nModulesPerString);
-						PVSystem->p_currentShortCircuit[nn][idx] = (ssc_number_t)Subarrays[nn]->Module->currentShortCircuit;
-						PVSystem->p_angleOfIncidenceModifier[nn][idx] = (ssc_number_t)(Subarrays[nn]->Module->angleOfIncidenceModifier);
-
+						annualMpptVoltageClipping += step.mpptVoltageClipping*util::watt_to_kilowatt*ts_hour; //power W to energy kWh
 					}
-					
+
 					//calculate net power for each subarray
 
 					// apply pre-inverter power derate
-					dcPowerNetPerSubarray[nn] = Subarrays[nn]->dcPowerSubarray * (1 - Subarrays[nn]->dcLossTotalPercent);
+					dcPowerNetPerSubarray[nn] = step.dcPowerSubarray * (1 - Subarrays[nn]->dcLossTotalPercent);
 
 					//module degradation and lifetime DC losses apply to all subarrays
 					if (system_use_lifetime_output == 1)
@@ -1873,32 +2479,13 @@ void cm_pvsamv1::exec( ) throw (compute_module::general_error)
 					PVSystem->p_poaFrontBeamTotal[idx] = (ssc_number_t)(ts_accum_poa_front_beam_eff * util::watt_to_kilowatt);
 					PVSystem->p_inverterMPPTLoss[idx] = 0;
 					for (size_t nn = 0; nn < num_subarrays; nn++) {
-						PVSystem->p_inverterMPPTLoss[idx] = (ssc_number_t)(mpptVoltageClipping[nn] * util::watt_to_kilowatt);
+						PVSystem->p_inverterMPPTLoss[idx] = (ssc_number_t)(block_steps[nn][s].mpptVoltageClipping * util::watt_to_kilowatt);
 					}
 				}
 
 				// Predict clipping for DC battery controller
 				if (en_batt)
-				{
-					double cliploss = 0;
-					double dcpwr_kw = PVSystem->p_systemDCPower[idx];
-
-					if (p_pv_dc_forecast.size() > 1 && p_pv_dc_forecast.size() > idx % (8760 * step_per_hour)) {
-						dcpwr_kw = p_pv_dc_forecast[idx % (8760 * step_per_hour)];
-					}
-					p_pv_dc_use.push_back(static_cast<ssc_number_t>(dcpwr_kw));
-
-					if (p_pv_clipping_forecast.size() > 1 && p_pv_clipping_forecast.size() > idx % (8760 * step_per_hour)) {
-						cliploss = p_pv_clipping_forecast[idx % (8760 * step_per_hour)] * util::kilowatt_to_watt;
-					}
-					else {
-						//DC batteries not allowed with multiple MPPT, so can just use MPPT 1's voltage
-						sharedInverter->calculateACPower(dcpwr_kw, PVSystem->p_mpptVoltage[0][idx], 0.0);
-						cliploss = sharedInverter->powerClipLoss_kW;
-					}
-
-					p_invcliploss_full.push_back(static_cast<ssc_number_t>(cliploss));
-				}
+					predict_dc_clipping(idx);
 
 				idx++;
 			}
@@ -1906,6 +2493,25 @@ void cm_pvsamv1::exec( ) throw (compute_module::general_error)
 		// using single weather file initially - so rewind to use for next year
 		wdprov->rewind();
 
+		if (use_dc_cache && !dcCache && iyear == 0)
+		{
+			std::shared_ptr<pvsamv1_dc_cache> dc(new pvsamv1_dc_cache());
+			dc->key = dcCacheKey;
+			dc->dcPowerSubarray = year1DcPowerSubarray;
+			dc->dcStringVoltage = dcStringVoltage;
+			std::vector<ssc_number_t *> outputs = dc_cache_outputs();
+			for (size_t k = 0; k < outputs.size(); k++)
+				dc->outputs.push_back(std::vector<ssc_number_t>(outputs[k], outputs[k] + nrec));
+			for (size_t nn = 0; nn < 4; nn++)
+				dc->dcGross[nn] = dc_gross[nn];
+			dc->annualSnowLoss = annual_snow_loss;
+			dc->annualMpptVoltageClipping = annualMpptVoltageClipping;
+			dc->snowBadValues = Subarrays[0]->snowModel.badValues;
+			for (int i = dcLogBegin; log_item *item = log(i); i++)
+				dc->logs.push_back(*item);
+			cache_dc(dc);
+		}
+
 		// Assign annual lifetime DC outputs
 		if (system_use_lifetime_output) {
 			PVSystem->p_dcDegradationFactor[iyear] = (ssc_number_t)(PVSystem->dcDegradationFactor[iyear]);
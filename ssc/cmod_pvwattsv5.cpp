@@ -260,6 +260,27 @@ public:
 		return code;
 	}
 
+	// same as process_irradiance(), for a timestep of irradiance already calculated by irrad_series
+	int assign_irradiance(const irrad_series &irr, size_t i)
+	{
+		solazi = irr.sunAnglesRadians[0][i] * (180 / M_PI);
+		solzen = irr.sunAnglesRadians[1][i] * (180 / M_PI);
+		solalt = irr.sunAnglesRadians[2][i] * (180 / M_PI);
+		sunup = irr.sunUp[i];
+
+		aoi = irr.surfaceAnglesRadians[0][i] * (180 / M_PI);
+		stilt = irr.surfaceAnglesRadians[1][i] * (180 / M_PI);
+		sazi = irr.surfaceAnglesRadians[2][i] * (180 / M_PI);
+		rot = irr.surfaceAnglesRadians[3][i] * (180 / M_PI);
+		btd = irr.surfaceAnglesRadians[4][i] * (180 / M_PI);
+
+		ibeam = irr.poaFront[0][i];
+		iskydiff = irr.poaFront[1][i];
+		ignddiff = irr.poaFront[2][i];
+
+		return irr.code[i];
+	}
+
 	void powerout(double time, double &shad_beam, double shad_diff, double dni, double alb, double wspd, double tdry)
 	{
 		
@@ -470,6 +491,38 @@ public:
 
 		double ts_hour = 1.0/step_per_hour;
 
+		// calculate sun position and plane-of-array irradiance for the whole year at once
+		std::vector<int> wf_year(nrec), wf_month(nrec), wf_day(nrec), wf_hour(nrec);
+		std::vector<double> wf_minute(nrec), wf_dn(nrec), wf_df(nrec), wf_alb(nrec);
+		for (size_t i = 0; i < nrec; i++)
+		{
+			if (!wdprov->read( &wf ))
+				throw exec_error("pvwattsv5", util::format("could not read data line %d of %d in weather file", (int)(i+1), (int)nrec ));
+
+			wf_year[i] = wf.year;
+			wf_month[i] = wf.month;
+			wf_day[i] = wf.day;
+			wf_hour[i] = wf.hour;
+			wf_minute[i] = wf.minute;
+			wf_dn[i] = wf.dn;
+			wf_df[i] = wf.df;
+
+			wf_alb[i] = 0.2; // do not increase albedo if snow exists in TMY2
+			if ( std::isfinite( wf.alb ) && wf.alb > 0 && wf.alb < 1 )
+				wf_alb[i] = wf.alb;
+		}
+		wdprov->rewind();
+
+		irrad_series irr;
+		irr.set_location( hdr.lat, hdr.lon, hdr.tz );
+		irr.set_sky_model( 2 );
+		irr.set_surface( track_mode, tilt, azimuth, 45.0,
+			shade_mode_1x == 1, // backtracking mode
+			gcr );
+		irr.calc_sun( nrec, &wf_year[0], &wf_month[0], &wf_day[0], &wf_hour[0], &wf_minute[0],
+			instantaneous ? IRRADPROC_NO_INTERPOLATE_SUNRISE_SUNSET : ts_hour );
+		irr.calc_poa( irrad::DN_DF, 0, &wf_dn[0], &wf_df[0], &wf_alb[0] );
+
 		initialize_cell_temp( ts_hour );
 
 		double annual_kwh = 0; 
@@ -500,13 +553,9 @@ public:
 				p_wspd[idx] = (ssc_number_t)wf.wspd;			
 				p_tcell[idx] = (ssc_number_t)wf.tdry;
 				
-				double alb = 0.2; // do not increase albedo if snow exists in TMY2			
-				if ( std::isfinite( wf.alb ) && wf.alb > 0 && wf.alb < 1 )
-					alb = wf.alb;					
+				double alb = wf_alb[idx];
 				
-				int code = process_irradiance(wf.year, wf.month, wf.day, wf.hour, wf.minute, 
-					instantaneous ? IRRADPROC_NO_INTERPOLATE_SUNRISE_SUNSET : ts_hour,
-					hdr.lat, hdr.lon, hdr.tz, wf.dn, wf.df, alb );
+				int code = assign_irradiance( irr, idx );
 
 				if ( -1 == code )
 				{
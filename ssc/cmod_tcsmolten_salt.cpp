@@ -252,6 +252,7 @@ static var_info _cm_vtab_tcsmolten_salt[] = {
 	{ SSC_INPUT,        SSC_NUMBER,      "fan_power_perc_net",   "% of net cycle output used for fan power at design",			      "%",	          "",            "sco2_pc",     "pc_config=2",                "",                      "" },	
 	{ SSC_INPUT,        SSC_NUMBER,      "sco2_T_amb_des",       "Ambient temperature at design point",                                      "C",     "",            "sco2_pc",     "pc_config=2",                "",                      "" },
 	{ SSC_INPUT,        SSC_NUMBER,      "sco2_T_approach",      "Temperature difference between main compressor CO2 inlet and ambient air", "C",     "",            "sco2_pc",     "pc_config=2",                "",                      "" },
+	{ SSC_INPUT,        SSC_NUMBER,      "co2_property_backend", "CO2 properties: 0 = equation of state, 1 = interpolated tables",     "",             "",            "sco2_pc",     "?=0",                        "INTEGER,MIN=0,MAX=1",   "" },
 		// sCO2 Powerblock pre-process
 	{ SSC_INPUT,        SSC_NUMBER,      "is_sco2_preprocess",       "Is sco2 off-design performance preprocessed? 1= yes",			                   "-",	                 "", "sco2_pc_pre",     "?=0",                        "",      "" },
 	{ SSC_INPUT,        SSC_NUMBER,      "sco2ud_T_htf_cold_calc",   "HTF cold temperature from sCO2 cycle des, may be different than T_htf_cold_des", "C",                  "", "sco2_pc_pre",     "is_sco2_preprocess=1",       "",      "" },
@@ -334,6 +335,7 @@ static var_info _cm_vtab_tcsmolten_salt[] = {
 	{ SSC_INPUT,        SSC_NUMBER,      "dispatch_factor9",     "Dispatch payment factor 9",	                                      "",             "",            "tou",            "*",						  "",                      "" },
 	{ SSC_INPUT,        SSC_NUMBER,      "is_dispatch_series",   "Use time-series dispatch factors",                                  "",             "",            "tou",            "?=0",						  "",                      "" },
 	{ SSC_INPUT,        SSC_ARRAY,       "dispatch_series",      "Time series dispatch factors",                                      "",             "",            "tou",            "",						  "",                      "" },
+	{ SSC_INPUT,        SSC_NUMBER,      "is_solver_profile",    "Report solver mode attempts, component calls, and wall time",        "-",            "",            "sys_ctrl",       "?=0",                     "",                      "" },
 
 	// Inputs required for user defined SF performance
 	{ SSC_INPUT,        SSC_NUMBER,      "A_sf_in",              "Solar Field Area",                                                 "m^2",           "",            "receiver",       "",                        "",                      "" },
@@ -506,6 +508,7 @@ static var_info _cm_vtab_tcsmolten_salt[] = {
     { SSC_OUTPUT,       SSC_ARRAY,       "disp_presolve_nconstr","Dispatch number of constraints in problem",                    "",             "",            "tou",            "*"                       "",            "" }, 
     { SSC_OUTPUT,       SSC_ARRAY,       "disp_presolve_nvar",   "Dispatch number of variables in problem",                      "",             "",            "tou",            "*"                       "",            "" }, 
     { SSC_OUTPUT,       SSC_ARRAY,       "disp_solve_time",      "Dispatch solver time",                                         "sec",          "",            "tou",            "*"                       "",            "" }, 
+    { SSC_OUTPUT,       SSC_ARRAY,       "disp_build_time",      "Dispatch model build time",                                    "sec",          "",            "tou",            "*"                       "",            "" }, 
 
 
 			// These outputs correspond to the first csp-solver timestep in the reporting timestep.
@@ -524,6 +527,15 @@ static var_info _cm_vtab_tcsmolten_salt[] = {
 	{ SSC_OUTPUT,       SSC_ARRAY,       "operating_modes_a",    "First 3 operating modes tried",                                "",             "",            "Solver",         "*",                       "",           "" },
 	{ SSC_OUTPUT,       SSC_ARRAY,       "operating_modes_b",    "Next 3 operating modes tried",                                 "",             "",            "Solver",         "*",                       "",           "" },
 	{ SSC_OUTPUT,       SSC_ARRAY,       "operating_modes_c",    "Final 3 operating modes tried",                                "",             "",            "Solver",         "*",                       "",           "" },
+	{ SSC_OUTPUT,       SSC_ARRAY,       "profile_n_op_modes",   "Solver profile: operating modes attempted",                    "",             "",            "Solver",         "is_solver_profile=1",     "",                      "" },
+	{ SSC_OUTPUT,       SSC_ARRAY,       "profile_n_cr_calls",   "Solver profile: collector-receiver calls",                     "",             "",            "Solver",         "is_solver_profile=1",     "",                      "" },
+	{ SSC_OUTPUT,       SSC_ARRAY,       "profile_n_pc_calls",   "Solver profile: power cycle calls",                            "",             "",            "Solver",         "is_solver_profile=1",     "",                      "" },
+	{ SSC_OUTPUT,       SSC_ARRAY,       "profile_n_tes_calls",  "Solver profile: TES calls",                                    "",             "",            "Solver",         "is_solver_profile=1",     "",                      "" },
+	{ SSC_OUTPUT,       SSC_ARRAY,       "profile_n_eq_calls",   "Solver profile: equation evaluations",                         "",             "",            "Solver",         "is_solver_profile=1",     "",                      "" },
+	{ SSC_OUTPUT,       SSC_ARRAY,       "profile_time_cr",      "Solver profile: wall time in collector-receiver calls",        "s",            "",            "Solver",         "is_solver_profile=1",     "",                      "" },
+	{ SSC_OUTPUT,       SSC_ARRAY,       "profile_time_pc",      "Solver profile: wall time in power cycle calls",               "s",            "",            "Solver",         "is_solver_profile=1",     "",                      "" },
+	{ SSC_OUTPUT,       SSC_ARRAY,       "profile_time_tes",     "Solver profile: wall time in TES calls",                       "s",            "",            "Solver",         "is_solver_profile=1",     "",                      "" },
+	{ SSC_OUTPUT,       SSC_ARRAY,       "profile_time_total",   "Solver profile: wall time solving the timestep",               "s",            "",            "Solver",         "is_solver_profile=1",     "",                      "" },
 	
 
 	{ SSC_OUTPUT,       SSC_ARRAY,       "gen",                  "Total electric power to grid w/ avail. derate",                                 "kWe",          "",            "System",         "*",                       "",           "" },
@@ -547,6 +559,16 @@ static var_info _cm_vtab_tcsmolten_salt[] = {
     { SSC_OUTPUT,       SSC_NUMBER,      "disp_presolve_nconstr_ann",  "Annual sum of dispatch problem constraint count",       "",            "",             "",               "*",                       "",           "" },
     { SSC_OUTPUT,       SSC_NUMBER,      "disp_presolve_nvar_ann",  "Annual sum of dispatch problem variable count",            "",            "",             "",               "*",                       "",           "" },
     { SSC_OUTPUT,       SSC_NUMBER,      "disp_solve_time_ann",  "Annual sum of dispatch solver time",                          "",            "",             "",               "*",                       "",           "" },
+    { SSC_OUTPUT,       SSC_NUMBER,      "disp_build_time_ann",  "Annual sum of dispatch model build time",                     "",            "",             "",               "*",                       "",           "" },
+	{ SSC_OUTPUT,       SSC_NUMBER,      "profile_n_op_modes_ann","Annual solver profile: operating modes attempted",      "",             "",            "Solver",         "is_solver_profile=1",     "",                      "" },
+	{ SSC_OUTPUT,       SSC_NUMBER,      "profile_n_cr_calls_ann","Annual solver profile: collector-receiver calls",       "",             "",            "Solver",         "is_solver_profile=1",     "",                      "" },
+	{ SSC_OUTPUT,       SSC_NUMBER,      "profile_n_pc_calls_ann","Annual solver profile: power cycle calls",              "",             "",            "Solver",         "is_solver_profile=1",     "",                      "" },
+	{ SSC_OUTPUT,       SSC_NUMBER,      "profile_n_tes_calls_ann","Annual solver profile: TES calls",                      "",             "",            "Solver",         "is_solver_profile=1",     "",                      "" },
+	{ SSC_OUTPUT,       SSC_NUMBER,      "profile_n_eq_calls_ann","Annual solver profile: equation evaluations",           "",             "",            "Solver",         "is_solver_profile=1",     "",                      "" },
+	{ SSC_OUTPUT,       SSC_NUMBER,      "profile_time_cr_ann",  "Annual solver profile: wall time in collector-receiver calls","s",            "",            "Solver",         "is_solver_profile=1",     "",                      "" },
+	{ SSC_OUTPUT,       SSC_NUMBER,      "profile_time_pc_ann",  "Annual solver profile: wall time in power cycle calls", "s",            "",            "Solver",         "is_solver_profile=1",     "",                      "" },
+	{ SSC_OUTPUT,       SSC_NUMBER,      "profile_time_tes_ann", "Annual solver profile: wall time in TES calls",         "s",            "",            "Solver",         "is_solver_profile=1",     "",                      "" },
+	{ SSC_OUTPUT,       SSC_NUMBER,      "profile_time_total_ann","Annual solver profile: wall time solving the timestep", "s",            "",            "Solver",         "is_solver_profile=1",     "",                      "" },
 
 
 	var_info_invalid };
@@ -1177,6 +1199,8 @@ public:
 				sco2_rc_csp_par.m_frac_fan_power = as_double("fan_power_perc_net") / 100.0;	//[-]
 				sco2_rc_csp_par.m_deltaP_cooler_frac = 0.002;		//[-]
 
+				sco2_rc_csp_par.m_co2_backend = as_integer("co2_property_backend");	//[-] 0 = equation of state, 1 = interpolated tables
+
 				sco2_pc.ms_params.ms_mc_sco2_recomp_params = sco2_rc_csp_par;
 
 				bool is_preprocess_udpc = true;		// "is_preprocess_udpc"
@@ -1701,6 +1725,21 @@ public:
 		csp_solver.mc_reported_outputs.assign(C_csp_solver::C_solver_outputs::DISPATCH_PRES_NCONSTR, allocate("disp_presolve_nconstr", n_steps_fixed), n_steps_fixed);
 		csp_solver.mc_reported_outputs.assign(C_csp_solver::C_solver_outputs::DISPATCH_PRES_NVAR, allocate("disp_presolve_nvar", n_steps_fixed), n_steps_fixed);
 		csp_solver.mc_reported_outputs.assign(C_csp_solver::C_solver_outputs::DISPATCH_SOLVE_TIME, allocate("disp_solve_time", n_steps_fixed), n_steps_fixed);
+		csp_solver.mc_reported_outputs.assign(C_csp_solver::C_solver_outputs::DISPATCH_BUILD_TIME, allocate("disp_build_time", n_steps_fixed), n_steps_fixed);
+
+		csp_solver.m_is_profile = as_boolean("is_solver_profile");
+		if( csp_solver.m_is_profile )
+		{
+			csp_solver.mc_reported_outputs.assign(C_csp_solver::C_solver_outputs::PROFILE_N_OP_MODES, allocate("profile_n_op_modes", n_steps_fixed), n_steps_fixed);
+			csp_solver.mc_reported_outputs.assign(C_csp_solver::C_solver_outputs::PROFILE_N_CR_CALLS, allocate("profile_n_cr_calls", n_steps_fixed), n_steps_fixed);
+			csp_solver.mc_reported_outputs.assign(C_csp_solver::C_solver_outputs::PROFILE_N_PC_CALLS, allocate("profile_n_pc_calls", n_steps_fixed), n_steps_fixed);
+			csp_solver.mc_reported_outputs.assign(C_csp_solver::C_solver_outputs::PROFILE_N_TES_CALLS, allocate("profile_n_tes_calls", n_steps_fixed), n_steps_fixed);
+			csp_solver.mc_reported_outputs.assign(C_csp_solver::C_solver_outputs::PROFILE_N_EQ_CALLS, allocate("profile_n_eq_calls", n_steps_fixed), n_steps_fixed);
+			csp_solver.mc_reported_outputs.assign(C_csp_solver::C_solver_outputs::PROFILE_TIME_CR, allocate("profile_time_cr", n_steps_fixed), n_steps_fixed);
+			csp_solver.mc_reported_outputs.assign(C_csp_solver::C_solver_outputs::PROFILE_TIME_PC, allocate("profile_time_pc", n_steps_fixed), n_steps_fixed);
+			csp_solver.mc_reported_outputs.assign(C_csp_solver::C_solver_outputs::PROFILE_TIME_TES, allocate("profile_time_tes", n_steps_fixed), n_steps_fixed);
+			csp_solver.mc_reported_outputs.assign(C_csp_solver::C_solver_outputs::PROFILE_TIME_TOTAL, allocate("profile_time_total", n_steps_fixed), n_steps_fixed);
+		}
 
 		csp_solver.mc_reported_outputs.assign(C_csp_solver::C_solver_outputs::SOLZEN, allocate("solzen", n_steps_fixed), n_steps_fixed);
 		csp_solver.mc_reported_outputs.assign(C_csp_solver::C_solver_outputs::SOLAZ, allocate("solaz", n_steps_fixed), n_steps_fixed);
@@ -1805,6 +1844,20 @@ public:
 			log(out_msg, out_type);
 		}
 
+		if( csp_solver.m_is_profile )
+		{
+			const C_csp_solver::S_solver_profile & profile = csp_solver.get_solver_profile();
+			assign("profile_n_op_modes_ann", (ssc_number_t)profile.m_n_op_modes);
+			assign("profile_n_cr_calls_ann", (ssc_number_t)profile.m_n_cr_calls);
+			assign("profile_n_pc_calls_ann", (ssc_number_t)profile.m_n_pc_calls);
+			assign("profile_n_tes_calls_ann", (ssc_number_t)profile.m_n_tes_calls);
+			assign("profile_n_eq_calls_ann", (ssc_number_t)profile.m_n_eq_calls);
+			assign("profile_time_cr_ann", (ssc_number_t)profile.m_time_cr);
+			assign("profile_time_pc_ann", (ssc_number_t)profile.m_time_pc);
+			assign("profile_time_tes_ann", (ssc_number_t)profile.m_time_tes);
+			assign("profile_time_total_ann", (ssc_number_t)profile.m_time_total);
+		}
+
 		// ******* Re-calculate system costs here ************
 		C_mspt_system_costs sys_costs;
 
@@ -2035,6 +2088,7 @@ public:
         accumulate_annual_for_year("disp_presolve_nconstr", "disp_presolve_nconstr_ann", sim_setup.m_report_step / 3600.0/ as_double("disp_frequency"), steps_per_hour, 1, n_steps_fixed/steps_per_hour);
         accumulate_annual_for_year("disp_presolve_nvar", "disp_presolve_nvar_ann", sim_setup.m_report_step / 3600.0/ as_double("disp_frequency"), steps_per_hour, 1, n_steps_fixed/steps_per_hour);
         accumulate_annual_for_year("disp_solve_time", "disp_solve_time_ann", sim_setup.m_report_step/3600. / as_double("disp_frequency"), steps_per_hour, 1, n_steps_fixed/steps_per_hour );
+        accumulate_annual_for_year("disp_build_time", "disp_build_time_ann", sim_setup.m_report_step/3600. / as_double("disp_frequency"), steps_per_hour, 1, n_steps_fixed/steps_per_hour );
 
 		// Calculated Outputs
 			// First, sum power cycle water consumption timeseries outputs
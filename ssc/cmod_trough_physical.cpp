@@ -104,6 +104,7 @@ static var_info _cm_vtab_trough_physical[] = {
     { SSC_INPUT,        SSC_NUMBER,      "tilt",                      "Tilt angle of surface/axis",                                                       "none",         "",               "solar_field",    "*",                       "",                      "" },
     { SSC_INPUT,        SSC_NUMBER,      "azimuth",                   "Azimuth angle of surface/axis",                                                    "none",         "",               "solar_field",    "*",                       "",                      "" },
     { SSC_INPUT,        SSC_NUMBER,      "wind_stow_speed",           "Trough wind stow speed",                                                           "m/s",          "",               "solar_field",    "?=50",                    "",                      "" },
+    { SSC_INPUT,        SSC_NUMBER,      "is_evac_surrogate",         "Interpolate receiver heat losses from tables built at initialization",             "0/1",          "",               "solar_field",    "?=0",                     "",                      "" },
     { SSC_INPUT,        SSC_NUMBER,      "accept_mode",               "Acceptance testing mode?",                                                         "0/1",          "no/yes",         "solar_field",    "*",                       "",                      "" },
     { SSC_INPUT,        SSC_NUMBER,      "accept_init",               "In acceptance testing mode - require steady-state startup",                        "none",         "",               "solar_field",    "*",                       "",                      "" },
     { SSC_INPUT,        SSC_NUMBER,      "solar_mult",                "Solar multiple",                                                                   "none",         "",               "solar_field",    "*",                       "",                      "" },
@@ -314,6 +315,7 @@ static var_info _cm_vtab_trough_physical[] = {
     { SSC_INPUT,        SSC_MATRIX,      "sgs_wallthicks",            "Custom SGS wall thicknesses",                                                      "m",            "",               "controller",     "*",                       "",                      "" },
     { SSC_INPUT,        SSC_MATRIX,      "sgs_lengths",               "Custom SGS lengths",                                                               "m",            "",               "controller",     "*",                       "",                      "" },
     { SSC_INPUT,        SSC_NUMBER,      "DP_SGS",                    "Pressure drop within the steam generator",                                         "bar",          "",               "controller",     "*",                       "",                      "" },
+    { SSC_INPUT,        SSC_NUMBER,      "is_solver_profile",         "Report solver mode attempts, component calls, and wall time",                      "-",            "",               "controller",     "?=0",                     "",                      "" },
 
 
     // *************************************************************************************************
@@ -430,6 +432,24 @@ static var_info _cm_vtab_trough_physical[] = {
     { SSC_OUTPUT,       SSC_ARRAY,       "operating_modes_a",         "First 3 operating modes tried",                                                    "",             "",               "solver",         "*",                       "",                      "" },
     { SSC_OUTPUT,       SSC_ARRAY,       "operating_modes_b",         "Next 3 operating modes tried",                                                     "",             "",               "solver",         "*",                       "",                      "" },
     { SSC_OUTPUT,       SSC_ARRAY,       "operating_modes_c",         "Final 3 operating modes tried",                                                    "",             "",               "solver",         "*",                       "",                      "" },
+    { SSC_OUTPUT,       SSC_ARRAY,       "profile_n_op_modes",        "Solver profile: operating modes attempted",                                        "",             "",               "solver",         "is_solver_profile=1",     "",                      "" },
+    { SSC_OUTPUT,       SSC_ARRAY,       "profile_n_cr_calls",        "Solver profile: collector-receiver calls",                                         "",             "",               "solver",         "is_solver_profile=1",     "",                      "" },
+    { SSC_OUTPUT,       SSC_ARRAY,       "profile_n_pc_calls",        "Solver profile: power cycle calls",                                                "",             "",               "solver",         "is_solver_profile=1",     "",                      "" },
+    { SSC_OUTPUT,       SSC_ARRAY,       "profile_n_tes_calls",       "Solver profile: TES calls",                                                        "",             "",               "solver",         "is_solver_profile=1",     "",                      "" },
+    { SSC_OUTPUT,       SSC_ARRAY,       "profile_n_eq_calls",        "Solver profile: equation evaluations",                                             "",             "",               "solver",         "is_solver_profile=1",     "",                      "" },
+    { SSC_OUTPUT,       SSC_ARRAY,       "profile_time_cr",           "Solver profile: wall time in collector-receiver calls",                            "s",            "",               "solver",         "is_solver_profile=1",     "",                      "" },
+    { SSC_OUTPUT,       SSC_ARRAY,       "profile_time_pc",           "Solver profile: wall time in power cycle calls",                                   "s",            "",               "solver",         "is_solver_profile=1",     "",                      "" },
+    { SSC_OUTPUT,       SSC_ARRAY,       "profile_time_tes",          "Solver profile: wall time in TES calls",                                           "s",            "",               "solver",         "is_solver_profile=1",     "",                      "" },
+    { SSC_OUTPUT,       SSC_ARRAY,       "profile_time_total",        "Solver profile: wall time solving the timestep",                                   "s",            "",               "solver",         "is_solver_profile=1",     "",                      "" },
+    { SSC_OUTPUT,       SSC_NUMBER,      "profile_n_op_modes_ann",    "Annual solver profile: operating modes attempted",                          "",             "",               "solver",         "is_solver_profile=1",     "",                      "" },
+    { SSC_OUTPUT,       SSC_NUMBER,      "profile_n_cr_calls_ann",    "Annual solver profile: collector-receiver calls",                           "",             "",               "solver",         "is_solver_profile=1",     "",                      "" },
+    { SSC_OUTPUT,       SSC_NUMBER,      "profile_n_pc_calls_ann",    "Annual solver profile: power cycle calls",                                  "",             "",               "solver",         "is_solver_profile=1",     "",                      "" },
+    { SSC_OUTPUT,       SSC_NUMBER,      "profile_n_tes_calls_ann",   "Annual solver profile: TES calls",                                          "",             "",               "solver",         "is_solver_profile=1",     "",                      "" },
+    { SSC_OUTPUT,       SSC_NUMBER,      "profile_n_eq_calls_ann",    "Annual solver profile: equation evaluations",                               "",             "",               "solver",         "is_solver_profile=1",     "",                      "" },
+    { SSC_OUTPUT,       SSC_NUMBER,      "profile_time_cr_ann",       "Annual solver profile: wall time in collector-receiver calls",              "s",            "",               "solver",         "is_solver_profile=1",     "",                      "" },
+    { SSC_OUTPUT,       SSC_NUMBER,      "profile_time_pc_ann",       "Annual solver profile: wall time in power cycle calls",                     "s",            "",               "solver",         "is_solver_profile=1",     "",                      "" },
+    { SSC_OUTPUT,       SSC_NUMBER,      "profile_time_tes_ann",      "Annual solver profile: wall time in TES calls",                             "s",            "",               "solver",         "is_solver_profile=1",     "",                      "" },
+    { SSC_OUTPUT,       SSC_NUMBER,      "profile_time_total_ann",    "Annual solver profile: wall time solving the timestep",                     "s",            "",               "solver",         "is_solver_profile=1",     "",                      "" },
                                                                                                                                                                                                                                                                   
     { SSC_OUTPUT,       SSC_ARRAY,       "disp_solve_state",          "Dispatch solver state",                                                            "",             "",               "tou",            "*",                       "",                      "" },
     { SSC_OUTPUT,       SSC_ARRAY,       "disp_solve_iter",           "Dispatch iterations count",                                                        "",             "",               "tou",            "*",                       "",                      "" },
@@ -447,6 +467,7 @@ static var_info _cm_vtab_trough_physical[] = {
     { SSC_OUTPUT,       SSC_ARRAY,       "disp_presolve_nconstr",     "Dispatch number of constraints in problem",                                        "",             "",               "tou",            "*",                       "",                      "" },
     { SSC_OUTPUT,       SSC_ARRAY,       "disp_presolve_nvar",        "Dispatch number of variables in problem",                                          "",             "",               "tou",            "*",                       "",                      "" },
     { SSC_OUTPUT,       SSC_ARRAY,       "disp_solve_time",           "Dispatch solver time",                                                             "sec",          "",               "tou",            "*",                       "",                      "" },
+    { SSC_OUTPUT,       SSC_ARRAY,       "disp_build_time",           "Dispatch model build time",                                                        "sec",          "",               "tou",            "*",                       "",                      "" },
                                                                                                                                                                                                                                                                   
     { SSC_OUTPUT,       SSC_ARRAY,       "htf_pump_power",            "Parasitic power TES and Cycle HTF pump",                                           "MWe",          "",               "system",         "*",                       "",                      "" },
     { SSC_OUTPUT,       SSC_ARRAY,       "P_cooling_tower_tot",       "Parasitic power condenser operation",                                              "MWe",          "",               "system",         "*",                       "",                      "" },
@@ -586,6 +607,7 @@ public:
         c_trough.m_ColTilt = as_double("tilt");                     //[deg] Collector tilt angle (0 is horizontal, 90deg is vertical)
         c_trough.m_ColAz = as_double("azimuth");                    //[deg] Collector azimuth angle
         c_trough.m_wind_stow_speed = as_double("wind_stow_speed");  //[m/s] Wind speed at and above which the collectors will be stowed
+        c_trough.m_use_evac_surrogate = as_boolean("is_evac_surrogate");	//[-] Interpolate receiver heat losses from tables built at initialization
         c_trough.m_accept_mode = as_integer("accept_mode");         //[-] Acceptance testing mode? (1=yes, 0=no)
         c_trough.m_accept_init = as_boolean("accept_init");         //[-] In acceptance testing mode - require steady-state startup
         c_trough.m_solar_mult = as_double("solar_mult");            //[-] Solar Multiple
@@ -1105,6 +1127,20 @@ public:
         csp_solver.mc_reported_outputs.assign(C_csp_solver::C_solver_outputs::CTRL_OP_MODE_SEQ_B, allocate("operating_modes_b", n_steps_fixed), n_steps_fixed);
         csp_solver.mc_reported_outputs.assign(C_csp_solver::C_solver_outputs::CTRL_OP_MODE_SEQ_C, allocate("operating_modes_c", n_steps_fixed), n_steps_fixed);
 
+        csp_solver.m_is_profile = as_boolean("is_solver_profile");
+        if( csp_solver.m_is_profile )
+        {
+            csp_solver.mc_reported_outputs.assign(C_csp_solver::C_solver_outputs::PROFILE_N_OP_MODES, allocate("profile_n_op_modes", n_steps_fixed), n_steps_fixed);
+            csp_solver.mc_reported_outputs.assign(C_csp_solver::C_solver_outputs::PROFILE_N_CR_CALLS, allocate("profile_n_cr_calls", n_steps_fixed), n_steps_fixed);
+            csp_solver.mc_reported_outputs.assign(C_csp_solver::C_solver_outputs::PROFILE_N_PC_CALLS, allocate("profile_n_pc_calls", n_steps_fixed), n_steps_fixed);
+            csp_solver.mc_reported_outputs.assign(C_csp_solver::C_solver_outputs::PROFILE_N_TES_CALLS, allocate("profile_n_tes_calls", n_steps_fixed), n_steps_fixed);
+            csp_solver.mc_reported_outputs.assign(C_csp_solver::C_solver_outputs::PROFILE_N_EQ_CALLS, allocate("profile_n_eq_calls", n_steps_fixed), n_steps_fixed);
+            csp_solver.mc_reported_outputs.assign(C_csp_solver::C_solver_outputs::PROFILE_TIME_CR, allocate("profile_time_cr", n_steps_fixed), n_steps_fixed);
+            csp_solver.mc_reported_outputs.assign(C_csp_solver::C_solver_outputs::PROFILE_TIME_PC, allocate("profile_time_pc", n_steps_fixed), n_steps_fixed);
+            csp_solver.mc_reported_outputs.assign(C_csp_solver::C_solver_outputs::PROFILE_TIME_TES, allocate("profile_time_tes", n_steps_fixed), n_steps_fixed);
+            csp_solver.mc_reported_outputs.assign(C_csp_solver::C_solver_outputs::PROFILE_TIME_TOTAL, allocate("profile_time_total", n_steps_fixed), n_steps_fixed);
+        }
+
         csp_solver.mc_reported_outputs.assign(C_csp_solver::C_solver_outputs::DISPATCH_SOLVE_STATE, allocate("disp_solve_state", n_steps_fixed), n_steps_fixed);
         csp_solver.mc_reported_outputs.assign(C_csp_solver::C_solver_outputs::DISPATCH_SOLVE_ITER, allocate("disp_solve_iter", n_steps_fixed), n_steps_fixed);
         csp_solver.mc_reported_outputs.assign(C_csp_solver::C_solver_outputs::DISPATCH_SOLVE_OBJ, allocate("disp_objective", n_steps_fixed), n_steps_fixed);
@@ -1121,6 +1157,7 @@ public:
         csp_solver.mc_reported_outputs.assign(C_csp_solver::C_solver_outputs::DISPATCH_PRES_NCONSTR, allocate("disp_presolve_nconstr", n_steps_fixed), n_steps_fixed);
         csp_solver.mc_reported_outputs.assign(C_csp_solver::C_solver_outputs::DISPATCH_PRES_NVAR, allocate("disp_presolve_nvar", n_steps_fixed), n_steps_fixed);
         csp_solver.mc_reported_outputs.assign(C_csp_solver::C_solver_outputs::DISPATCH_SOLVE_TIME, allocate("disp_solve_time", n_steps_fixed), n_steps_fixed);
+        csp_solver.mc_reported_outputs.assign(C_csp_solver::C_solver_outputs::DISPATCH_BUILD_TIME, allocate("disp_build_time", n_steps_fixed), n_steps_fixed);
 
 
         update("Initialize physical trough model...", 0.0);
@@ -1196,6 +1233,20 @@ public:
             log(out_msg, out_type);
         }
 
+        if( csp_solver.m_is_profile )
+        {
+            const C_csp_solver::S_solver_profile & profile = csp_solver.get_solver_profile();
+            assign("profile_n_op_modes_ann", (ssc_number_t)profile.m_n_op_modes);
+            assign("profile_n_cr_calls_ann", (ssc_number_t)profile.m_n_cr_calls);
+            assign("profile_n_pc_calls_ann", (ssc_number_t)profile.m_n_pc_calls);
+            assign("profile_n_tes_calls_ann", (ssc_number_t)profile.m_n_tes_calls);
+            assign("profile_n_eq_calls_ann", (ssc_number_t)profile.m_n_eq_calls);
+            assign("profile_time_cr_ann", (ssc_number_t)profile.m_time_cr);
+            assign("profile_time_pc_ann", (ssc_number_t)profile.m_time_pc);
+            assign("profile_time_tes_ann", (ssc_number_t)profile.m_time_tes);
+            assign("profile_time_total_ann", (ssc_number_t)profile.m_time_total);
+        }
+
 
         // Do unit post-processing here
         float *p_q_pc_startup = allocate("q_pc_startup", n_steps_fixed);
@@ -51,6 +51,8 @@
 #include <algorithm>
 #include <sstream>
 
+#include "lib_utility_rate.h"
+
 
   
 static var_info vtab_utility_rate5[] = {
@@ -419,6 +421,8 @@ private:
 	std::vector<std::vector<int> >  m_dc_tou_periods_tiers; // tier numbers
 	std::vector<std::vector<int> >  m_dc_flat_tiers; // tier numbers for each month of flat demand charge
 	size_t m_num_rec_yearly;
+	// schedules and rate tables compiled once per time step for all years
+	CompiledUtilityRate m_rate;
 
 public:
 	cm_utilityrate5()
@@ -760,6 +764,7 @@ public:
 		int metering_option = as_integer("ur_metering_option");
 		bool two_meter = (metering_option == 4 );
 		bool timestep_reconciliation = (metering_option == 2 || metering_option == 3 || metering_option == 4);
+		var_handle lifetime_output = intern("system_use_lifetime_output");
 
 
 		idx = 0;
@@ -794,7 +799,7 @@ public:
 
 
 				// update e_sys per year if lifetime output
-				if ((as_integer("system_use_lifetime_output") == 1) && ( idx < nrec_gen ))
+				if ((as_integer(lifetime_output) == 1) && ( idx < nrec_gen ))
 				{
 //					e_sys[j] = p_sys[j] = 0.0;
 //					ts_power = (idx < nrec_gen) ? pgen[idx] : 0;
@@ -1453,6 +1458,7 @@ public:
 
 		size_t idx = 0;
 		size_t steps_per_hour = m_num_rec_yearly / 8760;
+		m_rate = CompiledUtilityRate(steps_per_hour);
 
 		if (ec_enabled)
 		{
@@ -1481,20 +1487,6 @@ public:
 			// columns are period, tier1 max, tier 2 max, ..., tier n max
 
 
-			int ec_tod[8760];
-
-			if (!util::translate_schedule(ec_tod, ec_schedwkday, ec_schedwkend, 1, 12))
-				throw general_error("Could not translate weekday and weekend schedules for energy rates.");
-			for (i = 0; i < 8760; i++)
-			{
-				for (size_t ii = 0; ii < steps_per_hour; ii++)
-				{
-					if (idx < m_num_rec_yearly)
-						m_ec_tou_sched[idx] = ec_tod[i];
-					idx++;
-				}
-			}
-
 			// 6 columns period, tier, max usage, max usage units, buy, sell
 			ssc_number_t *ec_tou_in = as_matrix("ur_ec_tou_mat", &nrows, &ncols);
 			if (ncols != 6)
@@ -1506,6 +1498,11 @@ public:
 			util::matrix_t<float> ec_tou_mat(nrows, ncols);
 			ec_tou_mat.assign(ec_tou_in, nrows, ncols);
 
+			if (!m_rate.compileEnergyCharges(as_matrix_unsigned_long("ur_ec_sched_weekday"), as_matrix_unsigned_long("ur_ec_sched_weekend"), as_matrix("ur_ec_tou_mat")))
+				throw general_error("Could not translate weekday and weekend schedules for energy rates.");
+			for (idx = 0; idx < m_num_rec_yearly; idx++)
+				m_ec_tou_sched[idx] = m_rate.energyPeriod(idx);
+
 			bool sell_eq_buy = as_boolean("ur_sell_eq_buy");
 
 			for (r = 0; r < nrows; r++)
@@ -1682,22 +1679,6 @@ public:
 			// columns are period, tier1 max, tier 2 max, ..., tier n max
 
 
-			int dc_tod[8760];
-
-			if (!util::translate_schedule(dc_tod, dc_schedwkday, dc_schedwkend, 1, 12))
-				throw general_error("Could not translate weekday and weekend schedules for demand charges");
-
-			idx = 0;
-			for (i = 0; i < 8760; i++)
-			{
-				for (size_t ii = 0; ii < steps_per_hour; ii++)
-				{
-					if (idx < m_num_rec_yearly)
-						m_dc_tou_sched[idx] = dc_tod[i];
-					idx++;
-				}
-			}
-
 			// 4 columns period, tier, max usage, charge
 			ssc_number_t *dc_tou_in = as_matrix("ur_dc_tou_mat", &nrows, &ncols);
 			if (ncols != 4)
@@ -1822,6 +1803,11 @@ public:
 			util::matrix_t<float> dc_flat_mat(nrows, ncols);
 			dc_flat_mat.assign(dc_flat_in, nrows, ncols);
 
+			if (!m_rate.compileDemandCharges(as_matrix_unsigned_long("ur_dc_sched_weekday"), as_matrix_unsigned_long("ur_dc_sched_weekend"), as_matrix("ur_dc_tou_mat"), as_matrix("ur_dc_flat_mat")))
+				throw general_error("Could not translate weekday and weekend schedules for demand charges");
+			for (idx = 0; idx < m_num_rec_yearly; idx++)
+				m_dc_tou_sched[idx] = m_rate.demandPeriod(idx);
+
 			for (r = 0; r < m_month.size(); r++)
 			{
 				m_dc_flat_tiers.push_back(std::vector<int>());
@@ -2105,28 +2091,19 @@ public:
 					mon_e_net = monthly_cumulative_excess_energy[m - 1]; // rollover
 				}
 
-				for (d = 0; d < util::nday[m]; d++)
+				for (c = (int)m_rate.firstStepOfMonth(m); c <= (int)m_rate.lastStepOfMonth(m); c++)
 				{
-					for (h = 0; h < 24; h++)
+					mon_e_net += e_in[c];
+					int row = m_rate.energyPeriodRow(c);
+					if (row < 0)
 					{
-						for (s = 0; s < (int)steps_per_hour && c < (int)m_num_rec_yearly; s++)
-						{
-							mon_e_net += e_in[c];
-							int toup = m_ec_tou_sched[c];
-							std::vector<int>::iterator per_num = std::find(m_month[m].ec_periods.begin(), m_month[m].ec_periods.end(), toup);
-							if (per_num == m_month[m].ec_periods.end())
-							{
-								std::ostringstream ss;
-								ss << "Energy rate TOU Period " << toup << " not found for Month " << util::schedule_int_to_month(m) << ".";
-								throw exec_error("utilityrate5", ss.str());
-							}
-							int row = (int)(per_num - m_month[m].ec_periods.begin());
-							// place all in tier 0 initially and then update appropriately
-							// net energy per period per month
-							m_month[m].ec_energy_use(row, 0) += e_in[c];
-							c++;
-						}
+						std::ostringstream ss;
+						ss << "Energy rate TOU Period " << m_ec_tou_sched[c] << " not found for Month " << util::schedule_int_to_month(m) << ".";
+						throw exec_error("utilityrate5", ss.str());
 					}
+					// place all in tier 0 initially and then update appropriately
+					// net energy per period per month
+					m_month[m].ec_energy_use(row, 0) += e_in[c];
 				}
 
 				/*
@@ -2301,28 +2278,19 @@ public:
 					m_month[m].dc_tou_peak.push_back(0);
 					m_month[m].dc_tou_peak_hour.push_back(0);
 				}
-				for (d = 0; d < util::nday[m]; d++)
+				for (c = (int)m_rate.firstStepOfMonth(m); c <= (int)m_rate.lastStepOfMonth(m); c++)
 				{
-					for (h = 0; h < 24; h++)
+					int row = m_rate.demandPeriodRow(c);
+					if (row < 0)
 					{
-						for (s = 0; s < (int)steps_per_hour && c < (int)m_num_rec_yearly; s++)
-						{
-							int todp = m_dc_tou_sched[c];
-							std::vector<int>::iterator per_num = std::find(m_month[m].dc_periods.begin(), m_month[m].dc_periods.end(), todp);
-							if (per_num == m_month[m].dc_periods.end())
-							{
-								std::ostringstream ss;
-								ss << "Demand rate Period " << todp << " not found for Month " << m << ".";
-								throw exec_error("utilityrate5", ss.str());
-							}
-							int row = (int)(per_num - m_month[m].dc_periods.begin());
-							if (p_in[c] < 0 && p_in[c] < -m_month[m].dc_tou_peak[row])
-							{
-								m_month[m].dc_tou_peak[row] = -p_in[c];
-								m_month[m].dc_tou_peak_hour[row] = c;
-							}
-							c++;
-						}
+						std::ostringstream ss;
+						ss << "Demand rate Period " << m_dc_tou_sched[c] << " not found for Month " << m << ".";
+						throw exec_error("utilityrate5", ss.str());
+					}
+					if (p_in[c] < 0 && p_in[c] < -m_month[m].dc_tou_peak[row])
+					{
+						m_month[m].dc_tou_peak[row] = -p_in[c];
+						m_month[m].dc_tou_peak_hour[row] = (int)c;
 					}
 				}
 			}
@@ -2861,28 +2829,19 @@ public:
 					m_month[m].dc_tou_peak.push_back(0);
 					m_month[m].dc_tou_peak_hour.push_back(0);
 				}
-				for (d = 0; d < util::nday[m]; d++)
+				for (c = m_rate.firstStepOfMonth(m); c <= m_rate.lastStepOfMonth(m); c++)
 				{
-					for (h = 0; h < 24; h++)
+					int row = m_rate.demandPeriodRow(c);
+					if (row < 0)
 					{
-						for (s = 0; s < (int)steps_per_hour && c < (int)m_num_rec_yearly; s++)
-						{
-							int todp = m_dc_tou_sched[c];
-							std::vector<int>::iterator per_num = std::find(m_month[m].dc_periods.begin(), m_month[m].dc_periods.end(), todp);
-							if (per_num == m_month[m].dc_periods.end())
-							{
-								std::ostringstream ss;
-								ss << "Demand charge Period " << todp << " not found for Month " << m << ".";
-								throw exec_error("utilityrate5", ss.str());
-							}
-							int row = (int)(per_num - m_month[m].dc_periods.begin());
-							if (p_in[c] < 0 && p_in[c] < -m_month[m].dc_tou_peak[row])
-							{
-								m_month[m].dc_tou_peak[row] = -p_in[c];
-								m_month[m].dc_tou_peak_hour[row] = (int)c;
-							}
-							c++;
-						}
+						std::ostringstream ss;
+						ss << "Demand charge Period " << m_dc_tou_sched[c] << " not found for Month " << m << ".";
+						throw exec_error("utilityrate5", ss.str());
+					}
+					if (p_in[c] < 0 && p_in[c] < -m_month[m].dc_tou_peak[row])
+					{
+						m_month[m].dc_tou_peak[row] = -p_in[c];
+						m_month[m].dc_tou_peak_hour[row] = (int)c;
 					}
 				}
 			}
@@ -2908,16 +2867,15 @@ public:
 						if (ec_enabled)
 						{
 							period = m_ec_tou_sched[c];
-							// find corresponding monthly period
+							// corresponding monthly period
 							// check for valid period
-							std::vector<int>::iterator per_num = std::find(m_month[m].ec_periods.begin(), m_month[m].ec_periods.end(), period);
-							if (per_num == m_month[m].ec_periods.end())
+							int row = m_rate.energyPeriodRow(c);
+							if (row < 0)
 							{
 								std::ostringstream ss;
 								ss << "Energy rate Period " << period << " not found for Month " << m << ".";
 								throw exec_error("utilityrate5", ss.str());
 							}
-							int row = (int)(per_num - m_month[m].ec_periods.begin());
 
 							if (e_in[c] >= 0.0)
 							{ // calculate income or credit
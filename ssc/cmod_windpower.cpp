@@ -54,6 +54,8 @@
 #include "lib_util.h"
 #include "cmod_windpower.h"
 
+#include <mutex>
+
 static var_info _cm_vtab_windpower[] = {
 	// VARTYPE   DATATYPE		NAME								LABEL										UNITS		META	GROUP			REQUIRED_IF						CONSTRAINTS                                        UI_HINTS
 	{ SSC_INPUT, SSC_STRING,  "wind_resource_filename",				"local wind data file path",				"",			"",		"WindPower",	"?",							"LOCAL_FILE",										"" },
@@ -78,6 +80,12 @@ static var_info _cm_vtab_windpower[] = {
 	{ SSC_INPUT, SSC_ARRAY,   "wind_farm_yCoordinates",				"Turbine Y coordinates",					"m",		"",		"WindPower",	"*",							"LENGTH_EQUAL=wind_farm_xCoordinates",				"" },
 	{ SSC_INPUT, SSC_NUMBER,  "wind_farm_losses_percent",			"Percentage losses",						"%",		"",		"WindPower",	"*",							"",													"" },
 	{ SSC_INPUT, SSC_NUMBER,  "wind_farm_wake_model",				"Wake Model",								"0/1/2",	"",		"WindPower",	"*",							"INTEGER",											"" },
+	{ SSC_INPUT, SSC_NUMBER,  "wind_farm_wake_threads",				"Threads for the wake calculation",			"",			"0=automatic",	"WindPower",	"?=0",						"INTEGER,MIN=0",									"" },
+	{ SSC_INPUT, SSC_NUMBER,  "wind_farm_wake_table",				"Interpolate wake losses from a precomputed table",	"0/1",	"",		"WindPower",	"?=0",							"BOOLEAN",											"" },
+	{ SSC_INPUT, SSC_NUMBER,  "wind_farm_wake_table_dir_bin",		"Wake table wind direction bin width",		"deg",		"",		"WindPower",	"?=5",							"POSITIVE",											"" },
+	{ SSC_INPUT, SSC_NUMBER,  "wind_farm_wake_table_speed_bin",		"Wake table wind speed bin width",			"m/s",		"",		"WindPower",	"?=0.5",						"POSITIVE",											"" },
+	{ SSC_INPUT, SSC_NUMBER,  "wind_farm_wake_table_density_bin",	"Wake table air density bin width",			"kg/m3",	"",		"WindPower",	"?=0.1",						"POSITIVE",											"" },
+	{ SSC_INPUT, SSC_NUMBER,  "wind_farm_wake_table_check",			"Also run the exact wake model and report the table error",	"0/1",	"",	"WindPower",	"?=0",						"BOOLEAN",											"" },
 	{ SSC_INPUT, SSC_NUMBER,  "en_low_temp_cutoff",					"Enable Low Temperature Cutoff",			"0/1",		"",		"WindPower",	"?=0",							"INTEGER",											"" },
 	{ SSC_INPUT, SSC_NUMBER,  "low_temp_cutoff",					"Low Temperature Cutoff",					"C",		"",		"WindPower",	"en_low_temp_cutoff=1",			"",													"" },
 	{ SSC_INPUT, SSC_NUMBER,  "en_icing_cutoff",					"Enable Icing Cutoff",						"0/1",		"",		"WindPower",	"?=0",							"INTEGER",											"" },
@@ -98,6 +106,8 @@ static var_info _cm_vtab_windpower[] = {
 	{ SSC_OUTPUT, SSC_NUMBER, "annual_energy",					"Annual Energy",							"kWh",		"", "Annual", "*", "", "" },
 	{ SSC_OUTPUT, SSC_NUMBER, "capacity_factor",				"Capacity factor",							"%",		"", "Annual", "*", "", "" },
 	{ SSC_OUTPUT, SSC_NUMBER, "kwh_per_kw",						"First year kWh/kW",						"kWh/kW",	"", "Annual", "*", "", "" },
+	{ SSC_OUTPUT, SSC_NUMBER, "wake_table_max_error",			"Wake table maximum farm power error",		"kW",		"0 without a wake table", "Annual", "wind_farm_wake_table_check=1", "", "" },
+	{ SSC_OUTPUT, SSC_NUMBER, "wake_table_energy_error",		"Wake table annual energy error",			"%",		"0 without a wake table", "Annual", "wind_farm_wake_table_check=1", "", "" },
 
 	{ SSC_OUTPUT, SSC_NUMBER, "cutoff_losses",                  "Cutoff losses",                            "%",		"", "Annual", "", "", "" },
 
@@ -197,6 +207,41 @@ bool winddata::read_line(std::vector<double> &values)
 	return true;
 }
 
+bool winddata::read_lines(util::matrix_t<double> &values)
+{
+	if (irecord >= data.nrows()
+		|| data.ncols() == 0
+		|| data.nrows() == 0) return false;
+
+	values.resize(data.nrows() - irecord, data.ncols());
+	for (size_t r = 0; r < values.nrows(); r++)
+		for (size_t j = 0; j < data.ncols(); j++)
+			values(r, j) = (double)data(irecord + r, j);
+
+	irecord = data.nrows();
+	return true;
+}
+
+// The wake table only depends on the layout, turbine and wake model inputs, so the most recent table is shared
+// by later runs of the same farm (multiple resource years, P50/P90 studies) instead of being rebuilt each time
+static std::mutex sg_wakeTableMutex;
+static std::vector<double> sg_wakeTableKey;
+static std::shared_ptr<windWakeTable> sg_wakeTable;
+
+static std::shared_ptr<windWakeTable> cached_wake_table(const std::vector<double> &key)
+{
+	std::lock_guard<std::mutex> lock(sg_wakeTableMutex);
+	if (sg_wakeTable && key == sg_wakeTableKey)
+		return sg_wakeTable;
+	return nullptr;
+}
+
+static void cache_wake_table(const std::vector<double> &key, std::shared_ptr<windWakeTable> table)
+{
+	std::lock_guard<std::mutex> lock(sg_wakeTableMutex);
+	sg_wakeTableKey = key;
+	sg_wakeTable = table;
+}
 
 cm_windpower::cm_windpower(){
 	add_var_info(_cm_vtab_windpower);
@@ -241,8 +286,6 @@ void cm_windpower::exec() throw(general_error)
 		throw exec_error("windpower", util::format("wind turbine class not properly initialized"));
 	if (wpc.nTurbines < 1)
 		throw exec_error("windpower", util::format("the number of wind turbines was zero."));
-	if (wpc.nTurbines > wpc.GetMaxTurbines())
-		throw exec_error("windpower", util::format("the wind model is only configured to handle up to %d turbines.", wpc.GetMaxTurbines()));
 
 	// create adjustment factors and losses
 	adjustment_factors haf(this, "adjust");
@@ -250,6 +293,9 @@ void cm_windpower::exec() throw(general_error)
 		throw exec_error("windpower", "failed to setup adjustment factors: " + haf.error());
 	bool lowTempCutoff = as_boolean("en_low_temp_cutoff");
 	bool icingCutoff = as_boolean("en_icing_cutoff");
+	var_handle lowTempCutoffValue = intern("low_temp_cutoff");
+	var_handle icingCutoffTemp = intern("icing_cutoff_temp");
+	var_handle icingCutoffRH = intern("icing_cutoff_rh");
 	
 	// Run Weibull Statistical model (single outputs) if selected
 	if (as_integer("wind_resource_model_choice") == 1){	
@@ -291,6 +337,13 @@ void cm_windpower::exec() throw(general_error)
 		if (nameplate > 0) kWhperkW = annual_energy / nameplate;
 		assign("capacity_factor", var_data((ssc_number_t)(kWhperkW / 87.6)));
 		assign("kwh_per_kw", var_data((ssc_number_t)kWhperkW));
+
+		// the Weibull model doesn't use the wake table
+		if (as_boolean("wind_farm_wake_table_check"))
+		{
+			assign("wake_table_max_error", var_data((ssc_number_t)0));
+			assign("wake_table_energy_error", var_data((ssc_number_t)0));
+		}
 		
 		return;
 	}
@@ -359,6 +412,69 @@ void cm_windpower::exec() throw(general_error)
 	}
 	if (!wpc.InitializeModel(wakeModel))
 		throw exec_error("windpower", util::format("Wake model choice must be 0, 1 or 2"));
+	wakeModel->setThreadCount(as_integer("wind_farm_wake_threads"));
+
+	// optionally tabulate the wake losses once for this layout and interpolate them at each time step.
+	// densities outside 0.8-1.5 kg/m3 use the closest table edge
+	bool useWakeTable = as_boolean("wind_farm_wake_table");
+	bool checkWakeTable = false;
+	if (useWakeTable)
+	{
+		double dirBin = as_double("wind_farm_wake_table_dir_bin");
+		double speedBin = as_double("wind_farm_wake_table_speed_bin");
+		double densityBin = as_double("wind_farm_wake_table_density_bin");
+
+		std::vector<double> key = { (double)wakeModelChoice, wpc.turbulenceIntensity, wt.rotorDiameter, wt.hubHeight,
+			wt.lossesPercent, dirBin, speedBin, densityBin };
+		key.insert(key.end(), windSpeeds.begin(), windSpeeds.end());
+		key.insert(key.end(), powerOutput.begin(), powerOutput.end());
+		key.insert(key.end(), wpc.XCoords.begin(), wpc.XCoords.end());
+		key.insert(key.end(), wpc.YCoords.begin(), wpc.YCoords.end());
+
+		std::shared_ptr<windWakeTable> table = cached_wake_table(key);
+		if (table)
+			wpc.setWakeTable(table);
+		else if (wpc.buildWakeTable(dirBin, speedBin, 0.8, 1.5, densityBin))
+			cache_wake_table(key, wpc.getWakeTable());
+		else
+		{
+			if (wpc.GetErrorDetails().length() > 0)
+				throw exec_error("windpower", "failed to build wake table: " + wpc.GetErrorDetails());
+			useWakeTable = false; // a single turbine has no wake losses
+		}
+		checkWakeTable = useWakeTable && as_boolean("wind_farm_wake_table_check");
+	}
+	double wakeTableMaxError = 0.0, wakeTableEnergy = 0.0, wakeExactEnergy = 0.0;
+
+	// read the whole resource once at hub height. the closest measurement heights depend only on the file header,
+	// so the height checks and the shear correction are done once for all records
+	winddata_columns resource;
+	if (!wdprov->read_all(wt.hubHeight, true, resource))
+		throw exec_error("windpower", "error reading wind resource file: " + wdprov->error());
+	size_t nrecords_needed = nstep + (contains_leap_day ? 24 * steps_per_hour : 0);
+	if (resource.size() < nrecords_needed)
+		throw exec_error("windpower", util::format("error reading wind resource file at %d: ", (int)resource.size()) + wdprov->error());
+
+	// if read_all is able to interpolate, then it sets the speed measurement height equal to the hub height
+	// direction will not be interpolated, pressure and temperature will be if possible
+	wt.measurementHeight = resource.speedMeasHeight;
+	double closest_dir_meas_ht = resource.dirMeasHeight;
+	if (fabs(wt.measurementHeight - wt.hubHeight) > 35.0)
+		throw exec_error("windpower", util::format("the closest wind speed measurement height (%lg m) found is more than 35 m from the hub height specified (%lg m)", wt.measurementHeight, wt.hubHeight));
+
+	if (fabs(closest_dir_meas_ht - wt.measurementHeight) > 10.0)
+		throw exec_error("windpower", util::format("the closest wind speed measurement height (%lg m) and direction measurement height (%lg m) were more than 10m apart", wt.measurementHeight, closest_dir_meas_ht));
+
+	// If the wind speed measurement height still differs from the turbine hub height (ie it wasn't corrected above, maybe because file only has one measurement height), use the shear to correct it. 
+	if (fabs(wt.measurementHeight - wt.hubHeight) > 1) {
+		if (wt.shearExponent > 1.0) wt.shearExponent = 1.0 / 7.0;
+		double shearFactor = pow(wt.hubHeight / wt.measurementHeight, wt.shearExponent);
+		for (size_t r = 0; r < resource.size(); r++)
+			resource.speed[r] *= shearFactor;
+		wt.measurementHeight = wt.hubHeight;
+	}
+
+	const std::vector<float> &relativeHumidity = wdprov->relativeHumidity();
 
 	// allocate output data
 	ssc_number_t *farmpwr = allocate("gen", nstep);
@@ -388,53 +504,22 @@ void cm_windpower::exec() throw(general_error)
 			if (i % (nstep / 20) == 0)
 				update("", 100.0f * ((float)i) / ((float)nstep), (float)i); //update percentage complete in UI
 
-			double wind, dir, temp, pres, closest_dir_meas_ht;
+			//skip leap day if applicable: Feb 29 starts at hour 1416, (31 days in Jan  + 28 days in Feb) * 24 hours a day
+			size_t r = i;
+			if (contains_leap_day && hr >= 1416)
+				r += 24 * steps_per_hour;
 
-			//skip leap day if applicable
-			if (contains_leap_day)
-			{
-				if (hr == 1416) //(31 days in Jan  + 28 days in Feb) * 24 hours a day, +1 to be the start of Feb 29, -1 because of 0 indexing
-					for (size_t j = 0; j < 24 * steps_per_hour; j++) //trash 24 hours' worth of lines in the weather file to skip the entire day of Feb 29
-					{
-						if (!wdprov->read(wt.hubHeight, &wind, &dir, &temp, &pres, &wt.measurementHeight, &closest_dir_meas_ht, true))
-							throw exec_error("windpower", util::format("error reading wind resource file at %d: ", i) + wdprov->error());
-					}
-			} //now continue with the normal process, none of the counters have been incremented so everything else should be ok
-
-			// if wf.read is set to interpolate (last input), and it's able to do so, then it will set wpc.measurementHeight equal to hub_ht
-			// direction will not be interpolated, pressure and temperature will be if possible
-			if (!wdprov->read(wt.hubHeight, &wind, &dir, &temp, &pres, &wt.measurementHeight, &closest_dir_meas_ht, true))
-				throw exec_error("windpower", util::format("error reading wind resource file at %d: ", i) + wdprov->error());
-
-			if (fabs(wt.measurementHeight - wt.hubHeight) > 35.0)
-				throw exec_error("windpower", util::format("the closest wind speed measurement height (%lg m) found is more than 35 m from the hub height specified (%lg m)", wt.measurementHeight, wt.hubHeight));
-
-			if (fabs(closest_dir_meas_ht - wt.measurementHeight) > 10.0)
-			{
-				if (i > 0) // if this isn't the first hour, then it's probably because of interpolation
-				{
-					// probably interpolated wind speed, but could not interpolate wind direction because the directions were too far apart.
-					// first, verify:
-					if ((wt.measurementHeight == wt.hubHeight) && (closest_dir_meas_ht != wt.hubHeight))
-						// now, alert the user of this discrepancy
-						throw exec_error("windpower", util::format("on hour %d, SAM interpolated the wind speed to an %lgm measurement height, but could not interpolate the wind direction from the two closest measurements because the directions encountered were too disparate", i + 1, wt.measurementHeight));
-					else
-						throw exec_error("windpower", util::format("SAM encountered an error at hour %d: hub height = %lg, closest wind speed meas height = %lg, closest wind direction meas height = %lg ", i + 1, wt.hubHeight, wt.measurementHeight, closest_dir_meas_ht));
-				}
-				else
-					throw exec_error("windpower", util::format("the closest wind speed measurement height (%lg m) and direction measurement height (%lg m) were more than 10m apart", wt.measurementHeight, closest_dir_meas_ht));
-			}
+			double wind = resource.speed[r];
+			double dir = resource.direction[r];
+			double temp = resource.temperature[r];
+			double pres = resource.pressure[r];
 
-			// If the wind speed measurement height still differs from the turbine hub height (ie it wasn't corrected above, maybe because file only has one measurement height), use the shear to correct it. 
-			if (fabs(wt.measurementHeight - wt.hubHeight) > 1) {
-				if (wt.shearExponent > 1.0) wt.shearExponent = 1.0 / 7.0;
-				wind = wind * pow(wt.hubHeight / wt.measurementHeight, wt.shearExponent);
-				wt.measurementHeight = wt.hubHeight;
-			}
+			double farmp = 0, farmTable = 0;
 
-			double farmp = 0;
+			if (useWakeTable && (int)wpc.nTurbines != wpc.windPowerUsingWakeTable(wind, dir, pres, temp, &farmTable, NULL, NULL))
+				throw exec_error("windpower", util::format("error in wind calculation at time %d, details: %s", i, wpc.GetErrorDetails().c_str()));
 
-			if ((int)wpc.nTurbines != wpc.windPowerUsingResource(
+			if ((!useWakeTable || checkWakeTable) && (int)wpc.nTurbines != wpc.windPowerUsingResource(
 				/* inputs */
 				wind,	/* m/s */
 				dir,	/* degrees */
@@ -452,13 +537,22 @@ void cm_windpower::exec() throw(general_error)
 				&DistCross[0]))
 				throw exec_error("windpower", util::format("error in wind calculation at time %d, details: %s", i, wpc.GetErrorDetails().c_str()));
 
+			if (checkWakeTable)
+			{
+				wakeTableMaxError = max_of(wakeTableMaxError, fabs(farmTable - farmp));
+				wakeTableEnergy += farmTable * haf(hr) / steps_per_hour;
+				wakeExactEnergy += farmp * haf(hr) / steps_per_hour;
+			}
+			if (useWakeTable)
+				farmp = farmTable;
+
 			// apply losses
 			withoutLosses += farmp * haf(hr);
 			if (lowTempCutoff){
-				if (temp < as_double("low_temp_cutoff")) farmp = 0.0;
+				if (temp < as_double(lowTempCutoffValue)) farmp = 0.0;
 			}
 			if (icingCutoff){
-				if (temp < as_double("icing_cutoff_temp") && wdprov->relativeHumidity()[i] < as_double("icing_cutoff_rh"))
+				if (temp < as_double(icingCutoffTemp) && relativeHumidity[i] < as_double(icingCutoffRH))
 					farmp = 0.0;
 			}
 
@@ -485,6 +579,21 @@ void cm_windpower::exec() throw(general_error)
 	assign("kwh_per_kw", var_data((ssc_number_t)kWhperkW));
 	assign("cutoff_losses", var_data((ssc_number_t)((withoutLosses-annual)/ withoutLosses)));
 
+	if (checkWakeTable)
+	{
+		double energyError = (wakeExactEnergy > 0) ? 100.0 * (wakeTableEnergy - wakeExactEnergy) / wakeExactEnergy : 0.0;
+		assign("wake_table_max_error", var_data((ssc_number_t)wakeTableMaxError));
+		assign("wake_table_energy_error", var_data((ssc_number_t)energyError));
+		log(util::format("Wake table annual energy differs from the exact wake model by %lg %%, maximum farm power difference %lg kW.",
+			energyError, wakeTableMaxError), SSC_NOTICE);
+	}
+	else if (as_boolean("wind_farm_wake_table_check"))
+	{
+		// without a wake table, or for a single turbine, the exact wake model was used
+		assign("wake_table_max_error", var_data((ssc_number_t)0));
+		assign("wake_table_energy_error", var_data((ssc_number_t)0));
+	}
+
 } // exec
 
 DEFINE_MODULE_ENTRY(windpower, "Utility scale wind farm model (adapted from TRNSYS code by P.Quinlan and openWind software by AWS Truepower)", 2);
@@ -76,6 +76,7 @@ public:
 	ssc_number_t *get_vector(var_data *v, const char *name, size_t *len);
 
 	bool read_line(std::vector<double> &values);
+	bool read_lines(util::matrix_t<double> &values);
 };
 
 class cm_windpower : public compute_module
@@ -755,10 +755,6 @@ double shading_factor_calculator::dc_shade_factor()
 
 weatherdata::weatherdata( var_data *data_table )
 {
-	m_startSec = m_stepSec = m_nRecords = 0;
-	m_index = 0;
-	m_ok = true;
-
 	if ( data_table->type != SSC_TABLE ) 
 	{
 		m_message = "solar data must be an SSC table variable with fields: "
@@ -768,10 +764,10 @@ weatherdata::weatherdata( var_data *data_table )
 	}
 
 
-	m_hdr.lat = get_number( data_table, "lat" );
-	m_hdr.lon = get_number( data_table, "lon" );
-	m_hdr.tz = get_number( data_table, "tz" );
-	m_hdr.elev = get_number( data_table, "elev" );
+	set_location( get_number( data_table, "lat" ),
+		get_number( data_table, "lon" ),
+		get_number( data_table, "tz" ),
+		get_number( data_table, "elev" ) );
 
 	// make sure two types of irradiance are provided
 	size_t nrec = 0;
@@ -807,128 +803,35 @@ weatherdata::weatherdata( var_data *data_table )
 	}
 
 	// check that all vectors are of same length as irradiance vectors
-	vec year = get_vector( data_table, "year");
-	vec month = get_vector( data_table, "month");
-	vec day = get_vector( data_table, "day");
-	vec hour = get_vector( data_table, "hour");
-	vec minute = get_vector( data_table, "minute");
-	vec gh = get_vector( data_table, "gh", &nrec );
-	vec dn = get_vector( data_table, "dn", &nrec );
-	vec df = get_vector( data_table, "df", &nrec );
-	vec poa = get_vector(data_table, "poa", &nrec);
-	vec wspd = get_vector( data_table, "wspd", &nrec );
-	vec wdir = get_vector( data_table, "wdir", &nrec );
-	vec tdry = get_vector( data_table, "tdry", &nrec ); 
-	vec twet = get_vector( data_table, "twet", &nrec ); 
-	vec tdew = get_vector( data_table, "tdew", &nrec ); 
-	vec rhum = get_vector( data_table, "rhum", &nrec ); 
-	vec pres = get_vector( data_table, "pres", &nrec ); 
-	vec snow = get_vector( data_table, "snow", &nrec ); 
-	vec alb = get_vector( data_table, "alb", &nrec ); 
-	vec aod = get_vector( data_table, "aod", &nrec ); 
+	get_vector( data_table, "year");
+	get_vector( data_table, "month");
+	get_vector( data_table, "day");
+	get_vector( data_table, "hour");
+	get_vector( data_table, "minute");
+	get_vector( data_table, "gh", &nrec );
+	get_vector( data_table, "dn", &nrec );
+	get_vector( data_table, "df", &nrec );
+	get_vector( data_table, "poa", &nrec );
+	get_vector( data_table, "wspd", &nrec );
+	get_vector( data_table, "wdir", &nrec );
+	get_vector( data_table, "tdry", &nrec ); 
+	get_vector( data_table, "twet", &nrec ); 
+	get_vector( data_table, "tdew", &nrec ); 
+	get_vector( data_table, "rhum", &nrec ); 
+	get_vector( data_table, "pres", &nrec ); 
+	get_vector( data_table, "snow", &nrec ); 
+	get_vector( data_table, "alb", &nrec ); 
+	get_vector( data_table, "aod", &nrec ); 
 	if (m_ok == false){
 		return;
 	}
 
-	m_nRecords = nrec;
-
-	// estimate time step
-	size_t nmult = 0;
-	if ( m_nRecords%8760 == 0 )
-	{
-		nmult = nrec / 8760;
-		m_stepSec = 3600 / nmult;
-		m_startSec = m_stepSec / 2;
-	}
-	else if ( m_nRecords%8784==0 )
-	{ 
-		// Check if the weather file contains a leap day
-		// if so, correct the number of nrecords 
-		m_nRecords = m_nRecords/8784*8760;
-		nmult = m_nRecords/8760;
-		m_stepSec = 3600 / nmult;
-		m_startSec = m_stepSec / 2;
-	}
-	else
-	{
-		m_message = "could not determine timestep in weatherdata";
-		m_ok = false;
-		return;
-	}
-
-	if ( nrec > 0 && nmult >= 1 )
-	{
-		m_data.resize( nrec );
-		for( size_t i=0;i<nrec;i++ )
-		{
-			weather_record *r = new weather_record;
-
-			if ( i < year.len ) r->year = (int)year.p[i]; 
-			else r->year = 2000;
-
-			if ( i < month.len ) r->month = (int)month.p[i];
-			else if ( m_stepSec == 3600 && m_nRecords == 8760 ) {
-				r->month = util::month_of((double)i);
-			}
-
-			if ( i < day.len ) r->day = (int)day.p[i];
-			else if ( m_stepSec == 3600 && m_nRecords == 8760 ) {
-				int month = util::month_of( (double)i );
-				r->day = util::day_of_month( month, (double)i );
-			}
-
-			if ( i < hour.len ) r->hour = (int)hour.p[i];
-			else if ( m_stepSec == 3600 && m_nRecords == 8760 ) {
-				size_t day = i / 24;
-				size_t start_of_day = day * 24;
-				r->hour = (int)(i - start_of_day);
-			}
-
-			if ( i < minute.len ) r->minute = minute.p[i];
-			else r->minute = (double)((m_stepSec / 2) / 60);
-
-			r->gh = r->dn = r->df = r->poa = r->wspd = r->wdir = r->tdry = r->twet = r->tdew 
-				= r->rhum = r->pres = r->snow = r->alb = r->aod = std::numeric_limits<double>::quiet_NaN();
-			if ( i < gh.len ) r->gh = gh.p[i];
-			if ( i < dn.len ) r->dn = dn.p[i];
-			if ( i < df.len ) r->df = df.p[i];
-			if (i < poa.len ) r->poa = poa.p[i];
-
-			if ( i < wspd.len ) r->wspd = wspd.p[i];
-			if ( i < wdir.len ) r->wdir = wdir.p[i];
-
-			if ( i < tdry.len ) r->tdry = tdry.p[i];
-			if ( i < twet.len ) r->twet = twet.p[i];
-			else{
-				// calculate twet using calc_twet if tdry & rh & pres are available
-				if ((i < tdry.len) && (i < rhum.len) && (i < pres.len)){
-					r->twet = (float)calc_twet(tdry.p[i], rhum.p[i], pres.p[i]);
-				}
-			}
-			if ( i < tdew.len ) r->tdew = tdew.p[i];
-			else{
-				// calculate tdew using wiki_dew_calc if tdry & rh are available
-				if ((i < tdry.len) && (i < rhum.len)){
-					r->tdew = (float)wiki_dew_calc(tdry.p[i], rhum.p[i]);
-				}
-			}
-
-			if ( i < rhum.len ) r->rhum = rhum.p[i];
-			if ( i < pres.len ) r->pres = pres.p[i];
-
-			if ( i < snow.len ) r->snow = snow.p[i];
-			if ( i < alb.len ) r->alb = alb.p[i];
-			if ( i < aod.len ) r->aod = aod.p[i];
-
-			m_data[i] = r;
-		}
-	}
+	init( nrec );
 }
 
 weatherdata::~weatherdata()
 {
-	for( size_t i=0;i<m_data.size();i++ )
-		delete m_data[i];
+	// columns are owned by the data table, nothing to do..
 }
 
 
@@ -959,31 +862,20 @@ int weatherdata::name_to_id( const char *name )
 	return -1;
 }
 
-weatherdata::vec weatherdata::get_vector( var_data *v, const char *name, size_t *len )
+void weatherdata::get_vector( var_data *v, const char *name, size_t *len )
 {
-	vec x;
-	x.p = 0;
-	x.len = 0;
 	if ( var_data *value = v->table.lookup( name ) )
 	{
 		if ( value->type == SSC_ARRAY )
 		{
-			x.len = value->num.length();
-			x.p = value->num.data();
-			if (len && *len != x.len) {
+			if (len && *len != value->num.length()) {
 				std::string name_s(name);
 				m_message = name_s + " number of entries doesn't match with other fields";
 				m_ok = false;
 			}
-			size_t id = name_to_id(name);
-			if ( !has_data_column( id ) )
-			  {
-			    m_columns.push_back( id );
-			  }
+			set_column( name_to_id(name), value->num.data(), value->num.length() );
 		}
 	}
-
-	return x;
 }
 
 ssc_number_t weatherdata::get_number( var_data *v, const char *name )
@@ -997,43 +889,6 @@ ssc_number_t weatherdata::get_number( var_data *v, const char *name )
 	return std::numeric_limits<ssc_number_t>::quiet_NaN();
 }
 
-void weatherdata::set_counter_to(size_t cur_index){
-	if (cur_index < m_data.size()) {
-		m_index = cur_index;
-	}
-}
-
-bool weatherdata::read( weather_record *r )
-{
-	if (m_index < m_data.size())
-	{
-		*r = *m_data[m_index++];
-		return true;
-	}
-	else
-		return false;
-}
-
-bool weatherdata::read_average(weather_record *r, std::vector<int> &, size_t &)
-{
-	// finish per bool weatherfile::read_average(weather_record *r, std::vector<int> &cols, size_t &num_timesteps)
-	if (m_index < m_data.size())
-	{
-		*r = *m_data[m_index++];
-		return true;
-	}
-	else
-		return false;
-
-}
-
-
-
-bool weatherdata::has_data_column( size_t id )
-{
-	return std::find( m_columns.begin(), m_columns.end(), id ) != m_columns.end();
-}
-
 bool ssc_cmod_update(std::string &log_msg, std::string &progress_msg, void *data, double progress, int log_type)
 {
 	compute_module *cm = static_cast<compute_module*> (data);
@@ -137,33 +137,19 @@ public:
 	double dc_shade_factor();
 };
 
-class weatherdata : public weather_data_provider
+class weatherdata : public weather_data_columns
 {
-	std::vector< weather_record* > m_data;
-	std::vector<size_t> m_columns;
-
-	struct vec {
-		ssc_number_t *p;
-		size_t len;
-	};
-
-	vec get_vector(var_data *v, const char *name, size_t *len = nullptr);
+	void get_vector(var_data *v, const char *name, size_t *len = nullptr);
 	ssc_number_t get_number(var_data *v, const char *name);
 
 	int name_to_id(const char *name);
 
 public:
-	/* Detects file format, read header information, detects which data columns are available and at what index
-	and read weather record information.
-	If wet-bulb temperature or dew point are missing, calculate using tdry, pres & rhum or tdry & rhum, respectively.
-	Interpolates meteorological data if requested.*/
+	/* Reads header information and detects which data columns are available in the table.
+	The arrays in the table are used in place, so the table must outlive this object.
+	If wet-bulb temperature or dew point are missing, calculate using tdry, pres & rhum or tdry & rhum, respectively.*/
 	weatherdata(var_data *data_table);
 	virtual ~weatherdata();
-
-	void set_counter_to(size_t cur_index);
-	bool read(weather_record *r); // reads one more record	
-	bool read_average(weather_record *r, std::vector<int> &cols, size_t &num_timesteps); // reads one more record	
-	bool has_data_column(size_t id);
 };
 
 bool ssc_cmod_update(std::string &log_msg, std::string &progress_msg, void *data, double progress, int out_type);
@@ -51,6 +51,7 @@
 #include "core.h"
 #include <sstream>
 #include <sstream>
+#include <limits>
 
 #ifndef WIN32
 #include <float.h>
@@ -3292,3 +3293,178 @@ bool hourly_energy_calculation::calculate(compute_module *cm)
 	return true;
 }
 
+
+cashflow_returns::cashflow_returns()
+{
+	m_irr_cf = 0;
+	m_irr_line = -1;
+	m_irr_count = -1;
+	m_irr = std::numeric_limits<double>::quiet_NaN();
+}
+
+const std::vector<double> & cashflow_returns::discount_factors(double rate, int nyears)
+{
+	size_t k = 0;
+	while (k < m_df_rates.size() && m_df_rates[k] != rate)
+		k++;
+
+	if (k == m_df_rates.size())
+	{
+		// a handful of rates are used by a financial model, keep the cache from growing with one-off rates
+		if (m_df_rates.size() >= 8)
+		{
+			m_df_rates.clear();
+			m_df.clear();
+			k = 0;
+		}
+		m_df_rates.push_back(rate);
+		m_df.push_back(std::vector<double>(1, 1.0));
+	}
+
+	std::vector<double> &df = m_df[k];
+	if ((int)df.size() <= nyears)
+	{
+		double rr = 1.0;
+		if (rate != -1.0) rr = 1.0 / (1.0 + rate);
+		while ((int)df.size() <= nyears)
+			df.push_back(df.back() * rr);
+	}
+	return df;
+}
+
+double cashflow_returns::npv(const util::matrix_t<double> &cf, int cf_line, int nyears, double rate)
+{
+	if (rate != rate)
+		return rate;
+
+	const std::vector<double> &df = discount_factors(rate, nyears);
+	double result = 0;
+	for (int i = 1; i <= nyears; i++)
+		result += cf.at(cf_line, i) * df[i];
+
+	return result;
+}
+
+bool cashflow_returns::npv_horner(const util::matrix_t<double> &cf, int cf_line, int count, double rate, double &npv, double &derivative)
+{
+	// npv of years 0 to count in x = 1/(1+rate), and its derivative with respect to the rate
+	npv = 0;
+	derivative = 0;
+	if (rate == -1 || rate >= std::numeric_limits<int>::max() || rate <= std::numeric_limits<int>::min())
+		return false;
+
+	double x = 1.0 / (1.0 + rate);
+	double dnpv_dx = 0;
+	for (int j = count; j >= 0; j--)
+	{
+		dnpv_dx = dnpv_dx * x + npv;
+		npv = npv * x + cf.at(cf_line, j);
+	}
+	derivative = -dnpv_dx * x * x;
+	return true;
+}
+
+double cashflow_returns::irr_scale_factor(const util::matrix_t<double> &cf, int cf_line, int count)
+{
+	// scale to max value for better irr convergence
+	if (count < 1) return 1.0;
+	double max = fabs(cf.at(cf_line, 0));
+	for (int i = 0; i <= count; i++)
+		if (fabs(cf.at(cf_line, i)) > max) max = fabs(cf.at(cf_line, i));
+	return (max > 0 ? max : 1);
+}
+
+bool cashflow_returns::is_valid_irr(const util::matrix_t<double> &cf, int cf_line, int count, double residual, double tolerance, int number_of_iterations, int max_iterations, double calculated_irr)
+{
+	// converged, and the npv decreases through the root
+	double npv_of_irr, npv_of_irr_plus_delta, derivative;
+	if (!npv_horner(cf, cf_line, count, calculated_irr, npv_of_irr, derivative)
+		|| !npv_horner(cf, cf_line, count, calculated_irr + 0.001, npv_of_irr_plus_delta, derivative))
+		return false;
+	return (number_of_iterations < max_iterations) && (fabs(residual) < tolerance) && (npv_of_irr > npv_of_irr_plus_delta);
+}
+
+double cashflow_returns::irr_calc(const util::matrix_t<double> &cf, int cf_line, int count, double initial_guess, double tolerance, int max_iterations, double scale_factor, bool is_newton, int &number_of_iterations, double &residual)
+{
+	// steps along the slope at the initial guess, or newton steps from a guess close to the root
+	double calculated_irr = initial_guess;
+	double npv, slope, derivative;
+	number_of_iterations = 0;
+	residual = DBL_MAX;
+	if (!npv_horner(cf, cf_line, count, calculated_irr, npv, slope) || slope == 0.0)
+		return calculated_irr;
+
+	while (number_of_iterations < max_iterations)
+	{
+		calculated_irr -= npv / slope;
+		number_of_iterations++;
+		if (!npv_horner(cf, cf_line, count, calculated_irr, npv, derivative))
+		{
+			residual = DBL_MAX;
+			break;
+		}
+		residual = npv / scale_factor;
+		if (fabs(residual) <= tolerance || (is_newton && derivative == 0.0))
+			break;
+		if (is_newton)
+			slope = derivative;
+	}
+	return calculated_irr;
+}
+
+double cashflow_returns::irr(const util::matrix_t<double> &cf, int cf_line, int count, double initial_guess, double tolerance, int max_iterations)
+{
+	int number_of_iterations = 0;
+	double residual = DBL_MAX;
+	double calculated_irr = std::numeric_limits<double>::quiet_NaN();
+
+	// only possible for first value negative
+	if (count >= 1 && cf.at(cf_line, 0) <= 0)
+	{
+		double scale_factor = irr_scale_factor(cf, cf_line, count);
+		bool is_valid = false;
+
+		// start from the previous year of the same cash flow
+		if (initial_guess < -1 && m_irr_cf == &cf && m_irr_line == cf_line && m_irr_count == count - 1 && m_irr == m_irr)
+		{
+			calculated_irr = irr_calc(cf, cf_line, count, m_irr, tolerance, max_iterations, scale_factor, true, number_of_iterations, residual);
+			is_valid = is_valid_irr(cf, cf_line, count, residual, tolerance, number_of_iterations, max_iterations, calculated_irr);
+		}
+
+		if (!is_valid)
+		{
+			// initial guess from http://zainco.blogspot.com/2008/08/internal-rate-of-return-using-newton.html
+			if ((initial_guess < -1) && (count > 1))// second order
+			{
+				if (cf.at(cf_line, 0) != 0)
+				{
+					double b = 2.0 + cf.at(cf_line, 1) / cf.at(cf_line, 0);
+					double c = 1.0 + cf.at(cf_line, 1) / cf.at(cf_line, 0) + cf.at(cf_line, 2) / cf.at(cf_line, 0);
+					initial_guess = -0.5*b - 0.5*sqrt(b*b - 4.0*c);
+					if ((initial_guess <= 0) || (initial_guess >= 1)) initial_guess = -0.5*b + 0.5*sqrt(b*b - 4.0*c);
+				}
+			}
+			else if (initial_guess < 0) // first order
+			{
+				if (cf.at(cf_line, 0) != 0) initial_guess = -(1.0 + cf.at(cf_line, 1) / cf.at(cf_line, 0));
+			}
+
+			// then try 0.1, -0.1 and 0 as initial guesses
+			double guesses[4] = { initial_guess, 0.1, -0.1, 0 };
+			for (int k = 0; k < 4 && !is_valid; k++)
+			{
+				calculated_irr = irr_calc(cf, cf_line, count, guesses[k], tolerance, max_iterations, scale_factor, false, number_of_iterations, residual);
+				is_valid = is_valid_irr(cf, cf_line, count, residual, tolerance, number_of_iterations, max_iterations, calculated_irr);
+			}
+		}
+
+		if (!is_valid)
+			calculated_irr = std::numeric_limits<double>::quiet_NaN(); // did not converge
+	}
+
+	m_irr_cf = &cf;
+	m_irr_line = cf_line;
+	m_irr_count = count;
+	m_irr = calculated_irr;
+	return calculated_irr;
+}
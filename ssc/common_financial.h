@@ -114,6 +114,39 @@ public:
 };
 
 
+/*
+ * Net present value and internal rate of return of the rows of a cash flow matrix.
+ * Discount factors are kept for each discount rate in use, so the npv of a row is a single pass
+ * without pow() calls. The irr iterates on the Horner form of the npv and its derivative in
+ * 1/(1+irr). The irr of a row over consecutive years (count, count+1, ...) takes Newton steps from
+ * the previous year's result, and falls back to the usual initial guesses if that does not converge.
+ */
+class cashflow_returns
+{
+private:
+	std::vector<double> m_df_rates;
+	std::vector< std::vector<double> > m_df;
+
+	const util::matrix_t<double> *m_irr_cf;
+	int m_irr_line;
+	int m_irr_count;
+	double m_irr;
+
+	const std::vector<double> & discount_factors(double rate, int nyears);
+	bool npv_horner(const util::matrix_t<double> &cf, int cf_line, int count, double rate, double &npv, double &derivative);
+	double irr_scale_factor(const util::matrix_t<double> &cf, int cf_line, int count);
+	bool is_valid_irr(const util::matrix_t<double> &cf, int cf_line, int count, double residual, double tolerance, int number_of_iterations, int max_iterations, double calculated_irr);
+	double irr_calc(const util::matrix_t<double> &cf, int cf_line, int count, double initial_guess, double tolerance, int max_iterations, double scale_factor, bool is_newton, int &number_of_iterations, double &residual);
+
+public:
+	cashflow_returns();
+	// present value of years 1 to nyears at the discount rate, as a fraction
+	double npv(const util::matrix_t<double> &cf, int cf_line, int nyears, double rate);
+	// rate of return of years 0 to count, as a fraction; NaN if there is none
+	double irr(const util::matrix_t<double> &cf, int cf_line, int count, double initial_guess = -2, double tolerance = 1e-6, int max_iterations = 100);
+};
+
+
 
 
 /*
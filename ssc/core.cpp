@@ -57,7 +57,7 @@
 const var_info var_info_invalid = {	0, 0, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL };
 
 compute_module::compute_module( )
-	:  m_infomap(NULL), m_handler(NULL), m_vartab(NULL)
+	:  m_infomap(NULL), m_handler(NULL), m_vartab(NULL), m_string_lookups(0)
 {
 	/* nothing to do */
 }
@@ -95,7 +95,13 @@ bool compute_module::compute( handler_interface *handler, var_table *data )
 	try { // catch any 'general_error' that can be thrown during precheck, exec, and postcheck
 
 		if (!verify("precheck input", SSC_INPUT)) return false;
+
+		size_t lookups = data->lookup_count();
 		exec();
+		m_string_lookups = data->lookup_count() - lookups;
+		if (__DEBUG__)
+			log(util::format("%d variable lookups by name during exec", (int)m_string_lookups), SSC_NOTICE);
+
 		if (!verify("postcheck output", SSC_OUTPUT)) return false;
 
 	} catch ( general_error &e )	{
@@ -282,6 +288,12 @@ var_data *compute_module::assign( const std::string &name, const var_data &value
 	return m_vartab->assign( name, value );
 }
 
+var_data *compute_module::assign( const std::string &name, var_data &&value ) throw( general_error )
+{
+	if (!m_vartab) throw general_error("invalid data container object reference");
+	return m_vartab->assign( name, std::move(value) );
+}
+
 ssc_number_t *compute_module::allocate( const std::string &name, size_t length ) throw( general_error )
 {
 	var_data *v = assign(name, var_data());
@@ -375,6 +387,68 @@ ssc_number_t *compute_module::as_array( const std::string &name, size_t *count )
 	if (count) *count = x.num.length();
 	return x.num.data();
 }
+var_handle compute_module::intern( const std::string &name ) throw( general_error )
+{
+	if (!m_vartab) throw general_error("invalid data container object reference");
+	return m_vartab->intern(name);
+}
+
+var_data *compute_module::lookup( var_handle h ) throw( general_error )
+{
+	if (!m_vartab) throw general_error("invalid data container object reference");
+	return m_vartab->lookup(h);
+}
+
+var_data &compute_module::value( var_handle h ) throw( general_error )
+{
+	var_data *v = lookup( h );
+	if (!v){
+		throw general_error("ssc variable does not exist: '" + m_vartab->name(h) + "'");
+	}
+	return (*v);
+}
+
+bool compute_module::is_assigned( var_handle h ) throw( general_error )
+{
+	return (lookup(h) != 0);
+}
+
+int compute_module::as_integer( var_handle h ) throw( general_error )
+{
+	var_data &x = value(h);
+	if (x.type != SSC_NUMBER) throw cast_error("integer", x, m_vartab->name(h));
+	return (int) x.num;
+}
+
+bool compute_module::as_boolean( var_handle h ) throw( general_error )
+{
+	var_data &x = value(h);
+	if (x.type != SSC_NUMBER) throw cast_error("boolean", x, m_vartab->name(h));
+	return (bool) ( (int)(x.num!=0) );
+}
+
+ssc_number_t compute_module::as_number( var_handle h ) throw( general_error )
+{
+	var_data &x = value(h);
+	if (x.type != SSC_NUMBER) throw cast_error("ssc_number_t", x, m_vartab->name(h));
+	return x.num;
+}
+
+double compute_module::as_double( var_handle h ) throw( general_error )
+{
+	var_data &x = value(h);
+	if (x.type != SSC_NUMBER) throw cast_error("double", x, m_vartab->name(h));
+	return (double) x.num;
+}
+
+ssc_number_t *compute_module::as_array( var_handle h, size_t *count ) throw( general_error )
+{
+	var_data &x = value(h);
+	if (x.type != SSC_ARRAY) throw cast_error("array", x, m_vartab->name(h));
+	if (count) *count = x.num.length();
+	return x.num.data();
+}
+
 /** 
 The obvious improvement would be to made this a template, but ran into trouble with 
 "error: Access violation - no RTTI data!" 
@@ -257,6 +257,7 @@ public:
 	bool is_ssc_array_output( const std::string &name ) throw( general_error );
 	var_data *lookup( const std::string &name ) throw( general_error );
 	var_data *assign( const std::string &name, const var_data &value ) throw( general_error );
+	var_data *assign( const std::string &name, var_data &&value ) throw( general_error );
 	ssc_number_t *allocate( const std::string &name, size_t length ) throw( general_error );
 	ssc_number_t *allocate( const std::string &name, size_t nrows, size_t ncols ) throw( general_error );
 	util::matrix_t<ssc_number_t>& allocate_matrix( const std::string &name, size_t nrows, size_t ncols ) throw( general_error );
@@ -282,6 +283,21 @@ public:
 	util::matrix_t<double> as_matrix_transpose(const std::string & name) throw(general_error);
 	bool get_matrix(const std::string &name, util::matrix_t<ssc_number_t> &mat) throw(general_error);
 
+	/* interned variable handles: resolve a name once during 'exec' and use the handle
+	   inside per-timestep loops to avoid hashing the name on every access */
+	var_handle intern( const std::string &name ) throw( general_error );
+	var_data *lookup( var_handle h ) throw( general_error );
+	var_data &value( var_handle h ) throw( general_error );
+	bool is_assigned( var_handle h ) throw( general_error );
+	int as_integer( var_handle h ) throw( general_error );
+	bool as_boolean( var_handle h ) throw( general_error );
+	ssc_number_t as_number( var_handle h ) throw( general_error );
+	double as_double( var_handle h ) throw( general_error );
+	ssc_number_t *as_array( var_handle h, size_t *count ) throw( general_error );
+
+	/* number of variable lookups by name during the last call to 'exec' */
+	size_t string_lookup_count() { return m_string_lookups; }
+
 	size_t check_timestep_seconds( double t_start, double t_end, double t_step ) throw( timestep_error );
 	
 	ssc_number_t accumulate_annual(const std::string &hourly_var, const std::string &annual_var, double scale=1.0) throw(exec_error);
@@ -311,6 +327,8 @@ private:
 	  and are NULL otherwise */
 	handler_interface   *m_handler;
 	var_table           *m_vartab;
+
+	size_t m_string_lookups;
 };
 
 
@@ -52,6 +52,8 @@
 #include "lib_weatherfile.h"
 #include "lib_util.h"
 #include <sstream>
+#include <limits>
+#include <cstring>
 
 #include "common.h"
 
@@ -242,12 +244,14 @@ bool solarpilot_invoke::run(std::shared_ptr<weather_data_provider> wdata)
     amb.atm_coefs.val.at(2,2) = m_cmod->as_double("c_atm_2");
     amb.atm_coefs.val.at(2,3) = m_cmod->as_double("c_atm_3");
 
-    if(! m_cmod->is_assigned("helio_positions_in") ) 
-    {
+    bool is_user_field = m_cmod->is_assigned("helio_positions_in");
 
+    //weather data used to generate the field layout
+	vector<string> wfdata;
+    if(! is_user_field)
+    {
 	    weather_record wf;
 
-	    vector<string> wfdata;
 	    wfdata.reserve( 8760 );
 	    char buf[1024];
 	    for( int i=0;i<8760;i++ )
@@ -258,7 +262,28 @@ bool solarpilot_invoke::run(std::shared_ptr<weather_data_provider> wdata)
 		    mysnprintf(buf, 1023, "%d,%d,%d,%.2lf,%.1lf,%.1lf,%.1lf", wf.day, wf.hour, wf.month, wf.dn, wf.tdry, wf.pres/1000., wf.wspd);
 		    wfdata.push_back( std::string(buf) );
 	    }
+    }
+
+    //reuse the layout and flux tables from an earlier run with the same field inputs
+    std::string cache_file;
+    unsigned long long cache_key = 0;
+    std::string dir = cache_dir();
+    if( !dir.empty() )
+    {
+        cache_key = field_cache_key(wfdata, hdr);
+        char name[32];
+        sprintf(name, "%016llx.spc", cache_key);
+        cache_file = dir + util::path_separator() + name;
 
+        if( read_cache(cache_file, cache_key) )
+        {
+            m_cmod->log("Solar field layout and flux maps loaded from cache " + cache_file, SSC_NOTICE);
+            return true;
+        }
+    }
+
+    if(! is_user_field ) 
+    {
 	    m_sapi->SetDetailCallback( ssc_cmod_solarpilot_callback, m_cmod);
 	    m_sapi->SetSummaryCallbackStatus(false);
 
@@ -293,6 +318,12 @@ bool solarpilot_invoke::run(std::shared_ptr<weather_data_provider> wdata)
 
                 if(! m_sapi->Optimize(opt.algorithm.mapval(), optvars, upper, lower, stepsize, &names) )
                     return false;
+
+                //copy the iteration history from the API so that it is reported and cached with the field
+                vector<vector<double> > sim_points;
+                vector<double> objectives, fluxes;
+                m_sapi->GetOptimizationObject()->getOptimizationSimulationHistory(sim_points, objectives, fluxes);
+                setOptimizationSimulationHistory(sim_points, objectives, fluxes);
             }
 
 			m_sapi->Setup(*this);
@@ -405,10 +436,300 @@ bool solarpilot_invoke::run(std::shared_ptr<weather_data_provider> wdata)
 
 		m_cmod->assign("flux_max_observed", (ssc_number_t)flux_max_observed);
     }
+
+    if( !cache_file.empty() )
+        write_cache(cache_file, cache_key);
         
     return true;
 }
 
+static util::cache_dir_setting sg_solarpilotCacheDir("SSC_SOLARPILOT_CACHE_DIR");
+
+void solarpilot_invoke::set_cache_dir(const std::string &dir)
+{
+	sg_solarpilotCacheDir.set(dir);
+}
+
+std::string solarpilot_invoke::cache_dir()
+{
+	return sg_solarpilotCacheDir.get();
+}
+
+#define SPCACHE_MAGIC "SSCSPC2"
+
+unsigned long long solarpilot_invoke::field_cache_key(const vector<string> &wfdata, const weather_header &hdr)
+{
+	/*
+	Hash every input that run() reads, in its exact binary form, together with the weather data
+	that is passed to SolarPILOT. Inputs that only affect the rest of the plant (storage, dispatch,
+	financial parameters) are not part of the key.
+	*/
+	static const char *inputs[] = {
+		"is_optimize", "opt_init_step", "opt_max_iter", "opt_conv_tol", "opt_algorithm", "opt_flux_penalty", "flux_max",
+		"helio_width", "helio_height", "helio_optical_error", "helio_active_fraction", "dens_mirror", "helio_reflectance",
+		"n_facet_x", "n_facet_y", "cant_type", "focus_type",
+		"rec_absorptance", "rec_height", "rec_aspect", "rec_hl_perm2",
+		"q_design", "dni_des", "land_max", "land_min", "h_tower",
+		"tower_fixed_cost", "tower_exp", "rec_ref_cost", "rec_ref_area", "rec_cost_exp", "site_spec_cost", "heliostat_spec_cost",
+		"land_spec_cost", "contingency_rate", "sales_tax_rate", "sales_tax_frac", "cost_sf_fixed",
+		"c_atm_0", "c_atm_1", "c_atm_2", "c_atm_3",
+		"helio_positions_in", "calc_fluxmaps", "n_flux_days", "delta_flux_hrs", "n_flux_x", "n_flux_y", "check_max_flux",
+		0 };
+
+	unsigned long long h = util::fnv1a_init;
+	util::fnv1a_hash(h, SPCACHE_MAGIC, 8);
+
+	for (int i = 0; inputs[i] != 0; i++)
+	{
+		util::fnv1a_hash(h, inputs[i], strlen(inputs[i]) + 1);
+
+		var_data *v = m_cmod->lookup(inputs[i]);
+		if (!v)
+		{
+			unsigned char unassigned = SSC_INVALID;
+			util::fnv1a_hash(h, &unassigned, 1);
+			continue;
+		}
+		util::fnv1a_hash(h, &v->type, 1);
+		if (v->type == SSC_STRING)
+			util::fnv1a_hash(h, v->str.c_str(), v->str.length() + 1);
+		else
+		{
+			size_t dims[2] = { v->num.nrows(), v->num.ncols() };
+			util::fnv1a_hash(h, dims, sizeof(dims));
+			if (v->num.ncells() > 0)
+				util::fnv1a_hash(h, v->num.data(), v->num.ncells() * sizeof(ssc_number_t));
+		}
+	}
+
+	double loc[3] = { hdr.lat, hdr.lon, hdr.tz };
+	util::fnv1a_hash(h, loc, sizeof(loc));
+
+	for (size_t i = 0; i < wfdata.size(); i++)
+		util::fnv1a_hash(h, wfdata[i].c_str(), wfdata[i].length() + 1);
+
+	return h;
+}
+
+static bool spc_write_vec(FILE *fp, const vector<double> &v)
+{
+	unsigned long long n = v.size();
+	return util::write_value(fp, n) && (n == 0 || fwrite(&v[0], sizeof(double), v.size(), fp) == v.size());
+}
+
+static bool spc_read_vec(FILE *fp, vector<double> &v)
+{
+	unsigned long long n;
+	if (!util::read_value(fp, n) || n > 100000000ULL) return false;
+	v.resize((size_t)n);
+	return n == 0 || fread(&v[0], sizeof(double), v.size(), fp) == v.size();
+}
+
+bool solarpilot_invoke::write_cache(const std::string &cache_file, unsigned long long key)
+{
+	return util::write_file_atomic(cache_file, [&](FILE *fp) { return write_cache(fp, key); });
+}
+
+bool solarpilot_invoke::write_cache(FILE *fp, unsigned long long key)
+{
+	var_receiver *rf = &recs.front();
+	ssc_number_t flux_max_observed = std::numeric_limits<ssc_number_t>::quiet_NaN();
+	if (m_cmod->is_assigned("flux_max_observed"))
+		flux_max_observed = m_cmod->as_number("flux_max_observed");
+
+	char magic[8] = SPCACHE_MAGIC;
+	bool ok = fwrite(magic, 1, 8, fp) == 8
+		&& util::write_value(fp, key)
+		&& util::write_value(fp, sf.tht.val)
+		&& util::write_value(fp, rf->rec_height.val)
+		&& util::write_value(fp, rf->rec_diameter.val)
+		&& util::write_value(fp, rf->rec_width.val)
+		&& util::write_value(fp, rf->rec_aspect.Val())
+		&& util::write_value(fp, land.land_area.Val())
+		&& util::write_value(fp, sf.sf_area.Val())
+		&& util::write_value(fp, fin.rec_cost.Val())
+		&& util::write_value(fp, fin.heliostat_cost.Val())
+		&& util::write_value(fp, fin.tower_cost.Val())
+		&& util::write_value(fp, fin.land_cost.Val())
+		&& util::write_value(fp, fin.site_cost.Val())
+		&& util::write_value(fp, flux_max_observed);
+
+	// heliostat locations and aim points
+	vector<double> hpos;
+	hpos.reserve(layout.heliostat_positions.size() * 6);
+	for (size_t i = 0; i < layout.heliostat_positions.size(); i++)
+	{
+		sp_layout::h_position &p = layout.heliostat_positions[i];
+		double v[] = { p.location.x, p.location.y, p.location.z, p.aimpoint.x, p.aimpoint.y, p.aimpoint.z };
+		hpos.insert(hpos.end(), v, v + 6);
+	}
+	ok = ok && spc_write_vec(fp, hpos)
+		&& spc_write_vec(fp, fluxtab.azimuths)
+		&& spc_write_vec(fp, fluxtab.zeniths)
+		&& spc_write_vec(fp, fluxtab.efficiency)
+		&& util::write_value(fp, (unsigned long long)fluxtab.flux_surfaces.size());
+
+	for (size_t s = 0; ok && s < fluxtab.flux_surfaces.size(); s++)
+	{
+		sp_flux_map::sp_flux_stack &fs = fluxtab.flux_surfaces[s];
+		unsigned long long dims[3] = { fs.flux_data.nrows(), fs.flux_data.ncols(), fs.flux_data.nlayers() };
+
+		vector<double> fdata;
+		fdata.reserve((size_t)(dims[0] * dims[1] * dims[2]));
+		for (size_t i = 0; i < dims[0]; i++)
+			for (size_t j = 0; j < dims[1]; j++)
+				for (size_t k = 0; k < dims[2]; k++)
+					fdata.push_back(fs.flux_data.at(i, j, k));
+
+		unsigned int len = (unsigned int)fs.map_name.length();
+		ok = util::write_value(fp, len)
+			&& (len == 0 || fwrite(fs.map_name.c_str(), 1, len, fp) == len)
+			&& spc_write_vec(fp, fs.xpos)
+			&& spc_write_vec(fp, fs.ypos)
+			&& fwrite(dims, sizeof(dims), 1, fp) == 1
+			&& spc_write_vec(fp, fdata);
+	}
+
+	// optimization history, reported by the cmods for optimized runs
+	ok = ok && util::write_value(fp, (unsigned long long)_optimization_sim_points.size());
+	for (size_t i = 0; ok && i < _optimization_sim_points.size(); i++)
+		ok = spc_write_vec(fp, _optimization_sim_points[i]);
+	ok = ok && spc_write_vec(fp, _optimization_objectives)
+		&& spc_write_vec(fp, _optimization_fluxes);
+
+	return ok;
+}
+
+bool solarpilot_invoke::read_cache(const std::string &cache_file, unsigned long long key)
+{
+	FILE *fp = fopen(cache_file.c_str(), "rb");
+	if (!fp) return false;
+
+	char magic[8];
+	unsigned long long file_key, nsurf = 0;
+	double tht, rec_height, rec_diameter, rec_width, rec_aspect, land_area, sf_area,
+		rec_cost, heliostat_cost, tower_cost, land_cost, site_cost;
+	ssc_number_t flux_max_observed;
+	vector<double> hpos;
+	sp_flux_table ft;
+
+	bool ok = fread(magic, 1, 8, fp) == 8
+		&& strncmp(magic, SPCACHE_MAGIC, 8) == 0
+		&& util::read_value(fp, file_key)
+		&& file_key == key
+		&& util::read_value(fp, tht)
+		&& util::read_value(fp, rec_height)
+		&& util::read_value(fp, rec_diameter)
+		&& util::read_value(fp, rec_width)
+		&& util::read_value(fp, rec_aspect)
+		&& util::read_value(fp, land_area)
+		&& util::read_value(fp, sf_area)
+		&& util::read_value(fp, rec_cost)
+		&& util::read_value(fp, heliostat_cost)
+		&& util::read_value(fp, tower_cost)
+		&& util::read_value(fp, land_cost)
+		&& util::read_value(fp, site_cost)
+		&& util::read_value(fp, flux_max_observed)
+		&& spc_read_vec(fp, hpos)
+		&& hpos.size() % 6 == 0
+		&& spc_read_vec(fp, ft.azimuths)
+		&& spc_read_vec(fp, ft.zeniths)
+		&& spc_read_vec(fp, ft.efficiency)
+		&& util::read_value(fp, nsurf)
+		&& nsurf < 1000;
+
+	for (size_t s = 0; ok && s < nsurf; s++)
+	{
+		ft.flux_surfaces.push_back(sp_flux_map::sp_flux_stack());
+		sp_flux_map::sp_flux_stack &fs = ft.flux_surfaces.back();
+
+		unsigned int len;
+		unsigned long long dims[3];
+		vector<double> fdata;
+		ok = util::read_value(fp, len) && len < 65536;
+		if (ok)
+		{
+			fs.map_name.assign(len, ' ');
+			ok = (len == 0 || fread(&fs.map_name[0], 1, len, fp) == len)
+				&& spc_read_vec(fp, fs.xpos)
+				&& spc_read_vec(fp, fs.ypos)
+				&& fread(dims, sizeof(dims), 1, fp) == 1
+				&& spc_read_vec(fp, fdata)
+				&& fdata.size() == dims[0] * dims[1] * dims[2];
+		}
+		if (ok && fdata.size() > 0)
+		{
+			fs.flux_data.resize((size_t)dims[0], (size_t)dims[1], (size_t)dims[2]);
+			size_t n = 0;
+			for (size_t i = 0; i < dims[0]; i++)
+				for (size_t j = 0; j < dims[1]; j++)
+					for (size_t k = 0; k < dims[2]; k++)
+						fs.flux_data.at(i, j, k) = fdata[n++];
+		}
+	}
+
+	unsigned long long nhist = 0;
+	vector<vector<double> > sim_points;
+	vector<double> objectives, fluxes;
+	ok = ok && util::read_value(fp, nhist) && nhist < 100000;
+	for (size_t i = 0; ok && i < nhist; i++)
+	{
+		sim_points.push_back(vector<double>());
+		ok = spc_read_vec(fp, sim_points.back());
+	}
+	ok = ok && spc_read_vec(fp, objectives)
+		&& spc_read_vec(fp, fluxes)
+		&& objectives.size() == nhist
+		&& fluxes.size() == nhist;
+
+	fclose(fp);
+
+	// stale or corrupt cache, run the field calculations instead
+	if (!ok) return false;
+
+	var_receiver *rf = &recs.front();
+	sf.tht.val = tht;
+	rf->rec_height.val = rec_height;
+	rf->rec_diameter.val = rec_diameter;
+	rf->rec_width.val = rec_width;
+	rf->rec_aspect.Setval(rec_aspect);
+	land.land_area.Setval(land_area);
+	sf.sf_area.Setval(sf_area);
+	fin.rec_cost.Setval(rec_cost);
+	fin.heliostat_cost.Setval(heliostat_cost);
+	fin.tower_cost.Setval(tower_cost);
+	fin.land_cost.Setval(land_cost);
+	fin.site_cost.Setval(site_cost);
+
+	layout.heliostat_positions.clear();
+	layout.heliostat_positions.resize(hpos.size() / 6);
+	for (size_t i = 0; i < layout.heliostat_positions.size(); i++)
+	{
+		sp_layout::h_position &p = layout.heliostat_positions[i];
+		p.location.x = hpos[i * 6];
+		p.location.y = hpos[i * 6 + 1];
+		p.location.z = hpos[i * 6 + 2];
+		p.aimpoint.x = hpos[i * 6 + 3];
+		p.aimpoint.y = hpos[i * 6 + 4];
+		p.aimpoint.z = hpos[i * 6 + 5];
+		p.template_number = 0;
+		p.cant_vector.i = p.cant_vector.j = p.cant_vector.k = 0.;
+		p.focal_length = 0.;
+	}
+
+	fluxtab.azimuths = ft.azimuths;
+	fluxtab.zeniths = ft.zeniths;
+	fluxtab.efficiency = ft.efficiency;
+	fluxtab.flux_surfaces = ft.flux_surfaces;
+
+	if (flux_max_observed == flux_max_observed)
+		m_cmod->assign("flux_max_observed", flux_max_observed);
+
+	setOptimizationSimulationHistory(sim_points, objectives, fluxes);
+
+	return true;
+}
+
 bool solarpilot_invoke::postsim_calcs(compute_module *cm)
 {
     /* 
@@ -594,6 +915,7 @@ var_info vtab_sco2_design[] = {
 	{ SSC_INPUT,  SSC_NUMBER,  "des_objective",        "[2] = hit min phx deltat then max eta, [else] max eta",  "",           "",    "",      "?=0",   "",       "" },
 	{ SSC_INPUT,  SSC_NUMBER,  "min_phx_deltaT",       "Minimum design temperature difference across PHX",       "C",          "",    "",      "?=0",   "",       "" },	
 	{ SSC_INPUT,  SSC_NUMBER,  "rel_tol",              "Baseline solver and optimization relative tolerance exponent (10^-rel_tol)", "-", "", "", "?=3","",       "" },	
+	{ SSC_INPUT,  SSC_NUMBER,  "co2_property_backend", "CO2 properties: 0 = equation of state, 1 = interpolated tables", "", "",  "",      "?=0",   "INTEGER,MIN=0,MAX=1", "" },
 		// Cycle Design
 	{ SSC_INPUT,  SSC_NUMBER,  "eta_isen_mc",          "Design main compressor isentropic efficiency",           "-",          "",    "",      "*",     "",       "" },
 	{ SSC_INPUT,  SSC_NUMBER,  "eta_isen_rc",          "Design re-compressor isentropic efficiency",             "-",          "",    "",      "*",     "",       "" },
@@ -886,6 +1208,8 @@ int sco2_design_cmod_common(compute_module *cm, C_sco2_recomp_csp & c_sco2_cycle
 	sco2_rc_des_par.m_frac_fan_power = cm->as_double("fan_power_frac");         //[-]
 	sco2_rc_des_par.m_deltaP_cooler_frac = cm->as_double("deltaP_cooler_frac");	//[-]
 
+	sco2_rc_des_par.m_co2_backend = cm->as_integer("co2_property_backend");		//[-] 0 = equation of state, 1 = interpolated tables
+
 	// For try/catch below
 	int out_type = -1;
 	std::string out_msg = "";
@@ -66,6 +66,11 @@ class solarpilot_invoke : public var_map
 		_optimization_objectives,
 		_optimization_fluxes;
 
+	unsigned long long field_cache_key(const std::vector<std::string> &wfdata, const weather_header &hdr);
+	bool read_cache(const std::string &cache_file, unsigned long long key);
+	bool write_cache(const std::string &cache_file, unsigned long long key);
+	bool write_cache(FILE *fp, unsigned long long key);
+
 public:
 
 	void getOptimizationSimulationHistory(std::vector<std::vector<double> > &sim_points, std::vector<double> &obj_values, std::vector<double> &flux_values);
@@ -85,6 +90,10 @@ public:
     AutoPilot_S *GetSAPI();
     bool run(std::shared_ptr<weather_data_provider> wdata = nullptr);
     bool postsim_calcs( compute_module *cm );
+
+	/// Set the directory for cached field layouts and flux tables, empty to disable. Defaults to the SSC_SOLARPILOT_CACHE_DIR environment variable.
+	static void set_cache_dir(const std::string &dir);
+	static std::string cache_dir();
 };
 
 bool ssc_cmod_solarpilot_callback(simulation_info *siminfo, void *data);
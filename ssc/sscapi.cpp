@@ -50,6 +50,8 @@
 #include <stdio.h>
 #include <cstring>
 #include <iostream>
+#include <atomic>
+#include <thread>
 
 #include "core.h"
 #include "sscapi.h"
@@ -363,6 +365,26 @@ SSCEXPORT void ssc_data_set_table( ssc_data_t p_data, const char *name, ssc_data
 	dat->table = *value;  // invokes operator= for deep copy
 }
 
+SSCEXPORT ssc_number_t *ssc_data_allocate_array( ssc_data_t p_data, const char *name, int length )
+{
+	var_table *vt = static_cast<var_table*>(p_data);
+	if (!vt || length < 1) return 0;
+	var_data *dat = vt->assign( name, var_data() );
+	dat->type = SSC_ARRAY;
+	dat->num.resize_fill( (size_t)length, 0.0 );
+	return dat->num.data();
+}
+
+SSCEXPORT ssc_number_t *ssc_data_allocate_matrix( ssc_data_t p_data, const char *name, int nrows, int ncols )
+{
+	var_table *vt = static_cast<var_table*>(p_data);
+	if (!vt || nrows < 1 || ncols < 1) return 0;
+	var_data *dat = vt->assign( name, var_data() );
+	dat->type = SSC_MATRIX;
+	dat->num.resize_fill( (size_t)nrows, (size_t)ncols, 0.0 );
+	return dat->num.data();
+}
+
 SSCEXPORT const char *ssc_data_get_string( ssc_data_t p_data, const char *name )
 {
 	var_table *vt = static_cast<var_table*>(p_data);
@@ -672,6 +694,100 @@ SSCEXPORT ssc_bool_t ssc_module_exec_with_handler(
 	return cm->compute( &h, vt ) ? 1 : 0;
 }
 
+class batch_exec_handler : public default_exec_handler
+{
+private:
+	std::atomic<bool> *m_cancelled;
+
+public:
+	batch_exec_handler(
+		compute_module *cm,
+		ssc_bool_t (*f)( ssc_module_t, ssc_handler_t, int, float, float, const char *, const char *, void * ),
+		void *d,
+		std::atomic<bool> *cancelled )
+		: default_exec_handler( cm, f, d ), m_cancelled( cancelled )
+	{
+	}
+
+	virtual bool on_update( const std::string &text, float percent, float time )
+	{
+		// another run in the batch was cancelled, so abort this one too
+		if (m_cancelled->load()) return false;
+
+		if (!default_exec_handler::on_update( text, percent, time ))
+		{
+			m_cancelled->store( true );
+			return false;
+		}
+		return true;
+	}
+};
+
+SSCEXPORT ssc_bool_t ssc_module_exec_batch( const char *name, ssc_data_t *p_data, int n, int nthreads, ssc_bool_t *results )
+{
+	return ssc_module_exec_batch_with_handler( name, p_data, n, nthreads, results, default_internal_handler_no_print, 0 );
+}
+
+SSCEXPORT ssc_bool_t ssc_module_exec_batch_with_handler(
+	const char *name,
+	ssc_data_t *p_data,
+	int n,
+	int nthreads,
+	ssc_bool_t *results,
+	ssc_bool_t (*pf_handler)( ssc_module_t, ssc_handler_t, int, float, float, const char*, const char *, void * ),
+	void **pf_user_data )
+{
+	if (!name || !p_data || n < 0) return 0;
+
+	if (results)
+		for (int i = 0; i < n; i++)
+			results[i] = 0;
+
+	if (nthreads < 1)
+		nthreads = (int)std::thread::hardware_concurrency();
+	if (nthreads < 1)
+		nthreads = 1;
+	if (nthreads > n)
+		nthreads = n;
+
+	std::atomic<int> next_run( 0 );
+	std::atomic<int> n_succeeded( 0 );
+	std::atomic<bool> cancelled( false );
+
+	// each worker pulls the next unstarted run off the shared counter until the batch is exhausted or cancelled
+	auto worker = [&]()
+	{
+		int i;
+		while (!cancelled.load() && (i = next_run.fetch_add( 1 )) < n)
+		{
+			ssc_bool_t ok = 0;
+			compute_module *cm = static_cast<compute_module*>( ssc_module_create( name ) );
+			var_table *vt = static_cast<var_table*>( p_data[i] );
+			if (cm && vt)
+			{
+				batch_exec_handler h( cm, pf_handler, pf_user_data ? pf_user_data[i] : 0, &cancelled );
+				ok = cm->compute( &h, vt ) ? 1 : 0;
+			}
+			if (cm) ssc_module_free( static_cast<ssc_module_t>( cm ) );
+
+			if (results) results[i] = ok;
+			if (ok) n_succeeded++;
+		}
+	};
+
+	std::vector<std::thread> pool;
+	for (int t = 1; t < nthreads; t++)
+		pool.push_back( std::thread( worker ) );
+
+	// the calling thread participates as one of the workers
+	worker();
+
+	for (size_t t = 0; t < pool.size(); t++)
+		pool[t].join();
+
+	return (n_succeeded.load() == n) ? 1 : 0;
+}
+
 
 SSCEXPORT void ssc_module_extproc_output( ssc_handler_t p_handler, const char *output_line )
 {
@@ -164,6 +164,12 @@ SSCEXPORT void ssc_data_set_matrix( ssc_data_t p_data, const char *name, ssc_num
 
 /** Assigns value of type @a SSC_TABLE. */
 SSCEXPORT void ssc_data_set_table( ssc_data_t p_data, const char *name, ssc_data_t table );
+
+/** Assigns a zero-filled value of type @a SSC_ARRAY and returns its storage, so that large arrays can be filled in place instead of copied in with ssc_data_set_array. The memory is owned by the data container and remains valid until the variable is reassigned or unassigned, or the container is cleared or freed. */
+SSCEXPORT ssc_number_t *ssc_data_allocate_array( ssc_data_t p_data, const char *name, int length );
+
+/** Assigns a zero-filled value of type @a SSC_MATRIX in row-major order and returns its storage, as for ssc_data_allocate_array. */
+SSCEXPORT ssc_number_t *ssc_data_allocate_matrix( ssc_data_t p_data, const char *name, int nrows, int ncols );
 /**@}*/ 
 
 /** @name Retrieving variable values.
@@ -314,6 +320,19 @@ SSCEXPORT ssc_bool_t ssc_module_exec_with_handler(
 	ssc_bool_t (*pf_handler)( ssc_module_t, ssc_handler_t, int action, float f0, float f1, const char *s0, const char *s1, void *user_data ),
 	void *pf_user_data );
 
+/** Runs the compute module with the given name once over each of the 'n' data sets in the 'p_data' array, distributing the runs across a pool of 'nthreads' worker threads. If 'nthreads' is less than 1, one worker per hardware thread is used. Each run creates its own module instance, so data sets must not be shared between entries of 'p_data'. If 'results' is not NULL, it must hold 'n' values and receives the 1 or 0 result of each run; runs that were never started because the batch was cancelled report 0. Returns 1 only if every run succeeded. No error messages are available. */
+SSCEXPORT ssc_bool_t ssc_module_exec_batch( const char *name, ssc_data_t *p_data, int n, int nthreads, ssc_bool_t *results );
+
+/** Same as ssc_module_exec_batch, with a callback function to handle logging, progress updates, and cancelation requests for each run. The handler may be called concurrently from different worker threads and must be thread-safe. If 'pf_user_data' is not NULL, it must hold 'n' pointers, and the i-th pointer is passed as user data to the handler for the run over p_data[i]. Returning 0 from the handler on an SSC_UPDATE aborts that run and cancels the rest of the batch: runs in progress are aborted at their next progress update, and runs not yet started are skipped. Returns Boolean: 1 if every run succeeded, otherwise 0. */
+SSCEXPORT ssc_bool_t ssc_module_exec_batch_with_handler(
+	const char *name,
+	ssc_data_t *p_data,
+	int n,
+	int nthreads,
+	ssc_bool_t *results,
+	ssc_bool_t (*pf_handler)( ssc_module_t, ssc_handler_t, int action, float f0, float f1, const char *s0, const char *s1, void *user_data ),
+	void **pf_user_data );
+
 /** @name Message types:*/
 /**@{*/ 	
 #define SSC_NOTICE 1
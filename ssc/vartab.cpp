@@ -186,11 +186,21 @@ bool var_data::parse( unsigned char type, const std::string &buf, var_data &valu
 	return false;
 }
 
-var_table::var_table() : m_iterator(m_hash.begin())
+var_table::var_table() : m_iterator(m_hash.begin()), m_lookup_count(0)
 {
 	/* nothing to do here */
 }
 
+var_table::var_table( const var_table &cp ) : m_iterator(m_hash.begin()), m_lookup_count(0)
+{
+	*this = cp;
+}
+
+var_table::var_table( var_table &&mv ) : m_iterator(m_hash.begin()), m_lookup_count(0)
+{
+	*this = std::move(mv);
+}
+
 var_table::~var_table()
 {
 	clear();
@@ -208,6 +218,22 @@ var_table &var_table::operator=( const var_table &rhs )
 	return *this;
 }
 
+var_table &var_table::operator=( var_table &&rhs )
+{
+	if ( this != &rhs )
+	{
+		// take over the variables without copying their data
+		clear();
+		m_hash.swap( rhs.m_hash );
+		m_iterator = m_hash.begin();
+		rhs.m_iterator = rhs.m_hash.begin();
+		refresh_interned();
+		rhs.refresh_interned();
+	}
+
+	return *this;
+}
+
 void var_table::clear()
 {
 	for (var_hash::iterator it = m_hash.begin(); it != m_hash.end(); ++it)
@@ -217,6 +243,9 @@ void var_table::clear()
 		delete it->second; // delete the var_data object
 	}
 	m_hash.clear();
+
+	for (size_t i = 0; i < m_interned.size(); i++)
+		m_interned[i].data = NULL;
 }
 
 var_data *var_table::assign( const std::string &name, const var_data &val )
@@ -225,18 +254,37 @@ var_data *var_table::assign( const std::string &name, const var_data &val )
 	if (!v)
 	{
 		v = new var_data;
-		m_hash[ util::lower_case(name) ] = v;
+		std::string lcname( util::lower_case(name) );
+		m_hash[ lcname ] = v;
+		update_interned( lcname, v );
 	}
 	
 	v->copy(val);
 	return v;
 }
 
+var_data *var_table::assign( const std::string &name, var_data &&val )
+{
+	var_data *v = lookup(name);
+	if (!v)
+	{
+		v = new var_data( std::move(val) );
+		std::string lcname( util::lower_case(name) );
+		m_hash[ lcname ] = v;
+		update_interned( lcname, v );
+	}
+	else if ( v != &val )
+		*v = std::move(val);
+
+	return v;
+}
+
 void var_table::unassign( const std::string &name )
 {
 	var_hash::iterator it = m_hash.find( util::lower_case(name) );
 	if (it != m_hash.end())
 	{
+		update_interned( (*it).first, NULL );
 		delete (*it).second; // delete the associated data
 		m_hash.erase( it );
 	}
@@ -251,7 +299,9 @@ bool var_table::rename( const std::string &oldname, const std::string &newname )
 		std::string lcnewname( util::lower_case(newname) );
 
 		var_data *data = it->second; // save ptr to data
+		update_interned( it->first, NULL );
 		m_hash.erase( it );
+		update_interned( lcnewname, data );
 
 		// if a variable with 'newname' already exists, 
 		// delete its data, and reassign the name to the new data
@@ -272,6 +322,7 @@ bool var_table::rename( const std::string &oldname, const std::string &newname )
 
 var_data *var_table::lookup( const std::string &name )
 {
+	m_lookup_count++;
 	var_hash::iterator it = m_hash.find( util::lower_case(name) );
 	if ( it != m_hash.end() )
 		return (*it).second;
@@ -279,6 +330,47 @@ var_data *var_table::lookup( const std::string &name )
 		return NULL;
 }
 
+var_handle var_table::intern( const std::string &name )
+{
+	std::string lcname( util::lower_case(name) );
+	var_handle h;
+
+	unordered_map< std::string, size_t >::iterator it = m_intern_index.find( lcname );
+	if ( it != m_intern_index.end() )
+	{
+		h.index = it->second;
+		return h;
+	}
+
+	interned_var iv;
+	iv.name = lcname;
+	var_hash::iterator vit = m_hash.find( lcname );
+	iv.data = (vit != m_hash.end()) ? vit->second : NULL;
+
+	h.index = m_interned.size();
+	m_interned.push_back( iv );
+	m_intern_index[ lcname ] = h.index;
+	return h;
+}
+
+void var_table::refresh_interned()
+{
+	for (size_t i = 0; i < m_interned.size(); i++)
+	{
+		var_hash::iterator it = m_hash.find( m_interned[i].name );
+		m_interned[i].data = (it != m_hash.end()) ? it->second : NULL;
+	}
+}
+
+void var_table::update_interned( const std::string &lcname, var_data *v )
+{
+	if ( m_intern_index.empty() ) return;
+
+	unordered_map< std::string, size_t >::iterator it = m_intern_index.find( lcname );
+	if ( it != m_intern_index.end() )
+		m_interned[ it->second ].data = v;
+}
+
 const char *var_table::first( )
 {
 	m_iterator = m_hash.begin();
@@ -52,6 +52,7 @@
 
 #include "../shared/lib_util.h"
 #include <string>
+#include <vector>
 #include "sscapi.h"
 
 
@@ -66,14 +67,23 @@ class var_data;
 
 typedef unordered_map< std::string, var_data* > var_hash;
 
+/* handle to a variable name interned in a var_table, for repeated lookups without hashing the name */
+struct var_handle
+{
+	size_t index;
+};
+
 class var_table
 {
 public:
 	explicit var_table();
+	var_table( const var_table &cp );
+	var_table( var_table &&mv );
 	virtual ~var_table();
 
 	void clear();
 	var_data *assign( const std::string &name, const var_data &value );
+	var_data *assign( const std::string &name, var_data &&value );
 	void unassign( const std::string &name );
 	bool rename( const std::string &oldname, const std::string &newname );
 	var_data *lookup( const std::string &name );
@@ -81,10 +91,32 @@ public:
 	const char *next();
 	unsigned int size() { return (unsigned int)m_hash.size(); }
 	var_table &operator=( const var_table &rhs );
+	var_table &operator=( var_table &&rhs );
+
+	/* intern a name once, then look it up by handle in constant time. handles remain
+	   valid for the life of the table and follow assign, unassign, rename and clear */
+	var_handle intern( const std::string &name );
+	var_data *lookup( var_handle h ) { return m_interned[h.index].data; }
+	const std::string &name( var_handle h ) { return m_interned[h.index].name; }
+
+	/* number of lookups by name since the table was created */
+	size_t lookup_count() { return m_lookup_count; }
 
 private:
+	void update_interned( const std::string &lcname, var_data *v );
+	void refresh_interned();
+
+	struct interned_var
+	{
+		std::string name;
+		var_data *data;
+	};
+
 	var_hash m_hash;
 	var_hash::iterator m_iterator;
+	std::vector<interned_var> m_interned;
+	unordered_map< std::string, size_t > m_intern_index;
+	size_t m_lookup_count;
 };
 
 
@@ -94,6 +126,8 @@ public:
 	
 	var_data() : type(SSC_INVALID) { num=0.0; }
 	var_data( const var_data &cp ) : type(cp.type), num(cp.num), str(cp.str) {  }
+	var_data( var_data &&mv ) : type(mv.type), num(std::move(mv.num)), str(std::move(mv.str)), table(std::move(mv.table)) {  }
+	explicit var_data( util::matrix_t<ssc_number_t> &&m ) : type( m.nrows() == 1 ? SSC_ARRAY : SSC_MATRIX ), num(std::move(m)) {  }
 	var_data( const std::string &s ) : type(SSC_STRING), str(s) {  }
 	var_data( ssc_number_t n ) : type(SSC_NUMBER) { num = n; }
 	var_data(const ssc_number_t *pvalues, int length) : type(SSC_ARRAY) { num.assign(pvalues, (size_t)length); }
@@ -108,6 +142,7 @@ public:
 	static bool parse( unsigned char type, const std::string &buf, var_data &value );
 
 	var_data &operator=(const var_data &rhs) { copy(rhs); return *this; }
+	var_data &operator=(var_data &&rhs) { type=rhs.type; num=std::move(rhs.num); str=std::move(rhs.str); table=std::move(rhs.table); return *this; }
 	void copy( const var_data &rhs ) { type=rhs.type; num=rhs.num; str=rhs.str; table = rhs.table; }
 	
 	unsigned char type;
@@ -44749,7 +44749,7 @@ int CO2_TP(const double T, const double P, CO2_state *__restrict state) {
   return 0;
 }
 
-int CO2_PH(const double P, const double H, CO2_state *__restrict state) {
+int CO2_PH_eos(const double P, const double H, CO2_state *__restrict state) {
   const int max_iter = 20;
   const double rel_tol = 1e-10;
   const double P_tol = fmax(rel_tol, P * rel_tol);
@@ -44896,7 +44896,7 @@ int CO2_PH(const double P, const double H, CO2_state *__restrict state) {
   return 0;
 }
 
-int CO2_PS(const double P, const double S, CO2_state *__restrict state) {
+int CO2_PS_eos(const double P, const double S, CO2_state *__restrict state) {
   const int max_iter = 20;
   const double rel_tol = 1e-10;
   const double P_tol = fmax(rel_tol, P * rel_tol);
@@ -131,6 +131,37 @@ int CO2_TQ( double T, double Q, CO2_state * state );
 double CO2_visc( double D, double T);	//(uPa-s)
 double CO2_cond( double D, double T);	//(W/m-K)
 
+// Property backend used by CO2_PH and CO2_PS (see CO2_property_tables.cpp).
+//   CO2_BACKEND_EOS:    solve the fitted equation of state for T and D (default)
+//   CO2_BACKEND_TABLES: interpolate T and D in precomputed tables over 1 - 40 MPa and 270 - 1100 K, and
+//                       evaluate the state with CO2_TD. Compared to the EOS backend, the interpolated
+//                       temperature is within 1.e-3 K and the density within 1.e-5 (relative).
+//                       Table cells near the critical point and the saturation dome that do not meet
+//                       these bounds, and states outside the tables, use the EOS backend.
+// The backend is set per thread and new threads start with CO2_BACKEND_EOS. The tables are built once,
+// on first use, and shared by all threads.
+enum
+{
+	CO2_BACKEND_EOS = 0,
+	CO2_BACKEND_TABLES
+};
+
+void CO2_set_backend( int backend );
+int CO2_get_backend();
+
+// Sets the backend of the calling thread for the life of the object, then restores the previous one
+class CO2_backend_scope
+{
+	int m_previous;
+public:
+	explicit CO2_backend_scope( int backend ) : m_previous(CO2_get_backend()) { CO2_set_backend(backend); }
+	~CO2_backend_scope() { CO2_set_backend(m_previous); }
+};
+
+// CO2_PH and CO2_PS using the equation of state, independent of the backend setting.
+int CO2_PH_eos( double P, double H, CO2_state * state );
+int CO2_PS_eos( double P, double S, CO2_state * state );
+
 namespace N_co2_props
 {
 	const double T_crit = 304.1282;
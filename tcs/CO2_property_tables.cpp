@@ -0,0 +1,273 @@
+/*******************************************************************************************************
+*  Copyright 2017 Alliance for Sustainable Energy, LLC
+*
+*  NOTICE: This software was developed at least in part by Alliance for Sustainable Energy, LLC
+*  (Alliance) under Contract No. DE-AC36-08GO28308 with the U.S. Department of Energy and the U.S.
+*  The Government retains for itself and others acting on its behalf a nonexclusive, paid-up,
+*  irrevocable worldwide license in the software to reproduce, prepare derivative works, distribute
+*  copies to the public, perform publicly and display publicly, and to permit others to do so.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted
+*  provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, the above government
+*  rights notice, this list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice, the above government
+*  rights notice, this list of conditions and the following disclaimer in the documentation and/or
+*  other materials provided with the distribution.
+*
+*  3. The entire corresponding source code of any redistribution, with or without modification, by a
+*  research entity, including but not limited to any contracting manager/operator of a United States
+*  National Laboratory, any institution of higher learning, and any non-profit organization, must be
+*  made publicly available under this license for as long as the redistribution is made available by
+*  the research entity.
+*
+*  4. Redistribution of this software, without modification, must refer to the software by the same
+*  designation. Redistribution of a modified version of this software (i) may not refer to the modified
+*  version by the same designation, or by any confusingly similar designation, and (ii) must refer to
+*  the underlying software originally provided by Alliance as System Advisor Model or SAM. Except
+*  to comply with the foregoing, the terms System Advisor Model, SAM, or any confusingly similar
+*  designation may not be used to refer to any modified version of this software or any modified
+*  version of the underlying software originally provided by Alliance without the prior written consent
+*  of Alliance.
+*
+*  5. The name of the copyright holder, contributors, the United States Government, the United States
+*  Department of Energy, or any of their employees may not be used to endorse or promote products
+*  derived from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+*  IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+*  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER,
+*  CONTRIBUTORS, UNITED STATES GOVERNMENT OR UNITED STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR
+*  EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+*  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+*  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+*  THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************************************/
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "CO2_properties.h"
+
+/*
+Tabulated backend for CO2_PH and CO2_PS.
+
+Each table stores the temperature and density solved by the equation of state at the nodes of a
+uniform grid in pressure and enthalpy (or entropy). A lookup interpolates T and D with a bicubic
+Catmull-Rom spline through the 4 x 4 nodes around the state and then calls CO2_TD, so the returned
+state is exactly the equation of state at the interpolated T and D. Only the inversion is approximate.
+
+A table cell is only used if all 16 nodes around it are single phase on the same side of the
+saturation dome, and if the interpolated T and D match the equation of state at five check points in
+the cell to within a quarter of the error bounds documented in CO2_properties.h. The other cells,
+mostly near the critical point and along the pseudo-critical line, fall back to the equation of state.
+*/
+
+namespace N_co2_tables
+{
+	const double P_low = 1000.0;		//[kPa] Lowest tabulated pressure
+	const double P_high = 40000.0;		//[kPa] Highest tabulated pressure
+	const double T_low = 270.0;			//[K] Temperature setting the lowest tabulated enthalpy and entropy
+	const double T_high = 1100.0;		//[K] Temperature setting the highest tabulated enthalpy and entropy
+
+	const double T_tol_check = 2.5E-4;	//[K] Temperature error allowed at the cell check points
+	const double D_tol_check = 2.5E-6;	//[-] Relative density error allowed at the cell check points
+
+	typedef int (*f_co2_eos)(double P, double y, CO2_state * state);
+
+	// Catmull-Rom weights of the 4 nodes around fraction 't' of the interval between nodes 1 and 2
+	inline void catmull_rom_weights(double t, double * w)
+	{
+		double t2 = t*t;
+		double t3 = t2*t;
+		w[0] = 0.5*(-t3 + 2.0*t2 - t);
+		w[1] = 0.5*(3.0*t3 - 5.0*t2 + 2.0);
+		w[2] = 0.5*(-3.0*t3 + 4.0*t2 + t);
+		w[3] = 0.5*(t3 - t2);
+	}
+
+	class C_co2_table
+	{
+	private:
+		double m_P_0;		//[kPa] Pressure at the first node
+		double m_inv_dP;	//[1/kPa]
+		int m_n_P;			//[-] Nodes in pressure
+
+		double m_y_0;		//[kJ/kg] or [kJ/kg-K] Enthalpy or entropy at the first node
+		double m_inv_dy;
+		int m_n_y;			//[-] Nodes in enthalpy or entropy
+
+		std::vector<double> mv_T;			//[K] (m_n_P x m_n_y)
+		std::vector<double> mv_D;			//[kg/m3] (m_n_P x m_n_y)
+		std::vector<char> mv_is_cell_ok;	//[-] (m_n_P - 1 x m_n_y - 1), true if the cell meets the error bounds
+
+	public:
+
+		C_co2_table(f_co2_eos f_eos, bool is_enth, double dP /*kPa*/, double dy)
+		{
+			// Enthalpy or entropy range between the tabulated temperature limits
+			double y_low = std::numeric_limits<double>::max();
+			double y_high = -y_low;
+			CO2_state co2_props;
+			for (double P = P_low; P <= P_high; P += dP)
+			{
+				if (CO2_TP(T_low, P, &co2_props) == 0)
+					y_low = fmin(y_low, is_enth ? co2_props.enth : co2_props.entr);
+				if (CO2_TP(T_high, P, &co2_props) == 0)
+					y_high = fmax(y_high, is_enth ? co2_props.enth : co2_props.entr);
+			}
+
+			// One node past each limit, so every cell in the range has the 4 x 4 nodes it needs
+			m_P_0 = P_low - dP;
+			m_inv_dP = 1.0 / dP;
+			m_n_P = (int)ceil((P_high - P_low) / dP) + 3;
+
+			m_y_0 = y_low - dy;
+			m_inv_dy = 1.0 / dy;
+			m_n_y = (int)ceil((y_high - y_low) / dy) + 3;
+
+			// Solve the nodes. Phase: 0 = vapor or supercritical, 1 = liquid, -1 = two phase or error
+			mv_T.assign(m_n_P*m_n_y, 0.0);
+			mv_D.assign(m_n_P*m_n_y, 0.0);
+			std::vector<int> phase(m_n_P*m_n_y, -1);
+			for (int i = 0; i < m_n_P; i++)
+			{
+				for (int j = 0; j < m_n_y; j++)
+				{
+					int k = i*m_n_y + j;
+					if (f_eos(m_P_0 + i*dP, m_y_0 + j*dy, &co2_props) == 0 && (co2_props.qual < 0.0 || co2_props.qual > 1.0))
+					{
+						mv_T[k] = co2_props.temp;
+						mv_D[k] = co2_props.dens;
+						phase[k] = (co2_props.temp < N_co2_props::T_crit && co2_props.dens >= co2_props.sat_liq_dens) ? 1 : 0;
+					}
+				}
+			}
+
+			// Check the cells
+			const double check_points[5][2] = { {0.5, 0.5}, {0.5, 0.0}, {0.0, 0.5}, {0.25, 0.25}, {0.75, 0.75} };
+
+			mv_is_cell_ok.assign((m_n_P - 1)*(m_n_y - 1), 0);
+			for (int i = 1; i < m_n_P - 2; i++)
+			{
+				for (int j = 1; j < m_n_y - 2; j++)
+				{
+					int phase_cell = phase[i*m_n_y + j];
+					bool is_ok = phase_cell >= 0;
+					for (int ii = i - 1; ii <= i + 2 && is_ok; ii++)
+						for (int jj = j - 1; jj <= j + 2 && is_ok; jj++)
+							is_ok = phase[ii*m_n_y + jj] == phase_cell;
+
+					mv_is_cell_ok[i*(m_n_y - 1) + j] = is_ok;
+
+					for (int c = 0; c < 5 && is_ok; c++)
+					{
+						double P = m_P_0 + (i + check_points[c][0])*dP;
+						double y = m_y_0 + (j + check_points[c][1])*dy;
+						double T, D;
+						is_ok = interpolate(P, y, &T, &D) && f_eos(P, y, &co2_props) == 0
+							&& fabs(T - co2_props.temp) <= T_tol_check && fabs(D - co2_props.dens) <= D_tol_check*co2_props.dens;
+					}
+
+					mv_is_cell_ok[i*(m_n_y - 1) + j] = is_ok;
+				}
+			}
+		}
+
+		// Returns false if the state is outside the table or in a cell that does not meet the error bounds
+		bool interpolate(double P /*kPa*/, double y, double * T /*K*/, double * D /*kg/m3*/) const
+		{
+			double x_P = (P - m_P_0)*m_inv_dP;
+			double x_y = (y - m_y_0)*m_inv_dy;
+			if (!(x_P >= 1.0 && x_P < m_n_P - 2 && x_y >= 1.0 && x_y < m_n_y - 2))
+				return false;
+
+			int i = (int)x_P;
+			int j = (int)x_y;
+			if (!mv_is_cell_ok[i*(m_n_y - 1) + j])
+				return false;
+
+			double w_P[4], w_y[4];
+			catmull_rom_weights(x_P - i, w_P);
+			catmull_rom_weights(x_y - j, w_y);
+
+			double T_sum = 0.0;
+			double D_sum = 0.0;
+			for (int ii = 0; ii < 4; ii++)
+			{
+				int k = (i - 1 + ii)*m_n_y + j - 1;
+				const double *p_T = &mv_T[k];
+				const double *p_D = &mv_D[k];
+				T_sum += w_P[ii] * (w_y[0] * p_T[0] + w_y[1] * p_T[1] + w_y[2] * p_T[2] + w_y[3] * p_T[3]);
+				D_sum += w_P[ii] * (w_y[0] * p_D[0] + w_y[1] * p_D[1] + w_y[2] * p_D[2] + w_y[3] * p_D[3]);
+			}
+
+			*T = T_sum;
+			*D = D_sum;
+			return true;
+		}
+	};
+
+	// Tables are built by the first thread that needs them
+	const C_co2_table & ph_table()
+	{
+		static const C_co2_table table(CO2_PH_eos, true, 200.0, 4.0);
+		return table;
+	}
+
+	const C_co2_table & ps_table()
+	{
+		static const C_co2_table table(CO2_PS_eos, false, 200.0, 0.004);
+		return table;
+	}
+
+	// State at the interpolated T and D, with the quality convention of the equation of state solvers
+	int table_state(double T /*K*/, double D /*kg/m3*/, CO2_state * state)
+	{
+		int err = CO2_TD(T, D, state);
+		if (err == 0 && T < N_co2_props::T_crit)
+			state->qual = (state->sat_vap_dens * (state->sat_liq_dens - D)) / (D * (state->sat_liq_dens - state->sat_vap_dens));
+
+		return err;
+	}
+
+	thread_local int backend = CO2_BACKEND_EOS;
+}
+
+void CO2_set_backend(int backend)
+{
+	N_co2_tables::backend = (backend == CO2_BACKEND_TABLES ? CO2_BACKEND_TABLES : CO2_BACKEND_EOS);
+}
+
+int CO2_get_backend()
+{
+	return N_co2_tables::backend;
+}
+
+int CO2_PH(double P, double H, CO2_state * state)
+{
+	if (CO2_get_backend() == CO2_BACKEND_TABLES)
+	{
+		double T, D;
+		if (N_co2_tables::ph_table().interpolate(P, H, &T, &D) && N_co2_tables::table_state(T, D, state) == 0)
+			return 0;
+	}
+
+	return CO2_PH_eos(P, H, state);
+}
+
+int CO2_PS(double P, double S, CO2_state * state)
+{
+	if (CO2_get_backend() == CO2_BACKEND_TABLES)
+	{
+		double T, D;
+		if (N_co2_tables::ps_table().interpolate(P, S, &T, &D) && N_co2_tables::table_state(T, D, state) == 0)
+			return 0;
+	}
+
+	return CO2_PS_eos(P, S, state);
+}
@@ -51,6 +51,7 @@
 #include <sstream>
 #include <stdlib.h>
 #include <algorithm>
+#include <chrono>
 #include "csp_dispatch.h"
 #include "lp_lib.h" 
 #include "lib_util.h"
@@ -157,6 +158,7 @@ csp_dispatch_opt::csp_dispatch_opt()
 
     outputs.presolve_nconstr = 0;
     outputs.solve_time = 0.;
+    outputs.build_time = 0.;
     outputs.presolve_nvar = 0;
 
 }
@@ -465,92 +467,77 @@ bool csp_dispatch_opt::optimize()
     ychsp           1 if cycle hot startup penalty is enforced at time t; 0 otherwise
     -------------------------------------------------------------
     */
-    lprec *lp;
+    lprec *lp = NULL;
     int ret = 0;
 
 
     try{
 
+        std::chrono::steady_clock::time_point build_start = std::chrono::steady_clock::now();
+
         //Calculate the number of variables
         int nt = (int)m_nstep_opt;
 
+        //reuse the model from the last horizon if it has the same number of time steps
+        if( !m_lp_model || m_lp_model->nt != nt )
+            m_lp_model = std::make_shared<dispatch_lp_model>(nt);
+        dispatch_lp_model &M = *m_lp_model;
+        bool is_new_model = !M.is_built();
+
         //set up the variable structure
-        optimization_vars O;
-        O.add_var("xr", optimization_vars::VAR_TYPE::REAL_T, optimization_vars::VAR_DIM::DIM_T, nt, 0. );
-        O.add_var("xrsu", optimization_vars::VAR_TYPE::REAL_T, optimization_vars::VAR_DIM::DIM_T, nt, 0. );
-        O.add_var("ursu", optimization_vars::VAR_TYPE::REAL_T, optimization_vars::VAR_DIM::DIM_T, nt, 0. );
-        O.add_var("yr", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
-        O.add_var("yrsu", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
-        //O.add_var("yrsb", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
-        //O.add_var("yrsd", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
-        O.add_var("yrsup", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
-        //O.add_var("yrhsp", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
-
-        O.add_var("x", optimization_vars::VAR_TYPE::REAL_T, optimization_vars::VAR_DIM::DIM_T, nt, 0.);
-        O.add_var("y", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
-        O.add_var("s", optimization_vars::VAR_TYPE::REAL_T, optimization_vars::VAR_DIM::DIM_T, nt, 0. );
-        O.add_var("ucsu", optimization_vars::VAR_TYPE::REAL_T, optimization_vars::VAR_DIM::DIM_T, nt, 0. );
-        O.add_var("ycsu", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
-        O.add_var("ycsb", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
+        optimization_vars &O = M.vars;
+        if( is_new_model )
+        {
+            O.add_var("xr", optimization_vars::VAR_TYPE::REAL_T, optimization_vars::VAR_DIM::DIM_T, nt, 0. );
+            O.add_var("xrsu", optimization_vars::VAR_TYPE::REAL_T, optimization_vars::VAR_DIM::DIM_T, nt, 0. );
+            O.add_var("ursu", optimization_vars::VAR_TYPE::REAL_T, optimization_vars::VAR_DIM::DIM_T, nt, 0. );
+            O.add_var("yr", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
+            O.add_var("yrsu", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
+            //O.add_var("yrsb", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
+            //O.add_var("yrsd", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
+            O.add_var("yrsup", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
+            //O.add_var("yrhsp", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
+
+            O.add_var("x", optimization_vars::VAR_TYPE::REAL_T, optimization_vars::VAR_DIM::DIM_T, nt, 0.);
+            O.add_var("y", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
+            O.add_var("s", optimization_vars::VAR_TYPE::REAL_T, optimization_vars::VAR_DIM::DIM_T, nt, 0. );
+            O.add_var("ucsu", optimization_vars::VAR_TYPE::REAL_T, optimization_vars::VAR_DIM::DIM_T, nt, 0. );
+            O.add_var("ycsu", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
+            O.add_var("ycsb", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
 #ifdef MOD_CYCLE_SHUTDOWN
-        O.add_var("ycsd", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
+            O.add_var("ycsd", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
 #endif
-        O.add_var("ycsup", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
-        O.add_var("ychsp", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
-        O.add_var("wdot", optimization_vars::VAR_TYPE::REAL_T, optimization_vars::VAR_DIM::DIM_T, nt, 0. ); //0 lower bound?
-        O.add_var("delta_w", optimization_vars::VAR_TYPE::REAL_T, optimization_vars::VAR_DIM::DIM_T, nt, 0. ); 
+            O.add_var("ycsup", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
+            O.add_var("ychsp", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
+            O.add_var("wdot", optimization_vars::VAR_TYPE::REAL_T, optimization_vars::VAR_DIM::DIM_T, nt, 0. ); //0 lower bound?
+            O.add_var("delta_w", optimization_vars::VAR_TYPE::REAL_T, optimization_vars::VAR_DIM::DIM_T, nt, 0. );
+
+            O.construct();  //allocates memory for data array
+        }
         
         unordered_map<std::string, double> P;
         calculate_parameters(this, P, nt);
 
-        O.construct();  //allocates memory for data array
-
         int nvar = O.get_total_var_count(); //total number of variables in the problem
 
-        lp = make_lp(0, nvar);  //build the context
-
-        if(lp == NULL)
-            throw C_csp_exception("Failed to create a new CSP dispatch optimization problem context.");
-
-        //set variable names and types for each column
-        for(int i=0; i<O.get_num_varobjs(); i++)
+        if( is_new_model )
         {
-            optimization_vars::opt_var *v = O.get_var(i);
+            M.lp = make_lp(0, nvar);  //build the context
 
-            string name_base = v->name;
+            if(M.lp == NULL)
+                throw C_csp_exception("Failed to create a new CSP dispatch optimization problem context.");
 
-            if( v->var_dim == optimization_vars::VAR_DIM::DIM_T )
+            //note the variable and time step of each column for reading the solution
+            M.col_var.assign(nvar + 1, -1);
+            M.col_t.assign(nvar + 1, 0);
+            for(int i=0; i<O.get_num_varobjs(); i++)
             {
+                if( O.get_var(i)->var_dim != optimization_vars::VAR_DIM::DIM_T )
+                    continue;
                 for(int t=0; t<nt; t++)
                 {
-                    char s[40];
-                    sprintf(s, "%s-%d", name_base.c_str(), t);
-                    set_col_name(lp, O.column(i, t), s);
-                    
-                }
-            }
-            else if( v->var_dim == optimization_vars::VAR_DIM::DIM_NT ) 
-            {
-                for(int t1=0; t1<v->var_dim_size; t1++)
-                {
-                    for(int t2=0; t2<v->var_dim_size2; t2++)
-                    {
-                        char s[40];
-                        sprintf(s, "%s-%d-%d", name_base.c_str(), t1, t2);
-                        set_col_name(lp, O.column(i, t1,t2 ), s);
-                    }
-                }
-            }
-            else
-            {
-                for(int t1=0; t1<nt; t1++)
-                {
-                    for(int t2=t1; t2<nt; t2++)
-                    {
-                        char s[40];
-                        sprintf(s, "%s-%d-%d", name_base.c_str(), t1, t2);
-                        set_col_name(lp, O.column(i, t1, t2 ), s);
-                    }
+                    M.col_var[ O.column(i, t) ] = i;
+                    M.col_t[ O.column(i, t) ] = t;
                 }
             }
         }
@@ -624,36 +611,38 @@ bool csp_dispatch_opt::optimize()
                 tadj *= P["disp_time_weighting"];
             }
 
-            set_obj_fnex(lp, i*nt, row, col);
+            set_obj_fnex(M.lp, i*nt, row, col);
 
             delete[] col;
             delete[] row;
         }
 
-        //set the row mode
-        set_add_rowmode(lp, TRUE);
-
         /* 
         --------------------------------------------------------------------------------
         set up the variable properties
         --------------------------------------------------------------------------------
         */
-        for(int i=0; i<O.get_num_varobjs(); i++)
+        if( is_new_model )
         {
-            optimization_vars::opt_var *v = O.get_var(i);
-            if( v->var_type == optimization_vars::VAR_TYPE::BINARY_T )
+            for(int i=0; i<O.get_num_varobjs(); i++)
             {
+                optimization_vars::opt_var *v = O.get_var(i);
+                if( v->var_type == optimization_vars::VAR_TYPE::BINARY_T )
+                {
+                    for(int i=v->ind_start; i<v->ind_end; i++)
+                        set_binary(M.lp, i+1, TRUE);
+                }
+                //upper and lower variable bounds
                 for(int i=v->ind_start; i<v->ind_end; i++)
-                    set_binary(lp, i+1, TRUE);
-            }
-            //upper and lower variable bounds
-            for(int i=v->ind_start; i<v->ind_end; i++)
-            {
-                set_upbo(lp, i+1, v->upper_bound);
-                set_lowbo(lp, i+1, v->lower_bound);
+                {
+                    set_upbo(M.lp, i+1, v->upper_bound);
+                    set_lowbo(M.lp, i+1, v->lower_bound);
+                }
             }
         }
 
+        //add the rows to a new model, or update them in the existing one
+        M.begin_rows();
 
         /* 
         --------------------------------------------------------------------------------
@@ -678,11 +667,11 @@ bool csp_dispatch_opt::optimize()
                     col[2] = O.column("wdot", t-1);
                     row[2] = 1.;
                     
-                    add_constraintex(lp, 3, row, col, GE, 0.);
+                    M.add_row(3, row, col, GE, 0.);
                 }
                 else
                 {
-                    add_constraintex(lp, 2, row, col, GE, -P["Wdot0"]);
+                    M.add_row(2, row, col, GE, -P["Wdot0"]);
                 }
             }
         }
@@ -710,7 +699,7 @@ bool csp_dispatch_opt::optimize()
                 //row[i  ] = -outputs.eta_pb_expected.at(t);
                 //col[i++] = O.column("x", t);
 
-                add_constraintex(lp, i, row, col, EQ, 0.);
+                M.add_row(i, row, col, EQ, 0.);
 
             }
         }
@@ -732,7 +721,7 @@ bool csp_dispatch_opt::optimize()
         //        row[i  ] = 1.;
         //        col[i++] = O.column("xrsu", t);
 
-        //        add_constraintex(lp, i, row, col, GE, outputs.q_sfavail_expected.at(t)*0.999 );
+        //        M.add_row(i, row, col, GE, outputs.q_sfavail_expected.at(t)*0.999 );
         //    }
         //} //<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -756,11 +745,11 @@ bool csp_dispatch_opt::optimize()
                     row[2] = -1.;
                     col[2] = O.column("ursu", t-1);
 
-                    add_constraintex(lp, 3, row, col, LE, 0);
+                    M.add_row(3, row, col, LE, 0);
                 }
                 else
                 {
-                    add_constraintex(lp, 2, row, col, LE, 0.);
+                    M.add_row(2, row, col, LE, 0.);
                 }
 
                 //-----
@@ -772,7 +761,7 @@ bool csp_dispatch_opt::optimize()
                 row[1] = -P["Er"];
                 col[1] = O.column("yrsu", t);
 
-                add_constraintex(lp, 2, row, col, LE, 0.);
+                M.add_row(2, row, col, LE, 0.);
 
                 //Receiver operation allowed when:
                 row[0] = 1.;
@@ -786,11 +775,11 @@ bool csp_dispatch_opt::optimize()
                     row[2] = -1.;
                     col[2] = O.column("yr", t-1);
 
-                    add_constraintex(lp, 3, row, col, LE, 0.); 
+                    M.add_row(3, row, col, LE, 0.); 
                 }
                 else
                 {
-                    add_constraintex(lp, 2, row, col, LE, (params.is_rec_operating0 ? 1. : 0.) );
+                    M.add_row(2, row, col, LE, (params.is_rec_operating0 ? 1. : 0.) );
                 }
 
                 //Receiver startup can't be enabled after a time step where the Receiver was operating
@@ -802,7 +791,7 @@ bool csp_dispatch_opt::optimize()
                     row[1] = 1.;
                     col[1] = O.column("yr", t-1);
 
-                    add_constraintex(lp, 2, row, col, LE, 1.);
+                    M.add_row(2, row, col, LE, 1.);
                 }
 
                 //Receiver startup energy consumption
@@ -812,13 +801,13 @@ bool csp_dispatch_opt::optimize()
                 row[1] = -P["Qru"];
                 col[1] = O.column("yrsu", t);
 
-                add_constraintex(lp, 2, row, col, LE, 0.);
+                M.add_row(2, row, col, LE, 0.);
 
                 //Receiver startup only during solar positive periods
                 row[0] = 1.;
                 col[0] = O.column("yrsu", t);
 
-                add_constraintex(lp, 1, row, col, LE, min(P["M"]*outputs.q_sfavail_expected.at(t), 1.0) );
+                M.add_row(1, row, col, LE, min(P["M"]*outputs.q_sfavail_expected.at(t), 1.0) );
 
                 //Receiver consumption limit
                 row[0] = 1.;
@@ -827,7 +816,7 @@ bool csp_dispatch_opt::optimize()
                 row[1] = 1.;
                 col[1] = O.column("xrsu", t);
                 
-                add_constraintex(lp, 2, row, col, LE, outputs.q_sfavail_expected.at(t));
+                M.add_row(2, row, col, LE, outputs.q_sfavail_expected.at(t));
 
                 //Receiver operation mode requirement
                 row[0] = 1.;
@@ -836,7 +825,7 @@ bool csp_dispatch_opt::optimize()
                 row[1] = -outputs.q_sfavail_expected.at(t);
                 col[1] = O.column("yr", t);
 
-                add_constraintex(lp, 2, row, col, LE, 0.);
+                M.add_row(2, row, col, LE, 0.);
 
                 //Receiver minimum operation requirement
                 row[0] = 1.;
@@ -845,13 +834,13 @@ bool csp_dispatch_opt::optimize()
                 row[1] = -P["Qrl"];
                 col[1] = O.column("yr", t);
 
-                add_constraintex(lp, 2, row, col, GE, 0.);
+                M.add_row(2, row, col, GE, 0.);
 
                 //Receiver can't continue operating when no energy is available
                 row[0] = 1.;
                 col[0] = O.column("yr", t);
 
-                add_constraintex(lp, 1, row, col, LE, min(P["M"]*outputs.q_sfavail_expected.at(t), 1.0) );  //if any measurable energy, y^r can be 1
+                M.add_row(1, row, col, LE, min(P["M"]*outputs.q_sfavail_expected.at(t), 1.0) );  //if any measurable energy, y^r can be 1
 
                 // --- new constraints ---
 
@@ -862,7 +851,7 @@ bool csp_dispatch_opt::optimize()
                 row[1] = 1.;
                 col[1] = O.column("yrsb", t);
 
-                add_constraintex(lp, 2, row, col, LE, 1.);*/
+                M.add_row(2, row, col, LE, 1.);*/
 
                 //recever standby partition
                 /*row[0] = 1.;
@@ -871,7 +860,7 @@ bool csp_dispatch_opt::optimize()
                 row[1] = 1.;
                 col[1] = O.column("yrsb", t);
 
-                add_constraintex(lp, 2, row, col, LE, 1.);*/
+                M.add_row(2, row, col, LE, 1.);*/
 
                 if( t > 0 )
                 {
@@ -885,7 +874,7 @@ bool csp_dispatch_opt::optimize()
                     row[2] = -1.;
                     col[2] = O.column("yrsb", t-1);
 
-                    add_constraintex(lp, 3, row, col, LE, 0.);*/
+                    M.add_row(3, row, col, LE, 0.);*/
 
                     //receiver startup penalty
                     row[0] = 1.;
@@ -897,7 +886,7 @@ bool csp_dispatch_opt::optimize()
                     row[2] = 1.;
                     col[2] = O.column("yrsu", t-1);
 
-                    add_constraintex(lp, 3, row, col, GE, 0.);
+                    M.add_row(3, row, col, GE, 0.);
 
                     //receiver hot startup penalty
                     /*row[0] = 1.;
@@ -909,7 +898,7 @@ bool csp_dispatch_opt::optimize()
                     row[2] = -1.;
                     col[2] = O.column("yrsb", t-1);
 
-                    add_constraintex(lp, 3, row, col, GE, -1);*/
+                    M.add_row(3, row, col, GE, -1);*/
 
                     //receiver shutdown energy
                     /*row[0] = 1.;
@@ -927,7 +916,7 @@ bool csp_dispatch_opt::optimize()
                     row[4] = 1.;
                     col[4] = O.column("yrsb", t);
 
-                    add_constraintex(lp, 5, row, col, GE, 0.);*/
+                    M.add_row(5, row, col, GE, 0.);*/
 
                 }
             }
@@ -957,7 +946,7 @@ bool csp_dispatch_opt::optimize()
                     col[i++] = O.column("ucsu", t-1);
                 }
 
-                add_constraintex(lp, i, row, col, LE, 0.);
+                M.add_row(i, row, col, LE, 0.);
 
                 //Inventory nonzero
                 row[0] = 1.;
@@ -966,7 +955,7 @@ bool csp_dispatch_opt::optimize()
                 row[1] = -P["M"];
                 col[1] = O.column("ycsu", t);
 
-                add_constraintex(lp, 2, row, col, LE, 0.);
+                M.add_row(2, row, col, LE, 0.);
 
                 //Cycle operation allowed when:
                 i=0;
@@ -984,11 +973,11 @@ bool csp_dispatch_opt::optimize()
                     row[i  ] = -1.;
                     col[i++] = O.column("ycsb", t-1);
 
-                    add_constraintex(lp, i, row, col, LE, 0.); 
+                    M.add_row(i, row, col, LE, 0.); 
                 }
                 else
                 {
-                    add_constraintex(lp, i, row, col, LE, (params.is_pb_operating0 ? 1. : 0.) + (params.is_pb_standby0 ? 1. : 0.) );
+                    M.add_row(i, row, col, LE, (params.is_pb_operating0 ? 1. : 0.) + (params.is_pb_standby0 ? 1. : 0.) );
                 }
 
                 //Cycle consumption limit
@@ -1003,7 +992,7 @@ bool csp_dispatch_opt::optimize()
                 row[i  ] = -P["Qu"];
                 col[i++] = O.column("y", t);
 
-                add_constraintex(lp, i, row, col, LE, 0.);
+                M.add_row(i, row, col, LE, 0.);
 
                 //cycle operation mode requirement
                 row[0] = 1.;
@@ -1012,7 +1001,7 @@ bool csp_dispatch_opt::optimize()
                 row[1] = -P["Qu"];
                 col[1] = O.column("y", t);
 
-                add_constraintex(lp, 2, row, col, LE, 0.);
+                M.add_row(2, row, col, LE, 0.);
 
                 //Minimum cycle energy contribution
                 i=0;
@@ -1022,7 +1011,7 @@ bool csp_dispatch_opt::optimize()
                 row[i  ] = -P["Ql"];
                 col[i++] = O.column("y", t);
 
-                add_constraintex(lp, i, row, col, GE, 0);
+                M.add_row(i, row, col, GE, 0);
 
                 //cycle startup can't be enabled after a time step where the cycle was operating
                 if(t>0)
@@ -1033,7 +1022,7 @@ bool csp_dispatch_opt::optimize()
                     row[1] = 1.;
                     col[1] = O.column("y", t-1);
 
-                    add_constraintex(lp, 2, row, col, LE, 1.);
+                    M.add_row(2, row, col, LE, 1.);
                 }
 
 
@@ -1050,11 +1039,11 @@ bool csp_dispatch_opt::optimize()
                     row[i  ] = -1.;
                     col[i++] = O.column("ycsb", t-1);
 
-                    add_constraintex(lp, i, row, col, LE, 0);
+                    M.add_row(i, row, col, LE, 0);
                 }
                 else
                 {
-                    add_constraintex(lp, i, row, col, LE, (params.is_pb_standby0 ? 1 : 0) + (params.is_pb_operating0 ? 1 : 0));
+                    M.add_row(i, row, col, LE, (params.is_pb_standby0 ? 1 : 0) + (params.is_pb_operating0 ? 1 : 0));
                 }
 
                 //some modes can't coincide
@@ -1063,14 +1052,14 @@ bool csp_dispatch_opt::optimize()
                 row[1] = 1.;
                 col[1] = O.column("ycsb", t);    
 
-                add_constraintex(lp, 2, row, col, LE, 1);   
+                M.add_row(2, row, col, LE, 1);   
 
                 row[0] = 1.;
                 col[0] = O.column("y", t);
                 row[1] = 1.;
                 col[1] = O.column("ycsb", t);    
 
-                add_constraintex(lp, 2, row, col, LE, 1);   
+                M.add_row(2, row, col, LE, 1);   
 
                 if( t > 0 )
                 {
@@ -1084,7 +1073,7 @@ bool csp_dispatch_opt::optimize()
                     row[2] = 1.;
                     col[2] = O.column("ycsu", t-1);
 
-                    add_constraintex(lp, 3, row, col, GE, 0.);
+                    M.add_row(3, row, col, GE, 0.);
 
                     //cycle standby start penalty
                     row[0] = 1.;
@@ -1096,7 +1085,7 @@ bool csp_dispatch_opt::optimize()
                     row[2] = -1.;
                     col[2] = O.column("ycsb", t-1);
 
-                    add_constraintex(lp, 3, row, col, GE, -1.);
+                    M.add_row(3, row, col, GE, -1.);
 
 #ifdef MOD_CYCLE_SHUTDOWN
                     //cycle shutdown energy penalty
@@ -1115,7 +1104,7 @@ bool csp_dispatch_opt::optimize()
                     row[4] = 1.;
                     col[4] = O.column("ycsb", t);
 
-                    add_constraintex(lp, 5, row, col, GE, 0.);
+                    M.add_row(5, row, col, GE, 0.);
 #endif
 
                 }
@@ -1157,11 +1146,11 @@ bool csp_dispatch_opt::optimize()
                     row[i  ] = 1.;
                     col[i++] = O.column("s", t-1);
 
-                    add_constraintex(lp, i, row, col, EQ, 0.);
+                    M.add_row(i, row, col, EQ, 0.);
                 }
                 else
                 {
-                    add_constraintex(lp, i, row, col, EQ, -P["s0"]);  //initial storage state (kWh)
+                    M.add_row(i, row, col, EQ, -P["s0"]);  //initial storage state (kWh)
                 }
             }
         }
@@ -1177,7 +1166,7 @@ bool csp_dispatch_opt::optimize()
                 row[0] = 1.;
                 col[0] = O.column("s", t);
 
-                add_constraintex(lp, 1, row, col, LE, P["Eu"]);
+                M.add_row(1, row, col, LE, P["Eu"]);
 
 				//max cycle thermal input in time periods where cycle operates and receiver is starting up
                 //outputs.delta_rs.resize(nt);
@@ -1210,7 +1199,7 @@ bool csp_dispatch_opt::optimize()
 					row[i] = large;
 					col[i++] = O.column("ycsb", t);
 
-					add_constraintex(lp, i, row, col, LE, 3.0*large);
+					M.add_row(i, row, col, LE, 3.0*large);
 				}
 
             }
@@ -1226,7 +1215,7 @@ bool csp_dispatch_opt::optimize()
                 row[0] = 1.;
                 col[0] = O.column("wdot", t);
 
-				add_constraintex(lp, 1, row, col, LE, outputs.f_pb_op_limit.at(t) * P["W_dot_cycle"]);
+				M.add_row(1, row, col, LE, outputs.f_pb_op_limit.at(t) * P["W_dot_cycle"]);
             }
         }
 
@@ -1277,23 +1266,24 @@ bool csp_dispatch_opt::optimize()
 					//row[i] - params.w_stow / params.dt;	//kWe
 					//col[i++] = O.column("yrsd", t);
 
-					add_constraintex(lp, 7, row, col, LE, w_lim.at(t));
+					M.add_row(7, row, col, LE, w_lim.at(t));
 				}
 				else // Power cycle operation is impossible at current constrained wlim
 				{
 					row[0] = 1.0;
 					col[0] = O.column("wdot", t);
-					add_constraintex(lp, 1, row, col, EQ, 0.);
+					M.add_row(1, row, col, EQ, 0.);
 				}
 			}
 		}
 
         
-        //Set problem to maximize
-        set_maxim(lp);
+        M.end_rows();
 
-        //reset the row mode
-        set_add_rowmode(lp, FALSE);
+        //solve a copy so the stored model is not changed by presolve
+        lp = copy_lp(M.lp);
+        if(lp == NULL)
+            throw C_csp_exception("Failed to copy the CSP dispatch optimization problem.");
 
         //set the log function
         solver_params.reset();
@@ -1365,7 +1355,11 @@ bool csp_dispatch_opt::optimize()
 			if (P["wlim_min"] < 1.e20)
 				set_bb_rule(lp, NODE_PSEUDOCOSTSELECT + NODE_DYNAMICMODE);
 		}
-        
+
+        //each horizon starts from the default basis. presolve removes rows and columns from the copy, and
+        //lp_solve builds a new basis for the reduced model, so a basis kept from the last horizon isn't used.
+
+        outputs.build_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - build_start).count();
  
        //Problem scaling loop
         int scaling_iter = 0;
@@ -1478,45 +1472,12 @@ bool csp_dispatch_opt::optimize()
 
             for(int c=1; c<ncols; c++)
             {
-                char *colname = get_col_name(lp, c);
-                if(! colname) continue;
-
-                char root[15];
-
-                int i;
-                for(i=0; i<15; i++)
-                {
-                    if(colname[i] == '-')
-                    {
-                        root[i] = '\0';
-                        break;
-                    }
-                    else
-                        root[i] = colname[i];
-                }
-                int i1=1 + i++;
-                char ind[4];
-                bool not_interested = false;
-                for(i=i1; i<15; i++)
-                {
-                    if(colname[i] == '-')
-                    {
-                        //2D variable. Not interested at the moment..
-                        not_interested = true;
-                        break;
-                    }
-                    else if(colname[i] == 0)
-                    {
-                        ind[i-i1] = '\0';
-                        break;
-                    }
-                    else
-                        ind[i-i1] = colname[i];
-                }
-
-                if(not_interested) continue;  //a 2D variable
+                //presolve may have removed columns, so look up the original column
+                int c_orig = get_orig_index(lp, get_Nrows(lp) + c);
+                if( c_orig < 1 || c_orig > nvar || M.col_var[c_orig] < 0 ) continue;  //a 2D variable
 
-                int t = atoi(ind);
+                const char *root = O.get_var(M.col_var[c_orig])->name.c_str();
+                int t = M.col_t[c_orig];
 
                 if(strcmp(root, "ycsb") == 0)  //Cycle standby
                 {
@@ -1653,9 +1614,10 @@ bool csp_dispatch_opt::optimize()
     }
     catch(exception &e)
     {
-        //clean up memory and pass on the exception
+        //clean up memory and pass on the exception. the stored model may be partly updated, so start over next time
         if( lp != NULL )
             delete_lp(lp);
+        m_lp_model.reset();
         
         throw e;
 
@@ -1665,6 +1627,7 @@ bool csp_dispatch_opt::optimize()
         //clean up memory and pass on the exception
         if( lp != NULL )
             delete_lp(lp);
+        m_lp_model.reset();
 
         return false;
     }
@@ -1672,6 +1635,95 @@ bool csp_dispatch_opt::optimize()
     return false;
 }
 
+dispatch_lp_model::dispatch_lp_model(int nt_)
+{
+    lp = NULL;
+    nt = nt_;
+    m_is_update = false;
+    m_row = 0;
+}
+
+dispatch_lp_model::~dispatch_lp_model()
+{
+    if( lp != NULL )
+        delete_lp(lp);
+}
+
+bool dispatch_lp_model::is_built()
+{
+    return lp != NULL && !m_row_type.empty();
+}
+
+void dispatch_lp_model::begin_rows()
+{
+    m_is_update = is_built();
+    m_row = 0;
+    if( !m_is_update )
+        set_add_rowmode(lp, TRUE);
+}
+
+void dispatch_lp_model::add_row(int count, REAL *row, int *colno, int constr_type, REAL rh)
+{
+    if( !m_is_update )
+    {
+        add_constraintex(lp, count, row, colno, constr_type, rh);
+        m_row_cols.push_back( vector<int>(colno, colno + count) );
+        m_row_vals.push_back( vector<REAL>(row, row + count) );
+        m_row_type.push_back( constr_type );
+        m_row_rhs.push_back( rh );
+        return;
+    }
+
+    if( m_row >= (int)m_row_type.size() )
+        throw C_csp_exception("The dispatch optimization problem has more constraints than the stored model.");
+
+    int r = m_row++;
+    vector<int> &cols = m_row_cols[r];
+    vector<REAL> &vals = m_row_vals[r];
+
+    //remove coefficients that are no longer in the row
+    for(size_t k=0; k<cols.size(); k++)
+    {
+        if( std::find(colno, colno + count, cols[k]) == colno + count )
+            set_mat(lp, r + 1, cols[k], 0.);
+    }
+
+    if( constr_type != m_row_type[r] )
+        set_constr_type(lp, r + 1, constr_type);
+
+    for(int k=0; k<count; k++)
+    {
+        vector<int>::iterator it = std::find(cols.begin(), cols.end(), colno[k]);
+        if( it == cols.end() || vals[it - cols.begin()] != row[k] )
+            set_mat(lp, r + 1, colno[k], row[k]);
+    }
+
+    if( rh != m_row_rhs[r] || constr_type != m_row_type[r] )
+        set_rh(lp, r + 1, rh);
+
+    cols.assign(colno, colno + count);
+    vals.assign(row, row + count);
+    m_row_type[r] = constr_type;
+    m_row_rhs[r] = rh;
+}
+
+void dispatch_lp_model::end_rows()
+{
+    if( m_is_update )
+    {
+        if( m_row != (int)m_row_type.size() )
+            throw C_csp_exception("The dispatch optimization problem has fewer constraints than the stored model.");
+    }
+    else
+    {
+        //Set problem to maximize
+        set_maxim(lp);
+
+        //reset the row mode
+        set_add_rowmode(lp, FALSE);
+    }
+}
+
 bool strcompare(std::string a, std::string b)
 {
     return util::lower_case(a) < util::lower_case(b);
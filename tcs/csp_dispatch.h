@@ -52,6 +52,7 @@
 #include "csp_solver_core.h"
 
 #include <unordered_map>
+#include <memory>
 using std::unordered_map;
 
 #pragma warning(disable: 4290)  // ignore warning: 'C++ exception specification ignored except to indicate a function is not __declspec(nothrow)'
@@ -64,10 +65,13 @@ using namespace std;
 #ifndef _CSP_DISPATCH
 #define _CSP_DISPATCH
 
+class dispatch_lp_model;
+
 class csp_dispatch_opt
 {
     int  m_nstep_opt;              //number of time steps in the optimized array
     bool m_is_weather_setup;  //bool indicating whether the weather has been copied
+    std::shared_ptr<dispatch_lp_model> m_lp_model;    //lp_solve model kept between optimization horizons
     
     void clear_output_arrays();
 
@@ -276,6 +280,7 @@ public:
         int solve_iter;             //Number of iterations required to solve
         int solve_state;
         double solve_time;
+        double build_time;          //[s] Time to build or update the optimization model before solving
         int presolve_nconstr;
         int presolve_nvar;
     } outputs;
@@ -383,6 +388,38 @@ public:
     opt_var *get_var(int varindex);
 };
 
+/* 
+The dispatch problem structure only depends on the number of time steps in the horizon, so the lp_solve model 
+is built once and reused for every horizon of the same length. The first horizon adds the rows with 
+add_constraintex; later horizons go through the same row sequence with add_row and only change the coefficients, 
+right hand sides and constraint types that differ from the stored model. Each horizon is solved on a copy, 
+since presolve reduces the model it is run on.
+*/
+class dispatch_lp_model
+{
+    bool m_is_update;                   //rows are being updated rather than added
+    int m_row;                          //current row in the update sequence
+    vector<vector<int> > m_row_cols;    //columns in each row, as last written
+    vector<vector<REAL> > m_row_vals;   //coefficients in each row, as last written
+    vector<int> m_row_type;
+    vector<REAL> m_row_rhs;
+
+public:
+    lprec *lp;                          //the stored model. this is never solved directly
+    int nt;                             //number of time steps in the horizon
+    optimization_vars vars;
+    vector<int> col_var;                //variable index for each model column, -1 for 2D variables
+    vector<int> col_t;                  //time index for each model column
+
+    dispatch_lp_model(int nt);
+    ~dispatch_lp_model();
+
+    bool is_built();
+    void begin_rows();
+    void add_row(int count, REAL *row, int *colno, int constr_type, REAL rh);
+    void end_rows();
+};
+
 
 
 
@@ -261,6 +261,7 @@ static C_csp_reported_outputs::S_output_info S_solver_output_info[] =
 	{C_csp_solver::C_solver_outputs::DISPATCH_PRES_NCONSTR, C_csp_reported_outputs::TS_1ST},		  //[-] Number of constraint relationships in dispatch model formulation
 	{C_csp_solver::C_solver_outputs::DISPATCH_PRES_NVAR, C_csp_reported_outputs::TS_1ST},		  //[-] Number of variables in dispatch model formulation
 	{C_csp_solver::C_solver_outputs::DISPATCH_SOLVE_TIME, C_csp_reported_outputs::TS_1ST},		  //[sec]   Time required to solve the dispatch model at each instance
+	{C_csp_solver::C_solver_outputs::DISPATCH_BUILD_TIME, C_csp_reported_outputs::TS_1ST},		  //[sec]   Time required to build or update the dispatch model at each instance
 
 	// **************************************************************
 	//      Outputs that are reported as weighted averages if 
@@ -295,6 +296,16 @@ static C_csp_reported_outputs::S_output_info S_solver_output_info[] =
 	{C_csp_solver::C_solver_outputs::SYS_W_DOT_BOP, C_csp_reported_outputs::TS_WEIGHTED_AVE},		  //[MWe] Parasitic BOP power consumption
 	{C_csp_solver::C_solver_outputs::W_DOT_NET, C_csp_reported_outputs::TS_WEIGHTED_AVE},			  //[MWe] System total electric power to grid
 
+	{C_csp_solver::C_solver_outputs::PROFILE_N_OP_MODES, C_csp_reported_outputs::TS_SUM},		//[-] Operating modes attempted
+	{C_csp_solver::C_solver_outputs::PROFILE_N_CR_CALLS, C_csp_reported_outputs::TS_SUM},		//[-] Collector-receiver on, startup, off, and estimates calls
+	{C_csp_solver::C_solver_outputs::PROFILE_N_PC_CALLS, C_csp_reported_outputs::TS_SUM},		//[-] Power cycle calls
+	{C_csp_solver::C_solver_outputs::PROFILE_N_TES_CALLS, C_csp_reported_outputs::TS_SUM},		//[-] TES charge, discharge, and idle calls
+	{C_csp_solver::C_solver_outputs::PROFILE_N_EQ_CALLS, C_csp_reported_outputs::TS_SUM},		//[-] Solver monotonic equation evaluations
+	{C_csp_solver::C_solver_outputs::PROFILE_TIME_CR, C_csp_reported_outputs::TS_SUM},			//[s] Wall time in collector-receiver calls
+	{C_csp_solver::C_solver_outputs::PROFILE_TIME_PC, C_csp_reported_outputs::TS_SUM},			//[s] Wall time in power cycle calls
+	{C_csp_solver::C_solver_outputs::PROFILE_TIME_TES, C_csp_reported_outputs::TS_SUM},			//[s] Wall time in TES calls
+	{C_csp_solver::C_solver_outputs::PROFILE_TIME_TOTAL, C_csp_reported_outputs::TS_SUM},		//[s] Wall time solving the timestep
+
 	csp_info_invalid
 };
 
@@ -336,6 +347,8 @@ C_csp_solver::C_csp_solver(C_csp_weatherreader &weather,
 
 	m_op_mode_tracking.resize(0);
 
+	m_is_profile = false;
+
 	error_msg = "";
 
 	mv_time_local.reserve(10);
@@ -372,6 +385,96 @@ void C_csp_solver::send_callback(double percent)
 	}
 }
 
+void C_csp_solver::S_solver_profile::add(const S_solver_profile &ts)
+{
+	m_n_timesteps += ts.m_n_timesteps;
+	m_n_op_modes += ts.m_n_op_modes;
+	m_n_cr_calls += ts.m_n_cr_calls;
+	m_n_pc_calls += ts.m_n_pc_calls;
+	m_n_tes_calls += ts.m_n_tes_calls;
+	m_n_eq_calls += ts.m_n_eq_calls;
+
+	m_time_cr += ts.m_time_cr;
+	m_time_pc += ts.m_time_pc;
+	m_time_tes += ts.m_time_tes;
+	m_time_total += ts.m_time_total;
+}
+
+void C_csp_solver::cr_on(const C_csp_weatherreader::S_outputs &weather, const C_csp_solver_htf_1state &htf_state_in,
+	double field_control, C_csp_collector_receiver::S_csp_cr_out_solver &cr_out_solver, const C_csp_solver_sim_info &sim_info)
+{
+	ms_profile_ts.m_n_cr_calls++;
+	C_profile_timer c_timer(m_is_profile, ms_profile_ts.m_time_cr);
+	mc_collector_receiver.on(weather, htf_state_in, field_control, cr_out_solver, sim_info);
+}
+
+void C_csp_solver::cr_startup(const C_csp_weatherreader::S_outputs &weather, const C_csp_solver_htf_1state &htf_state_in,
+	C_csp_collector_receiver::S_csp_cr_out_solver &cr_out_solver, const C_csp_solver_sim_info &sim_info)
+{
+	ms_profile_ts.m_n_cr_calls++;
+	C_profile_timer c_timer(m_is_profile, ms_profile_ts.m_time_cr);
+	mc_collector_receiver.startup(weather, htf_state_in, cr_out_solver, sim_info);
+}
+
+void C_csp_solver::cr_off(const C_csp_weatherreader::S_outputs &weather, const C_csp_solver_htf_1state &htf_state_in,
+	C_csp_collector_receiver::S_csp_cr_out_solver &cr_out_solver, const C_csp_solver_sim_info &sim_info)
+{
+	ms_profile_ts.m_n_cr_calls++;
+	C_profile_timer c_timer(m_is_profile, ms_profile_ts.m_time_cr);
+	mc_collector_receiver.off(weather, htf_state_in, cr_out_solver, sim_info);
+}
+
+void C_csp_solver::cr_estimates(const C_csp_weatherreader::S_outputs &weather, const C_csp_solver_htf_1state &htf_state_in,
+	C_csp_collector_receiver::S_csp_cr_est_out &est_out, const C_csp_solver_sim_info &sim_info)
+{
+	ms_profile_ts.m_n_cr_calls++;
+	C_profile_timer c_timer(m_is_profile, ms_profile_ts.m_time_cr);
+	mc_collector_receiver.estimates(weather, htf_state_in, est_out, sim_info);
+}
+
+void C_csp_solver::pc_call(const C_csp_weatherreader::S_outputs &weather, C_csp_solver_htf_1state &htf_state_in,
+	const C_csp_power_cycle::S_control_inputs &inputs, C_csp_power_cycle::S_csp_pc_out_solver &out_solver, const C_csp_solver_sim_info &sim_info)
+{
+	ms_profile_ts.m_n_pc_calls++;
+	C_profile_timer c_timer(m_is_profile, ms_profile_ts.m_time_pc);
+	mc_power_cycle.call(weather, htf_state_in, inputs, out_solver, sim_info);
+}
+
+bool C_csp_solver::tes_discharge(double timestep /*s*/, double T_amb /*K*/, double m_dot_htf_in /*kg/s*/, double T_htf_cold_in, double & T_htf_hot_out /*K*/, C_csp_tes::S_csp_tes_outputs &outputs)
+{
+	ms_profile_ts.m_n_tes_calls++;
+	C_profile_timer c_timer(m_is_profile, ms_profile_ts.m_time_tes);
+	return mc_tes.discharge(timestep, T_amb, m_dot_htf_in, T_htf_cold_in, T_htf_hot_out, outputs);
+}
+
+void C_csp_solver::tes_discharge_full(double timestep /*s*/, double T_amb /*K*/, double T_htf_cold_in, double & T_htf_hot_out /*K*/, double & m_dot_htf_out /*kg/s*/, C_csp_tes::S_csp_tes_outputs &outputs)
+{
+	ms_profile_ts.m_n_tes_calls++;
+	C_profile_timer c_timer(m_is_profile, ms_profile_ts.m_time_tes);
+	mc_tes.discharge_full(timestep, T_amb, T_htf_cold_in, T_htf_hot_out, m_dot_htf_out, outputs);
+}
+
+bool C_csp_solver::tes_charge(double timestep /*s*/, double T_amb /*K*/, double m_dot_htf_in /*kg/s*/, double T_htf_hot_in, double & T_htf_cold_out /*K*/, C_csp_tes::S_csp_tes_outputs &outputs)
+{
+	ms_profile_ts.m_n_tes_calls++;
+	C_profile_timer c_timer(m_is_profile, ms_profile_ts.m_time_tes);
+	return mc_tes.charge(timestep, T_amb, m_dot_htf_in, T_htf_hot_in, T_htf_cold_out, outputs);
+}
+
+void C_csp_solver::tes_charge_full(double timestep /*s*/, double T_amb /*K*/, double T_htf_hot_in /*K*/, double & T_htf_cold_out /*K*/, double & m_dot_htf_out /*kg/s*/, C_csp_tes::S_csp_tes_outputs &outputs)
+{
+	ms_profile_ts.m_n_tes_calls++;
+	C_profile_timer c_timer(m_is_profile, ms_profile_ts.m_time_tes);
+	mc_tes.charge_full(timestep, T_amb, T_htf_hot_in, T_htf_cold_out, m_dot_htf_out, outputs);
+}
+
+void C_csp_solver::tes_idle(double timestep, double T_amb, C_csp_tes::S_csp_tes_outputs &outputs)
+{
+	ms_profile_ts.m_n_tes_calls++;
+	C_profile_timer c_timer(m_is_profile, ms_profile_ts.m_time_tes);
+	mc_tes.idle(timestep, T_amb, outputs);
+}
+
 void C_csp_solver::reset_hierarchy_logic()
 {
 	m_is_CR_SU__PC_OFF__TES_OFF__AUX_OFF_avail = true;
@@ -696,6 +799,9 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 	// Reset vector that tracks operating modes
 	m_op_mode_tracking.resize(0);
 
+	// Reset solver profile
+	ms_profile_sim.clear();
+
 	// Reset Controller Variables to Defaults
 	m_defocus = 1.0;		//[-]  
 
@@ -744,6 +850,11 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 
 	while( mc_kernel.mc_sim_info.ms_ts.m_time <= mc_kernel.get_sim_setup()->m_sim_time_end )
 	{
+		ms_profile_ts.clear();
+		std::chrono::steady_clock::time_point ts_profile_start;
+		if( m_is_profile )
+			ts_profile_start = std::chrono::steady_clock::now();
+
 		// Report simulation progress
 		double calc_frac_current = (mc_kernel.mc_sim_info.ms_ts.m_time - mc_kernel.get_sim_setup()->m_sim_time_start) / (mc_kernel.get_sim_setup()->m_sim_time_end - mc_kernel.get_sim_setup()->m_sim_time_start);
 		if( calc_frac_current > progress_msg_frac_current )
@@ -813,7 +924,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 		mc_pc_inputs.m_standby_control = C_csp_power_cycle::ON;
 		//mc_pc_inputs.m_tou = tou_timestep;
 		// Performance Call
-		mc_power_cycle.call(mc_weather.ms_outputs,
+		pc_call(mc_weather.ms_outputs,
 			mc_pc_htf_state_in,
 			mc_pc_inputs,
 			mc_pc_out_solver,
@@ -824,7 +935,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 		// Solve collector/receiver at steady state with design inputs and weather to estimate output
 		mc_cr_htf_state_in.m_temp = m_T_htf_pc_cold_est;	//[C]
 		C_csp_collector_receiver::S_csp_cr_est_out est_out;
-		mc_collector_receiver.estimates(mc_weather.ms_outputs,
+		cr_estimates(mc_weather.ms_outputs,
 			mc_cr_htf_state_in,
 			est_out,
 			mc_kernel.mc_sim_info);
@@ -1134,7 +1245,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 			// Set startup conditions
 			mc_cr_htf_state_in.m_temp = m_T_htf_cold_des - 273.15;		//[C], convert from [K]
 
-			mc_collector_receiver.startup(mc_weather.ms_outputs,
+			cr_startup(mc_weather.ms_outputs,
 				mc_cr_htf_state_in,
 				mc_cr_out_solver,
 				mc_kernel.mc_sim_info);
@@ -1692,6 +1803,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 
 			// Store operating mode
 			m_op_mode_tracking.push_back(operating_mode);
+			ms_profile_ts.m_n_op_modes++;
 
             op_mode_str = "";
             
@@ -1921,7 +2033,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 						// CR: ON
 						mc_cr_htf_state_in.m_temp = m_T_htf_cold_des - 273.15;		//[C], convert from [K]
 
-						mc_collector_receiver.on(mc_weather.ms_outputs,
+						cr_on(mc_weather.ms_outputs,
 							mc_cr_htf_state_in,
 							m_defocus,
 							mc_cr_out_solver,
@@ -1943,7 +2055,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 						// Inputs
 						mc_pc_inputs.m_standby_control = C_csp_power_cycle::STARTUP;
 						// Performance Call
-						mc_power_cycle.call(mc_weather.ms_outputs,
+						pc_call(mc_weather.ms_outputs,
 							mc_pc_htf_state_in,
 							mc_pc_inputs,
 							mc_pc_out_solver,
@@ -2010,7 +2122,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 				// Solve for idle storage
 				if (m_is_tes)
 				{
-					mc_tes.idle(mc_kernel.mc_sim_info.ms_ts.m_step, mc_weather.ms_outputs.m_tdry + 273.15, mc_tes_outputs);
+					tes_idle(mc_kernel.mc_sim_info.ms_ts.m_step, mc_weather.ms_outputs.m_tdry + 273.15, mc_tes_outputs);
 
 					// If not actually charging (i.e. mass flow rate = 0.0), what should the temperatures be?
 					mc_tes_ch_htf_state.m_m_dot = 0.0;										//[kg/hr]
@@ -2147,7 +2259,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 
 					if(m_is_tes)
 					{
-						mc_tes.idle(mc_kernel.mc_sim_info.ms_ts.m_step, mc_weather.ms_outputs.m_tdry + 273.15, mc_tes_outputs);
+						tes_idle(mc_kernel.mc_sim_info.ms_ts.m_step, mc_weather.ms_outputs.m_tdry + 273.15, mc_tes_outputs);
 					
 					
 						// If not actually charging (i.e. mass flow rate = 0.0), what should the temperatures be?
@@ -2197,7 +2309,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 				// First, solve the CR. Again, we're assuming HTF inlet temperature is always = m_T_htf_cold_des
 				mc_cr_htf_state_in.m_temp = m_T_htf_cold_des - 273.15;		//[C], convert from [K]
 
-				mc_collector_receiver.on(mc_weather.ms_outputs,
+				cr_on(mc_weather.ms_outputs,
 					mc_cr_htf_state_in,
 					m_defocus,
 					mc_cr_out_solver,
@@ -2219,7 +2331,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 					// Inputs
 				mc_pc_inputs.m_standby_control = C_csp_power_cycle::STANDBY;
 					// Performance Call
-				mc_power_cycle.call(mc_weather.ms_outputs,
+				pc_call(mc_weather.ms_outputs,
 					mc_pc_htf_state_in,
 					mc_pc_inputs,
 					mc_pc_out_solver,
@@ -2281,7 +2393,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 
 				if( m_is_tes )
 				{
-					mc_tes.idle(mc_kernel.mc_sim_info.ms_ts.m_step, mc_weather.ms_outputs.m_tdry + 273.15, mc_tes_outputs);
+					tes_idle(mc_kernel.mc_sim_info.ms_ts.m_step, mc_weather.ms_outputs.m_tdry + 273.15, mc_tes_outputs);
 
 					// If not actually charging (i.e. mass flow rate = 0.0), what should the temperatures be?
 					mc_tes_ch_htf_state.m_m_dot = 0.0;										//[kg/hr]
@@ -2319,7 +2431,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 				// CR: ON
 				mc_cr_htf_state_in.m_temp = m_T_htf_cold_des - 273.15;		//[C], convert from [K]
 
-				mc_collector_receiver.on(mc_weather.ms_outputs,
+				cr_on(mc_weather.ms_outputs,
 					mc_cr_htf_state_in,
 					m_defocus,
 					mc_cr_out_solver,
@@ -2341,7 +2453,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 					// Inputs
 				mc_pc_inputs.m_standby_control = C_csp_power_cycle::STARTUP;
 					// Performance Call
-				mc_power_cycle.call(mc_weather.ms_outputs,
+				pc_call(mc_weather.ms_outputs,
 					mc_pc_htf_state_in,
 					mc_pc_inputs,
 					mc_pc_out_solver,
@@ -2357,7 +2469,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 
 				if( m_is_tes )
 				{
-					mc_tes.idle(mc_kernel.mc_sim_info.ms_ts.m_step, mc_weather.ms_outputs.m_tdry + 273.15, mc_tes_outputs);
+					tes_idle(mc_kernel.mc_sim_info.ms_ts.m_step, mc_weather.ms_outputs.m_tdry + 273.15, mc_tes_outputs);
 
 
 					// If not actually charging (i.e. mass flow rate = 0.0), what should the temperatures be?
@@ -2407,7 +2519,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 				mc_cr_htf_state_in.m_pres = m_P_cold_des;					//[kPa]
 				mc_cr_htf_state_in.m_qual = m_x_cold_des;					//[-]
 
-				mc_collector_receiver.startup(mc_weather.ms_outputs,
+				cr_startup(mc_weather.ms_outputs,
 					mc_cr_htf_state_in,
 					mc_cr_out_solver,
 					mc_kernel.mc_sim_info);
@@ -2438,7 +2550,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 					// Inputs
 				mc_pc_inputs.m_standby_control = C_csp_power_cycle::OFF;
 					// Performance Call
-				mc_power_cycle.call(mc_weather.ms_outputs,
+				pc_call(mc_weather.ms_outputs,
 					mc_pc_htf_state_in,
 					mc_pc_inputs,
 					mc_pc_out_solver,
@@ -2446,7 +2558,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 
 				if( m_is_tes )
 				{
-					mc_tes.idle(mc_kernel.mc_sim_info.ms_ts.m_step, mc_weather.ms_outputs.m_tdry + 273.15, mc_tes_outputs);
+					tes_idle(mc_kernel.mc_sim_info.ms_ts.m_step, mc_weather.ms_outputs.m_tdry + 273.15, mc_tes_outputs);
 
 
 					// If not actually charging (i.e. mass flow rate = 0.0), what should the temperatures be?
@@ -2476,7 +2588,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 				mc_cr_htf_state_in.m_pres = m_P_cold_des;					//[kPa]
 				mc_cr_htf_state_in.m_qual = m_x_cold_des;					//[-]
 
-				mc_collector_receiver.off(mc_weather.ms_outputs,
+				cr_off(mc_weather.ms_outputs,
 					mc_cr_htf_state_in,
 					mc_cr_out_solver,
 					mc_kernel.mc_sim_info);
@@ -2490,7 +2602,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 					// Inputs
 				mc_pc_inputs.m_standby_control = C_csp_power_cycle::OFF;
 					// Performance Call
-				mc_power_cycle.call(mc_weather.ms_outputs,
+				pc_call(mc_weather.ms_outputs,
 					mc_pc_htf_state_in,
 					mc_pc_inputs,
 					mc_pc_out_solver,
@@ -2498,7 +2610,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 
 				if( m_is_tes )
 				{
-					mc_tes.idle(mc_kernel.mc_sim_info.ms_ts.m_step, mc_weather.ms_outputs.m_tdry + 273.15, mc_tes_outputs);
+					tes_idle(mc_kernel.mc_sim_info.ms_ts.m_step, mc_weather.ms_outputs.m_tdry + 273.15, mc_tes_outputs);
 
 
 					// If not actually charging (i.e. mass flow rate = 0.0), what should the temperatures be?
@@ -2559,7 +2671,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 				// Now run CR at 'OFF'
 				mc_cr_htf_state_in.m_temp = m_T_htf_cold_des - 273.15;		//[C], convert from [K]
 				
-				mc_collector_receiver.off(mc_weather.ms_outputs,
+				cr_off(mc_weather.ms_outputs,
 					mc_cr_htf_state_in,
 					mc_cr_out_solver,
 					mc_kernel.mc_sim_info);
@@ -2631,7 +2743,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 				mc_pc_inputs.m_m_dot = 0.0;		//[kg/hr] no mass flow rate to power cycle
 				mc_pc_inputs.m_standby_control = C_csp_power_cycle::OFF;
 					// Performance Call
-				mc_power_cycle.call(mc_weather.ms_outputs,
+				pc_call(mc_weather.ms_outputs,
 					mc_pc_htf_state_in,
 					mc_pc_inputs,
 					mc_pc_out_solver,
@@ -3155,7 +3267,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 				mc_pc_inputs.m_standby_control = C_csp_power_cycle::OFF;
 				mc_pc_inputs.m_m_dot = 0.0;		//[kg/hr] no mass flow rate to power cycle
 					// Performance Call
-				mc_power_cycle.call(mc_weather.ms_outputs,
+				pc_call(mc_weather.ms_outputs,
 					mc_pc_htf_state_in,
 					mc_pc_inputs,
 					mc_pc_out_solver,
@@ -3250,7 +3362,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 				// Now run CR at 'OFF'
 				mc_cr_htf_state_in.m_temp = m_T_htf_cold_des - 273.15;		//[C], convert from [K]
 
-				mc_collector_receiver.off(mc_weather.ms_outputs,
+				cr_off(mc_weather.ms_outputs,
 					mc_cr_htf_state_in,
 					mc_cr_out_solver,
 					mc_kernel.mc_sim_info);
@@ -3283,7 +3395,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 					// Now run CR at 'OFF'
 					mc_cr_htf_state_in.m_temp = m_T_htf_cold_des - 273.15;		//[C], convert from [K]
 					
-					mc_collector_receiver.off(mc_weather.ms_outputs,
+					cr_off(mc_weather.ms_outputs,
 						mc_cr_htf_state_in,
 						mc_cr_out_solver,
 						mc_kernel.mc_sim_info);
@@ -3294,7 +3406,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 					// Run CR at 'Start Up'
 					mc_cr_htf_state_in.m_temp = m_T_htf_cold_des - 273.15;		//[C], convert from [K]
 
-					mc_collector_receiver.startup(mc_weather.ms_outputs,
+					cr_startup(mc_weather.ms_outputs,
 						mc_cr_htf_state_in,
 						mc_cr_out_solver,
 						mc_kernel.mc_sim_info);
@@ -3468,7 +3580,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 				// First, startup the collector-receiver and get the time required
 				mc_cr_htf_state_in.m_temp = m_T_htf_cold_des - 273.15;		//[C], convert from [K]
 
-				mc_collector_receiver.startup(mc_weather.ms_outputs,
+				cr_startup(mc_weather.ms_outputs,
 					mc_cr_htf_state_in,
 					mc_cr_out_solver,
 					mc_kernel.mc_sim_info);
@@ -3554,7 +3666,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 					// Rerun CR_SU
 					mc_cr_htf_state_in.m_temp = m_T_htf_cold_des - 273.15;		//[C], convert from [K]
 
-					mc_collector_receiver.startup(mc_weather.ms_outputs,
+					cr_startup(mc_weather.ms_outputs,
 						mc_cr_htf_state_in,
 						mc_cr_out_solver,
 						mc_kernel.mc_sim_info);
@@ -3813,7 +3925,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 					// Now run CR at 'OFF'
 					mc_cr_htf_state_in.m_temp = m_T_htf_cold_des - 273.15;		//[C], convert from [K]
 					
-					mc_collector_receiver.off(mc_weather.ms_outputs,
+					cr_off(mc_weather.ms_outputs,
 						mc_cr_htf_state_in,
 						mc_cr_out_solver,
 						mc_kernel.mc_sim_info);
@@ -3825,7 +3937,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 					// Run CR at 'Start Up'
 					mc_cr_htf_state_in.m_temp = m_T_htf_cold_des - 273.15;		//[C], convert from [K]
 
-					mc_collector_receiver.startup(mc_weather.ms_outputs,
+					cr_startup(mc_weather.ms_outputs,
 						mc_cr_htf_state_in,
 						mc_cr_out_solver,
 						mc_kernel.mc_sim_info);
@@ -4637,7 +4749,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 				// First, startup the collector-receiver and get the time required
 				mc_cr_htf_state_in.m_temp = m_T_htf_cold_des - 273.15;		//[C], convert from [K]
 
-				mc_collector_receiver.startup(mc_weather.ms_outputs,
+				cr_startup(mc_weather.ms_outputs,
 					mc_cr_htf_state_in,
 					mc_cr_out_solver,
 					mc_kernel.mc_sim_info);
@@ -4695,7 +4807,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 						// Rerun CR_SU
 						mc_cr_htf_state_in.m_temp = m_T_htf_cold_des - 273.15;		//[C], convert from [K]
 
-						mc_collector_receiver.startup(mc_weather.ms_outputs,
+						cr_startup(mc_weather.ms_outputs,
 							mc_cr_htf_state_in,
 							mc_cr_out_solver,
 							mc_kernel.mc_sim_info);
@@ -4975,6 +5087,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 		mc_reported_outputs.value(C_solver_outputs::DISPATCH_PRES_NCONSTR, dispatch.outputs.presolve_nconstr);
 		mc_reported_outputs.value(C_solver_outputs::DISPATCH_PRES_NVAR, dispatch.outputs.presolve_nvar);
 		mc_reported_outputs.value(C_solver_outputs::DISPATCH_SOLVE_TIME, dispatch.outputs.solve_time);
+		mc_reported_outputs.value(C_solver_outputs::DISPATCH_BUILD_TIME, dispatch.outputs.build_time);
 
 		// Report series of operating modes attempted during the timestep as a 'double' using 0s to separate the enumerations 
 		// ... (10 is set as a dummy enumeration so it won't show up as a potential operating mode)
@@ -5027,7 +5140,21 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 		}
 		mc_reported_outputs.value(C_solver_outputs::CTRL_OP_MODE_SEQ_C, op_mode_key);
 
-
+			// Solver profile
+		ms_profile_ts.m_n_timesteps = 1;
+		if( m_is_profile )
+			ms_profile_ts.m_time_total = std::chrono::duration<double>(std::chrono::steady_clock::now() - ts_profile_start).count();	//[s]
+		ms_profile_sim.add(ms_profile_ts);
+
+		mc_reported_outputs.value(C_solver_outputs::PROFILE_N_OP_MODES, ms_profile_ts.m_n_op_modes);	//[-]
+		mc_reported_outputs.value(C_solver_outputs::PROFILE_N_CR_CALLS, ms_profile_ts.m_n_cr_calls);	//[-]
+		mc_reported_outputs.value(C_solver_outputs::PROFILE_N_PC_CALLS, ms_profile_ts.m_n_pc_calls);	//[-]
+		mc_reported_outputs.value(C_solver_outputs::PROFILE_N_TES_CALLS, ms_profile_ts.m_n_tes_calls);	//[-]
+		mc_reported_outputs.value(C_solver_outputs::PROFILE_N_EQ_CALLS, ms_profile_ts.m_n_eq_calls);	//[-]
+		mc_reported_outputs.value(C_solver_outputs::PROFILE_TIME_CR, ms_profile_ts.m_time_cr);			//[s]
+		mc_reported_outputs.value(C_solver_outputs::PROFILE_TIME_PC, ms_profile_ts.m_time_pc);			//[s]
+		mc_reported_outputs.value(C_solver_outputs::PROFILE_TIME_TES, ms_profile_ts.m_time_tes);		//[s]
+		mc_reported_outputs.value(C_solver_outputs::PROFILE_TIME_TOTAL, ms_profile_ts.m_time_total);	//[s]
 
 		mc_reported_outputs.set_timestep_outputs();
 
@@ -5130,6 +5257,15 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 		
 	}	// End timestep loop
 
+	if( m_is_profile )
+	{
+		mc_csp_messages.add_message(C_csp_messages::NOTICE, util::format("Solver profile: %d timesteps, %d operating modes attempted, %d equation evaluations; "
+			"collector-receiver %d calls %.3f s, power cycle %d calls %.3f s, TES %d calls %.3f s, %.3f s total",
+			ms_profile_sim.m_n_timesteps, ms_profile_sim.m_n_op_modes, ms_profile_sim.m_n_eq_calls,
+			ms_profile_sim.m_n_cr_calls, ms_profile_sim.m_time_cr, ms_profile_sim.m_n_pc_calls, ms_profile_sim.m_time_pc,
+			ms_profile_sim.m_n_tes_calls, ms_profile_sim.m_time_tes, ms_profile_sim.m_time_total));
+	}
+
 }	// End simulate() method
 
 
@@ -5199,7 +5335,7 @@ void C_csp_solver::solver_pc_su_controlled__tes_dc(double step_tol /*s*/,
 		// Get mass flow rate and temperature at a full discharge
 		double m_dot_pc = std::numeric_limits<double>::quiet_NaN();
 		double T_pc_in_calc = std::numeric_limits<double>::quiet_NaN();
-		mc_tes.discharge_full(mc_kernel.mc_sim_info.ms_ts.m_step, mc_weather.ms_outputs.m_tdry + 273.15, m_T_htf_cold_des, T_pc_in_calc, m_dot_pc, mc_tes_outputs);
+		tes_discharge_full(mc_kernel.mc_sim_info.ms_ts.m_step, mc_weather.ms_outputs.m_tdry + 273.15, m_T_htf_cold_des, T_pc_in_calc, m_dot_pc, mc_tes_outputs);
 
 		// If not actually charging (i.e. mass flow rate = 0.0), what should the temperatures be?
 		mc_tes_ch_htf_state.m_m_dot = 0.0;										//[kg/hr]
@@ -5217,7 +5353,7 @@ void C_csp_solver::solver_pc_su_controlled__tes_dc(double step_tol /*s*/,
 			// Inputs
 		mc_pc_inputs.m_standby_control = C_csp_power_cycle::STARTUP;
 			// Performance Call
-		mc_power_cycle.call(mc_weather.ms_outputs,
+		pc_call(mc_weather.ms_outputs,
 			mc_pc_htf_state_in,
 			mc_pc_inputs,
 			mc_pc_out_solver,
@@ -53,6 +53,7 @@
 #include <numeric>
 #include <limits>
 #include <memory>
+#include <chrono>
 
 #include "lib_weatherfile.h"
 #include "csp_solver_util.h"
@@ -796,6 +797,7 @@ public:
 			DISPATCH_PRES_NCONSTR,      //[-] Number of constraint relationships in dispatch model formulation
 			DISPATCH_PRES_NVAR,         //[-] Number of variables in dispatch model formulation
 			DISPATCH_SOLVE_TIME,        //[sec]   Time required to solve the dispatch model at each instance
+			DISPATCH_BUILD_TIME,        //[sec]   Time required to build or update the dispatch model at each instance
 
 			// **************************************************************
 			//      Outputs that are reported as weighted averages if 
@@ -827,7 +829,21 @@ public:
 			PC_W_DOT_COOLING,     //[MWe] Parasitic condenser operation power
 			SYS_W_DOT_FIXED,      //[MWe] Parasitic fixed power consumption
 			SYS_W_DOT_BOP,        //[MWe] Parasitic BOP power consumption
-			W_DOT_NET             //[MWe] System total electric power to grid
+			W_DOT_NET,            //[MWe] System total electric power to grid
+
+			// **************************************************************
+			//      Solver profile outputs that are reported as the sum
+			//       of the csp-timesteps in one reporting timestep
+			// **************************************************************
+			PROFILE_N_OP_MODES,       //[-] Operating modes attempted
+			PROFILE_N_CR_CALLS,       //[-] Collector-receiver on, startup, off, and estimates calls
+			PROFILE_N_PC_CALLS,       //[-] Power cycle calls
+			PROFILE_N_TES_CALLS,      //[-] TES charge, discharge, and idle calls
+			PROFILE_N_EQ_CALLS,       //[-] Solver monotonic equation evaluations
+			PROFILE_TIME_CR,          //[s] Wall time in collector-receiver calls
+			PROFILE_TIME_PC,          //[s] Wall time in power cycle calls
+			PROFILE_TIME_TES,         //[s] Wall time in TES calls
+			PROFILE_TIME_TOTAL        //[s] Wall time solving the timestep
 		};
 	};
 	
@@ -893,6 +909,36 @@ public:
 		}
 	};
 
+	// Counts and wall time of the work done to solve the timesteps
+	struct S_solver_profile
+	{
+		int m_n_timesteps;		//[-] csp-timesteps solved
+		int m_n_op_modes;		//[-] Operating modes attempted
+		int m_n_cr_calls;		//[-] Collector-receiver on, startup, off, and estimates calls
+		int m_n_pc_calls;		//[-] Power cycle calls
+		int m_n_tes_calls;		//[-] TES charge, discharge, and idle calls
+		int m_n_eq_calls;		//[-] Solver monotonic equation evaluations
+
+		double m_time_cr;		//[s] Wall time in collector-receiver calls
+		double m_time_pc;		//[s] Wall time in power cycle calls
+		double m_time_tes;		//[s] Wall time in TES calls
+		double m_time_total;	//[s] Wall time solving the timesteps
+
+		S_solver_profile()
+		{
+			clear();
+		}
+
+		void clear()
+		{
+			m_n_timesteps = m_n_op_modes = m_n_cr_calls = m_n_pc_calls = m_n_tes_calls = m_n_eq_calls = 0;
+
+			m_time_cr = m_time_pc = m_time_tes = m_time_total = 0.0;
+		}
+
+		void add(const S_solver_profile &ts);
+	};
+
 private:
 	C_csp_weatherreader &mc_weather;
 	C_csp_collector_receiver &mc_collector_receiver;
@@ -917,6 +963,51 @@ private:
 
 	C_csp_solver::C_csp_solver_kernel mc_kernel;
 
+	// Solver profile
+	S_solver_profile ms_profile_ts;		// Current timestep
+	S_solver_profile ms_profile_sim;	// Simulation totals
+
+	// Adds the wall time since construction to a profile time when profiling is enabled
+	class C_profile_timer
+	{
+	private:
+		double *mp_time;	//[s]
+		std::chrono::steady_clock::time_point m_start;
+
+	public:
+		C_profile_timer(bool is_profile, double &time /*s*/)
+		{
+			mp_time = is_profile ? &time : 0;
+			if( mp_time )
+				m_start = std::chrono::steady_clock::now();
+		}
+
+		~C_profile_timer()
+		{
+			if( mp_time )
+				*mp_time += std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+		}
+	};
+
+	// Component calls made by the controller and solvers, counted and timed for the solver profile
+	void cr_on(const C_csp_weatherreader::S_outputs &weather, const C_csp_solver_htf_1state &htf_state_in,
+		double field_control, C_csp_collector_receiver::S_csp_cr_out_solver &cr_out_solver, const C_csp_solver_sim_info &sim_info);
+	void cr_startup(const C_csp_weatherreader::S_outputs &weather, const C_csp_solver_htf_1state &htf_state_in,
+		C_csp_collector_receiver::S_csp_cr_out_solver &cr_out_solver, const C_csp_solver_sim_info &sim_info);
+	void cr_off(const C_csp_weatherreader::S_outputs &weather, const C_csp_solver_htf_1state &htf_state_in,
+		C_csp_collector_receiver::S_csp_cr_out_solver &cr_out_solver, const C_csp_solver_sim_info &sim_info);
+	void cr_estimates(const C_csp_weatherreader::S_outputs &weather, const C_csp_solver_htf_1state &htf_state_in,
+		C_csp_collector_receiver::S_csp_cr_est_out &est_out, const C_csp_solver_sim_info &sim_info);
+
+	void pc_call(const C_csp_weatherreader::S_outputs &weather, C_csp_solver_htf_1state &htf_state_in,
+		const C_csp_power_cycle::S_control_inputs &inputs, C_csp_power_cycle::S_csp_pc_out_solver &out_solver, const C_csp_solver_sim_info &sim_info);
+
+	bool tes_discharge(double timestep /*s*/, double T_amb /*K*/, double m_dot_htf_in /*kg/s*/, double T_htf_cold_in, double & T_htf_hot_out /*K*/, C_csp_tes::S_csp_tes_outputs &outputs);
+	void tes_discharge_full(double timestep /*s*/, double T_amb /*K*/, double T_htf_cold_in, double & T_htf_hot_out /*K*/, double & m_dot_htf_out /*kg/s*/, C_csp_tes::S_csp_tes_outputs &outputs);
+	bool tes_charge(double timestep /*s*/, double T_amb /*K*/, double m_dot_htf_in /*kg/s*/, double T_htf_hot_in, double & T_htf_cold_out /*K*/, C_csp_tes::S_csp_tes_outputs &outputs);
+	void tes_charge_full(double timestep /*s*/, double T_amb /*K*/, double T_htf_hot_in /*K*/, double & T_htf_cold_out /*K*/, double & m_dot_htf_out /*kg/s*/, C_csp_tes::S_csp_tes_outputs &outputs);
+	void tes_idle(double timestep, double T_amb, C_csp_tes::S_csp_tes_outputs &outputs);
+
 	// Hierarchy logic
 	bool m_is_CR_SU__PC_OFF__TES_OFF__AUX_OFF_avail;
 	bool m_is_CR_ON__PC_SB__TES_OFF__AUX_OFF_avail;
@@ -1048,6 +1139,9 @@ public:
 	// Vector to track operating modes
 	std::vector<int> m_op_mode_tracking;
 
+	// True: time the component calls and log a summary of the solver profile at the end of the simulation
+	bool m_is_profile;
+
 	enum tech_operating_modes
 	{
 		ENTRY_MODE = 0,
@@ -1129,6 +1223,11 @@ public:
 
 	double get_cr_aperture_area();
 
+	const S_solver_profile & get_solver_profile()
+	{
+		return ms_profile_sim;
+	}
+
 	// Output vectors
 	// Need to be sure these are always up-to-date as multiple operating modes are tested during one timestep
 	std::vector< std::vector< double > > mvv_outputs_temp;
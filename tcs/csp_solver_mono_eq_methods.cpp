@@ -57,6 +57,8 @@
 
 int C_csp_solver::C_MEQ_cr_on__pc_q_dot_max__tes_off__defocus::operator()(double defocus /*-*/, double *q_dot_pc /*MWt*/)
 {
+	mpc_csp_solver->ms_profile_ts.m_n_eq_calls++;
+
 	C_mono_eq_cr_to_pc_to_cr c_eq(mpc_csp_solver, m_pc_mode, mpc_csp_solver->m_P_cold_des, -1, defocus);
 	C_monotonic_eq_solver c_solver(c_eq);
 
@@ -102,12 +104,14 @@ int C_csp_solver::C_MEQ_cr_on__pc_q_dot_max__tes_off__defocus::operator()(double
 
 int C_csp_solver::C_mono_eq_cr_to_pc_to_cr::operator()(double T_htf_cold /*C*/, double *diff_T_htf_cold /*-*/)
 {
+	mpc_csp_solver->ms_profile_ts.m_n_eq_calls++;
+
 	// Solve the receiver model
 	mpc_csp_solver->mc_cr_htf_state_in.m_temp = T_htf_cold;		//[C]
 	mpc_csp_solver->mc_cr_htf_state_in.m_pres = m_P_field_in;	//[kPa]
 	mpc_csp_solver->mc_cr_htf_state_in.m_qual = m_x_field_in;	//[-]
 	
-	mpc_csp_solver->mc_collector_receiver.on(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->cr_on(mpc_csp_solver->mc_weather.ms_outputs,
 						mpc_csp_solver->mc_cr_htf_state_in,
 						m_field_control_in,
 						mpc_csp_solver->mc_cr_out_solver,
@@ -137,7 +141,7 @@ int C_csp_solver::C_mono_eq_cr_to_pc_to_cr::operator()(double T_htf_cold /*C*/,
 	mpc_csp_solver->mc_pc_inputs.m_m_dot = mpc_csp_solver->mc_cr_out_solver.m_m_dot_salt_tot;	//[kg/hr]
 	mpc_csp_solver->mc_pc_inputs.m_standby_control = m_pc_mode;		//[-]
 
-	mpc_csp_solver->mc_power_cycle.call(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->pc_call(mpc_csp_solver->mc_weather.ms_outputs,
 						mpc_csp_solver->mc_pc_htf_state_in,
 						mpc_csp_solver->mc_pc_inputs,
 						mpc_csp_solver->mc_pc_out_solver,
@@ -156,12 +160,14 @@ int C_csp_solver::C_mono_eq_cr_to_pc_to_cr::operator()(double T_htf_cold /*C*/,
 
 int C_csp_solver::C_mono_eq_pc_su_cont_tes_dc::operator()(double T_htf_hot /*C*/, double *diff_T_htf_hot /*-*/)
 {
+	mpc_csp_solver->ms_profile_ts.m_n_eq_calls++;
+
 	// Call the power cycle in STARTUP_CONTROLLED mode
 	mpc_csp_solver->mc_pc_inputs.m_m_dot = 0.0;		//[kg/hr]
 	mpc_csp_solver->mc_pc_htf_state_in.m_temp = T_htf_hot;		//[C] convert from K
 	mpc_csp_solver->mc_pc_inputs.m_standby_control = C_csp_power_cycle::STARTUP_CONTROLLED;
 
-	mpc_csp_solver->mc_power_cycle.call(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->pc_call(mpc_csp_solver->mc_weather.ms_outputs,
 							mpc_csp_solver->mc_pc_htf_state_in,
 							mpc_csp_solver->mc_pc_inputs,
 							mpc_csp_solver->mc_pc_out_solver,
@@ -179,7 +185,7 @@ int C_csp_solver::C_mono_eq_pc_su_cont_tes_dc::operator()(double T_htf_hot /*C*/
 	// Solve TES discharge
 	double T_htf_hot_calc = std::numeric_limits<double>::quiet_NaN();
 	double T_htf_cold = mpc_csp_solver->mc_pc_out_solver.m_T_htf_cold;		//[C]
-	bool is_dc_solved = mpc_csp_solver->mc_tes.discharge(m_time_pc_su, 
+	bool is_dc_solved = mpc_csp_solver->tes_discharge(m_time_pc_su, 
 											mpc_csp_solver->mc_weather.ms_outputs.m_tdry + 273.15, 
 											m_dot_pc,
 											T_htf_cold + 273.15,
@@ -213,8 +219,10 @@ int C_csp_solver::C_mono_eq_pc_su_cont_tes_dc::operator()(double T_htf_hot /*C*/
 
 int C_csp_solver::C_mono_eq_pc_target_tes_dc__m_dot::operator()(double m_dot_htf /*kg/hr*/, double *q_dot_pc /*MWt*/)
 {
+	mpc_csp_solver->ms_profile_ts.m_n_eq_calls++;
+
 	double T_htf_hot = std::numeric_limits<double>::quiet_NaN();
-	bool is_tes_success = mpc_csp_solver->mc_tes.discharge(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
+	bool is_tes_success = mpc_csp_solver->tes_discharge(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
 												mpc_csp_solver->mc_weather.ms_outputs.m_tdry + 273.15,
 												m_dot_htf / 3600.0,
 												m_T_htf_cold + 273.15,
@@ -245,7 +253,7 @@ int C_csp_solver::C_mono_eq_pc_target_tes_dc__m_dot::operator()(double m_dot_htf
 	mpc_csp_solver->mc_pc_inputs.m_m_dot = m_dot_htf;				//[kg/hr]
 	mpc_csp_solver->mc_pc_inputs.m_standby_control = m_pc_mode;		//[-]
 		// Performance
-	mpc_csp_solver->mc_power_cycle.call(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->pc_call(mpc_csp_solver->mc_weather.ms_outputs,
 									mpc_csp_solver->mc_pc_htf_state_in,
 									mpc_csp_solver->mc_pc_inputs,
 									mpc_csp_solver->mc_pc_out_solver,
@@ -264,6 +272,8 @@ int C_csp_solver::C_mono_eq_pc_target_tes_dc__m_dot::operator()(double m_dot_htf
 
 int C_csp_solver::C_mono_eq_pc_target_tes_dc__T_cold::operator()(double T_htf_cold /*C*/, double *diff_T_htf_cold /*-*/)
 {
+	mpc_csp_solver->ms_profile_ts.m_n_eq_calls++;
+
 	// Expect mc_pc_out_solver to be set in inner mono eq loop that converges m_dot_htf
 	C_mono_eq_pc_target_tes_dc__m_dot c_eq(mpc_csp_solver, m_pc_mode, T_htf_cold);
 	C_monotonic_eq_solver c_solver(c_eq);
@@ -391,10 +401,12 @@ int C_csp_solver::C_mono_eq_pc_target_tes_dc__T_cold::operator()(double T_htf_co
 
 int C_csp_solver::C_mono_eq_pc_match_tes_empty::operator()(double T_htf_cold /*C*/, double *diff_T_htf_cold /*-*/)
 {
+	mpc_csp_solver->ms_profile_ts.m_n_eq_calls++;
+
 	// First, get the maximum possible mass flow rate from a full TES discharge
 	double T_htf_tes_hot, m_dot_tes_dc;
 	T_htf_tes_hot = m_dot_tes_dc = std::numeric_limits<double>::quiet_NaN();
-	mpc_csp_solver->mc_tes.discharge_full(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
+	mpc_csp_solver->tes_discharge_full(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
 							mpc_csp_solver->mc_weather.ms_outputs.m_tdry + 273.15,
 							T_htf_cold + 273.15,
 							T_htf_tes_hot, 
@@ -420,7 +432,7 @@ int C_csp_solver::C_mono_eq_pc_match_tes_empty::operator()(double T_htf_cold /*C
 	mpc_csp_solver->mc_pc_inputs.m_standby_control = C_csp_power_cycle::ON;
 
 	// Performance Call
-	mpc_csp_solver->mc_power_cycle.call(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->pc_call(mpc_csp_solver->mc_weather.ms_outputs,
 		mpc_csp_solver->mc_pc_htf_state_in,
 		mpc_csp_solver->mc_pc_inputs,
 		mpc_csp_solver->mc_pc_out_solver,
@@ -433,10 +445,12 @@ int C_csp_solver::C_mono_eq_pc_match_tes_empty::operator()(double T_htf_cold /*C
 
 int C_csp_solver::C_mono_eq_cr_on_pc_su_tes_ch::operator()(double T_htf_cold /*C*/, double *diff_T_htf_cold /*-*/)
 {
+	mpc_csp_solver->ms_profile_ts.m_n_eq_calls++;
+
 	// Solve the receiver model
 	mpc_csp_solver->mc_cr_htf_state_in.m_temp = T_htf_cold;		//[C]
 
-	mpc_csp_solver->mc_collector_receiver.on(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->cr_on(mpc_csp_solver->mc_weather.ms_outputs,
 										mpc_csp_solver->mc_cr_htf_state_in,
 										mpc_csp_solver->m_defocus,
 										mpc_csp_solver->mc_cr_out_solver,
@@ -454,7 +468,7 @@ int C_csp_solver::C_mono_eq_cr_on_pc_su_tes_ch::operator()(double T_htf_cold /*C
 	mpc_csp_solver->mc_pc_htf_state_in.m_temp = mpc_csp_solver->mc_cr_out_solver.m_T_salt_hot;		//[C]
 	mpc_csp_solver->mc_pc_inputs.m_standby_control = C_csp_power_cycle::STARTUP_CONTROLLED;
 
-	mpc_csp_solver->mc_power_cycle.call(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->pc_call(mpc_csp_solver->mc_weather.ms_outputs,
 								mpc_csp_solver->mc_pc_htf_state_in,
 								mpc_csp_solver->mc_pc_inputs,
 								mpc_csp_solver->mc_pc_out_solver,
@@ -480,7 +494,7 @@ int C_csp_solver::C_mono_eq_cr_on_pc_su_tes_ch::operator()(double T_htf_cold /*C
 	}
 
 	double T_htf_tes_cold = std::numeric_limits<double>::quiet_NaN();
-	bool ch_solved = mpc_csp_solver->mc_tes.charge(m_step_pc_su, 
+	bool ch_solved = mpc_csp_solver->tes_charge(m_step_pc_su, 
 									mpc_csp_solver->mc_weather.ms_outputs.m_tdry + 273.15,
 									m_dot_tes_ch / 3600.0,
 									mpc_csp_solver->mc_cr_out_solver.m_T_salt_hot + 273.15,
@@ -514,6 +528,8 @@ int C_csp_solver::C_mono_eq_cr_on_pc_su_tes_ch::operator()(double T_htf_cold /*C
 
 int C_csp_solver::C_mono_eq_pc_target__m_dot::operator()(double m_dot_htf_pc /*kg/hr*/, double *q_dot_pc /*MWt*/)
 {
+	mpc_csp_solver->ms_profile_ts.m_n_eq_calls++;
+
 	// Set power cycle HTF inlet state
 	mpc_csp_solver->mc_pc_htf_state_in.m_temp = m_T_htf_hot;	//[C]
 
@@ -522,7 +538,7 @@ int C_csp_solver::C_mono_eq_pc_target__m_dot::operator()(double m_dot_htf_pc /*k
 	mpc_csp_solver->mc_pc_inputs.m_standby_control = m_pc_mode;	//[-]
 
 	// Power cycle performance call
-	mpc_csp_solver->mc_power_cycle.call(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->pc_call(mpc_csp_solver->mc_weather.ms_outputs,
 								mpc_csp_solver->mc_pc_htf_state_in,
 								mpc_csp_solver->mc_pc_inputs,
 								mpc_csp_solver->mc_pc_out_solver,
@@ -542,10 +558,12 @@ int C_csp_solver::C_mono_eq_pc_target__m_dot::operator()(double m_dot_htf_pc /*k
 
 int C_csp_solver::C_mono_eq_cr_on_pc_target_tes_ch__T_cold::operator()(double T_htf_cold /*C*/, double *diff_T_htf_cold /*-*/)
 {
+	mpc_csp_solver->ms_profile_ts.m_n_eq_calls++;
+
 	// Solve the CR
 	mpc_csp_solver->mc_cr_htf_state_in.m_temp = T_htf_cold;		//[C]
 
-	mpc_csp_solver->mc_collector_receiver.on(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->cr_on(mpc_csp_solver->mc_weather.ms_outputs,
 										mpc_csp_solver->mc_cr_htf_state_in,
 										m_defocus,
 										mpc_csp_solver->mc_cr_out_solver,
@@ -662,7 +680,7 @@ int C_csp_solver::C_mono_eq_cr_on_pc_target_tes_ch__T_cold::operator()(double T_
 	}
 
 	double T_tes_cold_out = std::numeric_limits<double>::quiet_NaN();	//[K]
-	bool is_tes_success = mpc_csp_solver->mc_tes.charge(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
+	bool is_tes_success = mpc_csp_solver->tes_charge(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
 												mpc_csp_solver->mc_weather.ms_outputs.m_tdry + 273.15,
 												m_dot_tes / 3600.0,
 												mpc_csp_solver->mc_cr_out_solver.m_T_salt_hot + 273.15,
@@ -696,10 +714,12 @@ int C_csp_solver::C_mono_eq_cr_on_pc_target_tes_ch__T_cold::operator()(double T_
 
 int C_csp_solver::C_mono_eq_cr_on_pc_match_tes_empty::operator()(double T_htf_cold /*C*/, double *diff_T_htf_cold /*-*/)
 {
+	mpc_csp_solver->ms_profile_ts.m_n_eq_calls++;
+
 	// Solve the CR model
 	mpc_csp_solver->mc_cr_htf_state_in.m_temp = T_htf_cold;		//[C]
 
-	mpc_csp_solver->mc_collector_receiver.on(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->cr_on(mpc_csp_solver->mc_weather.ms_outputs,
 										mpc_csp_solver->mc_cr_htf_state_in,
 										m_defocus,
 										mpc_csp_solver->mc_cr_out_solver,
@@ -714,7 +734,7 @@ int C_csp_solver::C_mono_eq_cr_on_pc_match_tes_empty::operator()(double T_htf_co
 
 	// Now solve TES full discharge
 	double T_htf_tes_dc, m_dot_tes_dc;
-	mpc_csp_solver->mc_tes.discharge_full(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
+	mpc_csp_solver->tes_discharge_full(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
 							mpc_csp_solver->mc_weather.ms_outputs.m_tdry + 273.15,
 							T_htf_cold + 273.15,
 							T_htf_tes_dc,
@@ -746,7 +766,7 @@ int C_csp_solver::C_mono_eq_cr_on_pc_match_tes_empty::operator()(double T_htf_co
 	mpc_csp_solver->mc_pc_inputs.m_m_dot = m_dot_pc;		//[kg/hr]
 	mpc_csp_solver->mc_pc_inputs.m_standby_control = C_csp_power_cycle::ON;
 		// Performance
-	mpc_csp_solver->mc_power_cycle.call(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->pc_call(mpc_csp_solver->mc_weather.ms_outputs,
 									mpc_csp_solver->mc_pc_htf_state_in,
 									mpc_csp_solver->mc_pc_inputs,
 									mpc_csp_solver->mc_pc_out_solver,
@@ -768,8 +788,10 @@ int C_csp_solver::C_mono_eq_cr_on_pc_match_tes_empty::operator()(double T_htf_co
 
 int C_csp_solver::C_mono_eq_pc_target__m_dot_fixed_plus_tes_dc::operator()(double m_dot_tes_dc /*kg/hr*/, double *q_dot_pc /*MWt*/)
 {
+	mpc_csp_solver->ms_profile_ts.m_n_eq_calls++;
+
 	double T_htf_tes_hot = std::numeric_limits<double>::quiet_NaN();
-	bool is_tes_success = mpc_csp_solver->mc_tes.discharge(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
+	bool is_tes_success = mpc_csp_solver->tes_discharge(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
 								mpc_csp_solver->mc_weather.ms_outputs.m_tdry + 273.15,
 								m_dot_tes_dc / 3600.0,
 								m_T_htf_cold + 273.15,
@@ -804,7 +826,7 @@ int C_csp_solver::C_mono_eq_pc_target__m_dot_fixed_plus_tes_dc::operator()(doubl
 	mpc_csp_solver->mc_pc_inputs.m_m_dot = m_dot_htf_pc;		//[kg/hr]
 	mpc_csp_solver->mc_pc_inputs.m_standby_control = m_pc_mode;				//[-]
 	// Performance
-	mpc_csp_solver->mc_power_cycle.call(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->pc_call(mpc_csp_solver->mc_weather.ms_outputs,
 		mpc_csp_solver->mc_pc_htf_state_in,
 		mpc_csp_solver->mc_pc_inputs,
 		mpc_csp_solver->mc_pc_out_solver,
@@ -823,8 +845,10 @@ int C_csp_solver::C_mono_eq_pc_target__m_dot_fixed_plus_tes_dc::operator()(doubl
 
 int C_csp_solver::C_mono_eq_pc_target_tes_empty__x_step::operator()(double step /*s*/, double *q_dot_pc /*MWt*/)
 {
+	mpc_csp_solver->ms_profile_ts.m_n_eq_calls++;
+
 	double T_htf_tes_hot, m_dot_tes_dc = std::numeric_limits<double>::quiet_NaN();
-	mpc_csp_solver->mc_tes.discharge_full(step,
+	mpc_csp_solver->tes_discharge_full(step,
 						mpc_csp_solver->mc_weather.ms_outputs.m_tdry + 273.15,
 						m_T_htf_cold + 273.15,
 						T_htf_tes_hot,
@@ -852,6 +876,8 @@ int C_csp_solver::C_mono_eq_pc_target_tes_empty__x_step::operator()(double step
 
 int C_csp_solver::C_mono_eq_pc_target_tes_empty__T_cold::operator()(double T_htf_cold /*C*/, double *diff_T_htf_cold /*-*/)
 {
+	mpc_csp_solver->ms_profile_ts.m_n_eq_calls++;
+
 	// Clear public member data
 	m_step = std::numeric_limits<double>::quiet_NaN();
 
@@ -859,7 +885,7 @@ int C_csp_solver::C_mono_eq_pc_target_tes_empty__T_cold::operator()(double T_htf
 	//   ... using the guess value for the TES cold inlet temperature
 	double T_htf_tes_hot, m_dot_htf_full_ts;
 	T_htf_tes_hot = m_dot_htf_full_ts = std::numeric_limits<double>::quiet_NaN();
-	mpc_csp_solver->mc_tes.discharge_full(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
+	mpc_csp_solver->tes_discharge_full(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
 							mpc_csp_solver->mc_weather.ms_outputs.m_tdry + 273.15,
 							T_htf_cold + 273.15,
 							T_htf_tes_hot,
@@ -975,7 +1001,7 @@ void C_csp_solver::C_mono_eq_pc_target_tes_empty__T_cold::solve_pc(double step /
 		step;	//[s]
 
 	// Performance Call
-	mpc_csp_solver->mc_power_cycle.call(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->pc_call(mpc_csp_solver->mc_weather.ms_outputs,
 		mpc_csp_solver->mc_pc_htf_state_in,
 		mpc_csp_solver->mc_pc_inputs,
 		mpc_csp_solver->mc_pc_out_solver,
@@ -984,9 +1010,11 @@ void C_csp_solver::C_mono_eq_pc_target_tes_empty__T_cold::solve_pc(double step /
 
 int C_csp_solver::C_mono_eq_cr_on_pc_target_tes_dc::operator()(double T_htf_cold /*C*/, double *diff_T_htf_cold /*-*/)
 {
+	mpc_csp_solver->ms_profile_ts.m_n_eq_calls++;
+
 	mpc_csp_solver->mc_cr_htf_state_in.m_temp = T_htf_cold;		//[C]
 
-	mpc_csp_solver->mc_collector_receiver.on(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->cr_on(mpc_csp_solver->mc_weather.ms_outputs,
 									mpc_csp_solver->mc_cr_htf_state_in,
 									m_defocus,
 									mpc_csp_solver->mc_cr_out_solver,
@@ -1108,10 +1136,12 @@ int C_csp_solver::C_mono_eq_cr_on_pc_target_tes_dc::operator()(double T_htf_cold
 
 int C_csp_solver::C_mono_eq_cr_on__pc_match__tes_full::operator()(double T_htf_cold /*C*/, double *diff_T_htf_cold /*-*/)
 {
+	mpc_csp_solver->ms_profile_ts.m_n_eq_calls++;
+
 	// Solve the receiver model with T_htf_cold
 	mpc_csp_solver->mc_cr_htf_state_in.m_temp = T_htf_cold;		//[C]
 
-	mpc_csp_solver->mc_collector_receiver.on(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->cr_on(mpc_csp_solver->mc_weather.ms_outputs,
 										mpc_csp_solver->mc_cr_htf_state_in,
 										m_defocus,
 										mpc_csp_solver->mc_cr_out_solver,
@@ -1131,7 +1161,7 @@ int C_csp_solver::C_mono_eq_cr_on__pc_match__tes_full::operator()(double T_htf_c
 	// Solve TES for *full* charge
 	double T_htf_tes_cold, m_dot_tes;
 	T_htf_tes_cold = m_dot_tes = std::numeric_limits<double>::quiet_NaN();
-	mpc_csp_solver->mc_tes.charge_full(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
+	mpc_csp_solver->tes_charge_full(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
 							mpc_csp_solver->mc_weather.ms_outputs.m_tdry + 273.15,
 							T_htf_rec_hot + 273.15,
 							T_htf_tes_cold,
@@ -1172,7 +1202,7 @@ int C_csp_solver::C_mono_eq_cr_on__pc_match__tes_full::operator()(double T_htf_c
 	mpc_csp_solver->mc_pc_inputs.m_m_dot = m_dot_pc;				//[kg/hr]
 	mpc_csp_solver->mc_pc_inputs.m_standby_control = m_pc_mode;		//[-]
 		// Performance Call
-	mpc_csp_solver->mc_power_cycle.call(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->pc_call(mpc_csp_solver->mc_weather.ms_outputs,
 							mpc_csp_solver->mc_pc_htf_state_in,
 							mpc_csp_solver->mc_pc_inputs,
 							mpc_csp_solver->mc_pc_out_solver,
@@ -1199,10 +1229,12 @@ int C_csp_solver::C_mono_eq_cr_on__pc_match__tes_full::operator()(double T_htf_c
 
 int C_csp_solver::C_mono_eq_cr_on__pc_max_m_dot__tes_full::operator()(double T_htf_cold /*C*/, double *diff_T_htf_cold /*-*/)
 {
+	mpc_csp_solver->ms_profile_ts.m_n_eq_calls++;
+
 	// Solve the receiver model with T_htf_cold
 	mpc_csp_solver->mc_cr_htf_state_in.m_temp = T_htf_cold;		//[C]
 
-	mpc_csp_solver->mc_collector_receiver.on(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->cr_on(mpc_csp_solver->mc_weather.ms_outputs,
 		mpc_csp_solver->mc_cr_htf_state_in,
 		m_defocus,
 		mpc_csp_solver->mc_cr_out_solver,
@@ -1235,7 +1267,7 @@ int C_csp_solver::C_mono_eq_cr_on__pc_max_m_dot__tes_full::operator()(double T_h
 	}
 	mpc_csp_solver->mc_pc_inputs.m_standby_control = m_pc_mode;		//[-]
 	// Performance Call
-	mpc_csp_solver->mc_power_cycle.call(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->pc_call(mpc_csp_solver->mc_weather.ms_outputs,
 		mpc_csp_solver->mc_pc_htf_state_in,
 		mpc_csp_solver->mc_pc_inputs,
 		mpc_csp_solver->mc_pc_out_solver,
@@ -1265,7 +1297,7 @@ int C_csp_solver::C_mono_eq_cr_on__pc_max_m_dot__tes_full::operator()(double T_h
 	// Solve TES for *full* charge
 	double T_htf_tes_cold, m_dot_tes;
 	T_htf_tes_cold = m_dot_tes = std::numeric_limits<double>::quiet_NaN();
-	mpc_csp_solver->mc_tes.charge_full(step_calc,
+	mpc_csp_solver->tes_charge_full(step_calc,
 		mpc_csp_solver->mc_weather.ms_outputs.m_tdry + 273.15,
 		T_htf_rec_hot + 273.15,
 		T_htf_tes_cold,
@@ -1297,6 +1329,8 @@ int C_csp_solver::C_mono_eq_cr_on__pc_max_m_dot__tes_full::operator()(double T_h
 
 int C_csp_solver::C_mono_eq_cr_on__pc_target__tes_full__defocus::operator()(double defocus /*-*/, double *q_dot_pc /*MWt*/)
 {
+	mpc_csp_solver->ms_profile_ts.m_n_eq_calls++;
+
 	int T_htf_cold_code = mpc_csp_solver->solver_cr_on__pc_match__tes_full(m_pc_mode, defocus);
 
 	if (T_htf_cold_code != 0)
@@ -1312,6 +1346,8 @@ int C_csp_solver::C_mono_eq_cr_on__pc_target__tes_full__defocus::operator()(doub
 
 int C_csp_solver::C_mono_eq_cr_on__pc_m_dot_max__tes_full_defocus::operator()(double defocus /*-*/, double *m_dot_bal /*-*/)
 {
+	mpc_csp_solver->ms_profile_ts.m_n_eq_calls++;
+
 	C_mono_eq_cr_on__pc_max_m_dot__tes_full c_eq(mpc_csp_solver, m_pc_mode, defocus);
 	C_monotonic_eq_solver c_solver(c_eq);
 
@@ -1364,10 +1400,12 @@ int C_csp_solver::C_mono_eq_cr_on__pc_m_dot_max__tes_full_defocus::operator()(do
 
 int C_csp_solver::C_mono_eq_cr_on__pc_match_m_dot_ceil__tes_full::operator()(double T_htf_cold /*C*/, double *diff_T_htf_cold /*-*/)
 {
+	mpc_csp_solver->ms_profile_ts.m_n_eq_calls++;
+
 	// Solve the receiver model with T_htf_cold
 	mpc_csp_solver->mc_cr_htf_state_in.m_temp = T_htf_cold;		//[C]
 
-	mpc_csp_solver->mc_collector_receiver.on(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->cr_on(mpc_csp_solver->mc_weather.ms_outputs,
 		mpc_csp_solver->mc_cr_htf_state_in,
 		m_defocus,
 		mpc_csp_solver->mc_cr_out_solver,
@@ -1387,7 +1425,7 @@ int C_csp_solver::C_mono_eq_cr_on__pc_match_m_dot_ceil__tes_full::operator()(dou
 	// Solve TES for *full* charge
 	double T_htf_tes_cold, m_dot_tes;
 	T_htf_tes_cold = m_dot_tes = std::numeric_limits<double>::quiet_NaN();
-	mpc_csp_solver->mc_tes.charge_full(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
+	mpc_csp_solver->tes_charge_full(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
 		mpc_csp_solver->mc_weather.ms_outputs.m_tdry + 273.15,
 		T_htf_rec_hot + 273.15, 
 		T_htf_tes_cold,
@@ -1416,7 +1454,7 @@ int C_csp_solver::C_mono_eq_cr_on__pc_match_m_dot_ceil__tes_full::operator()(dou
 	mpc_csp_solver->mc_pc_inputs.m_m_dot = m_dot_pc;				//[kg/hr]
 	mpc_csp_solver->mc_pc_inputs.m_standby_control = m_pc_mode;		//[-]
 	// Performance Call
-	mpc_csp_solver->mc_power_cycle.call(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->pc_call(mpc_csp_solver->mc_weather.ms_outputs,
 		mpc_csp_solver->mc_pc_htf_state_in,
 		mpc_csp_solver->mc_pc_inputs,
 		mpc_csp_solver->mc_pc_out_solver,
@@ -1444,6 +1482,8 @@ int C_csp_solver::C_mono_eq_cr_on__pc_match_m_dot_ceil__tes_full::operator()(dou
 
 int C_csp_solver::C_MEQ_cr_on__pc_m_dot_max__tes_off__defocus::operator()(double defocus /*-*/, double *m_dot_bal /*-*/)
 {
+	mpc_csp_solver->ms_profile_ts.m_n_eq_calls++;
+
 	C_MEQ_cr_on__pc_max_m_dot__tes_off__T_htf_cold c_eq(mpc_csp_solver, m_pc_mode, defocus);
 	C_monotonic_eq_solver c_solver(c_eq);
 
@@ -1496,10 +1536,12 @@ int C_csp_solver::C_MEQ_cr_on__pc_m_dot_max__tes_off__defocus::operator()(double
 
 int C_csp_solver::C_MEQ_cr_on__pc_max_m_dot__tes_off__T_htf_cold::operator()(double T_htf_cold /*C*/, double *diff_T_htf_cold /*-*/)
 {
+	mpc_csp_solver->ms_profile_ts.m_n_eq_calls++;
+
 	// Solve the receiver model with T_htf_cold
 	mpc_csp_solver->mc_cr_htf_state_in.m_temp = T_htf_cold;		//[C]
 
-	mpc_csp_solver->mc_collector_receiver.on(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->cr_on(mpc_csp_solver->mc_weather.ms_outputs,
 		mpc_csp_solver->mc_cr_htf_state_in,
 		m_defocus,
 		mpc_csp_solver->mc_cr_out_solver,
@@ -1524,7 +1566,7 @@ int C_csp_solver::C_MEQ_cr_on__pc_max_m_dot__tes_off__T_htf_cold::operator()(dou
 	mpc_csp_solver->mc_pc_inputs.m_m_dot = mpc_csp_solver->m_m_dot_pc_max;				//[kg/hr]
 	mpc_csp_solver->mc_pc_inputs.m_standby_control = m_pc_mode;		//[-]
 	// Performance Call
-	mpc_csp_solver->mc_power_cycle.call(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->pc_call(mpc_csp_solver->mc_weather.ms_outputs,
 		mpc_csp_solver->mc_pc_htf_state_in,
 		mpc_csp_solver->mc_pc_inputs,
 		mpc_csp_solver->mc_pc_out_solver,
@@ -1548,10 +1590,12 @@ int C_csp_solver::C_MEQ_cr_on__pc_max_m_dot__tes_off__T_htf_cold::operator()(dou
 
 int C_csp_solver::C_MEQ_cr_on__pc_off__tes_ch__T_htf_cold::operator()(double T_htf_cold /*C*/, double *diff_T_htf_cold /*-*/)
 {
+	mpc_csp_solver->ms_profile_ts.m_n_eq_calls++;
+
 	// Solve the collector-receiver
 	mpc_csp_solver->mc_cr_htf_state_in.m_temp = T_htf_cold;		//[C]
 
-	mpc_csp_solver->mc_collector_receiver.on(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->cr_on(mpc_csp_solver->mc_weather.ms_outputs,
 		mpc_csp_solver->mc_cr_htf_state_in,
 		m_defocus,
 		mpc_csp_solver->mc_cr_out_solver,
@@ -1566,7 +1610,7 @@ int C_csp_solver::C_MEQ_cr_on__pc_off__tes_ch__T_htf_cold::operator()(double T_h
 
 	// Now, solved TES charge with CR outputs
 	double T_htf_tes_cold_out = std::numeric_limits<double>::quiet_NaN();
-	bool tes_charge_success = mpc_csp_solver->mc_tes.charge(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step, 
+	bool tes_charge_success = mpc_csp_solver->tes_charge(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step, 
 								mpc_csp_solver->mc_weather.ms_outputs.m_tdry + 273.15, 
 								mpc_csp_solver->mc_cr_out_solver.m_m_dot_salt_tot / 3600.0, 
 								mpc_csp_solver->mc_cr_out_solver.m_T_salt_hot + 273.15,
@@ -1598,13 +1642,15 @@ int C_csp_solver::C_MEQ_cr_on__pc_off__tes_ch__T_htf_cold::operator()(double T_h
 
 int C_csp_solver::C_MEQ_cr_on__pc_target__tes_empty__T_htf_cold::operator()(double T_htf_cold /*C*/, double *diff_T_htf_cold /*-*/)
 {
+	mpc_csp_solver->ms_profile_ts.m_n_eq_calls++;
+
 	// Clear public member data  
 	m_step = std::numeric_limits<double>::quiet_NaN();
 
 	// Solve CR at full timestep
 	mpc_csp_solver->mc_cr_htf_state_in.m_temp = T_htf_cold;		//[C]
 
-	mpc_csp_solver->mc_collector_receiver.on(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->cr_on(mpc_csp_solver->mc_weather.ms_outputs,
 		mpc_csp_solver->mc_cr_htf_state_in,
 		m_defocus,
 		mpc_csp_solver->mc_cr_out_solver,
@@ -1625,7 +1671,7 @@ int C_csp_solver::C_MEQ_cr_on__pc_target__tes_empty__T_htf_cold::operator()(doub
 	// ... using the guess value for the TES cold inlet temperature
 	double T_htf_tes_hot, m_dot_htf_full_ts;
 	T_htf_tes_hot = m_dot_htf_full_ts = std::numeric_limits<double>::quiet_NaN();
-	mpc_csp_solver->mc_tes.discharge_full(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
+	mpc_csp_solver->tes_discharge_full(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
 		mpc_csp_solver->mc_weather.ms_outputs.m_tdry + 273.15,
 		T_htf_cold + 273.15,
 		T_htf_tes_hot,
@@ -1749,6 +1795,8 @@ int C_csp_solver::C_MEQ_cr_on__pc_target__tes_empty__T_htf_cold::operator()(doub
 
 int C_csp_solver::C_MEQ_cr_on__pc_target__tes_empty__step::operator()(double step /*s*/, double *q_dot_pc /*MWt*/)
 {
+	mpc_csp_solver->ms_profile_ts.m_n_eq_calls++;
+
 	m_m_dot_pc = std::numeric_limits<double>::quiet_NaN();		//[kg/hr]
 	m_T_htf_pc_hot = std::numeric_limits<double>::quiet_NaN();	//[MWt]
 
@@ -1761,7 +1809,7 @@ int C_csp_solver::C_MEQ_cr_on__pc_target__tes_empty__step::operator()(double ste
 
 	mpc_csp_solver->mc_cr_htf_state_in.m_temp = m_T_htf_cold;		//[C]
 
-	mpc_csp_solver->mc_collector_receiver.on(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->cr_on(mpc_csp_solver->mc_weather.ms_outputs,
 		mpc_csp_solver->mc_cr_htf_state_in,
 		m_defocus,
 		mpc_csp_solver->mc_cr_out_solver,
@@ -1780,7 +1828,7 @@ int C_csp_solver::C_MEQ_cr_on__pc_target__tes_empty__step::operator()(double ste
 	double q_dot_rec = mpc_csp_solver->mc_cr_out_solver.m_q_thermal;		//[MWt]
 
 	double T_htf_tes_hot, m_dot_tes_dc = std::numeric_limits<double>::quiet_NaN();
-	mpc_csp_solver->mc_tes.discharge_full(step,
+	mpc_csp_solver->tes_discharge_full(step,
 		mpc_csp_solver->mc_weather.ms_outputs.m_tdry + 273.15,
 		m_T_htf_cold + 273.15,
 		T_htf_tes_hot,
@@ -1826,7 +1874,7 @@ void C_csp_solver::C_MEQ_cr_on__pc_target__tes_empty__T_htf_cold::solve_pc(doubl
 		step;	//[s]
 
 	// Performance Call
-	mpc_csp_solver->mc_power_cycle.call(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->pc_call(mpc_csp_solver->mc_weather.ms_outputs,
 		mpc_csp_solver->mc_pc_htf_state_in,
 		mpc_csp_solver->mc_pc_inputs,
 		mpc_csp_solver->mc_pc_out_solver,
@@ -1835,9 +1883,11 @@ void C_csp_solver::C_MEQ_cr_on__pc_target__tes_empty__T_htf_cold::solve_pc(doubl
 
 int C_csp_solver::C_MEQ_cr_df__pc_off__tes_full__T_cold::operator()(double T_htf_cold /*C*/, double *diff_T_htf_cold /*-*/)
 {
+	mpc_csp_solver->ms_profile_ts.m_n_eq_calls++;
+
 	mpc_csp_solver->mc_cr_htf_state_in.m_temp = T_htf_cold;		//[C]
 
-	mpc_csp_solver->mc_collector_receiver.on(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->cr_on(mpc_csp_solver->mc_weather.ms_outputs,
 		mpc_csp_solver->mc_cr_htf_state_in,
 		m_defocus,
 		mpc_csp_solver->mc_cr_out_solver,
@@ -1856,7 +1906,7 @@ int C_csp_solver::C_MEQ_cr_df__pc_off__tes_full__T_cold::operator()(double T_htf
 	// Solve TES for *full* charge
 	double T_htf_tes_cold, m_dot_tes;
 	T_htf_tes_cold = m_dot_tes = std::numeric_limits<double>::quiet_NaN();
-	mpc_csp_solver->mc_tes.charge_full(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
+	mpc_csp_solver->tes_charge_full(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
 		mpc_csp_solver->mc_weather.ms_outputs.m_tdry + 273.15,
 		T_htf_rec_hot + 273.15,
 		T_htf_tes_cold,
@@ -1883,6 +1933,8 @@ int C_csp_solver::C_MEQ_cr_df__pc_off__tes_full__T_cold::operator()(double T_htf
 
 int C_csp_solver::C_MEQ_cr_df__pc_off__tes_full__defocus::operator()(double defocus /*-*/, double *diff_m_dot /*-*/)
 {
+	mpc_csp_solver->ms_profile_ts.m_n_eq_calls++;
+
 	C_MEQ_cr_df__pc_off__tes_full__T_cold c_eq(mpc_csp_solver, defocus);
 	C_monotonic_eq_solver c_solver(c_eq);
 
@@ -51,6 +51,9 @@
 
 #include "tcstype.h"
 
+#include <algorithm>
+#include <random>
+
 using namespace std;
 
 static C_csp_reported_outputs::S_output_info S_output_info[] =
@@ -153,6 +156,9 @@ C_csp_trough_collector_receiver::C_csp_trough_collector_receiver()
 	m_mc_bal_cold_per_MW = std::numeric_limits<double>::quiet_NaN();
 	m_mc_bal_sca = std::numeric_limits<double>::quiet_NaN();
 
+	m_use_evac_surrogate = false;
+	m_evac_surrogate_tol = 0.02;
+
 	m_defocus = std::numeric_limits<double>::quiet_NaN();
 	m_latitude = std::numeric_limits<double>::quiet_NaN();
 	m_longitude = std::numeric_limits<double>::quiet_NaN();
@@ -423,6 +429,9 @@ void C_csp_trough_collector_receiver::init(const C_csp_collector_receiver::S_csp
 	init_fieldgeom();
 	// for test end
 
+	if (m_use_evac_surrogate)
+		evac_surrogate_init();
+
 	// Calculate tracking parasitics for when trough is on sun
 	m_W_dot_sca_tracking_nom = m_SCA_drives_elec*(double)(m_nSCA*m_nLoops)/1.E6;	//[MWe]
 
@@ -3801,6 +3810,22 @@ void C_csp_trough_collector_receiver::EvacReceiver(double T_1_in, double m_dot,
 	//outputs
 	double &q_heatloss, double &q_12conv, double &q_34tot, double &c_1ave, double &rho_1ave)
 {
+	double colopteff_tot = m_ColOptEff(ct, sca_num)*m_Dirt_HCE(hn, hv)*m_Shadowing(hn, hv);	//The total optical efficiency
+	double q_opt = m_q_i * colopteff_tot;		//[W/m] Solar irradiation on the receiver per unit length
+
+	if (m_use_evac_surrogate && !single_point &&
+		evac_surrogate(T_1_in, m_dot, T_amb, m_T_sky, v_6, P_6, q_opt, hn, hv, ct, q_heatloss, q_12conv, q_34tot, c_1ave, rho_1ave))
+		return;
+
+	evac_energy_balance(T_1_in, m_dot, T_amb, m_T_sky, v_6, P_6, q_opt, hn, hv, ct, single_point, ncall, time,
+		q_heatloss, q_12conv, q_34tot, c_1ave, rho_1ave);
+}
+
+void C_csp_trough_collector_receiver::evac_energy_balance(double T_1_in, double m_dot, double T_amb, double m_T_sky, double v_6, double P_6, double q_opt,
+	int hn /*HCE number [0..3] */, int hv /* HCE variant [0..3] */, int ct /*Collector type*/, bool single_point, int ncall, double time,
+	//outputs
+	double &q_heatloss, double &q_12conv, double &q_34tot, double &c_1ave, double &rho_1ave)
+{
 
 	//cc -- note that collector/hce geometry is part of the parent class. Only the indices specifying the
 	//		number of the HCE and collector need to be passed here.
@@ -3816,7 +3841,7 @@ void C_csp_trough_collector_receiver::EvacReceiver(double T_1_in, double m_dot,
 	bool UPFLAG, LOWFLAG, T3upflag, T3lowflag, is_e_table;
 	int m_qq, q5_iter, T1_iter, q_conv_iter;
 
-	double T_save_tot, colopteff_tot;
+	double T_save_tot;
 	
 	//cc--> note that xx and yy have size 'nea'
 
@@ -3915,17 +3940,15 @@ lab_keep_guess:
 	k_45 = 1.04;                             //[W/m-K]  Conductivity of glass
 	R_45cond = log(m_D_5(hn, hv) / m_D_4(hn, hv)) / (2.*CSP::pi*k_45);    //[K-m/W]Equation of thermal resistance for conduction through a cylinder
 
-	colopteff_tot = m_ColOptEff(ct, sca_num)*m_Dirt_HCE(hn, hv)*m_Shadowing(hn, hv);	//The total optical efficiency
-
 	if (m_GlazingIntact(hn, hv)){   //These calculations (q_3SolAbs,q_5solAbs) are not dependent on temperature, so only need to be computed once per call to subroutine
 
-		q_3SolAbs = m_q_i * colopteff_tot * m_Tau_envelope.at(hn, hv) * m_alpha_abs.at(hn, hv);  //[W/m]  
+		q_3SolAbs = q_opt * m_Tau_envelope.at(hn, hv) * m_alpha_abs.at(hn, hv);  //[W/m]  
 		//We must account for the radiation absorbed as it passes through the envelope
-		q_5solabs = m_q_i * colopteff_tot * m_alpha_env(hn, hv);   //[W/m]  
+		q_5solabs = q_opt * m_alpha_env(hn, hv);   //[W/m]  
 	}
 	else{
 		//Calculate the absorbed energy 
-		q_3SolAbs = m_q_i * colopteff_tot * m_alpha_abs(hn, hv);  //[W/m]  
+		q_3SolAbs = q_opt * m_alpha_abs(hn, hv);  //[W/m]  
 		//No envelope
 		q_5solabs = 0.0;                            //[W/m]
 
@@ -4285,6 +4308,231 @@ lab_keep_guess:
 
 };
 
+/*
+Builds the receiver heat loss tables used by EvacReceiver when m_use_evac_surrogate is set. There is one table for each
+HCE type, variant, and collector type in the loop, over the difference between the average HTF and ambient temperatures,
+loop mass flow rate, optical flux on the receiver, ambient temperature, sky temperature depression, wind speed, and
+ambient pressure. Each table is checked against the receiver energy balance at random points, and a table that misses
+m_evac_surrogate_tol is not used.
+*/
+void C_csp_trough_collector_receiver::evac_surrogate_init()
+{
+	mv_evac_tables.clear();
+	mv_evac_table_index.assign(m_nHCEt*m_nHCEVar*m_nColt, -1);
+
+	// The energy balance updates the guess values, so put them back for the first timestep
+	double T_save[5];
+	for (int i = 0; i < 5; i++)
+		T_save[i] = m_T_save[i];
+	std::vector<double> reguess_args = mv_reguess_args;
+
+	double T_low = min(m_T_fp, m_T_loop_in_des) - 25.0;		//[K]
+	double T_high = m_T_loop_out_des + 50.0;				//[K]
+	double T_amb_low = 233.15;		//[K]
+	double T_amb_high = 328.15;		//[K]
+	int n_T = max(2, (int)ceil((T_high - T_amb_low - (T_low - T_amb_high)) / 15.0) + 1);
+
+	double max_error_all = 0.0;
+
+	for (int i = 0; i < m_nSCA; i++)
+	{
+		int HT = (int)m_SCAInfoArray(i, 0) - 1;    //[-] HCE type
+		int CT = (int)m_SCAInfoArray(i, 1) - 1;    //[-] Collector type
+
+		for (int j = 0; j < m_nHCEVar; j++)
+		{
+			if (m_HCE_FieldFrac(HT, j) == 0.0 || mv_evac_table_index[(HT*m_nHCEVar + j)*m_nColt + CT] >= 0)
+				continue;
+
+			S_evac_table table;
+			table.hn = HT;
+			table.hv = j;
+			table.ct = CT;
+
+			// Highest optical flux at normal incidence with clean mirrors, with some margin for the incidence angle modifier
+			double q_opt_max = 1.1*1200.0*m_A_aperture[CT] / m_L_actSCA[CT] * m_TrackingError[CT] * m_GeomEffects[CT] *
+				m_Rho_mirror_clean[CT] * m_Error[CT] * m_Dirt_HCE(HT, j) * m_Shadowing(HT, j);	//[W/m]
+
+			// The temperature difference between the absorber and the HTF goes with about 1/m_dot, and forced convection from
+			// the envelope with about the square root of the wind speed. Calm winds use the natural convection correlation,
+			// so those points are left to the energy balance.
+			double ax_min[7] = { T_low - T_amb_high, 1.0 / m_m_dot_htfmax, 0.0, T_amb_low, 0.0, sqrt(0.2), 60000.0 };
+			double ax_max[7] = { T_high - T_amb_low, 1.0 / m_m_dot_htfmin, q_opt_max, T_amb_high, 50.0, sqrt(30.0), 105000.0 };
+			int ax_n[7] = { n_T, 4, 4, 4, 3, 7, 2 };
+			for (int k = 0; k < 7; k++)
+			{
+				table.axes[k].resize(ax_n[k]);
+				for (int m = 0; m < ax_n[k]; m++)
+					table.axes[k][m] = ax_min[k] + (ax_max[k] - ax_min[k])*(double)m / (double)(ax_n[k] - 1);
+				table.axes[k].back() = ax_max[k];
+			}
+
+			size_t n_points = 1;
+			for (int k = 0; k < 7; k++)
+				n_points *= table.axes[k].size();
+			table.q_heatloss.resize(n_points);
+			table.q_34tot.resize(n_points);
+			table.is_valid = m_m_dot_htfmax > m_m_dot_htfmin;
+
+			// Solve the receiver at the average HTF temperature of each point, starting from the solution at the previous point
+			for (size_t p = 0; p < n_points && table.is_valid; p++)
+			{
+				double x[7];
+				size_t rem = p;
+				for (int k = 6; k >= 0; k--)
+				{
+					x[k] = table.axes[k][rem % table.axes[k].size()];
+					rem /= table.axes[k].size();
+				}
+
+				double q_12conv, c_1ave, rho_1ave;
+				evac_energy_balance(x[0] + x[3], 1.0 / x[1], x[3], x[3] - x[4], x[5] * x[5], x[6], x[2], HT, j, CT, true, 9, p == 0 ? 0.0 : 3.0,
+					table.q_heatloss[p], q_12conv, table.q_34tot[p], c_1ave, rho_1ave);
+
+				if (table.q_heatloss[p] != table.q_heatloss[p] || table.q_34tot[p] != table.q_34tot[p])
+					table.is_valid = false;
+			}
+
+			int i_table = (int)mv_evac_tables.size();
+			mv_evac_tables.push_back(table);
+			mv_evac_table_index[(HT*m_nHCEVar + j)*m_nColt + CT] = i_table;
+
+			// Check the table against the energy balance over the HTF inlet temperature at random points
+			std::mt19937 gen(1234 + i_table);
+			std::uniform_real_distribution<double> unit(0.0, 1.0);
+			double max_error = 0.0;
+			for (int n = 0; n < 64 && mv_evac_tables[i_table].is_valid; n++)
+			{
+				double x[7];
+				for (int k = 0; k < 7; k++)
+					x[k] = ax_min[k] + (ax_max[k] - ax_min[k])*unit(gen);
+				double T_htf_in = T_low + (T_high - T_low)*unit(gen);	//[K]
+
+				double m_dot = 1.0 / x[1];	//[kg/s]
+
+				double q_heatloss, q_12conv, q_34tot, c_1ave, rho_1ave;
+				evac_energy_balance(T_htf_in, m_dot, x[3], x[3] - x[4], x[5] * x[5], x[6], x[2], HT, j, CT, false, 9, 0.0,
+					q_heatloss, q_12conv, q_34tot, c_1ave, rho_1ave);
+				double q_heatloss_s, q_12conv_s, q_34tot_s;
+				if (!evac_surrogate(T_htf_in, m_dot, x[3], x[3] - x[4], x[5] * x[5], x[6], x[2], HT, j, CT,
+					q_heatloss_s, q_12conv_s, q_34tot_s, c_1ave, rho_1ave))
+					continue;
+
+				max_error = max(max_error, fabs(q_heatloss_s - q_heatloss) / max(fabs(q_heatloss), 10.0));
+			}
+
+			if (!mv_evac_tables[i_table].is_valid || max_error > m_evac_surrogate_tol)
+			{
+				mv_evac_tables[i_table].is_valid = false;
+				std::string msg = util::format("The receiver heat loss table for HCE type %d variant %d on collector type %d was not used"
+					" because it did not match the receiver energy balance. The heat loss is calculated at each call instead.", HT + 1, j + 1, CT + 1);
+				mc_csp_messages.add_message(C_csp_messages::WARNING, msg);
+			}
+			else
+				max_error_all = max(max_error_all, max_error);
+		}
+	}
+
+	int n_valid = 0;
+	for (size_t k = 0; k < mv_evac_tables.size(); k++)
+		n_valid += mv_evac_tables[k].is_valid ? 1 : 0;
+	if (n_valid > 0)
+	{
+		std::string msg = util::format("Receiver heat losses are interpolated from %d tables with a maximum relative error of %lg at the validation points.",
+			n_valid, max_error_all);
+		mc_csp_messages.add_message(C_csp_messages::NOTICE, msg);
+	}
+
+	for (int i = 0; i < 5; i++)
+		m_T_save[i] = T_save[i];
+	mv_reguess_args = reguess_args;
+}
+
+/*
+Interpolates the receiver heat losses from the table for the HCE type, variant, and collector type, iterating with the
+energy balance on the HTF for the average HTF temperature. Returns false, without setting the outputs, if there is no
+valid table or the point is outside the table.
+*/
+bool C_csp_trough_collector_receiver::evac_surrogate(double T_1_in, double m_dot, double T_amb, double m_T_sky, double v_6, double P_6, double q_opt,
+	int hn, int hv, int ct,
+	//outputs
+	double &q_heatloss, double &q_12conv, double &q_34tot, double &c_1ave, double &rho_1ave)
+{
+	if (mv_evac_table_index.empty())
+		return false;
+	int i_table = mv_evac_table_index[(hn*m_nHCEVar + hv)*m_nColt + ct];
+	if (i_table < 0 || !mv_evac_tables[i_table].is_valid)
+		return false;
+	const S_evac_table &table = mv_evac_tables[i_table];
+
+	double x[7] = { T_1_in - T_amb, 1.0 / m_dot, q_opt, T_amb, T_amb - m_T_sky, sqrt(v_6), P_6 };
+	size_t i_low[7], stride[7];
+	double f[7];
+	size_t n_stride = 1;
+	for (int k = 6; k >= 0; k--)
+	{
+		stride[k] = n_stride;
+		n_stride *= table.axes[k].size();
+	}
+
+	double q_3SolAbs;
+	if (m_GlazingIntact(hn, hv))
+		q_3SolAbs = q_opt * m_Tau_envelope.at(hn, hv) * m_alpha_abs.at(hn, hv);	//[W/m]
+	else
+		q_3SolAbs = q_opt * m_alpha_abs(hn, hv);	//[W/m]
+
+	double T_1_ave = T_1_in;		//[K]
+	double T_1_out = T_1_in;		//[K]
+	double cp_1 = std::numeric_limits<double>::quiet_NaN();
+	double diff_T1 = 1.0;
+	for (int T1_iter = 0; fabs(diff_T1) > 1.0e-5 && T1_iter < 100; T1_iter++)
+	{
+		// Only the HTF temperature changes between iterations
+		x[0] = T_1_ave - T_amb;
+		for (int k = (T1_iter == 0 ? 6 : 0); k >= 0; k--)
+		{
+			const std::vector<double> &ax = table.axes[k];
+			// The comparisons are false for NaN, so those points are also outside the table
+			if (!(x[k] >= ax.front() && x[k] <= ax.back()))
+				return false;
+			size_t i = std::upper_bound(ax.begin(), ax.end(), x[k]) - ax.begin();
+			i_low[k] = min(max(i, (size_t)1), ax.size() - 1) - 1;
+			f[k] = (x[k] - ax[i_low[k]]) / (ax[i_low[k] + 1] - ax[i_low[k]]);
+		}
+
+		// Multilinear interpolation from the corners of the cell
+		q_heatloss = 0.0;
+		q_34tot = 0.0;
+		for (int c = 0; c < (1 << 7); c++)
+		{
+			double w = 1.0;
+			size_t p = 0;
+			for (int k = 0; k < 7; k++)
+			{
+				int up = (c >> k) & 1;
+				w *= up ? f[k] : 1.0 - f[k];
+				p += (i_low[k] + up)*stride[k];
+			}
+			if (w == 0.0)
+				continue;
+			q_heatloss += w*table.q_heatloss[p];		//[W/m]
+			q_34tot += w*table.q_34tot[p];				//[W/m]
+		}
+
+		q_12conv = q_3SolAbs - q_heatloss;		//[W/m]
+		cp_1 = m_htfProps.Cp(T_1_ave)*1000.;	//[J/kg-K]
+		double T_1_out1 = max(m_T_sky, q_12conv * m_L_actSCA[ct] / (m_dot*cp_1) + T_1_in);	//[K]
+		diff_T1 = (T_1_out - T_1_out1) / T_1_out1;
+		T_1_out = T_1_out1;
+		T_1_ave = (T_1_out + T_1_in) / 2.0;
+	}
+
+	c_1ave = cp_1 / 1000.;						//[kJ/kg-K]
+	rho_1ave = m_htfProps.dens(T_1_ave, 0.0);	//[kg/m^3]
+
+	return true;
+}
+
 
 /*
 #################################################################################################################
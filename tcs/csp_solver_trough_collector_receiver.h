@@ -308,6 +308,19 @@ private:
 	// Member variables that are used to store information for the EvacReceiver method
 	double m_T_save[5];			//[K] Saved temperatures from previous call to EvacReceiver single SCA energy balance model
 	std::vector<double> mv_reguess_args;	//[-] Logic to determine whether to use previous guess values or start iteration fresh
+
+	// Receiver heat loss tables for the EvacReceiver surrogate, one for each HCE type, variant, and collector type in the loop
+	struct S_evac_table
+	{
+		int hn, hv, ct;
+		// T_htf_ave - T_amb [K], 1/m_dot_loop [s/kg], optical flux on the receiver [W/m], T_amb [K], T_amb - T_sky [K], sqrt(wind speed) [(m/s)^0.5], P_amb [Pa]
+		std::vector<double> axes[7];
+		std::vector<double> q_heatloss;		//[W/m] Total thermal losses at each grid point
+		std::vector<double> q_34tot;		//[W/m] Thermal losses from the absorber surface at each grid point
+		bool is_valid;
+	};
+	std::vector<S_evac_table> mv_evac_tables;
+	std::vector<int> mv_evac_table_index;	//[-] Table for each HCE type, variant, and collector type, or -1
 	
 	// member string for exception messages
 	std::string m_error_msg;
@@ -375,6 +388,9 @@ public:
 	double m_mc_bal_cold_per_MW;	//[kWht/K-MWt] The heat capacity per MWt design of the balance of plant on the cold side
 	double m_mc_bal_sca;		//[Wht/K-m] Non-HTF heat capacity associated with each SCA - per meter basis
 
+	bool m_use_evac_surrogate;		//[-] Interpolate receiver heat losses from tables built in init() instead of solving the receiver energy balance at each call
+	double m_evac_surrogate_tol;	//[-] Maximum error in receiver heat loss at the validation points, relative to the larger of the heat loss and 10 W/m, for a table to be used
+
 	std::vector<double> m_W_aperture;	//[m] The collector aperture width (Total structural area.. used for shadowing)
 	std::vector<double> m_A_aperture;	//[m^2] Reflective aperture area of the collector
 	std::vector<double> m_TrackingError;//[-] Tracking error derate
@@ -646,6 +662,15 @@ public:
 		int hn /*HCE number [0..3] */, int hv /* HCE variant [0..3] */, int ct /*Collector type*/, int sca_num, bool single_point, int ncall, double time,
 		//outputs
 		double &q_heatloss, double &q_12conv, double &q_34tot, double &c_1ave, double &rho_1ave);
+	void evac_energy_balance(double T_1_in, double m_dot, double T_amb, double m_T_sky, double v_6, double P_6, double q_opt /*W/m*/,
+		int hn, int hv, int ct, bool single_point, int ncall, double time,
+		//outputs
+		double &q_heatloss, double &q_12conv, double &q_34tot, double &c_1ave, double &rho_1ave);
+	void evac_surrogate_init();
+	bool evac_surrogate(double T_1_in, double m_dot, double T_amb, double m_T_sky, double v_6, double P_6, double q_opt /*W/m*/,
+		int hn, int hv, int ct,
+		//outputs
+		double &q_heatloss, double &q_12conv, double &q_34tot, double &c_1ave, double &rho_1ave);
 	double fT_2(double q_12conv, double T_1, double T_2g, double m_v_1, int hn, int hv);
 	void FQ_34CONV(double T_3, double T_4, double P_6, double v_6, double T_6, int hn, int hv, double &q_34conv, double &h_34);
 	void FQ_56CONV(double T_5, double T_6, double P_6, double v_6, int hn, int hv, double &q_56conv, double &h_6);
@@ -81,7 +81,8 @@ void C_csp_reported_outputs::C_output::set_m_is_ts_weighted(int subts_weight_typ
 
 	if( !(m_subts_weight_type == TS_WEIGHTED_AVE ||
 		  m_subts_weight_type == TS_1ST ||
-		  m_subts_weight_type == TS_LAST) )
+		  m_subts_weight_type == TS_LAST ||
+		  m_subts_weight_type == TS_SUM) )
 	{
 		throw(C_csp_exception("C_csp_reported_outputs::C_output::send_to_reporting_ts_array did not recognize subtimestep weighting type"));
 	}
@@ -146,6 +147,20 @@ void C_csp_reported_outputs::C_output::send_to_reporting_ts_array(double report_
 			// ************************************************************
 			mp_reporting_ts_array[m_counter_reporting_ts_array] = (float)mv_temp_outputs[n_report - 1];
 		}
+		else if (m_subts_weight_type == TS_SUM)
+		{	// ************************************************************
+			// Set counting outputs that are reported as the sum of the csp-timesteps
+			//   that end in the reporting timestep. A csp-timestep that ends after
+			//   the reporting timestep is saved and counted in the next one
+			// ************************************************************
+			double sum = 0.0;
+			for( int i = 0; i < n_report; i++ )
+			{
+				if( v_temp_ts_time_end[i] <= report_time_end )
+					sum += mv_temp_outputs[i];
+			}
+			mp_reporting_ts_array[m_counter_reporting_ts_array] = (float)sum;
+		}
 		else
 		{
 			throw(C_csp_exception("C_csp_reported_outputs::C_output::send_to_reporting_ts_array did not recognize subtimestep weighting type"));
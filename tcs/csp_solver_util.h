@@ -64,7 +64,8 @@ public:
 	{
 		TS_WEIGHTED_AVE,
 		TS_1ST,
-		TS_LAST
+		TS_LAST,
+		TS_SUM
 	};
 
 	class C_output
@@ -76,7 +77,7 @@ public:
 
 		bool m_is_allocated;		// True = memory allocated for array. False = no memory allocated, won't write outputs
 		
-		int m_subts_weight_type;	// 0: timestep-weighted average, 1: Take first piont in mv_temp_outputs, 2: Take final point in mv_temp_outupts
+		int m_subts_weight_type;	// 0: timestep-weighted average, 1: Take first piont in mv_temp_outputs, 2: Take final point in mv_temp_outupts, 3: Sum of csp-timesteps ending in reporting timestep
 		//bool m_is_ts_weighted;		// True = timestep-weighted average of mv_temp_outputs, False = take first point in mv_temp_outputs
 		
 		int m_counter_reporting_ts_array;	//[-] Tracking current location of reporting array
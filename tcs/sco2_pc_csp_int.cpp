@@ -81,12 +81,33 @@ C_sco2_recomp_csp::C_sco2_recomp_csp()
 
 	mf_callback_update = 0;		// NULL
 	mp_mf_update = 0;			// NULL
+
+	mpc_sco2_cycle = 0;			// NULL, set by 'design_core'
+}
+
+C_sco2_recomp_csp::C_sco2_recomp_csp(const C_sco2_recomp_csp &rhs) :
+	mf_callback_update(rhs.mf_callback_update), mp_mf_update(rhs.mp_mf_update), mc_messages(rhs.mc_messages),
+	mpc_sco2_cycle(0), mc_rc_cycle(rhs.mc_rc_cycle), mc_phx(rhs.mc_phx), mc_partialcooling_cycle(rhs.mc_partialcooling_cycle),
+	ms_des_par(rhs.ms_des_par), ms_cycle_des_par(rhs.ms_cycle_des_par), ms_phx_des_par(rhs.ms_phx_des_par),
+	ms_des_solved(rhs.ms_des_solved),
+	ms_od_par(rhs.ms_od_par), ms_cycle_od_par(rhs.ms_cycle_od_par), ms_phx_od_par(rhs.ms_phx_od_par),
+	ms_od_solved(rhs.ms_od_solved),
+	m_od_opt_objective(rhs.m_od_opt_objective), m_od_opt_ftol(rhs.m_od_opt_ftol), m_od_opt_xtol(rhs.m_od_opt_xtol),
+	m_nlopt_iter(rhs.m_nlopt_iter), m_off_design_turbo_operation(rhs.m_off_design_turbo_operation),
+	m_T_mc_in_min(rhs.m_T_mc_in_min), m_T_co2_crit(rhs.m_T_co2_crit), m_P_co2_crit(rhs.m_P_co2_crit)
+{
+	// Point to this object's copy of the cycle selected by 'design_core'
+	if (rhs.mpc_sco2_cycle == &rhs.mc_partialcooling_cycle)
+		mpc_sco2_cycle = &mc_partialcooling_cycle;
+	else if (rhs.mpc_sco2_cycle == &rhs.mc_rc_cycle)
+		mpc_sco2_cycle = &mc_rc_cycle;
 }
 
 void C_sco2_recomp_csp::design(S_des_par des_par)
 {
 	ms_des_par = des_par;
 
+	CO2_backend_scope co2_backend(ms_des_par.m_co2_backend);
 	design_core();
 }
 
@@ -273,6 +294,8 @@ void C_sco2_recomp_csp::design_core()
 
 int C_sco2_recomp_csp::off_design_fix_P_mc_in(S_od_par od_par, double P_mc_in /*MPa*/, int off_design_strategy, double od_opt_tol)
 {
+	CO2_backend_scope co2_backend(ms_des_par.m_co2_backend);
+
 	setup_off_design_info(od_par, off_design_strategy, od_opt_tol);
 	
 	// Now, call off-design with the optimized compressor inlet pressure		
@@ -357,6 +380,9 @@ void C_sco2_recomp_csp::setup_off_design_info(C_sco2_recomp_csp::S_od_par od_par
 
 int C_sco2_recomp_csp::optimize_off_design(C_sco2_recomp_csp::S_od_par od_par, int off_design_strategy, double od_opt_tol)
 {
+	// also sets the backend of the threads that generate the off-design tables
+	CO2_backend_scope co2_backend(ms_des_par.m_co2_backend);
+
 	// This sets: T_mc_in, T_pc_in, etc.
 	setup_off_design_info(od_par, off_design_strategy, od_opt_tol);
 
@@ -1111,6 +1137,8 @@ int C_sco2_recomp_csp::off_design_core(double & eta_solved)
 
 int C_sco2_recomp_csp::off_design(S_od_par od_par, S_od_operation_inputs od_op_inputs)
 {
+	CO2_backend_scope co2_backend(ms_des_par.m_co2_backend);
+
 	setup_off_design_info(od_par, -1, 1.E-3);
 
 		// Setting pressure, here
@@ -1236,16 +1264,32 @@ int C_sco2_recomp_csp::C_sco2_csp_od::operator()(S_f_inputs inputs, S_f_outputs
 	return off_design_code;
 }
 
+C_od_pc_function * C_sco2_recomp_csp::C_sco2_csp_od::clone() const
+{
+	// The partial cooling cycle starts its off-design solution from the last solved temperatures,
+	// so its table points must run in order on the original cycle
+	if (mpc_sco2_rc->mpc_sco2_cycle != &mpc_sco2_rc->mc_rc_cycle)
+		return 0;	// = NULL
+
+	C_sco2_csp_od *p_clone = new C_sco2_csp_od(0);
+	p_clone->mp_sco2_rc_copy.reset(new C_sco2_recomp_csp(*mpc_sco2_rc));
+	p_clone->mpc_sco2_rc = p_clone->mp_sco2_rc_copy.get();
+
+	return p_clone;
+}
+
 int C_sco2_recomp_csp::generate_ud_pc_tables(double T_htf_low /*C*/, double T_htf_high /*C*/, int n_T_htf /*-*/,
 	double T_amb_low /*C*/, double T_amb_high /*C*/, int n_T_amb /*-*/,
 	double m_dot_htf_ND_low /*-*/, double m_dot_htf_ND_high /*-*/, int n_m_dot_htf_ND,
-	util::matrix_t<double> & T_htf_ind, util::matrix_t<double> & T_amb_ind, util::matrix_t<double> & m_dot_htf_ND_ind)
+	util::matrix_t<double> & T_htf_ind, util::matrix_t<double> & T_amb_ind, util::matrix_t<double> & m_dot_htf_ND_ind,
+	int n_threads)
 {
 	C_sco2_csp_od c_sco2_csp(this);
 	C_ud_pc_table_generator c_sco2_ud_pc(c_sco2_csp);
 
 	c_sco2_ud_pc.mf_callback = mf_callback_update;
 	c_sco2_ud_pc.mp_mf_active = mp_mf_update;
+	c_sco2_ud_pc.m_n_threads = n_threads;
 
 	double T_htf_ref = ms_des_par.m_T_htf_hot_in - 273.15;	//[C] convert from K
 	double T_amb_ref = ms_des_par.m_T_amb_des - 273.15;		//[C] convert from K
@@ -56,6 +56,7 @@
 #include "sco2_cycle_templates.h"
 
 #include "heat_exchangers.h"
+#include "CO2_properties.h"
 #include "csp_solver_util.h"
 
 #include "numeric_solvers.h"
@@ -63,6 +64,7 @@
 #include "ud_power_cycle.h"
 
 #include <iosfwd>
+#include <memory>
 
 class C_sco2_recomp_csp
 {
@@ -118,6 +120,8 @@ public:
 		bool m_is_des_air_cooler;		//[-] False will skip physical air cooler design. UA will not be available for cost models.
 		double m_frac_fan_power;		//[-] Fraction of total cycle power 'S_des_par_cycle_dep.m_W_dot_fan_des' consumed by air fan
 		double m_deltaP_cooler_frac;    // [-] Fraction of high side (of cycle, i.e. comp outlet) pressure that is allowed as pressure drop to design the ACC
+
+		int m_co2_backend;				//[-] CO2 property backend for the design and off-design calculations of this cycle, CO2_BACKEND_EOS or CO2_BACKEND_TABLES
 	
 		S_des_par()
 		{
@@ -148,6 +152,8 @@ public:
 	
 			m_fixed_PR_mc = false;		//[-] If false, then should default to optimizing this parameter
 			m_fixed_P_mc_out = false;	//[-] If fasle, then should default to optimizing this parameter
+
+			m_co2_backend = CO2_BACKEND_EOS;
 		}
 	};
 
@@ -270,6 +276,12 @@ public:
 
 	C_sco2_recomp_csp();
 
+	// Copies the design and the current off-design state. The copy points to its own cycle model
+	// and can run off-design calculations on another thread independently of the original
+	C_sco2_recomp_csp(const C_sco2_recomp_csp &rhs);
+
+	C_sco2_recomp_csp & operator=(const C_sco2_recomp_csp &rhs) = delete;
+
 	~C_sco2_recomp_csp(){};
 
 	class C_mono_eq_T_t_in : public C_monotonic_equation
@@ -291,6 +303,8 @@ public:
 	private:
 		C_sco2_recomp_csp *mpc_sco2_rc;
 
+		std::unique_ptr<C_sco2_recomp_csp> mp_sco2_rc_copy;	// Cycle owned by a clone
+
 	public:
 		C_sco2_csp_od(C_sco2_recomp_csp *pc_sco2_rc)
 		{
@@ -298,12 +312,17 @@ public:
 		}
 	
 		virtual int operator()(S_f_inputs inputs, S_f_outputs & outputs);
+
+		virtual C_od_pc_function * clone() const;
 	};
 
+	// n_threads: number of threads used to evaluate the table points, 0 = all hardware threads.
+	//    The partial cooling cycle always runs the points in order on one thread
 	int generate_ud_pc_tables(double T_htf_low /*C*/, double T_htf_high /*C*/, int n_T_htf /*-*/,
 		double T_amb_low /*C*/, double T_amb_high /*C*/, int n_T_amb /*-*/,
 		double m_dot_htf_ND_low /*-*/, double m_dot_htf_ND_high /*-*/, int n_m_dot_htf_ND,
-		util::matrix_t<double> & T_htf_ind, util::matrix_t<double> & T_amb_ind, util::matrix_t<double> & m_dot_htf_ND_ind);
+		util::matrix_t<double> & T_htf_ind, util::matrix_t<double> & T_amb_ind, util::matrix_t<double> & m_dot_htf_ND_ind,
+		int n_threads = 0);
 
 	void design(S_des_par des_par);
 
@@ -59,6 +59,7 @@
 #include <limits>
 #include <iostream>
 #include <algorithm>
+#include <chrono>
 
 #include "tcskernel.h"
 
@@ -471,6 +472,7 @@ tcskernel::tcskernel( tcstypeprovider *prov )
 	m_timeStep = 0;
 	m_startTime = 0;
 	m_endTime = 0;
+	m_numMustCall = 0;
 }
 
 tcskernel::~tcskernel()
@@ -763,6 +765,8 @@ int tcskernel::add_unit( const std::string &type, const std::string &name )
 	u.name = name;
 	u.type = t;
 	u.instance = 0;
+	u.totalcalls = 0;
+	u.totaltime = 0;
 	
 	u.context.kernel_internal = this;
 	u.context.unit_internal = id;
@@ -857,6 +861,10 @@ bool tcskernel::connect( int unit1, int output,
 		if ( list[i].target_unit == unit2 && list[i].target_index == input )
 			return true; // already exists, so return success
 	
+	// values with connections are listed in variable order for 'propagate'
+	if ( list.empty() )
+		u1.linked.insert( std::lower_bound( u1.linked.begin(), u1.linked.end(), output ), output );
+
 	// add a new connection
 	connection c;
 	c.target_unit = unit2;
@@ -932,6 +940,108 @@ void tcskernel::free_instances()
 	}
 }
 
+void tcskernel::mark_for_call( int unit )
+{
+	if ( !m_units[unit].mustcall )
+	{
+		m_units[unit].mustcall = true;
+		m_numMustCall++;
+	}
+}
+
+bool tcskernel::propagate( size_t i, bool unset_inputs_only )
+{
+	// check the values of the unit that have connections
+	// to other units to see if their inputs need to be updated
+	for (size_t l=0;l<m_units[i].linked.size();l++)
+	{
+		// reference current output value
+		int j = m_units[i].linked[l];
+		tcsvalue *val1 = &m_units[i].values[j];
+		
+		// go through each connection attached to this output
+		for (size_t k=0;k<m_units[i].conn[j].size();k++)
+		{
+			connection &c = m_units[i].conn[j][k];
+			tcsvalue *val2 = &m_units[c.target_unit].values[c.target_index];
+
+			// before the first timestep, only inputs that were never set take values from their connections
+			if ( unset_inputs_only && !(val2->type == TCS_NUMBER && val2->data.value == -999) )
+				continue;
+			
+			// check that 'val2' and 'val1' are
+			// within tolerances of one another
+			
+			if ( val1->type == TCS_NUMBER 
+				&& val2->type == TCS_NUMBER)
+			{
+				if ( !check_tolerance( val1->data.value, val2->data.value, c.ftol ) )
+				{
+					// mark units for recalculation and propagate new output value to input									
+					val2->data.value = val1->data.value;									
+					mark_for_call( c.target_unit );
+				}
+			}
+			else if ( val1->type == TCS_ARRAY
+				&& val2->type == TCS_NUMBER
+				&& c.arridx >= 0 && c.arridx < (int)val1->data.array.length )
+			{
+				if ( !check_tolerance( val1->data.array.values[c.arridx], val2->data.value, c.ftol ))
+				{
+					val2->data.value = val1->data.array.values[c.arridx];
+					mark_for_call( c.target_unit );
+				}
+			}
+			else if ( val1->type == TCS_ARRAY && val2->type == TCS_ARRAY
+				 && val1->data.array.length == val2->data.array.length )
+			{
+				int len = val1->data.array.length;
+				bool pass = true;
+				for ( int m=0;m<len;m++ )
+					pass = pass && check_tolerance( val1->data.array.values[m],
+						val2->data.array.values[m], c.ftol );
+				
+				if ( !pass )
+				{
+					// propagate values and mark for recalculation
+					for ( int m=0;m<len;m++ )
+						val2->data.array.values[m] = val1->data.array.values[m];
+					mark_for_call( c.target_unit );
+				}
+			}
+			else if ( val1->type == TCS_MATRIX && val2->type == TCS_MATRIX
+				&& val1->data.matrix.nrows == val2->data.matrix.nrows
+				&& val1->data.matrix.ncols == val2->data.matrix.ncols )
+			{
+				int len = val1->data.matrix.nrows * val1->data.matrix.ncols;
+				bool pass = true;
+				for ( int m=0;m<len;m++ )
+					pass = pass && check_tolerance( val1->data.matrix.values[m],
+						val2->data.matrix.values[m], c.ftol );
+				
+				if ( !pass )
+				{
+					// propagate values and mark for recalculation
+					for ( int m=0;m<len;m++ )
+						val2->data.matrix.values[m] = val1->data.matrix.values[m];
+					mark_for_call( c.target_unit );
+				}
+			}
+			else
+			{
+				// type mismatch,
+				// dimension mismatch,
+				// or cannot compare strings for convergence
+				message( TCS_ERROR, "kernel could not check connection between [%d,%d] and [%d,%d]: type mismatch, dimension mismatch, or invalid type connection",
+					(int)i, j, c.target_unit, c.target_index);
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
 int tcskernel::solve( double time, double step )
 {
 	// must call each unit at least once each timestep
@@ -940,10 +1050,14 @@ int tcskernel::solve( double time, double step )
 		m_units[i].ncall = 0;
 		m_units[i].mustcall = true;
 	}
+	m_numMustCall = m_units.size();
 	
+	// units are called in the order they were added, and again only when
+	// a connected input changed beyond its tolerance.  the order is kept
+	// rather than sorted by connection since the sequence of calls 
+	// determines the converged values
 	int iterations = 0;
-	bool converged = false;		
-	while( !converged )
+	while( m_numMustCall > 0 )
 	{
 		if (iterations++ >= m_maxIterations )
 		{
@@ -959,10 +1073,7 @@ int tcskernel::solve( double time, double step )
 			if ( !m_units[i].mustcall )
 				continue;
 
-			/*if ( m_units[i].ncall > 0 )
-			{
-				notice( "@ time %.2lf, iteration %d for unit %d\n", time, m_units[i].ncall, i );
-			}*/
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
 
 			if ( m_units[i].type->invoke( &m_units[i].context, m_units[i].instance, TCS_INVOKE,
 					&m_units[i].values[0], (unsigned int)m_units[i].values.size(),
@@ -973,101 +1084,18 @@ int tcskernel::solve( double time, double step )
 				return -2;
 			}
 			
+			m_units[i].totaltime += std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+			m_units[i].totalcalls++;
 			m_units[i].mustcall = false;
+			m_numMustCall--;
 			m_units[i].ncall++;
 			
-			// check all values of the current unit
-			// for connections to other units to see if their 
-			// inputs need to be updated
-			for (size_t j=0;j<m_units[i].values.size();j++)
-			{
-				// reference current output value
-				tcsvalue *val1 = &m_units[i].values[j];
-				
-				// go through each connection attached to this output
-				for (size_t k=0;k<m_units[i].conn[j].size();k++)
-				{
-					connection &c = m_units[i].conn[j][k];
-					tcsvalue *val2 = &m_units[c.target_unit].values[c.target_index];
-					
-					// check that 'val2' and 'val1' are
-					// within tolerances of one another
-					
-					if ( val1->type == TCS_NUMBER 
-						&& val2->type == TCS_NUMBER)
-					{
-						if ( !check_tolerance( val1->data.value, val2->data.value, c.ftol ) )
-						{
-							// mark units for recalculation and propagate new output value to input									
-							val2->data.value = val1->data.value;									
-							m_units[c.target_unit].mustcall = true;
-						}
-					}
-					else if ( val1->type == TCS_ARRAY
-						&& val2->type == TCS_NUMBER
-						&& c.arridx >= 0 && c.arridx < (int)val1->data.array.length )
-					{
-						if ( !check_tolerance( val1->data.array.values[c.arridx], val2->data.value, c.ftol ))
-						{
-							val2->data.value = val1->data.array.values[c.arridx];
-							m_units[c.target_unit].mustcall = true;
-						}
-					}
-					else if ( val1->type == TCS_ARRAY && val2->type == TCS_ARRAY
-						 && val1->data.array.length == val2->data.array.length )
-					{
-						int len = val1->data.array.length;
-						bool pass = true;
-						for ( int m=0;m<len;m++ )
-							pass = pass && check_tolerance( val1->data.array.values[m],
-								val2->data.array.values[m], c.ftol );
-						
-						if ( !pass )
-						{
-							// propagate values and mark for recalculation
-							for ( int m=0;m<len;m++ )
-								val2->data.array.values[m] = val1->data.array.values[m];
-							m_units[c.target_unit].mustcall = true;									
-						}
-					}
-					else if ( val1->type == TCS_MATRIX && val2->type == TCS_MATRIX
-						&& val1->data.matrix.nrows == val2->data.matrix.nrows
-						&& val1->data.matrix.ncols == val2->data.matrix.ncols )
-					{
-						int len = val1->data.matrix.nrows * val1->data.matrix.ncols;
-						bool pass = true;
-						for ( int m=0;m<len;m++ )
-							pass = pass && check_tolerance( val1->data.matrix.values[m],
-								val2->data.matrix.values[m], c.ftol );
-						
-						if ( !pass )
-						{
-							// propagate values and mark for recalculation
-							for ( int m=0;m<len;m++ )
-								val2->data.matrix.values[m] = val1->data.matrix.values[m];
-							m_units[c.target_unit].mustcall = true;	
-						}
-					}
-					else
-					{
-						// type mismatch,
-						// dimension mismatch,
-						// or cannot compare strings for convergence
-						message( TCS_ERROR, "kernel could not check connection between [%d,%d] and [%d,%d]: type mismatch, dimension mismatch, or invalid type connection",
-							i, j, c.target_unit, c.target_index);
-						return -3;						
-					}
-				}
-			} // loop over all output connections, checking for output->input propagations
+			// propagate outputs to connected inputs, marking those 
+			// units for recalculation if the inputs changed
+			if ( !propagate( i, false ) )
+				return -3;
 			
 		} // loop over all units, invoke each if needed, check outputs etc
-		
-		// check if any units still need to be called
-		// if not, then all of them have converged
-		converged = true;
-		for (size_t i=0;i<m_units.size();i++)
-			if (m_units[i].mustcall)
-				converged = false;			
 				
 	} // while loop for convergence at this timestep
 	
@@ -1104,6 +1132,13 @@ int tcskernel::simulate( double start, double end, double step )
 	m_timeStep = step;
 	
 	create_instances(); // allows types to define local storage classes
+
+	// reset call statistics
+	for (size_t i=0;i<m_units.size();i++)
+	{
+		m_units[i].totalcalls = 0;
+		m_units[i].totaltime = 0;
+	}
 	
 	// call init on each type to setup arrays, internal data, etc
 	for (size_t i=0;i<m_units.size();i++)
@@ -1124,93 +1159,8 @@ int tcskernel::simulate( double start, double end, double step )
 	
 	for (size_t i = 0; i < m_units.size(); i++)
 	{
-		// check all values of the current unit
-		// for connections to other units to see if their 
-		// inputs need to be updated
-		for (size_t j = 0; j < m_units[i].values.size(); j++)
-		{
-			// reference current output value
-			tcsvalue *val1 = &m_units[i].values[j];
-
-			// go through each connection attached to this output
-			for (size_t k = 0; k < m_units[i].conn[j].size(); k++)
-			{
-				connection &c = m_units[i].conn[j][k];
-				tcsvalue *val2 = &m_units[c.target_unit].values[c.target_index];
-
-				if (val2->type == TCS_NUMBER && val2->data.value == -999)
-				{
-
-					// check that 'val2' and 'val1' are
-					// within tolerances of one another
-
-					if (val1->type == TCS_NUMBER
-						&& val2->type == TCS_NUMBER)
-					{
-						if (!check_tolerance(val1->data.value, val2->data.value, c.ftol))
-						{
-							// mark units for recalculation and propagate new output value to input									
-							val2->data.value = val1->data.value;
-							m_units[c.target_unit].mustcall = true;
-						}
-					}
-					else if (val1->type == TCS_ARRAY
-						&& val2->type == TCS_NUMBER
-						&& c.arridx >= 0 && c.arridx < (int)val1->data.array.length)
-					{
-						if (!check_tolerance(val1->data.array.values[c.arridx], val2->data.value, c.ftol))
-						{
-							val2->data.value = val1->data.array.values[c.arridx];
-							m_units[c.target_unit].mustcall = true;
-						}
-					}
-					else if (val1->type == TCS_ARRAY && val2->type == TCS_ARRAY
-						&& val1->data.array.length == val2->data.array.length)
-					{
-						int len = val1->data.array.length;
-						bool pass = true;
-						for (int m = 0; m < len; m++)
-							pass = pass && check_tolerance(val1->data.array.values[m],
-								val2->data.array.values[m], c.ftol);
-
-						if (!pass)
-						{
-							// propagate values and mark for recalculation
-							for (int m = 0; m < len; m++)
-								val2->data.array.values[m] = val1->data.array.values[m];
-							m_units[c.target_unit].mustcall = true;
-						}
-					}
-					else if (val1->type == TCS_MATRIX && val2->type == TCS_MATRIX
-						&& val1->data.matrix.nrows == val2->data.matrix.nrows
-						&& val1->data.matrix.ncols == val2->data.matrix.ncols)
-					{
-						int len = val1->data.matrix.nrows * val1->data.matrix.ncols;
-						bool pass = true;
-						for (int m = 0; m < len; m++)
-							pass = pass && check_tolerance(val1->data.matrix.values[m],
-								val2->data.matrix.values[m], c.ftol);
-
-						if (!pass)
-						{
-							// propagate values and mark for recalculation
-							for (int m = 0; m < len; m++)
-								val2->data.matrix.values[m] = val1->data.matrix.values[m];
-							m_units[c.target_unit].mustcall = true;
-						}
-					}
-					else
-					{
-						// type mismatch,
-						// dimension mismatch,
-						// or cannot compare strings for convergence
-						message(TCS_ERROR, "kernel could not check connection between [%d,%d] and [%d,%d]: type mismatch, dimension mismatch, or invalid type connection",
-							i, j, c.target_unit, c.target_index);
-						return -3;
-					}
-				}
-			}
-		} // loop over all output connections, checking for output->input propagations
+		if ( !propagate( i, true ) )
+			return -3;
 	}
 
 	for( m_currentTime = m_startTime;
@@ -1253,6 +1203,10 @@ int tcskernel::simulate( double start, double end, double step )
 		}
 		
 	}
+
+	for (size_t i=0;i<m_units.size();i++)
+		message( TCS_NOTICE, "unit %d (%s) type '%s' called %d times in %.3lf s", (int)i, m_units[i].name.c_str(),
+			m_units[i].type->name, m_units[i].totalcalls, m_units[i].totaltime );
 	
 	free_instances();
 	return 0;
@@ -183,8 +183,11 @@ public:
 		tcstypeinfo *type;
 		std::vector<tcsvalue> values;
 		std::vector< std::vector<connection> > conn;
+		std::vector<int> linked; // indices of values with connections, in order, kept by 'connect'
 		int ncall;
 		bool mustcall;
+		int totalcalls; // calls and seconds spent in calls over the simulation
+		double totaltime;
 		void *instance;
 		tcscontext context;
 	};
@@ -192,6 +195,9 @@ public:
 			
 protected:
 	int find_var( int unit, const char *name );
+	void mark_for_call( int unit );
+	bool propagate( size_t unit, bool unset_inputs_only );
+	size_t m_numMustCall;
 	bool m_proceedAnyway;
 	int m_maxIterations;
 	double m_currentTime;
@@ -49,6 +49,10 @@
 
 #include "ud_power_cycle.h"
 #include "csp_solver_util.h"
+#include "lib_parallel.h"
+
+#include <memory>
+#include <mutex>
 
 void C_ud_power_cycle::init(const util::matrix_t<double> & T_htf_ind, double T_htf_ref /*C*/, double T_htf_low /*C*/, double T_htf_high /*C*/,
 	const util::matrix_t<double> & T_amb_ind, double T_amb_ref /*C*/, double T_amb_low /*C*/, double T_amb_high /*C*/,
@@ -378,6 +382,7 @@ C_ud_pc_table_generator::C_ud_pc_table_generator(C_od_pc_function & f_pc_eq) : m
 {
 	mf_callback = 0;		// = NULL
 	mp_mf_active = 0;			// = NULL
+	m_n_threads = 1;
 	m_progress_msg = "Power cycle preprocessing...";
 	m_log_msg = "Log message";
 
@@ -417,6 +422,107 @@ void C_ud_pc_table_generator::send_callback(bool is_od_model_error, int run_numb
 	}
 }
 
+void C_ud_pc_table_generator::run_points(std::vector<S_table_point> & points,
+	util::matrix_t<double> & T_htf_ind, util::matrix_t<double> & T_amb_ind, util::matrix_t<double> & m_dot_htf_ind)
+{
+	util::matrix_t<double> *tables[3] = {&T_htf_ind, &T_amb_ind, &m_dot_htf_ind};
+	int n_points = (int)points.size();
+
+	// If the off-design function can't be copied, its results depend on the points solved before,
+	// so run the points on the function itself in table order, as each point uses the last one's solution.
+	// Otherwise each point runs on its own copy of the function as it was before the first point
+	std::unique_ptr<C_od_pc_function> p_f_check(mf_pc_eq.clone());
+	if( !p_f_check )
+	{
+		for(int k = 0; k < n_points; k++)
+		{
+			points[k].m_off_design_code = mf_pc_eq(points[k].ms_inputs, points[k].ms_outputs);
+			save_point(points[k], k + 1, n_points, *tables[points[k].m_table]);
+		}
+		return;
+	}
+	p_f_check.reset();
+
+	// Results are saved and reported in table order by the calling thread (worker 0)
+	// as soon as all earlier points are finished
+	std::vector<char> is_done(n_points, 0);
+	int n_saved = 0;
+	std::mutex done_lock;
+
+	auto save_finished_points = [&]()
+	{
+		while(true)
+		{
+			{
+				std::lock_guard<std::mutex> lock(done_lock);
+				if(n_saved >= n_points || !is_done[n_saved])
+					return;
+			}
+			save_point(points[n_saved], n_saved + 1, n_points, *tables[points[n_saved].m_table]);
+			n_saved++;
+		}
+	};
+
+	sp_parallel_for(n_points, m_n_threads, 1, [&](int k, int worker)
+	{
+		std::unique_ptr<C_od_pc_function> p_f(mf_pc_eq.clone());
+		points[k].m_off_design_code = (*p_f)(points[k].ms_inputs, points[k].ms_outputs);
+
+		{
+			std::lock_guard<std::mutex> lock(done_lock);
+			is_done[k] = 1;
+		}
+
+		if(worker == 0)
+			save_finished_points();
+	});
+
+	save_finished_points();
+}
+
+void C_ud_pc_table_generator::save_point(const S_table_point & point, int run_number, int n_runs_total, util::matrix_t<double> & table)
+{
+	int i = point.m_i;
+	int j = point.m_j;
+
+	bool is_od_model_error = false;
+
+	if( point.m_off_design_code == 0 )
+	{
+		// Save outputs
+		table(i,1+j) = point.ms_outputs.m_W_dot_gross_ND;		//[-]
+		table(i,4+j) = point.ms_outputs.m_Q_dot_in_ND;			//[-]
+		table(i,7+j) = point.ms_outputs.m_W_dot_cooling_ND;		//[-]
+		table(i,10+j) = point.ms_outputs.m_m_dot_water_ND;		//[-]
+	}
+	else if( point.m_off_design_code == -1 )
+	{
+		// Save 'generic' off design model response
+		table(i, 1 + j) = point.ms_inputs.m_m_dot_htf_ND;		//[-]
+		table(i, 4 + j) = point.ms_inputs.m_m_dot_htf_ND;		//[-]
+		table(i, 7 + j) = point.ms_inputs.m_m_dot_htf_ND;		//[-]
+		table(i, 10 + j) = point.ms_inputs.m_m_dot_htf_ND;		//[-]
+
+		is_od_model_error = true;
+	}
+	else
+	{
+		std::string err_msg;
+		if( point.m_table == E_T_HTF_TABLE )
+			err_msg = util::format("The 1st UDPC table (primary: T_htf, interaction: m_dot_htf_ND) generation failed at T_htf = %lg [C] and m_dot_htf = %lg [-]", point.ms_inputs.m_T_htf_hot, point.ms_inputs.m_m_dot_htf_ND);
+		else if( point.m_table == E_T_AMB_TABLE )
+			err_msg = util::format("The 2nd UDPC table (primary: T_amb, interaction: T_htf) generation failed at T_amb = %lg [C] and T_htf = %lg [C]", point.ms_inputs.m_T_amb, point.ms_inputs.m_T_htf_hot);
+		else
+			err_msg = util::format("The 3rd UDPC table (primary: m_dot_htf_ND, interaction: T_amb) generation failed at T_amb = %lg [C] and m_dot_htf = %lg [-]", point.ms_inputs.m_T_amb, point.ms_inputs.m_m_dot_htf_ND);
+		throw(C_csp_exception(err_msg, "UDPC"));
+	}
+
+	send_callback(is_od_model_error, run_number, n_runs_total,
+		point.ms_inputs.m_T_htf_hot, point.ms_inputs.m_m_dot_htf_ND, point.ms_inputs.m_T_amb,
+		table(i, 1 + j), table(i, 4 + j),
+		table(i, 7 + j), table(i, 10 + j));
+}
+
 int C_ud_pc_table_generator::generate_tables(double T_htf_ref /*C*/, double T_htf_low /*C*/, double T_htf_high /*C*/, int n_T_htf /*-*/,
 	double T_amb_ref /*C*/, double T_amb_low /*C*/, double T_amb_high /*C*/, int n_T_amb /*-*/,
 	double m_dot_htf_ND_ref /*-*/, double m_dot_htf_ND_low /*-*/, double m_dot_htf_ND_high /*-*/, int n_m_dot_htf_ND,
@@ -460,9 +566,6 @@ int C_ud_pc_table_generator::generate_tables(double T_htf_ref /*C*/, double T_ht
 		throw(C_csp_exception(msg, "User defined power cycle, generate tables"));
 	}
 
-	C_od_pc_function::S_f_inputs pc_inputs;
-	C_od_pc_function::S_f_outputs pc_outputs;
-
 	// ******************************************
 	// Setup T_HTF parameteric runs
 	if(n_T_htf < 3)
@@ -477,64 +580,6 @@ int C_ud_pc_table_generator::generate_tables(double T_htf_ref /*C*/, double T_ht
 	T_htf_ind.resize(n_T_htf, 13);		// Set matrix size
 	double delta_T_htf = (T_htf_high - T_htf_low)/double(n_T_htf-1);
 
-	double n_runs_total = 3.0*(n_T_htf + n_T_amb + n_m_dot_htf_ND);
-
-	// Set ambient temperature because it is constant for the HTF temperature parametrics
-	pc_inputs.m_T_amb = T_amb_ref;	//[C]
-	for(int i = 0; i < n_T_htf; i++)
-	{
-		T_htf_ind(i,0) = T_htf_low + delta_T_htf*i;	//[C]
-		pc_inputs.m_T_htf_hot = T_htf_ind(i,0);
-
-		// Call at low, ref, and high ND mass flow rate levels
-		std::vector<double> m_dot_htf_ND_levels(3);
-		m_dot_htf_ND_levels[0] = m_dot_htf_ND_low;
-		m_dot_htf_ND_levels[1] = m_dot_htf_ND_ref;
-		m_dot_htf_ND_levels[2] = m_dot_htf_ND_high;
-		for(int j = 0; j < 3; j++)
-		{
-			bool is_od_model_error = false;
-
-			pc_inputs.m_m_dot_htf_ND = m_dot_htf_ND_levels[j];
-			int off_design_code = mf_pc_eq(pc_inputs,pc_outputs);
-
-			if( off_design_code == 0 )
-			{
-				// Save outputs
-				T_htf_ind(i,1+j) = pc_outputs.m_W_dot_gross_ND;		//[-]
-				T_htf_ind(i,4+j) = pc_outputs.m_Q_dot_in_ND;		//[-]
-				T_htf_ind(i,7+j) = pc_outputs.m_W_dot_cooling_ND;	//[-]
-				T_htf_ind(i,10+j) = pc_outputs.m_m_dot_water_ND;	//[-]
-			}
-			else if (off_design_code == -1)
-			{
-				// Save 'generic' off design model response
-				T_htf_ind(i, 1 + j) = pc_inputs.m_m_dot_htf_ND;		//[-]
-				T_htf_ind(i, 4 + j) = pc_inputs.m_m_dot_htf_ND;		//[-]
-				T_htf_ind(i, 7 + j) = pc_inputs.m_m_dot_htf_ND;		//[-]
-				T_htf_ind(i, 10 + j) = pc_inputs.m_m_dot_htf_ND;	//[-]
-
-				is_od_model_error = true;
-			}
-			else
-			{
-				std::string err_msg = util::format("The 1st UDPC table (primary: T_htf, interaction: m_dot_htf_ND) generation failed at T_htf = %lg [C] and m_dot_htf = %lg [-]", pc_inputs.m_T_htf_hot, pc_inputs.m_m_dot_htf_ND);
-				throw(C_csp_exception(err_msg, "UDPC"));
-			}
-
-			double run_number = i*3 + j;
-
-			send_callback(is_od_model_error, (int)run_number + 1, (int)n_runs_total,
-				pc_inputs.m_T_htf_hot, pc_inputs.m_m_dot_htf_ND, pc_inputs.m_T_amb,
-				T_htf_ind(i, 1 + j), T_htf_ind(i, 4 + j),
-				T_htf_ind(i, 7 + j), T_htf_ind(i, 10 + j));
-
-		}
-
-	}
-	// ******************************************
-
-	// ******************************************
 	// Setup T_amb parametric runs
 	if(n_T_amb < 3)
 	{
@@ -548,60 +593,6 @@ int C_ud_pc_table_generator::generate_tables(double T_htf_ref /*C*/, double T_ht
 	T_amb_ind.resize(n_T_amb, 13);		// Set matrix size
 	double delta_T_amb = (T_amb_high - T_amb_low)/double(n_T_amb-1);
 
-	// Set ND htf mass flow rate because it is constant for the ambient temperature parametrics
-	pc_inputs.m_m_dot_htf_ND = m_dot_htf_ND_ref;
-	for(int i = 0; i < n_T_amb; i++)
-	{
-		T_amb_ind(i,0) = T_amb_low + delta_T_amb*i;		//[C]
-		pc_inputs.m_T_amb = T_amb_ind(i,0);				//[C]
-
-		// Call at low, ref, and high HTF temperature levels
-		std::vector<double> T_htf_levels(3);
-		T_htf_levels[0] = T_htf_low;   //[C]
-		T_htf_levels[1] = T_htf_ref;   //[C]
-		T_htf_levels[2] = T_htf_high;  //[C]
-		for(int j = 0; j < 3; j++)
-		{
-			bool is_od_model_error = false;
-
-			pc_inputs.m_T_htf_hot = T_htf_levels[j];
-			int off_design_code = mf_pc_eq(pc_inputs,pc_outputs);
-
-			if( off_design_code == 0 )
-			{
-				// Save outputs
-				T_amb_ind(i,1+j) = pc_outputs.m_W_dot_gross_ND;		//[-]
-				T_amb_ind(i,4+j) = pc_outputs.m_Q_dot_in_ND;		//[-]
-				T_amb_ind(i,7+j) = pc_outputs.m_W_dot_cooling_ND;	//[-]
-				T_amb_ind(i,10+j) = pc_outputs.m_m_dot_water_ND;	//[-]
-			}
-			else if (off_design_code == -1)
-			{
-				// Save 'generic' off design model response
-				T_amb_ind(i, 1 + j) = pc_inputs.m_m_dot_htf_ND;		//[-]
-				T_amb_ind(i, 4 + j) = pc_inputs.m_m_dot_htf_ND;		//[-]
-				T_amb_ind(i, 7 + j) = pc_inputs.m_m_dot_htf_ND;		//[-]
-				T_amb_ind(i, 10 + j) = pc_inputs.m_m_dot_htf_ND;	//[-]
-
-				is_od_model_error = true;
-			}
-			else
-			{
-				std::string err_msg = util::format("The 2nd UDPC table (primary: T_amb, interaction: T_htf) generation failed at T_amb = %lg [C] and T_htf = %lg [C]", pc_inputs.m_T_amb, pc_inputs.m_T_htf_hot);
-				throw(C_csp_exception(err_msg, "UDPC"));
-			}
-
-			double run_number = 3.0*n_T_htf + i*3 + j;
-
-			send_callback(is_od_model_error, (int)run_number + 1, (int)n_runs_total,
-				pc_inputs.m_T_htf_hot, pc_inputs.m_m_dot_htf_ND, pc_inputs.m_T_amb,
-				T_amb_ind(i, 1 + j), T_amb_ind(i, 4 + j),
-				T_amb_ind(i, 7 + j), T_amb_ind(i, 10 + j));
-		}
-	}
-	// ******************************************
-
-	// ******************************************
 	// Setup ND m_dot parametric runs
 	if(n_m_dot_htf_ND < 3)
 	{
@@ -614,59 +605,80 @@ int C_ud_pc_table_generator::generate_tables(double T_htf_ref /*C*/, double T_ht
 	m_dot_htf_ind.clear();
 	m_dot_htf_ind.resize(n_m_dot_htf_ND,13);		// Set matrix size
 	double delta_m_dot = (m_dot_htf_ND_high-m_dot_htf_ND_low)/double(n_m_dot_htf_ND-1);
+	// ******************************************
 
-	// Set HTF temperature because it is constant for the ambient temperature parametrics
-	pc_inputs.m_T_htf_hot = T_htf_ref;
-	for(int i = 0; i < n_m_dot_htf_ND; i++)
-	{
-		m_dot_htf_ind(i,0) = m_dot_htf_ND_low + delta_m_dot*i;		//[-]
-		pc_inputs.m_m_dot_htf_ND = m_dot_htf_ind(i,0);				//[-]
+	// ******************************************
+	// List the off-design runs in table order
+	std::vector<S_table_point> points;
+	points.reserve(3*(n_T_htf + n_T_amb + n_m_dot_htf_ND));
+
+	S_table_point point;
 
-		// Call at low, ref, and high ambient temperatures
-		std::vector<double> T_amb_levels(3);
-		T_amb_levels[0] = T_amb_low;    //[C]
-		T_amb_levels[1] = T_amb_ref;	//[C]
-		T_amb_levels[2] = T_amb_high;	//[C]
+	// HTF temperature parametrics at low, ref, and high ND mass flow rate levels and the design ambient temperature
+	std::vector<double> m_dot_htf_ND_levels(3);
+	m_dot_htf_ND_levels[0] = m_dot_htf_ND_low;
+	m_dot_htf_ND_levels[1] = m_dot_htf_ND_ref;
+	m_dot_htf_ND_levels[2] = m_dot_htf_ND_high;
+
+	point.m_table = E_T_HTF_TABLE;
+	point.ms_inputs.m_T_amb = T_amb_ref;	//[C]
+	for(int i = 0; i < n_T_htf; i++)
+	{
+		T_htf_ind(i,0) = T_htf_low + delta_T_htf*i;	//[C]
+		point.ms_inputs.m_T_htf_hot = T_htf_ind(i,0);
 		for(int j = 0; j < 3; j++)
 		{
-			bool is_od_model_error = false;
+			point.m_i = i;
+			point.m_j = j;
+			point.ms_inputs.m_m_dot_htf_ND = m_dot_htf_ND_levels[j];
+			points.push_back(point);
+		}
+	}
 
-			pc_inputs.m_T_amb = T_amb_levels[j];
-			int off_design_code = mf_pc_eq(pc_inputs, pc_outputs);
-		
-			if( off_design_code == 0 )
-			{
-				// Save outputs
-				m_dot_htf_ind(i,1+j) = pc_outputs.m_W_dot_gross_ND;		//[-]
-				m_dot_htf_ind(i,4+j) = pc_outputs.m_Q_dot_in_ND;		//[-]
-				m_dot_htf_ind(i,7+j) = pc_outputs.m_W_dot_cooling_ND;	//[-]
-				m_dot_htf_ind(i,10+j) = pc_outputs.m_m_dot_water_ND;	//[-]
-			}
-			else if (off_design_code == -1)
-			{
-				// Save 'generic' off design model response
-				m_dot_htf_ind(i, 1 + j) = pc_inputs.m_m_dot_htf_ND;		//[-]
-				m_dot_htf_ind(i, 4 + j) = pc_inputs.m_m_dot_htf_ND;		//[-]
-				m_dot_htf_ind(i, 7 + j) = pc_inputs.m_m_dot_htf_ND;		//[-]
-				m_dot_htf_ind(i, 10 + j) = pc_inputs.m_m_dot_htf_ND;	//[-]
+	// Ambient temperature parametrics at low, ref, and high HTF temperature levels and the design ND mass flow rate
+	std::vector<double> T_htf_levels(3);
+	T_htf_levels[0] = T_htf_low;   //[C]
+	T_htf_levels[1] = T_htf_ref;   //[C]
+	T_htf_levels[2] = T_htf_high;  //[C]
 
-				is_od_model_error = true;
-			}
-			else
-			{
-				std::string err_msg = util::format("The 3rd UDPC table (primary: m_dot_htf_ND, interaction: T_amb) generation failed at T_amb = %lg [C] and m_dot_htf = %lg [-]", pc_inputs.m_T_amb, pc_inputs.m_m_dot_htf_ND);
-				throw(C_csp_exception(err_msg, "UDPC"));
-			}
+	point.m_table = E_T_AMB_TABLE;
+	point.ms_inputs.m_m_dot_htf_ND = m_dot_htf_ND_ref;
+	for(int i = 0; i < n_T_amb; i++)
+	{
+		T_amb_ind(i,0) = T_amb_low + delta_T_amb*i;		//[C]
+		point.ms_inputs.m_T_amb = T_amb_ind(i,0);			//[C]
+		for(int j = 0; j < 3; j++)
+		{
+			point.m_i = i;
+			point.m_j = j;
+			point.ms_inputs.m_T_htf_hot = T_htf_levels[j];
+			points.push_back(point);
+		}
+	}
 
-			double run_number = 3.0*n_T_htf + 3.0*n_T_amb  + i*3 + j;
+	// ND mass flow rate parametrics at low, ref, and high ambient temperatures and the design HTF temperature
+	std::vector<double> T_amb_levels(3);
+	T_amb_levels[0] = T_amb_low;    //[C]
+	T_amb_levels[1] = T_amb_ref;	//[C]
+	T_amb_levels[2] = T_amb_high;	//[C]
 
-			send_callback(is_od_model_error, (int)run_number + 1, (int)n_runs_total,
-				pc_inputs.m_T_htf_hot, pc_inputs.m_m_dot_htf_ND, pc_inputs.m_T_amb,
-				m_dot_htf_ind(i, 1 + j), m_dot_htf_ind(i, 4 + j),
-				m_dot_htf_ind(i, 7 + j), m_dot_htf_ind(i, 10 + j));
+	point.m_table = E_M_DOT_HTF_TABLE;
+	point.ms_inputs.m_T_htf_hot = T_htf_ref;
+	for(int i = 0; i < n_m_dot_htf_ND; i++)
+	{
+		m_dot_htf_ind(i,0) = m_dot_htf_ND_low + delta_m_dot*i;		//[-]
+		point.ms_inputs.m_m_dot_htf_ND = m_dot_htf_ind(i,0);			//[-]
+		for(int j = 0; j < 3; j++)
+		{
+			point.m_i = i;
+			point.m_j = j;
+			point.ms_inputs.m_T_amb = T_amb_levels[j];
+			points.push_back(point);
 		}
 	}
 	// ******************************************
+
+	run_points(points, T_htf_ind, T_amb_ind, m_dot_htf_ind);
 	
 	return 0;
 }
\ No newline at end of file
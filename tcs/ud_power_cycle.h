@@ -51,6 +51,8 @@
 #define __UD_POWER_CYCLE_
 
 #include <limits>
+#include <string>
+#include <vector>
 #include "interpolation_routines.h"
 #include "csp_solver_util.h"
 
@@ -175,11 +177,21 @@ public:
 	C_od_pc_function()
 	{
 	}
-	~C_od_pc_function()
+	virtual ~C_od_pc_function()
 	{
 	}
 
 	virtual int operator()(S_f_inputs inputs, S_f_outputs & outputs) = 0;
+
+	// Returns a new, independent copy of this function in its current state that can be called from another thread,
+	// or NULL if the function does not support copies. The caller owns and deletes the copy.
+	// Table points run on copies in any order, so only return a copy if the result at a point does not depend on
+	// the points called before it. Functions that use their last solution as guesses return NULL, and their
+	// table points are run on the function itself in table order
+	virtual C_od_pc_function * clone() const
+	{
+		return 0;	// = NULL
+	}
 };
 
 class C_ud_pc_table_generator
@@ -190,6 +202,35 @@ private:
 	std::string m_log_msg;
 	std::string m_progress_msg;	
 
+	enum E_table
+	{
+		E_T_HTF_TABLE = 0,		// Primary: T_htf, interaction: m_dot_htf_ND
+		E_T_AMB_TABLE,			// Primary: T_amb, interaction: T_htf
+		E_M_DOT_HTF_TABLE		// Primary: m_dot_htf_ND, interaction: T_amb
+	};
+
+	struct S_table_point
+	{
+		int m_table;		//[-] E_table
+		int m_i;			//[-] Row in the table
+		int m_j;			//[-] Interaction level: 0 = low, 1 = reference, 2 = high
+
+		C_od_pc_function::S_f_inputs ms_inputs;
+		C_od_pc_function::S_f_outputs ms_outputs;
+		int m_off_design_code;	//[-] 0 = solved, -1 = use generic off design response, else error
+
+		S_table_point()
+		{
+			m_table = m_i = m_j = -1;
+			m_off_design_code = 1;
+		}
+	};
+
+	void run_points(std::vector<S_table_point> & points,
+		util::matrix_t<double> & T_htf_ind, util::matrix_t<double> & T_amb_ind, util::matrix_t<double> & m_dot_htf_ind);
+
+	void save_point(const S_table_point & point, int run_number, int n_runs_total, util::matrix_t<double> & table);
+
 	void send_callback(bool is_od_model_error, int run_number, int n_runs_total,
 		double T_htf_hot, double m_dot_htf_ND, double T_amb,
 		double W_dot_gross_ND, double Q_dot_in_ND,
@@ -199,6 +240,10 @@ public:
 
 	C_csp_messages mc_messages;
 
+	// Number of threads used to run the off-design model at the table points, 0 = all hardware threads.
+	// Threads are only used if the off-design function supports 'clone', so the tables don't depend on this value
+	int m_n_threads;
+
 	C_ud_pc_table_generator(C_od_pc_function & f_pc_eq);
 
 	~C_ud_pc_table_generator(){}
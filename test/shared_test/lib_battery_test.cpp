@@ -70,4 +70,32 @@ TEST_F(BatteryTest, LossesModel)
 	lossModel->run_losses(idx);
 	EXPECT_EQ(lossModel->getLoss(idx), 1);
 
-}
\ No newline at end of file
+}
+TEST_F(BatteryTest, CopyRestoresState)
+{
+	// dispatch keeps a copy of the battery and restores from it when it retries a timestep
+	battery_t * saved = new battery_t(*batteryModel);
+
+	std::vector<double> SOC, T_battery, q;
+	for (size_t idx = 0; idx < 72; idx++)
+	{
+		double I = (idx % 12 < 6) ? 20. : -20.;
+		batteryModel->run(idx, I);
+		SOC.push_back(batteryModel->battery_soc());
+		T_battery.push_back(batteryModel->thermal_model()->T_battery());
+		q.push_back(batteryModel->lifetime_model()->capacity_percent());
+	}
+
+	batteryModel->copy(saved);
+	for (size_t idx = 0; idx < 72; idx++)
+	{
+		double I = (idx % 12 < 6) ? 20. : -20.;
+		batteryModel->run(idx, I);
+		EXPECT_EQ(batteryModel->battery_soc(), SOC[idx]) << "step " << idx;
+		EXPECT_EQ(batteryModel->thermal_model()->T_battery(), T_battery[idx]) << "step " << idx;
+		EXPECT_EQ(batteryModel->lifetime_model()->capacity_percent(), q[idx]) << "step " << idx;
+	}
+
+	saved->delete_clone();
+	delete saved;
+}
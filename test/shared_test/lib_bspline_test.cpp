@@ -0,0 +1,150 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "bsplinebuilder.h"
+#include "datatable.h"
+#include "lib_bspline.h"
+
+using namespace SPLINTER;
+
+static BSpline bspline_1D(const std::vector<double> &x, const std::vector<double> &y)
+{
+	DataTable samples;
+	for (size_t i = 0; i < x.size(); i++)
+		samples.addSample(x[i], y[i]);
+	return BSpline::Builder(samples).degree(3).build();
+}
+
+static double bspline_eval(const BSpline &bspline, double x)
+{
+	DenseVector v(1);
+	v(0) = x;
+	return bspline.eval(v);
+}
+
+// Efficiency curve as read from an OND file, Pdc [W] and eta [%]
+static const std::vector<double> ond_Pdc = { 1040.0, 2080.0, 5200.0, 10400.0, 15600.0, 26000.0, 39000.0, 52000.0 };
+static const std::vector<double> ond_eta = { 93.1, 95.6, 97.5, 98.1, 98.2, 98.15, 97.9, 97.6 };
+
+// Incidence angle modifier table, angle [deg]
+static const std::vector<double> iam_angle = { 0.0, 30.0, 50.0, 60.0, 70.0, 75.0, 80.0, 85.0, 90.0 };
+static const std::vector<double> iam_value = { 1.0, 0.999, 0.987, 0.962, 0.892, 0.816, 0.681, 0.440, 0.0 };
+
+TEST(BSplineEvaluator, MatchesSPLINTER1D_lib_bspline)
+{
+	const std::vector<double> *X[2] = { &ond_Pdc, &iam_angle };
+	const std::vector<double> *Y[2] = { &ond_eta, &iam_value };
+
+	for (int c = 0; c < 2; c++)
+	{
+		BSpline bspline = bspline_1D(*X[c], *Y[c]);
+		bspline_evaluator spline;
+		ASSERT_TRUE(spline.compile(bspline));
+		ASSERT_TRUE(spline.is_compiled());
+
+		double x_min = X[c]->front();
+		double x_max = X[c]->back();
+		int n = 2000;
+		for (int i = 0; i <= n; i++)
+		{
+			double x = x_min + (x_max - x_min) * i / n;
+			EXPECT_NEAR(spline.eval(x), bspline_eval(bspline, x), 1.e-10) << "curve " << c << " x = " << x;
+		}
+
+		// Samples, including both ends of the knots
+		for (size_t i = 0; i < X[c]->size(); i++)
+		{
+			EXPECT_NEAR(spline.eval((*X[c])[i]), bspline_eval(bspline, (*X[c])[i]), 1.e-10);
+			EXPECT_NEAR(spline.eval((*X[c])[i]), (*Y[c])[i], 1.e-10);
+		}
+
+		// Outside the knots the spline is 0, as BSpline::eval in release builds (debug builds throw)
+		EXPECT_EQ(spline.eval(x_min - 1.0), 0.0);
+		EXPECT_EQ(spline.eval(x_max + 1.0), 0.0);
+
+		// Wrong number of variables
+		EXPECT_TRUE(std::isnan(spline.eval(x_min, x_min)));
+	}
+}
+
+TEST(BSplineEvaluator, MatchesSPLINTER2D_lib_bspline)
+{
+	DataTable samples;
+	DenseVector xy(2);
+	for (int i = 0; i < 7; i++)
+	{
+		for (int j = 0; j < 5; j++)
+		{
+			xy(0) = 0.5 * i;
+			xy(1) = 10.0 + 5.0 * j * j;
+			samples.addSample(xy, sin(xy(0)) * log(xy(1)) + 0.01 * xy(0) * xy(1));
+		}
+	}
+	BSpline bspline = BSpline::Builder(samples).degree(3).build();
+
+	bspline_evaluator spline;
+	ASSERT_TRUE(spline.compile(bspline));
+
+	for (int i = 0; i <= 60; i++)
+	{
+		for (int j = 0; j <= 80; j++)
+		{
+			xy(0) = 3.0 * i / 60;
+			xy(1) = 10.0 + 80.0 * j / 80;
+			EXPECT_NEAR(spline.eval(xy(0), xy(1)), bspline.eval(xy), 1.e-10) << "x = " << xy(0) << " y = " << xy(1);
+		}
+	}
+
+	EXPECT_EQ(spline.eval(1.0, 95.0), 0.0);
+	EXPECT_EQ(spline.eval(-1.0, 20.0), 0.0);
+	EXPECT_TRUE(std::isnan(spline.eval(1.0)));
+}
+
+TEST(BSplineEvaluator, NotCompiled_lib_bspline)
+{
+	bspline_evaluator spline;
+	EXPECT_FALSE(spline.is_compiled());
+	EXPECT_TRUE(std::isnan(spline.eval(1.0)));
+
+	// Knot vector that is regular but not clamped
+	std::vector<double> coefs(6, 1.0);
+	std::vector< std::vector<double> > knots(1);
+	for (int i = 0; i < 10; i++)
+		knots[0].push_back(i);
+	BSpline bspline(coefs, knots, std::vector<unsigned int>(1, 3));
+	EXPECT_FALSE(spline.compile(bspline));
+	EXPECT_FALSE(spline.is_compiled());
+
+	// More than 2 variables
+	std::vector<double> coefs_3D(64, 1.0);
+	std::vector< std::vector<double> > knots_3D(3, std::vector<double>({ 0., 0., 0., 0., 1., 1., 1., 1. }));
+	BSpline bspline_3D(coefs_3D, knots_3D, std::vector<unsigned int>(3, 3));
+	EXPECT_FALSE(spline.compile(bspline_3D));
+}
+
+TEST(BSplineEvaluator, DISABLED_Benchmark_lib_bspline)
+{
+	BSpline bspline = bspline_1D(ond_Pdc, ond_eta);
+	bspline_evaluator spline;
+	spline.compile(bspline);
+
+	int n_calls = 200000;
+	double sum_bspline = 0.0, sum_spline = 0.0;
+
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < n_calls; i++)
+		sum_bspline += bspline_eval(bspline, 1040.0 + 50000.0 * (i % 1000) / 1000.0);
+	std::chrono::duration<double, std::micro> t_bspline = std::chrono::steady_clock::now() - start;
+
+	start = std::chrono::steady_clock::now();
+	for (int i = 0; i < n_calls; i++)
+		sum_spline += spline.eval(1040.0 + 50000.0 * (i % 1000) / 1000.0);
+	std::chrono::duration<double, std::micro> t_spline = std::chrono::steady_clock::now() - start;
+
+	EXPECT_NEAR(sum_spline, sum_bspline, 1.e-6 * sum_bspline);
+	printf("BSpline::eval %.4f us/call, bspline_evaluator::eval %.4f us/call\n", t_bspline.count() / n_calls, t_spline.count() / n_calls);
+}
@@ -377,6 +377,61 @@ TEST_F(DayCaseIrradProc, CalcTestRadMode0_lib_irradproc){
 	}
 }
 
+/// irrad_series should give the same result as irrad::calc() at every timestep
+TEST_F(IrradTest, SeriesMatchesTimestepCalc_lib_irradproc){
+	size_t n = 48;
+	std::vector<int> y(n, year), m(n, month), d(n), h(n);
+	std::vector<double> min(n, 30), gh(n), dn(n), df(n), albedo(n, alb);
+	for (size_t i = 0; i < n; i++){
+		d[i] = day + (int)(i / 24);
+		h[i] = (int)(i % 24);
+		dn[i] = (h[i] > 6 && h[i] < 19) ? 600 : 0;
+		df[i] = (h[i] > 5 && h[i] < 20) ? 100 : 0;
+		gh[i] = (h[i] > 6 && h[i] < 19) ? 550 : df[i];
+	}
+
+	for (int radmode = irrad::DN_DF; radmode <= irrad::GH_DF; radmode++){
+		for (int sky = 0; sky < 3; sky++){
+			irrad_series series;
+			series.set_location(lat, lon, tz);
+			series.set_sky_model(sky);
+			series.set_surface(1, tilt, azim, 45, true, 0.4);
+			series.calc_sun(n, &y[0], &m[0], &d[0], &h[0], &min[0], 1.0);
+			series.calc_poa(radmode, &gh[0], &dn[0], &df[0], &albedo[0]);
+			ASSERT_EQ(series.size(), n);
+
+			for (size_t i = 0; i < n; i++){
+				irrad irr;
+				irr.set_time(y[i], m[i], d[i], h[i], min[i], 1.0);
+				irr.set_location(lat, lon, tz);
+				irr.set_sky_model(sky, albedo[i]);
+				if (radmode == irrad::DN_DF) irr.set_beam_diffuse(dn[i], df[i]);
+				else if (radmode == irrad::DN_GH) irr.set_global_beam(gh[i], dn[i]);
+				else irr.set_global_diffuse(gh[i], df[i]);
+				irr.set_surface(1, tilt, azim, 45, true, 0.4);
+				int code = irr.calc();
+
+				EXPECT_EQ(series.code[i], code) << "radmode " << radmode << " sky " << sky << " step " << i;
+				int sunup = 0;
+				irr.get_sun(0, 0, 0, 0, 0, 0, &sunup, 0, 0, 0);
+				EXPECT_EQ(series.sunUp[i], sunup) << "sunup step " << i;
+				for (int k = 0; k < 9; k++)
+					EXPECT_DOUBLE_EQ(series.sunAnglesRadians[k][i], irr.get_sun_component(k)) << "sun parameter " << k << " step " << i;
+
+				double angle[5], poa[6];
+				irr.get_angles(&angle[0], &angle[1], &angle[2], &angle[3], &angle[4]);
+				irr.get_poa(&poa[0], &poa[1], &poa[2], &poa[3], &poa[4], &poa[5]);
+				for (int k = 0; k < 5; k++)
+					EXPECT_DOUBLE_EQ(series.surfaceAnglesRadians[k][i] * (180 / M_PI), angle[k]) << "angle parameter " << k << " step " << i;
+				for (int k = 0; k < 3; k++){
+					EXPECT_DOUBLE_EQ(series.poaFront[k][i], poa[k]) << "poa parameter " << k << " step " << i;
+					EXPECT_DOUBLE_EQ(series.diffuseFront[k][i], poa[k + 3]) << "diffuse parameter " << k << " step " << i;
+				}
+			}
+		}
+	}
+}
+
 TEST_F(SunsetCaseIrradProc, CalcTestRadMode0_lib_irradproc){
 	vector<double> sun_p;
 	sun_p.resize(10);
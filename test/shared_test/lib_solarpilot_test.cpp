@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+#include "../solarpilot/AutoPilot_API.h"
+#include "../solarpilot/API_structures.h"
+#include "../solarpilot/definitions.h"
+#include "../shared/lib_parallel.h"
+
+TEST(SolarPilotParallelTest, EachItemVisitedOnce_lib_solarpilot)
+{
+	int n = 1003;
+	std::vector<int> visits(n, 0);
+
+	sp_parallel_for(n, 4, 7, [&](int i, int)
+	{
+		visits[i]++;
+	});
+
+	for (int i = 0; i < n; i++)
+		EXPECT_EQ(visits[i], 1) << "item " << i;
+}
+
+TEST(SolarPilotParallelTest, WorkerExceptionRethrown_lib_solarpilot)
+{
+	EXPECT_THROW(
+		sp_parallel_for(500, 4, 5, [&](int i, int)
+		{
+			if (i == 321)
+				throw std::runtime_error("heliostat failed");
+		}),
+		std::runtime_error);
+}
+
+TEST(SolarPilotParallelTest, ThreadCountLimitedByChunks_lib_solarpilot)
+{
+	EXPECT_EQ(sp_thread_count(8, 10, 64), 1);
+	EXPECT_EQ(sp_thread_count(8, 130, 64), 3);
+	EXPECT_EQ(sp_thread_count(2, 1000, 64), 2);
+	EXPECT_GE(sp_thread_count(0, 1000, 1), 1);
+}
+
+/// Calculate the flux table for a small user-defined field with the given number of simulation threads
+static void run_flux_table(int n_threads, sp_flux_table &fluxtab)
+{
+	var_map V;
+
+	//use the first heliostat template
+	std::string name = "Template 1", val = "0";
+	V.sf.temp_which.combo_clear();
+	V.sf.temp_which.combo_add_choice(name, val);
+	V.sf.temp_which.combo_select_by_choice_index(0);
+
+	//radial rows of heliostats to the north of the tower
+	std::string layout;
+	char row[200];
+	for (int r = 0; r < 6; r++)
+	{
+		double radius = 150. + 25.*r;
+		for (int a = -20; a <= 20; a++)
+		{
+			double az = a * 3. * D2R;
+			sprintf(row, "0,%f,%f,%f,NULL,NULL,NULL,NULL,NULL,NULL,NULL,NULL;", radius*sin(az), radius*cos(az), 0.);
+			layout.append(row);
+		}
+	}
+	V.sf.layout_data.val = layout;
+
+	AutoPilot_S sapi;
+	sapi.SetSimulationThreadCount(n_threads);
+	sapi.SetSummaryCallbackStatus(false);
+	sapi.SetDetailCallbackStatus(false);
+	sapi.Setup(V);
+
+	fluxtab.is_user_spacing = true;
+	fluxtab.azimuths.push_back(180. * D2R);
+	fluxtab.zeniths.push_back(30. * D2R);
+	fluxtab.azimuths.push_back(120. * D2R);
+	fluxtab.zeniths.push_back(60. * D2R);
+
+	ASSERT_TRUE(sapi.CalculateFluxMaps(fluxtab, 12, 10, true));
+}
+
+TEST(SolarPilotParallelTest, FluxTableIndependentOfThreadCount_lib_solarpilot)
+{
+	sp_flux_table serial, threaded;
+	run_flux_table(1, serial);
+	run_flux_table(4, threaded);
+
+	ASSERT_EQ(serial.efficiency.size(), 2);
+	ASSERT_EQ(threaded.efficiency.size(), serial.efficiency.size());
+	for (size_t i = 0; i < serial.efficiency.size(); i++)
+	{
+		EXPECT_GT(serial.efficiency[i], 0.);
+		EXPECT_EQ(threaded.efficiency[i], serial.efficiency[i]);
+	}
+
+	block_t<double> &fs = serial.flux_surfaces.front().flux_data;
+	block_t<double> &ft = threaded.flux_surfaces.front().flux_data;
+	ASSERT_EQ(fs.nrows(), ft.nrows());
+	ASSERT_EQ(fs.ncols(), ft.ncols());
+	ASSERT_EQ(fs.nlayers(), ft.nlayers());
+	for (size_t i = 0; i < fs.nrows(); i++)
+		for (size_t j = 0; j < fs.ncols(); j++)
+			for (size_t k = 0; k < fs.nlayers(); k++)
+				EXPECT_EQ(ft.at(i, j, k), fs.at(i, j, k));
+}
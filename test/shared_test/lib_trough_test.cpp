@@ -55,3 +55,47 @@ TEST_F(TroughTest, DefocusTest)
     EXPECT_NEAR(troughOutputs.m_m_dot_salt_tot, 2494962., 2494962. * m_error_tolerance_lo);
     // mass flow changes by 2.1%
 }
+
+TEST_F(TroughTest, EvacSurrogateTest)
+{
+    troughModel->m_use_evac_surrogate = true;
+    troughModel->evac_surrogate_init();
+
+    ASSERT_GT(troughModel->mv_evac_tables.size(), 0);
+    for (size_t k = 0; k < troughModel->mv_evac_tables.size(); k++)
+        EXPECT_TRUE(troughModel->mv_evac_tables[k].is_valid) << "table " << k;
+
+    const C_csp_trough_collector_receiver::S_evac_table &table = troughModel->mv_evac_tables[0];
+    int hn = table.hn, hv = table.hv, ct = table.ct;
+    double q_heatloss, q_12conv, q_34tot, c_1ave, rho_1ave;
+    double q_heatloss_s, q_12conv_s, q_34tot_s, c_1ave_s, rho_1ave_s;
+
+    // Operating points along the loop, at part and full flow, in still and windy conditions
+    double T_htf_in[4] = { 570., 600., 630., 660. };    // [K]
+    double m_dot[2] = { 0.5*(m_dot_htfmin + m_dot_htfmax), m_dot_htfmax };  // [kg/s]
+    double wind[2] = { 0.5, 8. };                       // [m/s]
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 2; j++) {
+            for (int k = 0; k < 2; k++) {
+                troughModel->evac_energy_balance(T_htf_in[i], m_dot[j], 300., 285., wind[k], 92000., 2000., hn, hv, ct, false, 9, 0.,
+                    q_heatloss, q_12conv, q_34tot, c_1ave, rho_1ave);
+                ASSERT_TRUE(troughModel->evac_surrogate(T_htf_in[i], m_dot[j], 300., 285., wind[k], 92000., 2000., hn, hv, ct,
+                    q_heatloss_s, q_12conv_s, q_34tot_s, c_1ave_s, rho_1ave_s));
+
+                double tol = troughModel->m_evac_surrogate_tol * std::max(fabs(q_heatloss), 10.);
+                EXPECT_NEAR(q_heatloss_s, q_heatloss, tol) << "T_htf_in = " << T_htf_in[i];
+                EXPECT_NEAR(q_12conv_s, q_12conv, tol) << "T_htf_in = " << T_htf_in[i];
+                EXPECT_NEAR(c_1ave_s, c_1ave, 1.e-3 * c_1ave) << "T_htf_in = " << T_htf_in[i];
+                EXPECT_NEAR(rho_1ave_s, rho_1ave, 1.e-3 * rho_1ave) << "T_htf_in = " << T_htf_in[i];
+            }
+        }
+    }
+
+    // Calm wind, no flow, and temperatures outside the table are left to the energy balance
+    EXPECT_FALSE(troughModel->evac_surrogate(600., m_dot_htfmax, 300., 285., 0., 92000., 2000., hn, hv, ct,
+        q_heatloss_s, q_12conv_s, q_34tot_s, c_1ave_s, rho_1ave_s));
+    EXPECT_FALSE(troughModel->evac_surrogate(600., 0., 300., 285., 8., 92000., 2000., hn, hv, ct,
+        q_heatloss_s, q_12conv_s, q_34tot_s, c_1ave_s, rho_1ave_s));
+    EXPECT_FALSE(troughModel->evac_surrogate(troughModel->m_T_loop_out_des + 200., m_dot_htfmax, 300., 285., 8., 92000., 2000., hn, hv, ct,
+        q_heatloss_s, q_12conv_s, q_34tot_s, c_1ave_s, rho_1ave_s));
+}
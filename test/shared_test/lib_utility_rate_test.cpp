@@ -0,0 +1,270 @@
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "lib_utility_rate.h"
+#include "sscapi.h"
+
+/**
+ * Two period energy schedule with a summer afternoon peak, and a three row rate table given out of tier order.
+ */
+class CompiledUtilityRateTest : public ::testing::Test
+{
+protected:
+	util::matrix_t<size_t> m_weekday;
+	util::matrix_t<size_t> m_weekend;
+	util::matrix_t<double> m_ecRates;
+
+	void SetUp()
+	{
+		m_weekday.resize_fill(12, 24, 1);
+		m_weekend.resize_fill(12, 24, 1);
+		for (size_t m = 5; m < 9; m++)
+			for (size_t h = 12; h < 18; h++)
+				m_weekday.at(m, h) = 2;
+
+		// period, tier, max usage, units, buy, sell
+		double rates[3][6] = { { 1, 2, 1e38, 0, 0.12, 0.03 }, { 1, 1, 500, 0, 0.10, 0.02 }, { 2, 1, 1e38, 0, 0.25, 0.05 } };
+		m_ecRates.resize(3, 6);
+		for (size_t r = 0; r < 3; r++)
+			for (size_t c = 0; c < 6; c++)
+				m_ecRates.at(r, c) = rates[r][c];
+	}
+};
+
+TEST_F(CompiledUtilityRateTest, PeriodPerStepMatchesSchedule_lib_utility_rate)
+{
+	for (size_t stepsPerHour = 1; stepsPerHour <= 4; stepsPerHour *= 4)
+	{
+		CompiledUtilityRate rate(stepsPerHour);
+		ASSERT_TRUE(rate.compileEnergyCharges(m_weekday, m_weekend, m_ecRates));
+		ASSERT_EQ(rate.firstStepOfMonth(0), 0);
+		ASSERT_EQ(rate.lastStepOfMonth(11), rate.numberOfSteps() - 1);
+
+		for (size_t m = 0; m < 12; m++)
+		{
+			ASSERT_EQ(rate.lastStepOfMonth(m) - rate.firstStepOfMonth(m) + 1, util::nday[m] * 24 * stepsPerHour);
+			ASSERT_EQ(rate.energyPeriodsInMonth(m).size(), (m >= 5 && m < 9) ? 2 : 1);
+
+			for (size_t step = rate.firstStepOfMonth(m); step <= rate.lastStepOfMonth(m); step++)
+			{
+				size_t hourOfYear = step / stepsPerHour;
+				size_t month, hour;
+				util::month_hour(hourOfYear, month, hour);
+				int period = (int)(util::weekday(hourOfYear) ? m_weekday.at(month - 1, hour - 1) : m_weekend.at(month - 1, hour - 1));
+
+				EXPECT_EQ(month - 1, m);
+				EXPECT_EQ(rate.energyPeriod(step), period) << "step " << step;
+				ASSERT_GE(rate.energyPeriodRow(step), 0);
+				EXPECT_EQ(rate.energyPeriodsInMonth(m)[rate.energyPeriodRow(step)], period);
+			}
+		}
+	}
+}
+
+TEST_F(CompiledUtilityRateTest, TiersSortedByTier_lib_utility_rate)
+{
+	CompiledUtilityRate rate;
+	ASSERT_TRUE(rate.compileEnergyCharges(m_weekday, m_weekend, m_ecRates));
+
+	const CompiledUtilityRate::RateTiers & tiers = rate.energyTiers(1);
+	ASSERT_EQ(tiers.tier.size(), 2);
+	EXPECT_EQ(tiers.tier[0], 1);
+	EXPECT_EQ(tiers.max[0], 500);
+	EXPECT_EQ(tiers.rate[0], 0.10);
+	EXPECT_EQ(tiers.sellRate[0], 0.02);
+	EXPECT_EQ(tiers.tier[1], 2);
+	EXPECT_EQ(tiers.rate[1], 0.12);
+
+	EXPECT_EQ(rate.energyTiers(2).tier.size(), 1);
+	EXPECT_TRUE(rate.energyTiers(3).tier.empty());
+
+	// a single period schedule
+	util::matrix_t<size_t> flat(1, 1, 2);
+	ASSERT_TRUE(rate.compileEnergyCharges(flat, flat, m_ecRates));
+	EXPECT_EQ(rate.energyPeriod(0), 2);
+	EXPECT_EQ(rate.energyPeriod(8759), 2);
+}
+
+TEST_F(CompiledUtilityRateTest, BillsForLoadProfiles_lib_utility_rate)
+{
+	CompiledUtilityRate rate;
+	util::matrix_t<size_t> flat(1, 1, 1);
+	ASSERT_TRUE(rate.compileEnergyCharges(flat, flat, m_ecRates));
+
+	// 1 kW all year is 720 kWh in a 30 day month, 744 kWh in a 31 day month
+	std::vector<std::vector<double> > profiles(3, std::vector<double>(8760, 1.0));
+	for (size_t i = 0; i < 8760; i++)
+		profiles[2][i] = -0.5;
+	profiles[1][0] = 10.0;
+
+	double expected = 0;
+	for (size_t m = 0; m < 12; m++)
+		expected += 500 * 0.10 + (util::nday[m] * 24 - 500) * 0.12;
+
+	std::vector<double> bills;
+	ASSERT_TRUE(rate.calculateBills(profiles, bills));
+	ASSERT_EQ(bills.size(), 3);
+	EXPECT_NEAR(bills[0], expected, 1e-6);
+	EXPECT_NEAR(bills[1], expected + 9 * 0.12, 1e-6);
+	EXPECT_NEAR(bills[2], -0.5 * 8760 * 0.02, 1e-6);
+	EXPECT_EQ(bills[0], rate.calculateBill(&profiles[0][0]));
+
+	// flat demand of $10/kW up to 5 kW then $20/kW, and a TOU period 2 demand charge of $5/kW in the summer afternoons
+	util::matrix_t<double> dcTou(1, 4, 0.0), dcFlat(24, 4, 0.0);
+	dcTou.at(0, 0) = 2; dcTou.at(0, 1) = 1; dcTou.at(0, 2) = 1e38; dcTou.at(0, 3) = 5;
+	for (size_t m = 0; m < 12; m++)
+	{
+		double row0[4] = { (double)m, 2, 1e38, 20 };
+		double row1[4] = { (double)m, 1, 5, 10 };
+		for (size_t c = 0; c < 4; c++)
+		{
+			dcFlat.at(2 * m, c) = row0[c];
+			dcFlat.at(2 * m + 1, c) = row1[c];
+		}
+	}
+	util::matrix_t<size_t> dcWeekend(12, 24, 1);
+	ASSERT_TRUE(rate.compileDemandCharges(m_weekday, dcWeekend, dcTou, dcFlat));
+	EXPECT_EQ(rate.flatDemandTiers(3).max[0], 5);
+
+	// the 10 kW January peak is 5 kW at $10 and 5 kW at $20, summer months add $5 for their 1 kW afternoon peak
+	ASSERT_TRUE(rate.calculateBills(profiles, bills));
+	EXPECT_NEAR(bills[0], expected + 12 * 10 + 4 * 5, 1e-6);
+	EXPECT_NEAR(bills[1], expected + 9 * 0.12 + 11 * 10 + 150 + 4 * 5, 1e-6);
+	EXPECT_NEAR(bills[2], -0.5 * 8760 * 0.02, 1e-6);
+
+	// a profile shorter than a year has no bill
+	profiles[1].resize(8759);
+	EXPECT_FALSE(rate.calculateBills(profiles, bills));
+	ASSERT_EQ(bills.size(), 3);
+	EXPECT_NEAR(bills[0], expected + 12 * 10 + 4 * 5, 1e-6);
+	EXPECT_TRUE(std::isnan(bills[1]));
+}
+
+/// Year 1 bill from utilityrate5 with or without the system, with the energy charges and optional demand charges of a compiled rate
+static double utilityrate5_bill(std::vector<ssc_number_t> &gen, std::vector<ssc_number_t> &load, int meteringOption, bool withSystem,
+	util::matrix_t<size_t> &weekday, util::matrix_t<size_t> &weekend, util::matrix_t<double> &ecRates,
+	util::matrix_t<double> *dcTou = 0, util::matrix_t<double> *dcFlat = 0)
+{
+	ssc_data_t data = ssc_data_create();
+	ssc_number_t zero = 0;
+	ssc_data_set_number(data, "analysis_period", 1);
+	ssc_data_set_number(data, "system_use_lifetime_output", 0);
+	ssc_data_set_number(data, "inflation_rate", 0);
+	ssc_data_set_array(data, "degradation", &zero, 1);
+	ssc_data_set_array(data, "gen", &gen[0], (int)gen.size());
+	ssc_data_set_array(data, "load", &load[0], (int)load.size());
+	ssc_data_set_number(data, "ur_metering_option", meteringOption);
+
+	auto setMatrix = [data](const char *name, const double *values, size_t nrows, size_t ncols)
+	{
+		std::vector<ssc_number_t> m(values, values + nrows * ncols);
+		ssc_data_set_matrix(data, name, &m[0], (int)nrows, (int)ncols);
+	};
+	std::vector<double> weekdayValues(weekday.data(), weekday.data() + weekday.ncells());
+	std::vector<double> weekendValues(weekend.data(), weekend.data() + weekend.ncells());
+	setMatrix("ur_ec_sched_weekday", &weekdayValues[0], weekday.nrows(), weekday.ncols());
+	setMatrix("ur_ec_sched_weekend", &weekendValues[0], weekend.nrows(), weekend.ncols());
+	setMatrix("ur_ec_tou_mat", ecRates.data(), ecRates.nrows(), ecRates.ncols());
+	if (dcTou && dcFlat)
+	{
+		ssc_data_set_number(data, "ur_dc_enable", 1);
+		setMatrix("ur_dc_sched_weekday", &weekdayValues[0], weekday.nrows(), weekday.ncols());
+		setMatrix("ur_dc_sched_weekend", &weekendValues[0], weekend.nrows(), weekend.ncols());
+		setMatrix("ur_dc_tou_mat", dcTou->data(), dcTou->nrows(), dcTou->ncols());
+		setMatrix("ur_dc_flat_mat", dcFlat->data(), dcFlat->nrows(), dcFlat->ncols());
+	}
+
+	double bill = std::numeric_limits<double>::quiet_NaN();
+	ssc_module_exec_set_print(0);
+	ssc_module_t module = ssc_module_create("utilityrate5");
+	if (ssc_module_exec(module, data))
+	{
+		int n = 0;
+		ssc_number_t *bills = ssc_data_get_array(data, withSystem ? "utility_bill_w_sys" : "utility_bill_wo_sys", &n);
+		if (bills && n > 1)
+			bill = bills[1];
+	}
+	ssc_module_free(module);
+	ssc_data_free(data);
+	return bill;
+}
+
+TEST_F(CompiledUtilityRateTest, BillMatchesUtilityRate5_lib_utility_rate)
+{
+	// a load with a weekly peak day, and a midday generation profile exporting around noon
+	std::vector<ssc_number_t> gen(8760), load(8760);
+	std::vector<double> grid(8760), loadOnly(8760);
+	for (size_t i = 0; i < 8760; i++)
+	{
+		size_t hour = i % 24;
+		load[i] = (i / 24) % 7 == 0 ? 1.5f : 1.0f;
+		gen[i] = (hour >= 8 && hour < 17) ? (ssc_number_t)(2.5 * sin(M_PI * (hour - 7) / 10.0)) : 0;
+		grid[i] = load[i] - gen[i];
+		loadOnly[i] = load[i];
+	}
+
+	// untiered TOU energy charges, a TOU demand charge in period 2 and a two tier flat demand charge:
+	// imports at buy rates and exports at sell rates are net billing
+	double untiered[2][6] = { { 1, 1, 1e38, 0, 0.10, 0.02 }, { 2, 1, 1e38, 0, 0.25, 0.05 } };
+	util::matrix_t<double> ecRates(2, 6);
+	for (size_t r = 0; r < 2; r++)
+		for (size_t c = 0; c < 6; c++)
+			ecRates.at(r, c) = untiered[r][c];
+	util::matrix_t<double> dcTou(2, 4, 0.0), dcFlat(24, 4, 0.0);
+	double touRows[2][4] = { { 1, 1, 1e38, 0 }, { 2, 1, 1e38, 5 } };
+	for (size_t r = 0; r < 2; r++)
+		for (size_t c = 0; c < 4; c++)
+			dcTou.at(r, c) = touRows[r][c];
+	for (size_t m = 0; m < 12; m++)
+	{
+		double row0[4] = { (double)m, 1, 1.2, 10 };
+		double row1[4] = { (double)m, 2, 1e38, 20 };
+		for (size_t c = 0; c < 4; c++)
+		{
+			dcFlat.at(2 * m, c) = row0[c];
+			dcFlat.at(2 * m + 1, c) = row1[c];
+		}
+	}
+
+	CompiledUtilityRate rate;
+	ASSERT_TRUE(rate.compileEnergyCharges(m_weekday, m_weekend, ecRates));
+	ASSERT_TRUE(rate.compileDemandCharges(m_weekday, m_weekend, dcTou, dcFlat));
+	double bill = rate.calculateBill(&grid[0]);
+	double expected = utilityrate5_bill(gen, load, 2, true, m_weekday, m_weekend, ecRates, &dcTou, &dcFlat);
+	EXPECT_GT(bill, 0);
+	EXPECT_NEAR(bill, expected, 1e-5 * bill);
+
+	// tiered energy charges without exports are split over the tiers in proportion to each period's share,
+	// which is the monthly reconciliation of net metering
+	double tiered[4][6] = { { 1, 1, 500, 0, 0.10, 0.02 }, { 1, 2, 1e38, 0, 0.12, 0.03 }, { 2, 1, 500, 0, 0.25, 0.05 }, { 2, 2, 1e38, 0, 0.30, 0.06 } };
+	ecRates.resize(4, 6);
+	for (size_t r = 0; r < 4; r++)
+		for (size_t c = 0; c < 6; c++)
+			ecRates.at(r, c) = tiered[r][c];
+
+	CompiledUtilityRate tieredRate;
+	ASSERT_TRUE(tieredRate.compileEnergyCharges(m_weekday, m_weekend, ecRates));
+	bill = tieredRate.calculateBill(&loadOnly[0]);
+	expected = utilityrate5_bill(gen, load, 0, false, m_weekday, m_weekend, ecRates);
+	EXPECT_NEAR(bill, expected, 1e-5 * bill);
+}
+
+TEST_F(CompiledUtilityRateTest, CalculatorUsesCompiledPeriods_lib_utility_rate)
+{
+	UtilityRate utilityRate(m_weekday, m_weekend, m_ecRates);
+	UtilityRateCalculator calculator(&utilityRate, 1);
+
+	// the period from the schedules, looked up by month, hour and day of week
+	for (size_t hourOfYear = 0; hourOfYear < 8760; hourOfYear++)
+	{
+		size_t month, hour;
+		util::month_hour(hourOfYear, month, hour);
+		size_t period = util::weekday(hourOfYear) ? m_weekday.at(month - 1, hour - 1) : m_weekend.at(month - 1, hour - 1);
+
+		ASSERT_EQ(calculator.getEnergyPeriod(hourOfYear), period) << "hour " << hourOfYear;
+		ASSERT_EQ(calculator.getEnergyRate(hourOfYear), m_ecRates.at(period - 1, 4)) << "hour " << hourOfYear;
+	}
+}
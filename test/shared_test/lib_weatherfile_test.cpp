@@ -1,6 +1,16 @@
 #include <string>
 #include <vector>
 #include <cmath>
+#include <cstdio>
+
+#ifdef _WIN32
+#include <direct.h>
+#include <process.h>
+#define getpid _getpid
+#define rmdir _rmdir
+#else
+#include <unistd.h>
+#endif
  
 #include <gtest/gtest.h>
 #include "lib_weatherfile.h"
@@ -49,6 +59,52 @@ TEST_F(CSVCase_WeatherfileTest, initTest){
 	EXPECT_FALSE(wf.has_data_column(4));
 }
 
+/// Opening the same file through the binary cache gives the same header and records as parsing it
+TEST_F(CSVCase_WeatherfileTest, binaryCacheTest_lib_weatherfile){
+	// new, empty directory for this process
+	const char *tmp = std::getenv("TMPDIR");
+	if (!tmp) tmp = std::getenv("TEMP");
+	if (!tmp) tmp = "/tmp";
+	char cachedir[256];
+	sprintf(cachedir, "%s/ssc_wfcache_test_%d", tmp, (int)getpid());
+	ASSERT_TRUE(util::mkdir(cachedir));
+	weatherfile::set_cache_dir(cachedir);
+	std::string cachefile = weatherfile::cache_file(file);
+	ASSERT_FALSE(cachefile.empty());
+
+	weatherfile first, cached;
+	bool opened = first.open(file);	// parses and writes the cache
+	bool written = util::file_exists(cachefile.c_str());
+	bool reopened = cached.open(file);	// loads from the cache
+	weatherfile::set_cache_dir("");
+
+	util::remove_file(cachefile.c_str());
+	EXPECT_EQ(rmdir(cachedir), 0);
+
+	ASSERT_TRUE(opened);
+	ASSERT_TRUE(written);
+	ASSERT_TRUE(reopened);
+
+	EXPECT_EQ(cached.header().city, wf.header().city);
+	EXPECT_EQ(cached.header().lat, wf.header().lat);
+	EXPECT_EQ(cached.type(), wf.type());
+	EXPECT_EQ(cached.nrecords(), wf.nrecords());
+	EXPECT_EQ(cached.step_sec(), wf.step_sec());
+	for (size_t c = 0; c < weather_data_provider::_MAXCOL_; c++)
+		EXPECT_EQ(cached.has_data_column(c), wf.has_data_column(c)) << "column " << c;
+
+	weather_record r0, r1;
+	for (size_t i = 0; i < wf.nrecords(); i++)
+	{
+		wf.read(&r0);
+		cached.read(&r1);
+		EXPECT_EQ(r0.hour, r1.hour);
+		EXPECT_EQ(r0.dn, r1.dn);
+		EXPECT_EQ(r0.tdry, r1.tdry);
+		EXPECT_EQ(r0.pres, r1.pres);
+	}
+}
+
 TEST_F(CSVCase_WeatherfileTest, normalizeCityTest_lib_weatherfile){
 	EXPECT_EQ("Buenos Aires", wf.normalize_city("buenos aires"));
 }
@@ -45,4 +45,48 @@ TEST_F(windDataProviderCalculatorTest, FindClosestUsingData_lib_windfile_test) {
 	EXPECT_NEAR(spd, 5, e) << "case 2";
 	EXPECT_NEAR(dir, 200, e) << "case 2";
 	EXPECT_NEAR(heightOfClosestMeasuredSpd, 90, e) << "case 2";
-}
\ No newline at end of file
+}
+
+/// read_all gives the same resource as reading the file record by record
+TEST_F(windDataProviderCalculatorTest, ReadAllMatchesRead_lib_windfile_test) {
+	windDataProvider = nullptr;
+	char file[256];
+	sprintf(file, "%s/test/input_docs/AR Northwestern-Flat Lands.srw", std::getenv("SSCDIR"));
+
+	for (double hubHeight : {80.0, 95.0, 120.0}) {
+		windfile byRecord(file), allRecords(file);
+		ASSERT_TRUE(byRecord.ok()) << byRecord.error();
+
+		winddata_columns resource;
+		ASSERT_TRUE(allRecords.read_all(hubHeight, true, resource)) << allRecords.error();
+		ASSERT_EQ(resource.size(), byRecord.nrecords());
+
+		double pres, temp, spd, dir, spdHeight, dirHeight;
+		for (size_t i = 0; i < resource.size(); i++) {
+			ASSERT_TRUE(byRecord.read(hubHeight, &spd, &dir, &temp, &pres, &spdHeight, &dirHeight, true));
+			EXPECT_EQ(resource.speed[i], spd) << "record " << i;
+			EXPECT_EQ(resource.direction[i], dir) << "record " << i;
+			EXPECT_EQ(resource.temperature[i], temp) << "record " << i;
+			EXPECT_EQ(resource.pressure[i], pres) << "record " << i;
+			EXPECT_EQ(resource.speedMeasHeight, spdHeight);
+			EXPECT_EQ(resource.dirMeasHeight, dirHeight);
+		}
+	}
+}
+
+TEST_F(windDataProviderCalculatorTest, ReadAllUsingData_lib_windfile_test) {
+	var_data* windresourcedata = create_winddata_array(1,2);
+	windDataProvider = new winddata(windresourcedata);
+
+	winddata_columns resource;
+	ASSERT_TRUE(windDataProvider->read_all(85, true, resource));
+	ASSERT_EQ(resource.size(), windDataProvider->nrecords());
+	EXPECT_NEAR(resource.pressure[0], 0.975, e);
+	EXPECT_NEAR(resource.temperature[0], 52.5, e);
+	EXPECT_NEAR(resource.speed[0], 2.5, e);
+	EXPECT_NEAR(resource.direction[0], 190, e);
+	EXPECT_NEAR(resource.speedMeasHeight, 85, e);
+
+	// everything has been read
+	EXPECT_FALSE(windDataProvider->read_all(85, true, resource));
+}
@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <cmath>
+#include <cstdio>
 #include <iostream>
 #include <vector>
 
@@ -87,4 +90,158 @@ TEST_F(windPowerCalculatorTest, windPowerUsingWeibull_lib_windwatts){
 
 	double energyTotal = wpc.windPowerUsingWeibull(weibullK, avgSpeed, refHeight, &energy[0]); // runs method we want to test
 	EXPECT_NEAR(energyTotal, 5639180, e);
-}
\ No newline at end of file
+}
+
+/// Wake table interpolation against the exact wake calculation for a 3x3 farm with 4 rotor diameter spacing
+TEST(windPowerCalculatorWakeTableTest, MatchesExactWakeModel_lib_windwatts){
+	windTurbine wt;
+	createDefaultTurbine(&wt);
+
+	windPowerCalculator wpc;
+	wpc.windTurb = &wt;
+	wpc.turbulenceIntensity = 0.1;
+	for (int i = 0; i < 3; i++){
+		for (int j = 0; j < 3; j++){
+			wpc.XCoords.push_back(i * 4 * wt.rotorDiameter);
+			wpc.YCoords.push_back(j * 4 * wt.rotorDiameter);
+		}
+	}
+	wpc.nTurbines = wpc.XCoords.size();
+	wpc.InitializeModel(std::make_shared<parkWakeModel>(parkWakeModel(wpc.nTurbines, &wt)));
+
+	double farmPower = 0.;
+	ASSERT_TRUE(wpc.buildWakeTable(1., 0.25, 0.8, 1.5, 0.05));
+	EXPECT_TRUE(wpc.hasWakeTable());
+
+	size_t n = wpc.nTurbines;
+	std::vector<double> power(n), thrust(n), eff(n), windSpeed(n), turbulence(n), distDown(n), distCross(n);
+	std::vector<double> tablePower(n), tableEff(n);
+	double maxError = 0., exactEnergy = 0., tableEnergy = 0.;
+	for (double dir = 0.5; dir < 360.; dir += 7.3){
+		for (double speed = 2.; speed < 30.; speed += 1.7){
+			double exact = 0.;
+			ASSERT_EQ(wpc.windPowerUsingResource(speed, dir, 0.95, 15., &exact, &power[0], &thrust[0], &eff[0],
+				&windSpeed[0], &turbulence[0], &distDown[0], &distCross[0]), (int)n);
+			ASSERT_EQ(wpc.windPowerUsingWakeTable(speed, dir, 0.95, 15., &farmPower, &tablePower[0], &tableEff[0]), (int)n);
+
+			double sum = 0.;
+			for (size_t i = 0; i < n; i++)
+				sum += tablePower[i];
+			EXPECT_NEAR(sum, farmPower, 1e-6 * farmPower + 1e-3);
+
+			maxError = max_of(maxError, fabs(farmPower - exact));
+			exactEnergy += exact;
+			tableEnergy += farmPower;
+		}
+	}
+
+	// 9 turbines x 1500 kW: worst case within 3% of the farm rating, total energy within 0.5%
+	EXPECT_LT(maxError, 0.03 * 9 * 1500.);
+	EXPECT_NEAR(tableEnergy, exactEnergy, 0.005 * exactEnergy);
+
+	// free stream turbine is exact, so no power below cut in or above cut out
+	wpc.windPowerUsingWakeTable(1., 90., 1., 15., &farmPower, NULL, NULL);
+	EXPECT_EQ(farmPower, 0.);
+	wpc.windPowerUsingWakeTable(35., 90., 1., 15., &farmPower, NULL, NULL);
+	EXPECT_EQ(farmPower, 0.);
+}
+
+
+/// The threaded wake pass must match the serial one exactly, over several time steps on the same wake model's threads
+TEST(windPowerCalculatorLargeFarmTest, ThreadedMatchesSerial_lib_windwatts){
+	windTurbine wt;
+	createDefaultTurbine(&wt);
+
+	int n = 64;
+	windPowerCalculator wpc;
+	wpc.windTurb = &wt;
+	for (int i = 0; i < n; i++){
+		wpc.XCoords.push_back((i % 8) * 7 * wt.rotorDiameter);
+		wpc.YCoords.push_back((i / 8) * 5 * wt.rotorDiameter);
+	}
+	wpc.nTurbines = n;
+
+	for (int model = 0; model < 3; model++){
+		std::shared_ptr<wakeModelBase> wm;
+		wpc.turbulenceIntensity = 0.1;
+		if (model == 0) wm = std::make_shared<simpleWakeModel>(simpleWakeModel(n, &wt));
+		else if (model == 1) wm = std::make_shared<parkWakeModel>(parkWakeModel(n, &wt));
+		else{
+			wpc.turbulenceIntensity = 10.;
+			wm = std::make_shared<eddyViscosityWakeModel>(eddyViscosityWakeModel(n, &wt, 0.1));
+		}
+		wpc.InitializeModel(wm);
+
+		std::vector<double> power(n), thrust(n), eff(n), windSpeed(n), turbulence(n), distDown(n), distCross(n);
+		std::vector<double> farm[2];
+		for (int pass = 0; pass < 2; pass++){
+			wm->setThreadCount(pass == 0 ? 1 : 3);
+			for (double dir = 0.; dir < 360.; dir += 45.){
+				double farmPower = 0.;
+				ASSERT_EQ(wpc.windPowerUsingResource(9., dir, 1., 15., &farmPower, &power[0], &thrust[0], &eff[0],
+					&windSpeed[0], &turbulence[0], &distDown[0], &distCross[0]), n);
+				farm[pass].push_back(farmPower);
+			}
+		}
+
+		for (size_t i = 0; i < farm[0].size(); i++){
+			EXPECT_EQ(farm[1][i], farm[0][i]) << wm->getModelName() << ", direction " << i * 45;
+			EXPECT_GT(farm[0][i], 0.);
+		}
+	}
+}
+
+/// Synthetic grid farms beyond the former 300 turbine limit: the threaded wake pass must match the serial one exactly.
+/// Prints the time per time step for each farm size and wake model, run with --gtest_also_run_disabled_tests.
+TEST(windPowerCalculatorLargeFarmTest, DISABLED_GridFarmBenchmark_lib_windwatts){
+	windTurbine wt;
+	createDefaultTurbine(&wt);
+
+	int sizes[] = { 100, 500, 2000 };
+	for (int n : sizes){
+		windPowerCalculator wpc;
+		wpc.windTurb = &wt;
+		wpc.turbulenceIntensity = 0.1;
+		int columns = (int)ceil(sqrt((double)n));
+		for (int i = 0; i < n; i++){
+			wpc.XCoords.push_back((i % columns) * 7 * wt.rotorDiameter);
+			wpc.YCoords.push_back((i / columns) * 5 * wt.rotorDiameter);
+		}
+		wpc.nTurbines = n;
+
+		for (int model = 0; model < 3; model++){
+			std::shared_ptr<wakeModelBase> wm;
+			if (model == 0) wm = std::make_shared<simpleWakeModel>(simpleWakeModel(n, &wt));
+			else if (model == 1) wm = std::make_shared<parkWakeModel>(parkWakeModel(n, &wt));
+			else{
+				wpc.turbulenceIntensity = 10.;
+				wm = std::make_shared<eddyViscosityWakeModel>(eddyViscosityWakeModel(n, &wt, 0.1));
+			}
+			wpc.InitializeModel(wm);
+
+			std::vector<double> power(n), thrust(n), eff(n), windSpeed(n), turbulence(n), distDown(n), distCross(n);
+			std::vector<double> serial, threaded;
+			double seconds[2] = { 0., 0. };
+			for (int pass = 0; pass < 2; pass++){
+				wm->setThreadCount(pass == 0 ? 1 : 4);
+				std::vector<double> &farm = (pass == 0) ? serial : threaded;
+				std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				for (double dir = 0.; dir < 360.; dir += 15.){
+					double farmPower = 0.;
+					ASSERT_EQ(wpc.windPowerUsingResource(9., dir, 1., 15., &farmPower, &power[0], &thrust[0], &eff[0],
+						&windSpeed[0], &turbulence[0], &distDown[0], &distCross[0]), n);
+					farm.push_back(farmPower);
+				}
+				seconds[pass] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			}
+
+			for (size_t i = 0; i < serial.size(); i++){
+				EXPECT_EQ(threaded[i], serial[i]) << n << " turbines, " << wm->getModelName() << ", direction " << i * 15;
+				EXPECT_GT(serial[i], 0.);
+				EXPECT_LT(serial[i], n * 1500.);
+			}
+			printf("%4d turbines %-6s: %8.3f ms/step serial, %8.3f ms/step 4 threads\n", n, wm->getModelName().c_str(),
+				1000. * seconds[0] / serial.size(), 1000. * seconds[1] / serial.size());
+		}
+	}
+}
@@ -69,6 +69,72 @@ TEST_F(CMPvsamv1PowerIntegration, DefaultLifetimeNoFinancialModel) {
 }
 
 
+/// Reusing year 1 DC power in a lifetime simulation should reproduce the full lifetime simulation
+TEST_F(CMPvsamv1PowerIntegration, LifetimeYear1ReuseMatchesFullLifetime) {
+
+	std::map<std::string, double> pairs;
+	pairs["system_use_lifetime_output"] = 1;
+	pairs["analysis_period"] = 25;
+	pairs["en_dc_lifetime_losses"] = 0;
+
+	double dc_degradation[25];
+	for (size_t i = 0; i < 25; i++) {
+		dc_degradation[i] = 0.5;
+	}
+	ssc_data_set_array(data, "dc_degradation", (ssc_number_t*)dc_degradation, 25);
+
+	int pvsam_errors = modify_ssc_data_and_run_module(data, "pvsamv1", pairs);
+	EXPECT_FALSE(pvsam_errors);
+
+	int n_full = 0;
+	ssc_number_t *p_gen = ssc_data_get_array(data, "gen", &n_full);
+	ASSERT_TRUE(p_gen != 0);
+	std::vector<ssc_number_t> gen_full(p_gen, p_gen + n_full);
+
+	pairs["en_lifetime_year1_reuse"] = 1;
+	pvsam_errors = modify_ssc_data_and_run_module(data, "pvsamv1", pairs);
+	EXPECT_FALSE(pvsam_errors);
+
+	int n_reuse = 0;
+	p_gen = ssc_data_get_array(data, "gen", &n_reuse);
+	ASSERT_TRUE(p_gen != 0);
+	ASSERT_EQ(n_full, n_reuse);
+	for (int i = 0; i < n_full; i++)
+		EXPECT_NEAR(gen_full[i], p_gen[i], 1e-6) << "gen at lifetime step " << i;
+}
+
+/// The snow cover carries over from one year to the next, so year 1 is not reused with the snow model
+TEST_F(CMPvsamv1PowerIntegration, LifetimeYear1ReuseWithSnowModel) {
+
+	std::map<std::string, double> pairs;
+	pairs["system_use_lifetime_output"] = 1;
+	pairs["analysis_period"] = 3;
+	pairs["en_dc_lifetime_losses"] = 0;
+	pairs["en_snow_model"] = 1;
+
+	double dc_degradation[3] = { 0.5, 0.5, 0.5 };
+	ssc_data_set_array(data, "dc_degradation", (ssc_number_t*)dc_degradation, 3);
+
+	int pvsam_errors = modify_ssc_data_and_run_module(data, "pvsamv1", pairs);
+	EXPECT_FALSE(pvsam_errors);
+
+	int n_full = 0;
+	ssc_number_t *p_gen = ssc_data_get_array(data, "gen", &n_full);
+	ASSERT_TRUE(p_gen != 0);
+	std::vector<ssc_number_t> gen_full(p_gen, p_gen + n_full);
+
+	pairs["en_lifetime_year1_reuse"] = 1;
+	pvsam_errors = modify_ssc_data_and_run_module(data, "pvsamv1", pairs);
+	EXPECT_FALSE(pvsam_errors);
+
+	int n_reuse = 0;
+	p_gen = ssc_data_get_array(data, "gen", &n_reuse);
+	ASSERT_TRUE(p_gen != 0);
+	ASSERT_EQ(n_full, n_reuse);
+	for (int i = 0; i < n_full; i++)
+		ASSERT_EQ(gen_full[i], p_gen[i]) << "gen at lifetime step " << i;
+}
+
 /// Test PVSAMv1 with all defaults and residential financial model
 TEST_F(CMPvsamv1PowerIntegration, DefaultResidentialModel)
 {
@@ -589,6 +655,160 @@ TEST_F(CMPvsamv1PowerIntegration, NoFinancialModelMultipleMPPT)
 
 }
 
+/// Subarrays and MPPT inputs calculated on several threads should reproduce the serial calculation
+TEST_F(CMPvsamv1PowerIntegration, ThreadedSubarraysMatchSerial)
+{
+	std::map<std::string, double> pairs;
+
+	pairs["inv_num_mppt"] = 2;
+	pairs["subarray1_nstrings"] = 1;
+	pairs["subarray1_modules_per_string"] = 7;
+	pairs["subarray1_mppt_input"] = 1;
+	pairs["subarray1_tilt"] = 20;
+	pairs["subarray2_enable"] = 1;
+	pairs["subarray2_nstrings"] = 1;
+	pairs["subarray2_modules_per_string"] = 7;
+	pairs["subarray2_azimuth"] = 90;
+	pairs["subarray2_mppt_input"] = 1;
+	pairs["subarray3_enable"] = 1;
+	pairs["subarray3_nstrings"] = 1;
+	pairs["subarray3_modules_per_string"] = 6;
+	pairs["subarray3_tilt"] = 0;
+	pairs["subarray3_mppt_input"] = 2;
+	pairs["subarray4_enable"] = 1;
+	pairs["subarray4_nstrings"] = 1;
+	pairs["subarray4_modules_per_string"] = 6;
+	pairs["subarray4_track_mode"] = 1;
+	pairs["subarray4_mppt_input"] = 2;
+
+	std::vector<std::string> outputs = { "gen", "dc_net", "inverterMPPT1_DCVoltage", "inverterMPPT2_DCVoltage",
+		"subarray1_dc_gross", "subarray2_dc_gross", "subarray3_dc_gross", "subarray4_dc_gross",
+		"subarray1_poa_eff", "subarray4_poa_eff" };
+
+	pairs["n_threads"] = 1;
+	int pvsam_errors = modify_ssc_data_and_run_module(data, "pvsamv1", pairs);
+	EXPECT_FALSE(pvsam_errors);
+
+	std::vector<std::vector<ssc_number_t>> serial;
+	for (size_t k = 0; k < outputs.size(); k++)
+	{
+		int n = 0;
+		ssc_number_t *p = ssc_data_get_array(data, outputs[k].c_str(), &n);
+		ASSERT_TRUE(p != 0) << outputs[k];
+		serial.push_back(std::vector<ssc_number_t>(p, p + n));
+	}
+
+	pairs["n_threads"] = 4;
+	pvsam_errors = modify_ssc_data_and_run_module(data, "pvsamv1", pairs);
+	EXPECT_FALSE(pvsam_errors);
+
+	for (size_t k = 0; k < outputs.size(); k++)
+	{
+		int n = 0;
+		ssc_number_t *p = ssc_data_get_array(data, outputs[k].c_str(), &n);
+		ASSERT_TRUE(p != 0) << outputs[k];
+		ASSERT_EQ(serial[k].size(), (size_t)n) << outputs[k];
+		for (int i = 0; i < n; i++)
+			ASSERT_EQ(serial[k][i], p[i]) << outputs[k] << " at step " << i;
+	}
+}
+
+/// Test that runs restarting from the cached subarray DC power match full runs
+TEST_F(CMPvsamv1PowerIntegration, DCCacheMatchesFullRun)
+{
+	std::vector<std::string> outputs = { "gen", "dc_net", "inverterMPPT1_DCVoltage", "subarray1_dc_gross", "subarray1_poa_eff", "poa_eff", "sol_zen" };
+	std::vector<std::string> numbers = { "annual_energy", "annual_dc_gross", "annual_dc_net", "annual_poa_eff", "annual_dc_loss_ond" };
+
+	auto get_results = [&](std::vector<std::vector<ssc_number_t>> &arrays, std::vector<ssc_number_t> &values)
+	{
+		arrays.clear();
+		values.clear();
+		for (size_t k = 0; k < outputs.size(); k++)
+		{
+			int n = 0;
+			ssc_number_t *p = ssc_data_get_array(data, outputs[k].c_str(), &n);
+			ASSERT_TRUE(p != 0) << outputs[k];
+			arrays.push_back(std::vector<ssc_number_t>(p, p + n));
+		}
+		for (size_t k = 0; k < numbers.size(); k++)
+		{
+			ssc_number_t value = 0;
+			ssc_data_get_number(data, numbers[k].c_str(), &value);
+			values.push_back(value);
+		}
+	};
+
+	// the first run fills the cache, and the second only changes losses and the inverter count
+	std::map<std::string, double> pairs;
+	pairs["en_dc_cache"] = 1;
+	int pvsam_errors = modify_ssc_data_and_run_module(data, "pvsamv1", pairs);
+	EXPECT_FALSE(pvsam_errors);
+
+	ssc_number_t tilt = 0;
+	ssc_data_get_number(data, "subarray1_tilt", &tilt);
+
+	std::map<std::string, double> downstream[2];
+	downstream[0]["subarray1_tilt"] = tilt;
+	downstream[0]["acwiring_loss"] = 2;
+	downstream[0]["subarray1_mismatch_loss"] = 3;
+	downstream[0]["inverter_count"] = 2;
+	downstream[1] = downstream[0];
+	downstream[1]["subarray1_tilt"] = 30;
+
+	// runs with en_dc_cache, returns true if the subarray DC power was loaded from the cache
+	auto run_cached = [&](std::map<std::string, double> &inputs)
+	{
+		inputs["en_dc_cache"] = 1;
+		for (std::map<std::string, double>::iterator it = inputs.begin(); it != inputs.end(); it++)
+			ssc_data_set_number(data, it->first.c_str(), static_cast<ssc_number_t>(it->second));
+
+		ssc_module_t module = ssc_module_create("pvsamv1");
+		EXPECT_TRUE(module != 0);
+		EXPECT_TRUE(ssc_module_exec(module, data) != 0);
+		bool loaded = false;
+		int type = 0;
+		float time = 0;
+		for (int j = 0; const char *text = ssc_module_log(module, j, &type, &time); j++)
+			loaded = loaded || std::string(text).find("loaded from the cache") != std::string::npos;
+		ssc_module_free(module);
+		return loaded;
+	};
+
+	std::vector<std::vector<ssc_number_t>> cached_arrays[2], full_arrays;
+	std::vector<ssc_number_t> cached_values[2], full_values;
+	for (int i = 0; i < 2; i++)
+	{
+		pairs = downstream[i];
+		EXPECT_EQ(run_cached(pairs), i == 0) << "run " << i;
+		get_results(cached_arrays[i], cached_values[i]);
+	}
+
+	// runs without en_dc_cache are full runs that leave the cached results in place
+	for (int i = 0; i < 2; i++)
+	{
+		pairs = downstream[i];
+		pairs["en_dc_cache"] = 0;
+		pvsam_errors = modify_ssc_data_and_run_module(data, "pvsamv1", pairs);
+		EXPECT_FALSE(pvsam_errors);
+		get_results(full_arrays, full_values);
+
+		for (size_t k = 0; k < outputs.size(); k++)
+		{
+			ASSERT_EQ(cached_arrays[i][k].size(), full_arrays[k].size()) << outputs[k];
+			for (size_t j = 0; j < full_arrays[k].size(); j++)
+				ASSERT_EQ(cached_arrays[i][k][j], full_arrays[k][j]) << outputs[k] << " at step " << j << " run " << i;
+		}
+		for (size_t k = 0; k < numbers.size(); k++)
+			EXPECT_EQ(cached_values[i][k], full_values[k]) << numbers[k] << " run " << i;
+	}
+
+	for (int i = 0; i < 2; i++)
+	{
+		pairs = downstream[i];
+		EXPECT_TRUE(run_cached(pairs)) << "run " << i;
+	}
+}
+
 /// Test PVSAMv1 with Snow Model enabled and set to 1-axis Tracking
 TEST_F(CMPvsamv1PowerIntegration, SnowModel)
 {
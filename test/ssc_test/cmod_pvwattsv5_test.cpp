@@ -37,4 +37,34 @@ TEST_F(CMPvwattsV5Integration, DefaultNoFinancialModel){
 	ssc_data_get_number(data, "capacity_factor", &capacity_factor);
 	EXPECT_NEAR(capacity_factor, 19.7197, error_tolerance) << "Capacity factor";
 
-}
\ No newline at end of file
+}
+/// Batch execution over a thread pool gives the same results as running each case on its own
+TEST_F(CMPvwattsV5Integration, BatchExecutionMatchesSerial){
+	const int n = 4;
+	ssc_data_t batch[n];
+	ssc_number_t serial_energy[n];
+	for (int i = 0; i < n; i++)
+	{
+		batch[i] = ssc_data_create();
+		EXPECT_FALSE(pvwattsv5_nofinancial_testfile(batch[i]));
+		ssc_data_set_number(batch[i], "tilt", (ssc_number_t)(10 * i));
+
+		ssc_data_t single = ssc_data_create();
+		pvwattsv5_nofinancial_testfile(single);
+		ssc_data_set_number(single, "tilt", (ssc_number_t)(10 * i));
+		EXPECT_TRUE(ssc_module_exec_simple("pvwattsv5", single));
+		ssc_data_get_number(single, "annual_energy", &serial_energy[i]);
+		ssc_data_free(single);
+	}
+
+	ssc_bool_t results[n];
+	EXPECT_TRUE(ssc_module_exec_batch("pvwattsv5", batch, n, 3, results));
+	for (int i = 0; i < n; i++)
+	{
+		EXPECT_TRUE(results[i]);
+		ssc_number_t annual_energy = 0;
+		ssc_data_get_number(batch[i], "annual_energy", &annual_energy);
+		EXPECT_EQ(annual_energy, serial_energy[i]) << "Batch case " << i;
+		ssc_data_free(batch[i]);
+	}
+}
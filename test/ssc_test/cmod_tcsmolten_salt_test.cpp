@@ -1,8 +1,18 @@
 #include <gtest/gtest.h>
 
+#ifdef _WIN32
+#include <direct.h>
+#include <process.h>
+#define getpid _getpid
+#define rmdir _rmdir
+#else
+#include <unistd.h>
+#endif
+
 #include "cmod_tcsmolten_salt_test.h"
 #include "../input_cases/tcsmolten_salt_cases.h"
 #include "../input_cases/weather_inputs.h"
+#include "csp_common.h"
 
 /// Test tcsmolten_salt with all defaults and the single owner financial model
 TEST_F(CMTcsMoltenSalt, DefaultSingleOwnerFinancialModel) {
@@ -71,6 +81,225 @@ TEST_F(CMTcsMoltenSalt, DefaultSingleOwnerFinancialModel) {
     }
 }
 
+/// Runs a module and returns the cache file named in its log if the solar field was loaded from the cache
+static std::string run_solarpilot_cached(ssc_data_t data, int *status, const char *module_name = "solarpilot")
+{
+    std::string loaded = "";
+    ssc_module_t module = ssc_module_create(module_name);
+    *status = ssc_module_exec(module, data) ? 0 : 1;
+    const char *text;
+    int type;
+    float time;
+    std::string prefix = "Solar field layout and flux maps loaded from cache ";
+    for (int i = 0; (text = ssc_module_log(module, i, &type, &time)) != 0; i++)
+        if (std::string(text).find(prefix) == 0)
+            loaded = text + prefix.length();
+    ssc_module_free(module);
+    return loaded;
+}
+
+/// A second field calculation with the same inputs loads the flux tables from the solar field cache
+TEST_F(CMTcsMoltenSalt, SolarFieldCache) {
+    // new, empty directory for this process
+    const char *tmp = std::getenv("TMPDIR");
+    if (!tmp) tmp = std::getenv("TEMP");
+    if (!tmp) tmp = "/tmp";
+    char cachedir[256];
+    sprintf(cachedir, "%s/ssc_spcache_test_%d", tmp, (int)getpid());
+    ASSERT_TRUE(util::mkdir(cachedir));
+    solarpilot_invoke::set_cache_dir(cachedir);
+
+    ssc_data_t cached = ssc_data_create();
+    tcsmolten_salt_default(cached);
+    ssc_data_t cases[] = { data, cached };
+    for (int k = 0; k < 2; k++)
+    {
+        set_matrix(cases[k], "helio_positions_in", helio_positions_path, 8790, 2);
+        ssc_data_set_number(cases[k], "calc_fluxmaps", 1);
+        ssc_data_set_number(cases[k], "n_flux_days", 2);
+        ssc_data_set_number(cases[k], "optimize", 0);
+        // conversions made by tcsmolten_salt before it runs the field calculations
+        ssc_data_set_number(cases[k], "helio_optical_error", 1.53e-3);
+        ssc_data_set_number(cases[k], "rec_aspect", 21.6029 / 17.65);
+        ssc_data_set_number(cases[k], "q_design", 115. / 0.412 * 2.4);
+        ssc_data_set_number(cases[k], "n_flux_x", 20);
+        ssc_data_set_number(cases[k], "n_flux_y", 1);
+    }
+
+    int status_calc, status_load;
+    std::string calc_file = run_solarpilot_cached(data, &status_calc);      // calculates the field and writes the cache
+    std::string load_file = run_solarpilot_cached(cached, &status_load);    // loads the field from the cache
+    solarpilot_invoke::set_cache_dir("");
+
+    bool written = !load_file.empty() && util::file_exists(load_file.c_str());
+    if (!load_file.empty())
+        util::remove_file(load_file.c_str());
+    EXPECT_EQ(rmdir(cachedir), 0);
+
+    ASSERT_FALSE(status_calc);
+    ASSERT_FALSE(status_load);
+    EXPECT_TRUE(calc_file.empty());
+    ASSERT_TRUE(written);
+    EXPECT_EQ(load_file.find(cachedir), 0);
+
+    const char *outputs[] = { "opteff_table", "flux_table", "heliostat_positions", 0 };
+    for (int k = 0; outputs[k] != 0; k++)
+    {
+        int nr, nc, nr_cached, nc_cached;
+        ssc_number_t *calc = ssc_data_get_matrix(data, outputs[k], &nr, &nc);
+        ssc_number_t *load = ssc_data_get_matrix(cached, outputs[k], &nr_cached, &nc_cached);
+        ASSERT_TRUE(calc != 0 && load != 0) << outputs[k];
+        ASSERT_EQ(nr, nr_cached) << outputs[k];
+        ASSERT_EQ(nc, nc_cached) << outputs[k];
+        for (int i = 0; i < nr * nc; i++)
+            EXPECT_EQ(calc[i], load[i]) << outputs[k] << " " << i;
+    }
+
+    const char *numbers[] = { "h_tower_opt", "rec_height_opt", "rec_aspect_opt", "area_sf", "land_area", "cost_sf_tot", "cost_rec_tot", 0 };
+    for (int k = 0; numbers[k] != 0; k++)
+    {
+        ssc_number_t calc, load;
+        ssc_data_get_number(data, numbers[k], &calc);
+        ssc_data_get_number(cached, numbers[k], &load);
+        EXPECT_EQ(calc, load) << numbers[k];
+    }
+    ssc_data_free(cached);
+}
+
+/// An optimized field loaded from the cache reports the optimization history of the run that wrote the cache
+TEST_F(CMTcsMoltenSalt, SolarFieldCacheOptimized) {
+    const char *tmp = std::getenv("TMPDIR");
+    if (!tmp) tmp = std::getenv("TEMP");
+    if (!tmp) tmp = "/tmp";
+    char cachedir[256];
+    sprintf(cachedir, "%s/ssc_spcache_opt_test_%d", tmp, (int)getpid());
+    ASSERT_TRUE(util::mkdir(cachedir));
+    solarpilot_invoke::set_cache_dir(cachedir);
+
+    ssc_data_t cached = ssc_data_create();
+    tcsmolten_salt_default(cached);
+    ssc_data_t cases[] = { data, cached };
+    for (int k = 0; k < 2; k++)
+    {
+        ssc_data_set_number(cases[k], "field_model_type", 0);
+        ssc_data_set_number(cases[k], "opt_max_iter", 2);
+        ssc_data_set_number(cases[k], "n_flux_days", 2);
+        ssc_data_set_number(cases[k], "time_stop", 24 * 3600);
+    }
+
+    int status_calc, status_load;
+    std::string calc_file = run_solarpilot_cached(data, &status_calc, "tcsmolten_salt");
+    std::string load_file = run_solarpilot_cached(cached, &status_load, "tcsmolten_salt");
+    solarpilot_invoke::set_cache_dir("");
+
+    if (!load_file.empty())
+        util::remove_file(load_file.c_str());
+    EXPECT_EQ(rmdir(cachedir), 0);
+
+    ASSERT_FALSE(status_calc);
+    ASSERT_FALSE(status_load);
+    EXPECT_TRUE(calc_file.empty());
+    EXPECT_FALSE(load_file.empty());
+
+    int nr, nc, nr_cached, nc_cached;
+    ssc_number_t *calc = ssc_data_get_matrix(data, "opt_history", &nr, &nc);
+    ssc_number_t *load = ssc_data_get_matrix(cached, "opt_history", &nr_cached, &nc_cached);
+    ASSERT_TRUE(calc != 0);
+    ASSERT_TRUE(load != 0);
+    ASSERT_GT(nr, 0);
+    ASSERT_EQ(nr, nr_cached);
+    ASSERT_EQ(nc, nc_cached);
+    for (int i = 0; i < nr * nc; i++)
+        EXPECT_EQ(calc[i], load[i]) << "opt_history " << i;
+    ssc_data_free(cached);
+}
+
+/// Dispatch optimization over several horizons updates the same LP model and reports its build time
+TEST_F(CMTcsMoltenSalt, DispatchModelReused) {
+    ssc_data_set_number(data, "is_dispatch", 1);
+    ssc_data_set_number(data, "time_stop", 4 * 24 * 3600);
+    int status = run_module(data, "tcsmolten_salt");
+    ASSERT_FALSE(status);
+
+    int n, n_build, n_solve;
+    ssc_number_t *solve_state = ssc_data_get_array(data, "disp_solve_state", &n);
+    ssc_number_t *build_time = ssc_data_get_array(data, "disp_build_time", &n_build);
+    ssc_number_t *solve_time = ssc_data_get_array(data, "disp_solve_time", &n_solve);
+    ASSERT_TRUE(build_time != 0);
+    ASSERT_EQ(n_build, n);
+    ASSERT_EQ(n_solve, n);
+    for (int h = 0; h < 96; h += 24)
+    {
+        EXPECT_GE(solve_state[h], 0) << "hour " << h;     // optimal or suboptimal
+        EXPECT_LE(solve_state[h], 1) << "hour " << h;
+        EXPECT_GT(build_time[h], 0.) << "hour " << h;
+        EXPECT_LT(build_time[h], solve_time[h]) << "hour " << h;
+    }
+
+    ssc_number_t *objective = ssc_data_get_array(data, "disp_objective", &n);
+    EXPECT_NEAR(objective[0], 5770663.5, 5770663.5 * m_error_tolerance_lo) << "Objective first horizon";
+    EXPECT_NEAR(objective[72], 317112.56, 317112.56 * m_error_tolerance_lo) << "Objective fourth horizon";
+
+    ssc_number_t annual_energy;
+    ssc_data_get_number(data, "annual_energy", &annual_energy);
+    EXPECT_NEAR(annual_energy, 2059785.25, 2059785.25 * m_error_tolerance_lo) << "Annual Energy";
+}
+
+/// Solver profiling reports work per timestep without changing the results
+TEST_F(CMTcsMoltenSalt, SolverProfile) {
+    ssc_data_set_number(data, "time_stop", 4 * 24 * 3600);
+    int status = run_module(data, "tcsmolten_salt");
+    ASSERT_FALSE(status);
+
+    ssc_number_t annual_energy;
+    ssc_data_get_number(data, "annual_energy", &annual_energy);
+
+    ssc_data_set_number(data, "is_solver_profile", 1);
+    status = run_module(data, "tcsmolten_salt");
+    ASSERT_FALSE(status);
+
+    ssc_number_t annual_energy_profiled;
+    ssc_data_get_number(data, "annual_energy", &annual_energy_profiled);
+    EXPECT_EQ(annual_energy_profiled, annual_energy);
+
+    const char *counts[5] = { "profile_n_op_modes", "profile_n_cr_calls", "profile_n_pc_calls", "profile_n_tes_calls", "profile_n_eq_calls" };
+    for (int k = 0; k < 5; k++)
+    {
+        int n;
+        ssc_number_t *p_count = ssc_data_get_array(data, counts[k], &n);
+        ASSERT_TRUE(p_count != 0) << counts[k];
+        ASSERT_GE(n, 96) << counts[k];
+        ssc_number_t sum = 0.0;
+        for (int h = 0; h < n; h++)
+            sum += p_count[h];
+
+        ssc_number_t annual;
+        ssc_data_get_number(data, (std::string(counts[k]) + "_ann").c_str(), &annual);
+        EXPECT_EQ(sum, annual) << counts[k];
+        EXPECT_GT(annual, 0.) << counts[k];
+    }
+
+    int n;
+    ssc_number_t *n_op_modes = ssc_data_get_array(data, "profile_n_op_modes", &n);
+    ssc_number_t *n_cr_calls = ssc_data_get_array(data, "profile_n_cr_calls", &n);
+    ssc_number_t *time_total = ssc_data_get_array(data, "profile_time_total", &n);
+    for (int h = 0; h < 96; h++)
+    {
+        EXPECT_GE(n_op_modes[h], 1.) << "hour " << h;
+        EXPECT_GE(n_cr_calls[h], n_op_modes[h]) << "hour " << h;
+        EXPECT_GT(time_total[h], 0.) << "hour " << h;
+    }
+
+    ssc_number_t time_cr, time_pc, time_tes, time_ann;
+    ssc_data_get_number(data, "profile_time_cr_ann", &time_cr);
+    ssc_data_get_number(data, "profile_time_pc_ann", &time_pc);
+    ssc_data_get_number(data, "profile_time_tes_ann", &time_tes);
+    ssc_data_get_number(data, "profile_time_total_ann", &time_ann);
+    EXPECT_GT(time_cr, 0.);
+    EXPECT_GT(time_pc, 0.);
+    EXPECT_LE(time_cr + time_pc + time_tes, time_ann);
+}
+
 //TestResult tcsmoltenSaltSingleOwnerDefaultResult[] = {
 //    /*  SSC Var Name                            Test Type           Test Result             Error Bound % */
 //    { "annual_energy",                          NR,                 5.77916e8,              0.1 },  // Annual total electric power to grid
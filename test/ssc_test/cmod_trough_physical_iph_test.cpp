@@ -117,3 +117,34 @@ TEST_F(CMTroughPhysicalIPH, DefaultLCOHFinancialModel) {
 //        { "lcoe_fcr",                           NR,                 0.0375859,              0.1 },  // Levelized cost of energy [$/kWh]
 //        { "annual_total_water_use",             NR,                 176.333,                0.1 },  // Total Annual Water Usage [m^3]
 //};
+
+/// Test trough_physical_iph with receiver heat losses interpolated from tables
+TEST_F(CMTroughPhysicalIPH, EvacSurrogateNoFinancialModel) {
+
+    ssc_data_set_number(data, "is_evac_surrogate", 1);
+    int test_errors = run_module(data, "trough_physical_process_heat");
+
+    EXPECT_FALSE(test_errors);
+    if (!test_errors)
+    {
+        ssc_number_t annual_gross_energy;
+        ssc_data_get_number(data, "annual_gross_energy", &annual_gross_energy);
+        EXPECT_NEAR(annual_gross_energy, 2.44933e7, 2.44933e7 * m_error_tolerance_lo) << "Annual Gross Energy";
+
+        ssc_number_t annual_energy;
+        ssc_data_get_number(data, "annual_energy", &annual_energy);
+        EXPECT_NEAR(annual_energy, 2.44931e7, 2.44931e7 * m_error_tolerance_lo) << "Annual Energy";
+
+        ssc_number_t annual_electricity_consumption;
+        ssc_data_get_number(data, "annual_electricity_consumption", &annual_electricity_consumption);
+        EXPECT_NEAR(annual_electricity_consumption, 122659, 122659 * m_error_tolerance_hi) << "Annual Electricity Consumption";
+
+        ssc_number_t annual_thermal_consumption;
+        ssc_data_get_number(data, "annual_thermal_consumption", &annual_thermal_consumption);
+        EXPECT_NEAR(annual_thermal_consumption, 236.609, 236.609 * m_error_tolerance_hi) << "Annual Thermal Consumption";
+
+        ssc_number_t annual_total_water_use;
+        ssc_data_get_number(data, "annual_total_water_use", &annual_total_water_use);
+        EXPECT_NEAR(annual_total_water_use, 176.333, 176.333 * m_error_tolerance_lo) << "Annual Total Water Use";
+    }
+}
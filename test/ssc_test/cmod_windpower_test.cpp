@@ -75,6 +75,53 @@ TEST_F(CMWindPowerIntegration, WakeModelsUsingFile_cmod_windpower){
 
 }
 
+/// Wake losses interpolated from a precomputed table, checked against the exact wake model
+TEST_F(CMWindPowerIntegration, WakeTable_cmod_windpower){
+	ssc_data_set_number(data, "wind_farm_wake_model", 1);
+	ssc_data_set_number(data, "wind_farm_wake_table", 1);
+	ssc_data_set_number(data, "wind_farm_wake_table_check", 1);
+	compute();
+
+	ssc_number_t annual_energy, energy_error, max_error;
+	ssc_data_get_number(data, "annual_energy", &annual_energy);
+	EXPECT_NEAR(annual_energy, 32346158, 0.005 * 32346158);
+
+	ssc_data_get_number(data, "wake_table_energy_error", &energy_error);
+	EXPECT_LT(fabs(energy_error), 0.5) << "Annual energy error, %";
+
+	ssc_data_get_number(data, "wake_table_max_error", &max_error);
+	EXPECT_GT(max_error, 0.);
+}
+
+/// The wake table check reports no error when the exact wake model is used: with the table off, for a single turbine and for Weibull
+TEST_F(CMWindPowerIntegration, WakeTableCheckWithoutTable_cmod_windpower){
+	ssc_data_set_number(data, "wind_farm_wake_table_check", 1);
+
+	for (int i = 0; i < 3; i++){
+		if (i == 1){
+			ssc_number_t coordinate = 0;
+			ssc_data_set_number(data, "wind_farm_wake_table", 1);
+			ssc_data_set_array(data, "wind_farm_xCoordinates", &coordinate, 1);
+			ssc_data_set_array(data, "wind_farm_yCoordinates", &coordinate, 1);
+		}
+		else if (i == 2)
+			ssc_data_set_number(data, "wind_resource_model_choice", 1);
+
+		ssc_module_t module = ssc_module_create("windpower");
+		ASSERT_TRUE(module != NULL);
+		EXPECT_TRUE(ssc_module_exec(module, data) != 0) << "case " << i;
+		ssc_module_free(module);
+
+		ssc_number_t max_error = -1, energy_error = -1;
+		EXPECT_TRUE(ssc_data_get_number(data, "wake_table_max_error", &max_error) != 0) << "case " << i;
+		EXPECT_TRUE(ssc_data_get_number(data, "wake_table_energy_error", &energy_error) != 0) << "case " << i;
+		EXPECT_EQ(max_error, 0.) << "case " << i;
+		EXPECT_EQ(energy_error, 0.) << "case " << i;
+		ssc_data_unassign(data, "wake_table_max_error");
+		ssc_data_unassign(data, "wake_table_energy_error");
+	}
+}
+
 /// Using Interpolated Subhourly Wind Data
 TEST_F(CMWindPowerIntegration, UsingInterpolatedSubhourly_cmod_windpower){
 	// Using AR Northwestern-Flat Lands
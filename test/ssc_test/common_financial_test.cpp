@@ -0,0 +1,117 @@
+#include <cmath>
+#include <limits>
+
+#include <gtest/gtest.h>
+
+#include "../ssc/common_financial.h"
+
+/**
+ * Cash flow rows: an investment paid back with a mid-life dip, and a payment made back and forth
+ * with no rate of return.
+ */
+class CashflowReturns : public ::testing::Test
+{
+protected:
+	util::matrix_t<double> cf;
+	int nyears;
+
+	void SetUp()
+	{
+		nyears = 25;
+		cf.resize_fill(2, nyears + 1, 0.0);
+		cf.at(0, 0) = -1000.0;
+		for (int i = 1; i <= nyears; i++)
+		{
+			cf.at(0, i) = 60.0 + 5.0*i - (i == 12 ? 150.0 : 0.0);
+			cf.at(1, i) = (i % 2 == 1) ? 500.0 : -500.0;
+		}
+		cf.at(1, 0) = -500.0;
+	}
+
+	double npv_direct(int cf_line, int count, double rate)
+	{
+		double npv = 0;
+		for (int i = 1; i <= count; i++)
+			npv += cf.at(cf_line, i) / pow(1.0 + rate, i);
+		return npv;
+	}
+};
+
+TEST_F(CashflowReturns, NpvMatchesDirectSum_common_financial)
+{
+	cashflow_returns returns;
+	double rates[5] = { 0.07, 0.0, -0.3, 0.07, 0.12 };
+	for (int k = 0; k < 5; k++)
+	{
+		for (int n = 0; n <= nyears; n++)
+		{
+			double npv = npv_direct(0, n, rates[k]);
+			EXPECT_NEAR(returns.npv(cf, 0, n, rates[k]), npv, 1.e-12*(1.0 + fabs(npv))) << "rate " << rates[k] << " years " << n;
+		}
+	}
+
+	// Undiscounted at a rate of -1
+	EXPECT_NEAR(returns.npv(cf, 0, nyears, -1.0), npv_direct(0, nyears, 0.0), 1.e-9);
+	double nan = std::numeric_limits<double>::quiet_NaN();
+	EXPECT_TRUE(std::isnan(returns.npv(cf, 0, nyears, nan)));
+}
+
+TEST_F(CashflowReturns, IrrOfKnownCashFlow_common_financial)
+{
+	cashflow_returns returns;
+	util::matrix_t<double> cf_two_years(1, 3, 0.0);
+	cf_two_years.at(0, 0) = -100.0;
+	cf_two_years.at(0, 1) = 60.0;
+	cf_two_years.at(0, 2) = 60.0;
+
+	// -100 + 60 x + 60 x^2 = 0 with x = 1/(1+irr)
+	double x = (-60.0 + sqrt(60.0*60.0 + 4.0*60.0*100.0)) / (2.0*60.0);
+	EXPECT_NEAR(returns.irr(cf_two_years, 0, 2), 1.0 / x - 1.0, 1.e-6);
+
+	double irr = returns.irr(cf, 0, nyears);
+	EXPECT_NEAR(irr, 0.086919, 1.e-5);
+	EXPECT_NEAR(cf.at(0, 0) + npv_direct(0, nyears, irr), 0.0, 1.e-6*1000.0);
+}
+
+TEST_F(CashflowReturns, RunningIrrWarmStartMatchesColdStart_common_financial)
+{
+	cashflow_returns returns_warm;
+	int n_warm = 0, n_cold = 0;
+	for (int i = 1; i <= nyears; i++)
+	{
+		cashflow_returns returns_cold;
+		double irr_warm = returns_warm.irr(cf, 0, i);
+		double irr_cold = returns_cold.irr(cf, 0, i);
+
+		if (!std::isnan(irr_cold))
+		{
+			n_cold++;
+			EXPECT_NEAR(irr_warm, irr_cold, 1.e-6) << "year " << i;
+		}
+		if (!std::isnan(irr_warm))
+		{
+			n_warm++;
+			EXPECT_NEAR(cf.at(0, 0) + npv_direct(0, i, irr_warm), 0.0, 1.e-6*1000.0) << "year " << i;
+		}
+	}
+	EXPECT_GE(n_warm, n_cold);
+	EXPECT_EQ(n_warm, nyears);
+}
+
+TEST_F(CashflowReturns, IrrUndefined_common_financial)
+{
+	cashflow_returns returns;
+	EXPECT_TRUE(std::isnan(returns.irr(cf, 0, 0)));
+
+	// Payments that never return the investment
+	for (int i = 1; i <= nyears; i++)
+		cf.at(0, i) = -10.0;
+	EXPECT_TRUE(std::isnan(returns.irr(cf, 0, nyears)));
+
+	// First value positive
+	cf.at(0, 0) = 1000.0;
+	EXPECT_TRUE(std::isnan(returns.irr(cf, 0, nyears)));
+
+	// Alternating payments with no return
+	EXPECT_TRUE(std::isnan(returns.irr(cf, 1, 2)));
+}
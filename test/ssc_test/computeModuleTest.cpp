@@ -43,3 +43,86 @@ TEST_P(computeModuleTest, RunSimulationTest) {
 		}
 	}
 }
+
+/// Interned handles resolve to the same data as a lookup by name as variables come and go
+TEST(VarTableTest, InternedHandles) {
+	var_table vt;
+	var_handle h = vt.intern("Gen");
+	EXPECT_EQ(vt.lookup(h), (var_data*)0);
+	EXPECT_EQ(vt.name(h), "gen");
+
+	vt.assign("gen", var_data((ssc_number_t)2.0));
+	ASSERT_NE(vt.lookup(h), (var_data*)0);
+	EXPECT_EQ(vt.lookup(h), vt.lookup("GEN"));
+	EXPECT_EQ(vt.intern("gen").index, h.index);
+
+	vt.rename("gen", "load");
+	EXPECT_EQ(vt.lookup(h), (var_data*)0);
+	EXPECT_EQ(vt.lookup(vt.intern("load"))->num.at(0), 2.0);
+
+	vt.rename("load", "gen");
+	EXPECT_EQ(vt.lookup(h)->num.at(0), 2.0);
+
+	vt.unassign("gen");
+	EXPECT_EQ(vt.lookup(h), (var_data*)0);
+
+	vt.assign("gen", var_data((ssc_number_t)3.0));
+	vt.clear();
+	EXPECT_EQ(vt.lookup(h), (var_data*)0);
+
+	size_t n = vt.lookup_count();
+	vt.lookup("gen");
+	vt.lookup(h);
+	EXPECT_EQ(vt.lookup_count(), n + 1);
+}
+
+/// Moving a value into a table hands over its storage instead of copying it
+TEST(VarTableTest, MoveAssign) {
+	var_table vt;
+	util::matrix_t<ssc_number_t> gen(1, 8760, 1.5);
+	ssc_number_t *storage = gen.data();
+
+	var_data *v = vt.assign("gen", var_data(std::move(gen)));
+	EXPECT_EQ(v->type, SSC_ARRAY);
+	EXPECT_EQ(v->num.data(), storage);
+	EXPECT_EQ(v->num.ncols(), 8760);
+
+	// reassigning an existing variable reuses its entry
+	util::matrix_t<ssc_number_t> load(24, 365, 2.0);
+	storage = load.data();
+	EXPECT_EQ(vt.assign("GEN", var_data(std::move(load))), v);
+	EXPECT_EQ(v->type, SSC_MATRIX);
+	EXPECT_EQ(v->num.data(), storage);
+
+	var_table moved(std::move(vt));
+	EXPECT_EQ(moved.lookup("gen"), v);
+	EXPECT_EQ(vt.lookup("gen"), (var_data*)0);
+	EXPECT_EQ(vt.size(), 0);
+
+	var_table copied(moved);
+	ASSERT_NE(copied.lookup("gen"), (var_data*)0);
+	EXPECT_NE(copied.lookup("gen"), v);
+	EXPECT_EQ(copied.lookup("gen")->num.at(23, 364), 2.0);
+}
+
+/// Arrays allocated through the API are filled in place
+TEST(VarTableTest, AllocateArray) {
+	ssc_data_t data = ssc_data_create();
+	ssc_number_t *p = ssc_data_allocate_array(data, "gen", 8760);
+	ASSERT_NE(p, (ssc_number_t*)0);
+	EXPECT_EQ(p[100], 0.0);
+	for (int i = 0; i < 8760; i++)
+		p[i] = (ssc_number_t)i;
+
+	int len;
+	EXPECT_EQ(ssc_data_get_array(data, "gen", &len), p);
+	EXPECT_EQ(len, 8760);
+
+	int nr, nc;
+	ssc_number_t *m = ssc_data_allocate_matrix(data, "flux", 3, 4);
+	m[11] = 5.0;
+	EXPECT_EQ(ssc_data_get_matrix(data, "flux", &nr, &nc)[11], 5.0);
+	EXPECT_EQ(nr, 3);
+	EXPECT_EQ(nc, 4);
+	ssc_data_free(data);
+}
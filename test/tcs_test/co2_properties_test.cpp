@@ -0,0 +1,163 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../tcs/CO2_properties.h"
+
+/**
+ * Selects a CO2 property backend for the life of a test and restores the equation of state afterwards,
+ * as the backend of the test thread carries over to the following tests.
+ */
+class CO2PropertiesTest : public ::testing::Test
+{
+protected:
+	void TearDown()
+	{
+		CO2_set_backend(CO2_BACKEND_EOS);
+	}
+};
+
+TEST_F(CO2PropertiesTest, BackendScope_CO2_properties)
+{
+	{
+		CO2_backend_scope co2_backend(CO2_BACKEND_TABLES);
+		EXPECT_EQ(CO2_get_backend(), CO2_BACKEND_TABLES);
+
+		// other threads keep their own backend
+		int thread_backend = -1;
+		std::thread t([&thread_backend]() { thread_backend = CO2_get_backend(); });
+		t.join();
+		EXPECT_EQ(thread_backend, CO2_BACKEND_EOS);
+	}
+	EXPECT_EQ(CO2_get_backend(), CO2_BACKEND_EOS);
+}
+
+TEST_F(CO2PropertiesTest, TablesWithinErrorBounds_CO2_properties)
+{
+	CO2_set_backend(CO2_BACKEND_TABLES);
+	ASSERT_EQ(CO2_get_backend(), CO2_BACKEND_TABLES);
+
+	std::mt19937 gen(17);
+	std::uniform_real_distribution<double> P_dist(3000.0, 30000.0);	//[kPa]
+	std::uniform_real_distribution<double> T_dist(300.0, 900.0);		//[K]
+
+	int n_samples = 2000;
+	int n_interpolated = 0;
+	for (int k = 0; k < n_samples; k++)
+	{
+		double P = P_dist(gen);
+		double T = T_dist(gen);
+
+		CO2_state exact, table;
+		ASSERT_EQ(CO2_TP(T, P, &exact), 0);
+		double H = exact.enth;
+		double S = exact.entr;
+
+		ASSERT_EQ(CO2_PH_eos(P, H, &exact), 0);
+		ASSERT_EQ(CO2_PH(P, H, &table), 0);
+		EXPECT_NEAR(table.temp, exact.temp, 1.e-3) << "P = " << P << " H = " << H;
+		EXPECT_NEAR(table.dens, exact.dens, 1.e-5*exact.dens) << "P = " << P << " H = " << H;
+		EXPECT_NEAR(table.enth, exact.enth, 1.e-2) << "P = " << P << " H = " << H;
+		EXPECT_EQ(table.qual < 0.0 || table.qual > 1.0, true);
+		if (table.temp != exact.temp)
+			n_interpolated++;
+
+		ASSERT_EQ(CO2_PS_eos(P, S, &exact), 0);
+		ASSERT_EQ(CO2_PS(P, S, &table), 0);
+		EXPECT_NEAR(table.temp, exact.temp, 1.e-3) << "P = " << P << " S = " << S;
+		EXPECT_NEAR(table.dens, exact.dens, 1.e-5*exact.dens) << "P = " << P << " S = " << S;
+		EXPECT_NEAR(table.entr, exact.entr, 1.e-5) << "P = " << P << " S = " << S;
+	}
+
+	// Most of the sCO2 cycle range is away from the critical point
+	EXPECT_GT(n_interpolated, 0.9*n_samples);
+}
+
+TEST_F(CO2PropertiesTest, TablesFallBackToEOS_CO2_properties)
+{
+	CO2_state co2_props;
+	ASSERT_EQ(CO2_TP(305.0, 7500.0, &co2_props), 0);
+	double H_crit = co2_props.enth;
+	double S_crit = co2_props.entr;
+	ASSERT_EQ(CO2_TP(285.0, 3000.0, &co2_props), 0);
+	double H_sat_vap = co2_props.enth;
+
+	// Near the critical point, in the two phase region, and outside the tables
+	double P_H[3][2] = { {7500.0, H_crit}, {3000.0, H_sat_vap - 100.0}, {45000.0, H_crit} };
+
+	for (int k = 0; k < 3; k++)
+	{
+		CO2_state exact, table;
+		CO2_set_backend(CO2_BACKEND_EOS);
+		int err_exact = CO2_PH(P_H[k][0], P_H[k][1], &exact);
+		CO2_set_backend(CO2_BACKEND_TABLES);
+		int err_table = CO2_PH(P_H[k][0], P_H[k][1], &table);
+
+		ASSERT_EQ(err_table, err_exact);
+		EXPECT_EQ(table.temp, exact.temp) << "point " << k;
+		EXPECT_EQ(table.dens, exact.dens) << "point " << k;
+		EXPECT_EQ(table.qual, exact.qual) << "point " << k;
+	}
+
+	CO2_state exact, table;
+	ASSERT_EQ(CO2_PS_eos(7500.0, S_crit, &exact), 0);
+	ASSERT_EQ(CO2_PS(7500.0, S_crit, &table), 0);
+	EXPECT_EQ(table.temp, exact.temp);
+	EXPECT_EQ(table.dens, exact.dens);
+
+	// Errors are reported as the equation of state reports them
+	EXPECT_EQ(CO2_PH(-1.0, H_crit, &table), CO2_PH_eos(-1.0, H_crit, &exact));
+	EXPECT_EQ(CO2_PS(7500.0, 100.0, &table), CO2_PS_eos(7500.0, 100.0, &exact));
+}
+
+static double co2_us_per_call(int(*f_co2)(double, double, CO2_state*), const std::vector<double> &P, const std::vector<double> &y)
+{
+	CO2_state co2_props;
+	double T_sum = 0.0;
+	auto start = std::chrono::steady_clock::now();
+	for (size_t k = 0; k < P.size(); k++)
+	{
+		f_co2(P[k], y[k], &co2_props);
+		T_sum += co2_props.temp;
+	}
+	std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+	return T_sum > 0.0 ? elapsed.count() / P.size() : 0.0;
+}
+
+TEST_F(CO2PropertiesTest, DISABLED_Benchmark_CO2_properties)
+{
+	// Random states, and a sweep along a recuperator-like path in pressure and enthalpy
+	std::mt19937 gen(17);
+	std::uniform_real_distribution<double> P_dist(8000.0, 25000.0);
+	std::uniform_real_distribution<double> T_dist(320.0, 850.0);
+
+	int n_calls = 200000;
+	std::vector<double> P_rand(n_calls), H_rand(n_calls), S_rand(n_calls), P_sweep(n_calls), H_sweep(n_calls);
+	CO2_state co2_props;
+	CO2_state co2_low, co2_high;
+	CO2_TP(350.0, 25000.0, &co2_low);
+	CO2_TP(800.0, 24000.0, &co2_high);
+	for (int k = 0; k < n_calls; k++)
+	{
+		CO2_TP(T_dist(gen), P_rand[k] = P_dist(gen), &co2_props);
+		H_rand[k] = co2_props.enth;
+		S_rand[k] = co2_props.entr;
+
+		double f = (double)(k % 1000) / 999.0;
+		P_sweep[k] = 25000.0 - 1000.0*f;
+		H_sweep[k] = co2_low.enth + (co2_high.enth - co2_low.enth)*f;
+	}
+
+	CO2_set_backend(CO2_BACKEND_TABLES);
+	CO2_PH(P_rand[0], H_rand[0], &co2_props);	// build the tables outside the timing
+	CO2_PS(P_rand[0], S_rand[0], &co2_props);
+
+	printf("PH random: EOS %.3f us/call, tables %.3f us/call\n", co2_us_per_call(CO2_PH_eos, P_rand, H_rand), co2_us_per_call(CO2_PH, P_rand, H_rand));
+	printf("PH sweep:  EOS %.3f us/call, tables %.3f us/call\n", co2_us_per_call(CO2_PH_eos, P_sweep, H_sweep), co2_us_per_call(CO2_PH, P_sweep, H_sweep));
+	printf("PS random: EOS %.3f us/call, tables %.3f us/call\n", co2_us_per_call(CO2_PS_eos, P_rand, S_rand), co2_us_per_call(CO2_PS, P_rand, S_rand));
+}
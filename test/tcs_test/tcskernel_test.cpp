@@ -0,0 +1,108 @@
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../tcs/tcskernel.h"
+
+/**
+ * Two units in a loop converging to x = 2 (y = x/2 + 1, x = y), a unit reading y that feeds nothing back,
+ * and a unit with no connections.
+ */
+static tcsvarinfo tk_half_variables[] = {
+	{ TCS_INPUT, TCS_NUMBER, 0, "x", "Input", "", "", "", "0" },
+	{ TCS_OUTPUT, TCS_NUMBER, 1, "y", "Output", "", "", "", "0" },
+	{ TCS_INVALID, TCS_INVALID, 0, 0, 0, 0, 0, 0, 0 } };
+
+static tcsvarinfo tk_copy_variables[] = {
+	{ TCS_INPUT, TCS_NUMBER, 0, "in", "Input", "", "", "", "0" },
+	{ TCS_OUTPUT, TCS_NUMBER, 1, "out", "Output", "", "", "", "0" },
+	{ TCS_INVALID, TCS_INVALID, 0, 0, 0, 0, 0, 0, 0 } };
+
+static void *tk_create(tcscontext *, tcstypeinfo *) { return new int(0); }
+static void tk_free(void *inst) { delete static_cast<int*>(inst); }
+
+static int tk_half_invoke(tcscontext *, void *, int ctrl, tcsvalue *values, unsigned int, double, double, int)
+{
+	if (ctrl == TCS_INVOKE)
+		values[1].data.value = 0.5 * values[0].data.value + 1.0;
+	return 0;
+}
+
+static int tk_copy_invoke(tcscontext *, void *, int ctrl, tcsvalue *values, unsigned int, double, double, int)
+{
+	if (ctrl == TCS_INVOKE)
+		values[1].data.value = values[0].data.value;
+	return 0;
+}
+
+static tcstypeinfo tk_half_type = { "tk_half", "", "", "", 1, tk_half_variables, 0, TCS_KERNEL_VERSION, 0, tk_create, tk_free, tk_half_invoke };
+static tcstypeinfo tk_copy_type = { "tk_copy", "", "", "", 1, tk_copy_variables, 0, TCS_KERNEL_VERSION, 0, tk_create, tk_free, tk_copy_invoke };
+
+class tcskernel_test : public tcskernel
+{
+public:
+	std::vector<std::string> m_notices;
+
+	tcskernel_test(tcstypeprovider *prov) : tcskernel(prov) { }
+
+	virtual void message(const std::string &text, int msgtype)
+	{
+		if (msgtype == TCS_NOTICE)
+			m_notices.push_back(text);
+	}
+
+	unit &get_unit(int id) { return m_units[id]; }
+};
+
+TEST(TcsKernel, UnitsCalledOnlyWhenInputsChange_tcskernel)
+{
+	tcstypeprovider provider;
+	provider.register_type("tk_half", &tk_half_type);
+	provider.register_type("tk_copy", &tk_copy_type);
+
+	tcskernel_test kernel(&provider);
+	int half = kernel.add_unit("tk_half", "half");
+	int feedback = kernel.add_unit("tk_copy", "feedback");
+	int sink = kernel.add_unit("tk_copy", "sink");
+	int unconnected = kernel.add_unit("tk_copy", "unconnected");
+	ASSERT_TRUE(kernel.connect(half, "y", feedback, "in"));
+	ASSERT_TRUE(kernel.connect(feedback, "out", half, "x"));
+	ASSERT_TRUE(kernel.connect(half, "y", sink, "in"));
+
+	ASSERT_EQ(kernel.simulate(0, 7200, 3600), 0);
+
+	EXPECT_NEAR(kernel.get_unit_value_number(half, "x"), 2.0, 1.0e-2);
+	EXPECT_NEAR(kernel.get_unit_value_number(sink, "out"), kernel.get_unit_value_number(half, "y"), 1.0e-2);
+
+	// the loop iterates in the first step, and is already within tolerance in later steps, where
+	// each unit is called once.  the loop ends when y changes within tolerance, so y's targets are not called
+	int n_steps = 3;
+	int n_half = kernel.get_unit(half).totalcalls;
+	EXPECT_GT(n_half, 2 * n_steps);
+	EXPECT_EQ(kernel.get_unit(feedback).totalcalls, n_half - 1);
+	EXPECT_EQ(kernel.get_unit(sink).totalcalls, n_half - 1);
+	EXPECT_EQ(kernel.get_unit(unconnected).totalcalls, n_steps);
+
+	// call counts and times are reported for each unit at the end of the simulation
+	ASSERT_EQ(kernel.m_notices.size(), 4);
+	EXPECT_EQ(kernel.m_notices[3].find("unit 3 (unconnected) type 'tk_copy' called 3 times in "), 0);
+}
+
+TEST(TcsKernel, SolveWithoutSimulate_tcskernel)
+{
+	tcstypeprovider provider;
+	provider.register_type("tk_half", &tk_half_type);
+	provider.register_type("tk_copy", &tk_copy_type);
+
+	tcskernel_test kernel(&provider);
+	int half = kernel.add_unit("tk_half", "half");
+	int feedback = kernel.add_unit("tk_copy", "feedback");
+	ASSERT_TRUE(kernel.connect(half, "y", feedback, "in"));
+	ASSERT_TRUE(kernel.connect(feedback, "out", half, "x"));
+
+	// connections made before 'solve' are propagated without a call to 'simulate'
+	ASSERT_GT(kernel.solve(0, 3600), 1);
+	EXPECT_NEAR(kernel.get_unit_value_number(half, "x"), 2.0, 1.0e-2);
+	EXPECT_GT(kernel.get_unit(half).totalcalls, 2);
+}
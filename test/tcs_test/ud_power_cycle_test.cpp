@@ -0,0 +1,202 @@
+#include <string>
+#include <vector>
+#include <cstdio>
+
+#include <gtest/gtest.h>
+
+#include "../tcs/ud_power_cycle.h"
+#include "../ssc/sscapi.h"
+
+/**
+ * Off-design function with an analytic response. If it can't be copied, its water use is its call count,
+ * which stands in for the last solution an off-design cycle model uses as its next guess.
+ */
+class C_od_pc_analytic : public C_od_pc_function
+{
+public:
+	int m_n_calls;
+	bool m_is_cloneable;
+
+	C_od_pc_analytic(bool is_cloneable)
+	{
+		m_n_calls = 0;
+		m_is_cloneable = is_cloneable;
+	}
+
+	virtual int operator()(S_f_inputs inputs, S_f_outputs & outputs)
+	{
+		m_n_calls++;
+
+		// Generic off-design response at the coldest ambient temperature
+		if (inputs.m_T_amb < 1.0)
+			return -1;
+
+		outputs.m_W_dot_gross_ND = inputs.m_m_dot_htf_ND * (1.0 + 0.001*(inputs.m_T_htf_hot - 574.0)) - 0.002*(inputs.m_T_amb - 35.0);
+		outputs.m_Q_dot_in_ND = inputs.m_m_dot_htf_ND;
+		outputs.m_W_dot_cooling_ND = 1.0 + 0.05*(inputs.m_T_amb - 35.0);
+		outputs.m_m_dot_water_ND = m_is_cloneable ? 1.0 : 0.01*m_n_calls;
+
+		return 0;
+	}
+
+	virtual C_od_pc_function * clone() const
+	{
+		if (!m_is_cloneable)
+			return 0;
+
+		return new C_od_pc_analytic(*this);
+	}
+};
+
+static bool ud_pc_test_callback(std::string &log_msg, std::string &progress_msg, void *data, double progress, int out_type)
+{
+	int run_number = -1, n_runs = -1;
+	std::string::size_type i_run = log_msg.find('[');
+	if (i_run != std::string::npos)
+		sscanf(log_msg.c_str() + i_run, "[%d/%d]", &run_number, &n_runs);
+	static_cast<std::vector<int>*>(data)->push_back(run_number);
+
+	return true;
+}
+
+static void ud_pc_generate_tables(C_od_pc_function &f_od, int n_threads, std::vector<int> &run_numbers,
+	util::matrix_t<double> &T_htf_ind, util::matrix_t<double> &T_amb_ind, util::matrix_t<double> &m_dot_htf_ind)
+{
+	C_ud_pc_table_generator c_ud_pc(f_od);
+	c_ud_pc.m_n_threads = n_threads;
+	c_ud_pc.mf_callback = ud_pc_test_callback;
+	c_ud_pc.mp_mf_active = &run_numbers;
+
+	c_ud_pc.generate_tables(574.0, 554.0, 589.0, 4,
+		35.0, 0.0, 45.0, 5,
+		1.0, 0.5, 1.05, 3,
+		T_htf_ind, T_amb_ind, m_dot_htf_ind);
+}
+
+TEST(UDPCTableGenerator, ThreadedMatchesSerial_ud_power_cycle)
+{
+	C_od_pc_analytic f_od(true);
+
+	std::vector<int> runs_serial, runs_threaded;
+	util::matrix_t<double> T_htf_serial, T_amb_serial, m_dot_serial;
+	util::matrix_t<double> T_htf_threaded, T_amb_threaded, m_dot_threaded;
+	ud_pc_generate_tables(f_od, 1, runs_serial, T_htf_serial, T_amb_serial, m_dot_serial);
+	ud_pc_generate_tables(f_od, 4, runs_threaded, T_htf_threaded, T_amb_threaded, m_dot_threaded);
+
+	// Points run on copies of the function, so the original is never called
+	EXPECT_EQ(f_od.m_n_calls, 0);
+
+	util::matrix_t<double> *serial[3] = { &T_htf_serial, &T_amb_serial, &m_dot_serial };
+	util::matrix_t<double> *threaded[3] = { &T_htf_threaded, &T_amb_threaded, &m_dot_threaded };
+	for (int t = 0; t < 3; t++)
+	{
+		ASSERT_EQ(serial[t]->nrows(), threaded[t]->nrows());
+		ASSERT_EQ(serial[t]->ncols(), 13);
+		ASSERT_EQ(threaded[t]->ncols(), 13);
+		for (size_t i = 0; i < serial[t]->nrows(); i++)
+			for (size_t j = 0; j < 13; j++)
+				EXPECT_EQ(serial[t]->at(i, j), threaded[t]->at(i, j)) << "table " << t << " row " << i << " col " << j;
+	}
+
+	EXPECT_EQ(T_htf_serial.at(3, 11), 1.0);
+	EXPECT_NEAR(T_htf_serial.at(3, 3), 1.05*1.015, 1.e-12);
+
+	// Generic response at T_amb = 0 C
+	EXPECT_EQ(T_amb_serial.at(0, 0), 0.0);
+	EXPECT_EQ(T_amb_serial.at(0, 2), 1.0);
+	EXPECT_EQ(m_dot_serial.at(0, 1), 0.5);
+
+	// Progress is reported once per point, in table order
+	int n_runs = 3 * (4 + 5 + 3);
+	ASSERT_EQ(runs_serial.size(), n_runs);
+	ASSERT_EQ(runs_threaded.size(), n_runs);
+	for (int k = 0; k < n_runs; k++)
+	{
+		EXPECT_EQ(runs_serial[k], k + 1);
+		EXPECT_EQ(runs_threaded[k], k + 1);
+	}
+}
+
+TEST(UDPCTableGenerator, NotCloneableRunsInOrder_ud_power_cycle)
+{
+	C_od_pc_analytic f_od(false);
+
+	std::vector<int> run_numbers;
+	util::matrix_t<double> T_htf_ind, T_amb_ind, m_dot_htf_ind;
+	ud_pc_generate_tables(f_od, 4, run_numbers, T_htf_ind, T_amb_ind, m_dot_htf_ind);
+
+	int n_runs = 3 * (4 + 5 + 3);
+	EXPECT_EQ(f_od.m_n_calls, n_runs);
+	ASSERT_EQ(run_numbers.size(), n_runs);
+
+	// The original function is called for each point in table order
+	EXPECT_NEAR(T_htf_ind.at(0, 10), 0.01, 1.e-12);
+	EXPECT_NEAR(T_htf_ind.at(3, 12), 0.12, 1.e-12);
+	EXPECT_NEAR(T_amb_ind.at(4, 12), 0.27, 1.e-12);
+	EXPECT_NEAR(m_dot_htf_ind.at(2, 11), 0.35, 1.e-12);
+}
+
+TEST(UDPCTableGenerator, PartialCoolingMatchesSerial_ud_power_cycle)
+{
+	// 50 MWe partial cooling cycle with 3 levels of each independent variable
+	ssc_data_t data = ssc_data_create();
+	ssc_data_set_number(data, "htf", 17);
+	ssc_data_set_number(data, "T_htf_hot_des", 574);
+	ssc_data_set_number(data, "dT_PHX_hot_approach", 20);
+	ssc_data_set_number(data, "T_amb_des", 35);
+	ssc_data_set_number(data, "dT_mc_approach", 6);
+	ssc_data_set_number(data, "site_elevation", 588);
+	ssc_data_set_number(data, "W_dot_net_des", 50);
+	ssc_data_set_number(data, "design_method", 1);
+	ssc_data_set_number(data, "eta_thermal_des", 0.44);
+	ssc_data_set_number(data, "cycle_config", 2);
+	ssc_data_set_number(data, "eta_isen_mc", 0.89);
+	ssc_data_set_number(data, "eta_isen_rc", 0.89);
+	ssc_data_set_number(data, "eta_isen_pc", 0.89);
+	ssc_data_set_number(data, "eta_isen_t", 0.9);
+	ssc_data_set_number(data, "LT_recup_eff_max", 1);
+	ssc_data_set_number(data, "HT_recup_eff_max", 1);
+	ssc_data_set_number(data, "P_high_limit", 25);
+	ssc_data_set_number(data, "dT_PHX_cold_approach", 20);
+	ssc_data_set_number(data, "fan_power_frac", 0.01);
+	ssc_data_set_number(data, "deltaP_cooler_frac", 0.002);
+	ssc_data_set_number(data, "n_T_htf_hot", 3);
+	ssc_data_set_number(data, "n_T_amb", 3);
+	ssc_data_set_number(data, "n_m_dot_htf_ND", 3);
+	ssc_data_set_number(data, "n_threads", 4);
+
+	ssc_module_exec_set_print(0);
+	ssc_module_t module = ssc_module_create("sco2_csp_ud_pc_tables");
+	ASSERT_TRUE(ssc_module_exec(module, data));
+
+	// Tables from the serial generator, where each point starts from the previous point's solution
+	double T_htf_serial[3][13] = {
+		{ 554, 0.499990612, 0.966695547, 0.975257397, 0.616713822, 0.991356492, 0.993606091, 0.229320034, 1.0568589, 1.04343784, 1, 1, 1 },
+		{ 571.5, 0.49998638, 0.995907605, 1.0033474, 0.591606021, 0.998583674, 1.0011121, 0.175711304, 1.00710678, 0.999656379, 1, 1, 1 },
+		{ 589, 0.500002503, 1.00000072, 1.03145063, 0.573500335, 0.981209755, 1.00888276, 0.142949119, 0.860503197, 0.958973646, 1, 1, 1 } };
+	double T_amb_serial[3][13] = {
+		{ 0, 0.999995947, 0.999974668, 0.999970734, 1.02179134, 0.990390241, 0.970175207, 0.0126320571, 0.00998460688, 0.00930500589, 1, 1, 1 },
+		{ 22.5, 0.999995947, 0.999974668, 0.999970734, 1.02179134, 0.990390241, 0.970175207, 0.148733169, 0.10731604, 0.112254798, 1, 1, 1 },
+		{ 45, 0.784757376, 0.813481152, 0.834170163, 0.876354039, 0.886053622, 0.893071353, 0.783899248, 0.753535032, 0.732976675, 1, 1, 1 } };
+	double m_dot_serial[3][13] = {
+		{ 0.5, 0.49999398, 0.499990463, 0.500003576, 0.541197062, 0.588673949, 0.681680441, 0.00369971106, 0.170035958, 0.479819626, 1, 1, 1 },
+		{ 0.774999976, 0.774877906, 0.774967074, 0.758208394, 0.752707779, 0.801116407, 0.867772758, 0.00677530188, 0.394334853, 0.811387658, 1, 1, 1 },
+		{ 1.04999995, 1.05118573, 1.00769842, 0.818750739, 1.04332972, 1.00215566, 0.888014138, 0.0119945463, 0.992131829, 0.749415576, 1, 1, 1 } };
+
+	const char *names[3] = { "T_htf_ind", "T_amb_ind", "m_dot_htf_ND_ind" };
+	double (*serial[3])[13] = { T_htf_serial, T_amb_serial, m_dot_serial };
+	for (int t = 0; t < 3; t++)
+	{
+		int n_rows = 0, n_cols = 0;
+		ssc_number_t *table = ssc_data_get_matrix(data, names[t], &n_rows, &n_cols);
+		ASSERT_TRUE(table != 0);
+		ASSERT_EQ(n_rows, 3);
+		ASSERT_EQ(n_cols, 13);
+		for (int i = 0; i < n_rows; i++)
+			for (int j = 0; j < n_cols; j++)
+				EXPECT_NEAR(table[i*n_cols + j], serial[t][i][j], 1.e-6) << names[t] << " row " << i << " col " << j;
+	}
+
+	ssc_module_free(module);
+	ssc_data_free(data);
+}